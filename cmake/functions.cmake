@@ -13,9 +13,11 @@ function( make_pak name )
         message( FATAL_ERROR "archive ${name} not declared, check name typos" )
     endif()
     get_target_property( src ${name} SOURCES )
+    # release archives are always packed from scratch for deterministic output
     add_custom_command( OUTPUT "${CMAKE_BINARY_DIR}/${name}.pak"
+        BYPRODUCTS "${CMAKE_BINARY_DIR}/${name}.pak.manifest"
         DEPENDS cooker_pak "${src}"
-        COMMAND cooker_pak "${CMAKE_BINARY_DIR}/${name}.pak" "\"${src}\""
+        COMMAND cooker_pak "${CMAKE_BINARY_DIR}/${name}.pak" "\"${src}\"" $<$<NOT:$<CONFIG:Release>>:--incremental>
     )
     add_dependencies( cook ${name} )
     set_vs_directory( ${name} ${name} )
@@ -64,11 +66,49 @@ function( cook_lang )
     pak_file_cooked( ${DEFAULT_PACK} "${file_out}" "lang.${COOK_LANG_DST}" )
 endfunction()
 
+function( cook_ui )
+    cmake_parse_arguments( COOK_UI "" "SRC;DST;PACK" "" ${ARGN} )
+
+    if ( NOT COOK_UI_SRC )
+        message( FATAL_ERROR "SRC argument not specified" )
+    elseif( NOT COOK_UI_DST )
+        message( FATAL_ERROR "DST argument not specified" )
+    endif()
+    if ( NOT DEFINED COOK_UI_PACK )
+        set( COOK_UI_PACK ${DEFAULT_PACK} )
+    endif()
+    set( file_out "${CMAKE_CURRENT_BINARY_DIR}/${COOK_UI_DST}" )
+    add_custom_target( "ui.${COOK_UI_DST}" DEPENDS "${file_out}" )
+
+    add_custom_command(
+        OUTPUT "${file_out}"
+        DEPENDS cooker_ui
+        DEPENDS "${CMAKE_CURRENT_SOURCE_DIR}/${COOK_UI_SRC}"
+        COMMAND cooker_ui
+            --src "${CMAKE_CURRENT_SOURCE_DIR}/${COOK_UI_SRC}"
+            --dst "${file_out}"
+    )
+    set_vs_directory( "ui.${COOK_UI_DST}" "assets/ui" )
+    pak_file_cooked( ${COOK_UI_PACK} "${file_out}" "ui.${COOK_UI_DST}" )
+endfunction()
+
 function( cook_dds )
-    cmake_parse_arguments( COOK_DDS "MIPGEN;CUBEMAP" "DST;FORMAT;PACK" "SRC" ${ARGN} )
+    cmake_parse_arguments( COOK_DDS "MIPGEN;CUBEMAP;SRGB" "DST;FORMAT;PACK;MIPFILTER;ALPHA_COVERAGE;QUALITY" "SRC" ${ARGN} )
     if ( COOK_DDS_MIPGEN )
         set( COOK_DDS_MIPGEN "--mipgen" )
     endif()
+    if ( COOK_DDS_SRGB )
+        set( COOK_DDS_SRGB "--srgb" )
+    endif()
+    if ( COOK_DDS_MIPFILTER )
+        set( COOK_DDS_MIPFILTER_PARAM "--mipfilter" )
+    endif()
+    if ( COOK_DDS_ALPHA_COVERAGE )
+        set( COOK_DDS_ALPHA_COVERAGE_PARAM "--alpha-coverage" )
+    endif()
+    if ( COOK_DDS_QUALITY )
+        set( COOK_DDS_QUALITY_PARAM "--quality" )
+    endif()
     if ( COOK_DDS_CUBEMAP )
         set( COOK_DDS_CUBEMAP "--cubemap" )
     endif()
@@ -105,6 +145,10 @@ function( cook_dds )
             ${COOK_DDS_MIPGEN}
             ${COOK_DDS_CUBEMAP}
             ${COOK_DDS_FORMAT_PARAM} ${COOK_DDS_FORMAT}
+            ${COOK_DDS_SRGB}
+            ${COOK_DDS_MIPFILTER_PARAM} ${COOK_DDS_MIPFILTER}
+            ${COOK_DDS_ALPHA_COVERAGE_PARAM} ${COOK_DDS_ALPHA_COVERAGE}
+            ${COOK_DDS_QUALITY_PARAM} ${COOK_DDS_QUALITY}
     )
     set_vs_directory( "texture.${COOK_DDS_DST}" "assets/textures" )
     pak_file_cooked( ${COOK_DDS_PACK} "${file_out}" "texture.${COOK_DDS_DST}" )
@@ -1,6 +1,8 @@
 #include <audio/audio.hpp>
+#include <audio/mixer.hpp>
+#include <audio/sound_bank.hpp>
+#include <audio/stream.hpp>
 
-#include <shared/indexer.hpp>
 #include <platform/utils.hpp>
 
 #include <profiler.hpp>
@@ -12,10 +14,8 @@
 #include <atomic>
 #include <cassert>
 #include <memory_resource>
-#include <mutex>
 #include <string>
 #include <string_view>
-#include <variant>
 #include <vector>
 
 constexpr unsigned long long operator""_Hz( unsigned long long hz ) noexcept
@@ -23,34 +23,19 @@ constexpr unsigned long long operator""_Hz( unsigned long long hz ) noexcept
     return hz;
 }
 
-class SDLAudio;
-
 using Buffer = std::pmr::vector<Uint8>;
 
-struct PlayerWav {
-    SDLAudio* m_instance{};
-    uint32_t m_position{};
-    Audio::Slot m_slot{};
-    Audio::Channel m_channel{};
-
-    void operator () ( std::span<Uint8> );
-    inline operator bool () const { return !!m_instance; }
-};
-
-using Player = std::variant<PlayerWav>;
-
 class SDLAudio : public Audio {
 public:
     SDL_AudioSpec m_spec{};
     std::array<float, (size_t)Audio::Channel::count> m_volumeChannels{};
 
-    std::mutex m_bottleneck;
-    std::pmr::vector<Player> m_players;
-
-    static constexpr uint64_t c_maxSlots = 8;
-    Indexer<c_maxSlots> m_slotMachine{};
-    std::array<Buffer, c_maxSlots> m_audioSlots{};
+    SoundBank m_bank{};
+    Mixer m_mixer{};
+    StreamDecoder m_streams{};
 
+    Listener m_listener{};
+    std::atomic<uint32_t> m_culled = 0;
 
     SDL_AudioDeviceID m_device{};
     std::pmr::string m_deviceName{};
@@ -68,13 +53,20 @@ public:
     virtual ~SDLAudio() override;
     SDLAudio();
 
-    virtual void play( Slot, Channel ) override;
-    virtual Slot load( std::span<const uint8_t> ) override;
+    virtual void play( Slot, Channel, Priority ) override;
+    virtual void play( Slot, Channel, const Emitter&, Priority ) override;
+    virtual void setListener( const Listener& ) override;
+    virtual Stream stream( std::span<const uint8_t>, Channel, bool ) override;
+    virtual void stop( Stream ) override;
+    virtual void stop( std::span<const uint8_t> ) override;
+    virtual Slot load( std::span<const uint8_t>, Channel ) override;
+    virtual void unload( Slot ) override;
     virtual void setVolume( Channel, float ) override;
     virtual std::pmr::vector<std::pmr::string> listDrivers() override;
     virtual bool selectDriver( std::string_view ) override;
     virtual std::pmr::vector<std::pmr::string> listDevices() override;
     virtual bool selectDevice( std::string_view ) override;
+    virtual Statistics statistics() const override;
 };
 
 Audio* Audio::create()
@@ -83,26 +75,6 @@ Audio* Audio::create()
 }
 
 
-void PlayerWav::operator () ( std::span<Uint8> stream )
-{
-    assert( m_instance );
-    assert( m_slot < m_instance->m_audioSlots.size() );
-    const Buffer& buffer = m_instance->m_audioSlots[ m_slot ];
-    const uint32_t bufferSize = static_cast<uint32_t>( buffer.size() );
-    assert( m_position < bufferSize );
-
-    const Uint32 sizeRemaining = static_cast<Uint32>( bufferSize - m_position );
-    const Uint32 playLength = std::min( static_cast<Uint32>( stream.size() ), sizeRemaining );
-    SDL_MixAudioFormat( stream.data()
-        , buffer.data() + m_position
-        , m_instance->m_spec.format
-        , playLength
-        , static_cast<decltype(SDL_MIX_MAXVOLUME)>( SDL_MIX_MAXVOLUME * m_instance->volume( m_channel ) )
-    );
-    m_position += playLength;
-    if ( m_position == bufferSize ) m_instance = nullptr;
-}
-
 SDLAudio::~SDLAudio()
 {
     ZoneScoped;
@@ -137,16 +109,17 @@ void SDLAudio::callback( void* userData, Uint8* data, int len )
     assert( userData );
     assert( data );
 
-    std::fill_n( data, len, (Uint8)0 );
     SDLAudio* instance = reinterpret_cast<SDLAudio*>( userData );
-    auto& toPlay = instance->m_players;
-    std::span<Uint8> stream( data, data + len );
-    std::scoped_lock bottleneck( instance->m_bottleneck );
-    std::ranges::for_each( toPlay, [stream]( auto& p ) { std::visit( [stream]( auto& pp ) { pp( stream ); }, p ); } );
-    std::erase_if( toPlay, []( const auto& p ) { return std::visit( []( const auto& pp ) -> bool { return !pp; }, p ); } );
+    std::array<float, (size_t)Audio::Channel::count> gain{};
+    for ( size_t i = 0; i < gain.size(); ++i ) {
+        gain[ i ] = instance->volume( static_cast<Audio::Channel>( i ) );
+    }
+    // device is opened with AUDIO_S16SYS, mixer writes every sample
+    std::span<int16_t> stream{ reinterpret_cast<int16_t*>( data ), static_cast<size_t>( len ) / sizeof( int16_t ) };
+    instance->m_mixer.mix( stream, gain );
 }
 
-Audio::Slot SDLAudio::load( std::span<const uint8_t> data )
+Audio::Slot SDLAudio::load( std::span<const uint8_t> data, Audio::Channel c )
 {
     ZoneScoped;
     Buffer buffer{ allocator() };
@@ -174,30 +147,81 @@ Audio::Slot SDLAudio::load( std::span<const uint8_t> data )
         buffer.resize( static_cast<Buffer::size_type>( cvt.len_cvt ) );
 
     }
+    else {
+        buffer.assign( tmpBuff, tmpBuff + tmpLen );
+    }
     SDL_FreeWAV( tmpBuff );
-
-    uint16_t slot = static_cast<uint16_t>( m_slotMachine.next() );
-    assert( slot < m_audioSlots.size() );
-    m_audioSlots[ slot ] = std::move( buffer );
     SDL_RWclose( rwops );
-    return slot + 1;
+    return m_bank.add( std::move( buffer ), static_cast<uint8_t>( c ) );
+}
+
+void SDLAudio::unload( Audio::Slot slot )
+{
+    ZoneScoped;
+    m_bank.release( slot );
+}
+
+void SDLAudio::play( Audio::Slot idx, Audio::Channel c, Audio::Priority p )
+{
+    ZoneScoped;
+    // stale handles of unloaded or reloaded sounds play nothing
+    const SoundBank::Sound sound = m_bank.acquire( idx );
+    if ( !sound.voices ) return;
+    m_mixer.play( sound.samples, static_cast<uint8_t>( c ), static_cast<uint8_t>( p ), sound.voices );
+}
+
+void SDLAudio::play( Audio::Slot idx, Audio::Channel c, const Audio::Emitter& emitter, Audio::Priority p )
+{
+    ZoneScoped;
+    const Spatial spatial = Spatial::compute( m_listener, emitter );
+    if ( !spatial.audible() ) {
+        m_culled.fetch_add( 1, std::memory_order_relaxed );
+        return;
+    }
+    const SoundBank::Sound sound = m_bank.acquire( idx );
+    if ( !sound.voices ) return;
+    const Mixer::Placement placement{
+        .left = spatial.left,
+        .right = spatial.right,
+        .pitch = spatial.pitch,
+    };
+    m_mixer.play( sound.samples, static_cast<uint8_t>( c ), static_cast<uint8_t>( p ), sound.voices, placement );
+}
+
+void SDLAudio::setListener( const Audio::Listener& listener )
+{
+    m_listener = listener;
 }
 
-void SDLAudio::play( Audio::Slot idx, Audio::Channel c )
+Audio::Stream SDLAudio::stream( std::span<const uint8_t> wav, Audio::Channel c, bool loop )
 {
     ZoneScoped;
-    assert( idx > 0 );
-    idx--;
-    assert( idx < m_audioSlots.size() );
-
-    PlayerWav play{
-        .m_instance = this,
-        .m_position = 0,
-        .m_slot = idx,
-        .m_channel = c,
+    if ( !m_device ) return 0;
+    const AudioStream::Format device{
+        .rate = static_cast<uint32_t>( m_spec.freq ),
+        .channels = m_spec.channels,
     };
-    std::scoped_lock bottleneck( m_bottleneck );
-    m_players.emplace_back( play );
+    AudioStream* stream = m_streams.open( wav, device, loop );
+    if ( !stream ) return 0;
+    // music is never replaced by sound effects
+    m_mixer.play( stream, static_cast<uint8_t>( c ), 0xFFu );
+    return ( static_cast<Stream>( stream->generation() ) << 16 ) | ( m_streams.indexOf( stream ) + 1u );
+}
+
+void SDLAudio::stop( Audio::Stream s )
+{
+    const uint32_t index = s & 0xFFFFu;
+    if ( !index ) return;
+    assert( index <= StreamDecoder::MAX_STREAMS );
+    // stream of stale handle may have finished and been reopened for another playback
+    AudioStream* stream = m_streams[ index - 1u ];
+    if ( stream->generation() != static_cast<uint16_t>( s >> 16 ) ) return;
+    stream->stop();
+}
+
+void SDLAudio::stop( std::span<const uint8_t> wav )
+{
+    m_streams.stop( wav );
 }
 
 void SDLAudio::setVolume( Audio::Channel c, float v )
@@ -248,18 +272,34 @@ bool SDLAudio::selectDevice( std::string_view name )
 
     const SDL_AudioSpec want{
         .freq = 48000_Hz,
-        .format = AUDIO_S16LSB,
+        .format = AUDIO_S16SYS,
         .channels = 2,
         .samples = 512,
         .callback = &SDLAudio::callback,
         .userdata = this,
     };
     if ( m_device ) SDL_CloseAudioDevice( m_device );
-    m_device = SDL_OpenAudioDevice( it->c_str(), 0, &want, &m_spec, SDL_AUDIO_ALLOW_FORMAT_CHANGE );
+    m_device = SDL_OpenAudioDevice( it->c_str(), 0, &want, &m_spec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE | SDL_AUDIO_ALLOW_CHANNELS_CHANGE );
     if ( m_device == 0 ) platform::showFatalError( "Failed to initialize audio device", (std::string)name );
+    // device starts paused, mixer is not running yet
+    m_mixer.setChannels( m_spec.channels );
     SDL_PauseAudioDevice( m_device, 0 );
     m_deviceName = *it;
     return true;
 
 }
 
+Audio::Statistics SDLAudio::statistics() const
+{
+    const SoundBank::Statistics bank = m_bank.statistics();
+    const Mixer::Statistics mixer = m_mixer.statistics();
+    Statistics ret{
+        .voices = mixer.voices,
+        .stolen = mixer.stolen,
+        .dropped = mixer.dropped,
+        .culled = m_culled.load( std::memory_order_relaxed ),
+    };
+    std::copy_n( bank.bytes.begin(), ret.bytes.size(), ret.bytes.begin() );
+    std::copy_n( bank.sounds.begin(), ret.sounds.size(), ret.sounds.begin() );
+    return ret;
+}
@@ -0,0 +1,267 @@
+#include <audio/mixer.hpp>
+
+#include <audio/stream.hpp>
+
+#include <profiler.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#elif defined( __SSE2__ ) || defined( _M_X64 )
+#include <emmintrin.h>
+#endif
+
+// acc[ i ] += src[ i ] * gain
+static void accumulate( float* acc, const int16_t* src, uint32_t count, float gain )
+{
+    uint32_t i = 0;
+#if defined( __AVX2__ )
+    const __m256 g = _mm256_set1_ps( gain );
+    for ( ; i + 8 <= count; i += 8 ) {
+        const __m128i s = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i ) );
+        const __m256 f = _mm256_cvtepi32_ps( _mm256_cvtepi16_epi32( s ) );
+        _mm256_storeu_ps( acc + i, _mm256_add_ps( _mm256_loadu_ps( acc + i ), _mm256_mul_ps( f, g ) ) );
+    }
+#elif defined( __SSE2__ ) || defined( _M_X64 )
+    const __m128 g = _mm_set1_ps( gain );
+    for ( ; i + 8 <= count; i += 8 ) {
+        const __m128i s = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i ) );
+        // sign extend by placing sample in upper half and shifting back
+        const __m128 lo = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( s, s ), 16 ) );
+        const __m128 hi = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( s, s ), 16 ) );
+        _mm_storeu_ps( acc + i, _mm_add_ps( _mm_loadu_ps( acc + i ), _mm_mul_ps( lo, g ) ) );
+        _mm_storeu_ps( acc + i + 4, _mm_add_ps( _mm_loadu_ps( acc + i + 4 ), _mm_mul_ps( hi, g ) ) );
+    }
+#endif
+    for ( ; i < count; ++i ) {
+        acc[ i ] += static_cast<float>( src[ i ] ) * gain;
+    }
+}
+
+// rounds and saturates to int16, returns number of clipped samples
+static uint64_t convert( int16_t* dst, const float* acc, uint32_t count )
+{
+    static constexpr float MIN = -32768.0f;
+    static constexpr float MAX = 32767.0f;
+    uint64_t clipped = 0;
+    uint32_t i = 0;
+#if defined( __AVX2__ )
+    const __m256 min = _mm256_set1_ps( MIN );
+    const __m256 max = _mm256_set1_ps( MAX );
+    for ( ; i + 16 <= count; i += 16 ) {
+        const __m256 a = _mm256_loadu_ps( acc + i );
+        const __m256 b = _mm256_loadu_ps( acc + i + 8 );
+        const __m256 clipA = _mm256_or_ps( _mm256_cmp_ps( a, max, _CMP_GT_OQ ), _mm256_cmp_ps( a, min, _CMP_LT_OQ ) );
+        const __m256 clipB = _mm256_or_ps( _mm256_cmp_ps( b, max, _CMP_GT_OQ ), _mm256_cmp_ps( b, min, _CMP_LT_OQ ) );
+        clipped += static_cast<uint64_t>( std::popcount( static_cast<uint32_t>( _mm256_movemask_ps( clipA ) ) ) );
+        clipped += static_cast<uint64_t>( std::popcount( static_cast<uint32_t>( _mm256_movemask_ps( clipB ) ) ) );
+        // pack works within 128 bit lanes, restore sample order afterwards
+        const __m256i packed = _mm256_packs_epi32( _mm256_cvtps_epi32( a ), _mm256_cvtps_epi32( b ) );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst + i ), _mm256_permute4x64_epi64( packed, 0b11'01'10'00 ) );
+    }
+#elif defined( __SSE2__ ) || defined( _M_X64 )
+    const __m128 min = _mm_set1_ps( MIN );
+    const __m128 max = _mm_set1_ps( MAX );
+    for ( ; i + 8 <= count; i += 8 ) {
+        const __m128 a = _mm_loadu_ps( acc + i );
+        const __m128 b = _mm_loadu_ps( acc + i + 4 );
+        const __m128 clipA = _mm_or_ps( _mm_cmpgt_ps( a, max ), _mm_cmplt_ps( a, min ) );
+        const __m128 clipB = _mm_or_ps( _mm_cmpgt_ps( b, max ), _mm_cmplt_ps( b, min ) );
+        clipped += static_cast<uint64_t>( std::popcount( static_cast<uint32_t>( _mm_movemask_ps( clipA ) | ( _mm_movemask_ps( clipB ) << 4 ) ) ) );
+        const __m128i packed = _mm_packs_epi32( _mm_cvtps_epi32( a ), _mm_cvtps_epi32( b ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i ), packed );
+    }
+#endif
+    for ( ; i < count; ++i ) {
+        const float a = acc[ i ];
+        clipped += ( a > MAX ) || ( a < MIN );
+        dst[ i ] = static_cast<int16_t>( std::nearbyint( std::clamp( a, MIN, MAX ) ) );
+    }
+    return clipped;
+}
+
+void Mixer::play( std::span<const int16_t> samples, uint8_t channel, uint8_t priority, std::atomic<uint32_t>* users )
+{
+    play( samples, channel, priority, users, Placement{} );
+}
+
+void Mixer::play( std::span<const int16_t> samples, uint8_t channel, uint8_t priority, std::atomic<uint32_t>* users, const Placement& placement )
+{
+    assert( channel < MAX_CHANNELS );
+    assert( placement.pitch > 0.0f );
+    // unplaced voices take the vectorized path
+    const bool placed = placement.left != 1.0f || placement.right != 1.0f || placement.pitch != 1.0f;
+    const Voice voice{
+        .samples = samples.data(),
+        .users = users,
+        .length = static_cast<uint32_t>( samples.size() ),
+        .step = placed ? static_cast<uint64_t>( static_cast<double>( placement.pitch ) * 4294967296.0 ) : 0,
+        .left = placement.left,
+        .right = placement.right,
+        .channel = channel,
+        .priority = priority,
+    };
+    if ( samples.empty() ) [[unlikely]] {
+        release( voice );
+        return;
+    }
+
+    std::scoped_lock sl{ m_bottleneck };
+    if ( m_pendingCount == m_pending.size() ) [[unlikely]] {
+        m_pendingDropped++;
+        release( voice );
+        return;
+    }
+    m_pending[ m_pendingCount++ ] = voice;
+}
+
+void Mixer::play( AudioStream* stream, uint8_t channel, uint8_t priority )
+{
+    assert( stream );
+    assert( channel < MAX_CHANNELS );
+    const Voice voice{
+        .stream = stream,
+        .channel = channel,
+        .priority = priority,
+    };
+    std::scoped_lock sl{ m_bottleneck };
+    if ( m_pendingCount == m_pending.size() ) [[unlikely]] {
+        m_pendingDropped++;
+        release( voice );
+        return;
+    }
+    m_pending[ m_pendingCount++ ] = voice;
+}
+
+void Mixer::release( const Voice& voice )
+{
+    if ( voice.stream ) voice.stream->release();
+    if ( voice.users ) voice.users->fetch_sub( 1, std::memory_order_release );
+}
+
+void Mixer::start( const Voice& voice )
+{
+    Voice* v = nullptr;
+    if ( m_voiceCount < m_voices.size() ) {
+        v = &m_voices[ m_voiceCount++ ];
+    }
+    else {
+        v = &*std::ranges::min_element( m_voices, []( const Voice& lhs, const Voice& rhs )
+        {
+            if ( lhs.priority != rhs.priority ) return lhs.priority < rhs.priority;
+            return lhs.sequence < rhs.sequence;
+        } );
+        if ( v->priority > voice.priority ) {
+            m_statistics.dropped++;
+            release( voice );
+            return;
+        }
+        m_statistics.stolen++;
+        release( *v );
+    }
+    m_statistics.started++;
+    *v = voice;
+    v->sequence = m_sequence++;
+}
+
+uint32_t Mixer::mixBlock( std::span<int16_t> out, std::span<const float> channelGain )
+{
+    const uint32_t count = static_cast<uint32_t>( out.size() );
+    assert( count <= BLOCK );
+    std::fill_n( m_accumulator.begin(), count, 0.0f );
+
+    for ( uint32_t i = 0; i < m_voiceCount; ) {
+        Voice& v = m_voices[ i ];
+        assert( v.channel < channelGain.size() );
+        bool playing = false;
+        if ( v.stream ) {
+            std::array<int16_t, BLOCK> samples;
+            const uint32_t n = v.stream->read( std::span<int16_t>{ samples }.first( count ) );
+            accumulate( m_accumulator.data(), samples.data(), n, channelGain[ v.channel ] );
+            playing = !v.stream->finished();
+            if ( playing ) m_statistics.underrun += count - n;
+        }
+        else if ( v.step ) {
+            playing = mixPlaced( v, count / m_channels, channelGain[ v.channel ] );
+        }
+        else {
+            const uint32_t n = std::min( count, v.length - v.position );
+            accumulate( m_accumulator.data(), v.samples + v.position, n, channelGain[ v.channel ] );
+            v.position += n;
+            playing = v.position < v.length;
+        }
+        if ( playing ) {
+            ++i;
+            continue;
+        }
+        release( v );
+        v = m_voices[ --m_voiceCount ];
+    }
+    m_statistics.clipped += convert( out.data(), m_accumulator.data(), count );
+    return count;
+}
+
+bool Mixer::mixPlaced( Voice& v, uint32_t frames, float gain )
+{
+    const uint32_t channels = m_channels;
+    const uint32_t sourceFrames = v.length / channels;
+    // first two outputs are left and right, remaining ones get average
+    std::array<float, MAX_OUTPUT_CHANNELS> side{};
+    side.fill( ( v.left + v.right ) * 0.5f * gain );
+    if ( channels >= 2 ) {
+        side[ 0 ] = v.left * gain;
+        side[ 1 ] = v.right * gain;
+    }
+
+    float* acc = m_accumulator.data();
+    for ( uint32_t f = 0; f < frames; ++f, acc += channels ) {
+        const uint32_t frame = static_cast<uint32_t>( v.cursor >> 32 );
+        if ( frame >= sourceFrames ) return false;
+        const uint32_t next = std::min( frame + 1, sourceFrames - 1 );
+        const float t = static_cast<float>( v.cursor & 0xFFFF'FFFFull ) * ( 1.0f / 4294967296.0f );
+        const int16_t* a = v.samples + frame * channels;
+        const int16_t* b = v.samples + next * channels;
+        for ( uint32_t c = 0; c < channels; ++c ) {
+            const float s = static_cast<float>( a[ c ] ) + static_cast<float>( b[ c ] - a[ c ] ) * t;
+            acc[ c ] += s * side[ c ];
+        }
+        v.cursor += v.step;
+    }
+    return ( v.cursor >> 32 ) < sourceFrames;
+}
+
+void Mixer::mix( std::span<int16_t> out, std::span<const float> channelGain )
+{
+    ZoneScoped;
+    {
+        std::scoped_lock sl{ m_bottleneck };
+        std::for_each_n( m_pending.begin(), m_pendingCount, [this]( const Voice& v ) { start( v ); } );
+        m_pendingCount = 0;
+        m_statistics.dropped += std::exchange( m_pendingDropped, 0u );
+        m_statistics.voices = m_voiceCount;
+        m_published = m_statistics;
+    }
+    // blocks hold whole frames for placed voices
+    const size_t block = BLOCK - BLOCK % m_channels;
+    while ( !out.empty() ) {
+        out = out.subspan( mixBlock( out.first( std::min( out.size(), block ) ), channelGain ) );
+    }
+}
+
+Mixer::Statistics Mixer::statistics() const
+{
+    std::scoped_lock sl{ m_bottleneck };
+    return m_published;
+}
+
+void Mixer::setChannels( uint32_t channels )
+{
+    assert( channels > 0 );
+    assert( channels <= MAX_OUTPUT_CHANNELS );
+    m_channels = channels;
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <audio/spatial.hpp>
+
+#include <array>
 #include <cstdint>
 #include <span>
 #include <memory_resource>
@@ -15,8 +18,13 @@ protected:
     static Audio* create();
 
 public:
-    using Slot = uint16_t;
+    // generation checked, slots of unloaded sounds are not reused under same handle
+    using Slot = uint32_t;
     static constexpr uint16_t c_invalidSlot = 0xFFFFu;
+    // low 16 bits are stream index + 1, high 16 bits are generation, stale handles stop nothing
+    using Stream = uint32_t;
+    using Listener = Spatial::Listener;
+    using Emitter = Spatial::Emitter;
 
     enum class Channel : uint8_t {
         eMaster,
@@ -25,15 +33,49 @@ public:
         eUI,
         count,
     };
+
+    // when out of voices, lower priority voices are replaced first
+    enum class Priority : uint8_t {
+        eLow,
+        eNormal,
+        eHigh,
+    };
+
+    struct Statistics {
+        // decoded sounds resident per channel given at load()
+        std::array<uint64_t, (size_t)Channel::count> bytes{};
+        std::array<uint32_t, (size_t)Channel::count> sounds{};
+        uint32_t voices = 0;
+        uint32_t stolen = 0;
+        uint32_t dropped = 0;
+        // positional sounds too far away to take a voice
+        uint32_t culled = 0;
+    };
+
     virtual ~Audio() = default;
     Audio() = default;
 
     [[nodiscard]]
-    virtual Slot load( std::span<const uint8_t> ) = 0;
-    virtual void play( Slot, Channel ) = 0;
+    virtual Slot load( std::span<const uint8_t>, Channel = Channel::eSFX ) = 0;
+    // sound is released once every voice playing it finishes
+    virtual void unload( Slot ) = 0;
+    virtual void play( Slot, Channel, Priority = Priority::eNormal ) = 0;
+    // gain, pan and pitch are taken relative to listener when sound starts
+    virtual void play( Slot, Channel, const Emitter&, Priority = Priority::eNormal ) = 0;
+    virtual void setListener( const Listener& ) = 0;
+
+    // Plays wav decoded incrementally on background thread,
+    // data has to stay valid until playback finishes or stop( data ) returns.
+    // Returns 0 when wav is not supported or too many streams are playing.
+    [[nodiscard]]
+    virtual Stream stream( std::span<const uint8_t>, Channel, bool loop ) = 0;
+    virtual void stop( Stream ) = 0;
+    // stops every stream playing data, once it returns data can be released
+    virtual void stop( std::span<const uint8_t> ) = 0;
     virtual void setVolume( Channel, float ) = 0;
     virtual std::pmr::vector<std::pmr::string> listDrivers() = 0;
     virtual bool selectDriver( std::string_view ) = 0;
     virtual std::pmr::vector<std::pmr::string> listDevices() = 0;
     virtual bool selectDevice( std::string_view ) = 0;
+    virtual Statistics statistics() const = 0;
 };
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+class AudioStream;
+
+// Sums interleaved signed 16 bit sample streams already converted to device format.
+// Voices live in fixed pool, playing never allocates; when pool is full lowest priority, then oldest voice is replaced.
+class Mixer {
+public:
+    static constexpr inline uint32_t MAX_VOICES = 32;
+    static constexpr inline uint32_t MAX_CHANNELS = 8;
+    static constexpr inline uint32_t MAX_OUTPUT_CHANNELS = 8;
+    // samples accumulated in float per pass
+    static constexpr inline uint32_t BLOCK = 1024;
+
+    struct Statistics {
+        uint32_t voices = 0;
+        uint32_t started = 0;
+        uint32_t stolen = 0;
+        uint32_t dropped = 0;
+        // samples streams could not deliver in time
+        uint64_t underrun = 0;
+        uint64_t clipped = 0;
+    };
+
+    // positional voices: gain of left and right output and playback rate
+    struct Placement {
+        float left = 1.0f;
+        float right = 1.0f;
+        float pitch = 1.0f;
+    };
+
+private:
+    struct Voice {
+        AudioStream* stream = nullptr;
+        const int16_t* samples = nullptr;
+        std::atomic<uint32_t>* users = nullptr;
+        uint32_t length = 0;
+        uint32_t position = 0;
+        uint64_t sequence = 0;
+        // placed voices only, 32.32 fixed point source frame and step per output frame
+        uint64_t cursor = 0;
+        uint64_t step = 0;
+        float left = 1.0f;
+        float right = 1.0f;
+        uint8_t channel = 0;
+        uint8_t priority = 0;
+    };
+
+    std::array<Voice, MAX_VOICES> m_voices{};
+    // active voices are kept packed at front
+    uint32_t m_voiceCount = 0;
+    uint32_t m_channels = 2;
+    uint64_t m_sequence = 0;
+    Statistics m_statistics{};
+    alignas( 32 ) std::array<float, BLOCK> m_accumulator{};
+
+    // starts queued by play(), moved to pool at beginning of mix()
+    mutable std::mutex m_bottleneck{};
+    std::array<Voice, MAX_VOICES> m_pending{};
+    uint32_t m_pendingCount = 0;
+    uint32_t m_pendingDropped = 0;
+    // copy of m_statistics as of last mix()
+    Statistics m_published{};
+
+    void start( const Voice& );
+    static void release( const Voice& );
+    uint32_t mixBlock( std::span<int16_t>, std::span<const float> channelGain );
+    bool mixPlaced( Voice&, uint32_t frames, float gain );
+
+public:
+    // thread-safe, samples have to stay valid until voice finishes;
+    // users is decremented once voice finishes, is replaced or dropped
+    void play( std::span<const int16_t> samples, uint8_t channel, uint8_t priority, std::atomic<uint32_t>* users = nullptr );
+    void play( std::span<const int16_t> samples, uint8_t channel, uint8_t priority, std::atomic<uint32_t>* users, const Placement& );
+
+    // thread-safe, stream is released once finished, stolen or dropped
+    void play( AudioStream*, uint8_t channel, uint8_t priority );
+
+    // audio thread; channelGain is indexed by channel passed to play()
+    void mix( std::span<int16_t> out, std::span<const float> channelGain );
+
+    Statistics statistics() const;
+
+    // interleaved channels of output and samples, only while audio thread is not mixing
+    void setChannels( uint32_t );
+};
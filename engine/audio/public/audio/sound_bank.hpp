@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <vector>
+
+// Growable storage of decoded sounds with stable, generation checked handles.
+// Sounds are reference counted, unloaded ones are reclaimed by collect() once no voice plays them,
+// so memory is never released on audio thread.
+class SoundBank {
+public:
+    // low 16 bits are slot index + 1, high 16 bits are generation of slot
+    using Handle = uint32_t;
+    static constexpr inline uint32_t MAX_CHANNELS = 8;
+    static constexpr inline uint32_t CHUNK = 64;
+
+    struct Statistics {
+        std::array<uint64_t, MAX_CHANNELS> bytes{};
+        std::array<uint32_t, MAX_CHANNELS> sounds{};
+        // unloaded, waiting for voices to finish
+        uint32_t retired = 0;
+        uint32_t capacity = 0;
+    };
+
+    struct Sound {
+        std::span<const int16_t> samples{};
+        // voices playing sound, decremented by mixer when voice ends
+        std::atomic<uint32_t>* voices = nullptr;
+    };
+
+private:
+    struct Entry {
+        std::pmr::vector<uint8_t> data{};
+        std::atomic<uint32_t> voices = 0;
+        uint32_t refs = 0;
+        uint16_t generation = 0;
+        uint8_t channel = 0;
+        bool retired = false;
+    };
+    using Chunk = std::array<Entry, CHUNK>;
+
+    mutable std::mutex m_bottleneck{};
+    // chunks never move, entry addresses stay valid while bank grows
+    std::pmr::vector<std::unique_ptr<Chunk>> m_chunks{};
+    std::pmr::vector<uint32_t> m_free{};
+    std::pmr::vector<uint32_t> m_retired{};
+    Statistics m_statistics{};
+
+    Entry* find( Handle );
+    void collectLocked();
+
+public:
+    // data holds signed 16 bit samples in device format
+    [[nodiscard]]
+    Handle add( std::pmr::vector<uint8_t>&& data, uint8_t channel );
+    void retain( Handle );
+    // drops reference, last one retires sound
+    void release( Handle );
+
+    // counts voice as playing sound until mixer decrements Sound::voices; empty when handle is stale
+    Sound acquire( Handle );
+
+    // reclaims retired sounds which are no longer played, returns number of reclaimed slots;
+    // also done by add(), release() and acquire()
+    uint32_t collect();
+
+    Statistics statistics() const;
+};
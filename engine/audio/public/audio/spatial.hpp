@@ -0,0 +1,50 @@
+#pragma once
+
+#include <math.hpp>
+
+#include <cstdint>
+
+// Gain, stereo pan and Doppler pitch of a positional voice, evaluated once when voice starts.
+struct Spatial {
+    // sources quieter than this are not worth a mixer voice, roughly -60 dB
+    static constexpr inline float CULL_GAIN = 1.0f / 1024.0f;
+    static constexpr inline float MIN_PITCH = 0.5f;
+    static constexpr inline float MAX_PITCH = 2.0f;
+
+    enum class Curve : uint8_t {
+        // minDistance / ( minDistance + rolloff * ( distance - minDistance ) )
+        eInverse,
+        // 1 - rolloff * ( distance - minDistance ) / ( maxDistance - minDistance )
+        eLinear,
+        // ( distance / minDistance ) ^ -rolloff
+        eExponential,
+    };
+
+    struct Listener {
+        math::vec3 position{};
+        math::vec3 velocity{};
+        math::vec3 forward{ 0.0f, 0.0f, -1.0f };
+        math::vec3 up{ 0.0f, 1.0f, 0.0f };
+        // world units per second, 0 disables Doppler
+        float speedOfSound = 343.0f;
+    };
+
+    struct Emitter {
+        math::vec3 position{};
+        math::vec3 velocity{};
+        // full volume below minDistance, silent past maxDistance
+        float minDistance = 1.0f;
+        float maxDistance = 1000.0f;
+        float rolloff = 1.0f;
+        Curve curve = Curve::eInverse;
+    };
+
+    float left = 0.0f;
+    float right = 0.0f;
+    float pitch = 1.0f;
+
+    static float attenuation( const Emitter&, float distance );
+    static Spatial compute( const Listener&, const Emitter& );
+
+    bool audible() const;
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+
+// Decodes RIFF WAVE from memory incrementally into ring buffer of device format samples.
+// Single producer ( decode() ), single consumer ( read() ), only the producer side locks.
+class AudioStream {
+public:
+    // interleaved signed 16 bit samples
+    static constexpr inline uint32_t CAPACITY = 1u << 16;
+    // output frames produced per decode() call
+    static constexpr inline uint32_t CHUNK = 4096;
+
+    struct Format {
+        uint32_t rate = 0;
+        uint32_t channels = 0;
+    };
+
+private:
+    enum class Encoding : uint8_t {
+        ePCM8,
+        ePCM16,
+        eFloat32,
+    };
+
+    std::array<int16_t, CAPACITY> m_ring{};
+    std::atomic<uint32_t> m_head = 0;
+    std::atomic<uint32_t> m_tail = 0;
+    std::atomic<bool> m_decoded = false;
+    std::atomic<bool> m_stop = false;
+    std::atomic<bool> m_free = true;
+    // bumped by every open(), tells handles of earlier playbacks apart
+    std::atomic<uint16_t> m_generation = 0;
+
+    std::mutex m_bottleneck{};
+    // whole wav given to open(), m_data is its data chunk
+    std::span<const uint8_t> m_source{};
+    std::span<const uint8_t> m_data{};
+    uint32_t m_frames = 0;
+    uint32_t m_channels = 0;
+    Encoding m_encoding{};
+    Format m_device{};
+    bool m_loop = false;
+    // 32.32 fixed point source frame position and step per device frame
+    uint64_t m_position = 0;
+    uint64_t m_step = 0;
+
+    float sample( uint32_t frame, uint32_t channel ) const;
+
+public:
+    // data has to stay valid until playback finishes or stop( data ) returns, stream has to be claimed first
+    bool open( std::span<const uint8_t> wav, Format device, bool loop );
+
+    // producer: resamples next chunk into ring buffer, returns number of samples written
+    uint32_t decode();
+
+    // consumer: returns number of samples read
+    uint32_t read( std::span<int16_t> );
+
+    // nothing more to read or stop() was requested
+    bool finished() const;
+
+    void stop();
+    // stops playback of wav given to open(), once it returns wav is no longer read
+    void stop( std::span<const uint8_t> wav );
+    uint16_t generation() const;
+    bool claim();
+    // consumer is done with stream, it can be claimed again
+    void release();
+};
+
+// Pool of streams refilled by background thread.
+class StreamDecoder {
+public:
+    static constexpr inline uint32_t MAX_STREAMS = 4;
+
+private:
+    std::array<AudioStream, MAX_STREAMS> m_streams{};
+    std::mutex m_bottleneck{};
+    std::condition_variable m_wake{};
+    bool m_quit = false;
+    std::thread m_thread{};
+
+    void decodeThread();
+
+public:
+    ~StreamDecoder() noexcept;
+    StreamDecoder() noexcept;
+
+    // returns nullptr when wav is not supported or all streams are busy
+    AudioStream* open( std::span<const uint8_t> wav, AudioStream::Format device, bool loop );
+    // stops every stream playing wav, once it returns wav is no longer read
+    void stop( std::span<const uint8_t> wav );
+    AudioStream* operator [] ( uint32_t );
+    uint32_t indexOf( const AudioStream* ) const;
+};
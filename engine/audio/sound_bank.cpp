@@ -0,0 +1,127 @@
+#include <audio/sound_bank.hpp>
+
+#include <profiler.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+static constexpr uint32_t indexOf( SoundBank::Handle h )
+{
+    return ( h & 0xFFFFu ) - 1u;
+}
+
+static constexpr uint16_t generationOf( SoundBank::Handle h )
+{
+    return static_cast<uint16_t>( h >> 16 );
+}
+
+SoundBank::Entry* SoundBank::find( Handle h )
+{
+    if ( !( h & 0xFFFFu ) ) return nullptr;
+    const uint32_t index = indexOf( h );
+    if ( index >= m_chunks.size() * CHUNK ) return nullptr;
+    Entry& entry = ( *m_chunks[ index / CHUNK ] )[ index % CHUNK ];
+    if ( entry.generation != generationOf( h ) || entry.retired || !entry.refs ) return nullptr;
+    return &entry;
+}
+
+SoundBank::Handle SoundBank::add( std::pmr::vector<uint8_t>&& data, uint8_t channel )
+{
+    ZoneScoped;
+    assert( channel < MAX_CHANNELS );
+    std::scoped_lock sl{ m_bottleneck };
+    collectLocked();
+    if ( m_free.empty() ) {
+        // index + 1 has to fit in 16 bits
+        if ( m_chunks.size() * CHUNK + CHUNK > 0xFFFFu ) [[unlikely]] {
+            assert( !"sound bank is full" );
+            return 0;
+        }
+        const uint32_t base = static_cast<uint32_t>( m_chunks.size() * CHUNK );
+        m_chunks.emplace_back( std::make_unique<Chunk>() );
+        for ( uint32_t i = CHUNK; i > 0; --i ) {
+            m_free.emplace_back( base + i - 1 );
+        }
+        m_statistics.capacity += CHUNK;
+    }
+    const uint32_t index = m_free.back();
+    m_free.pop_back();
+
+    Entry& entry = ( *m_chunks[ index / CHUNK ] )[ index % CHUNK ];
+    assert( !entry.refs );
+    assert( !entry.voices.load() );
+    entry.data = std::move( data );
+    entry.refs = 1;
+    entry.channel = channel;
+    entry.retired = false;
+    m_statistics.bytes[ channel ] += entry.data.size();
+    m_statistics.sounds[ channel ]++;
+    return ( static_cast<Handle>( entry.generation ) << 16 ) | ( index + 1u );
+}
+
+void SoundBank::retain( Handle h )
+{
+    std::scoped_lock sl{ m_bottleneck };
+    Entry* entry = find( h );
+    assert( entry );
+    if ( entry ) entry->refs++;
+}
+
+void SoundBank::release( Handle h )
+{
+    std::scoped_lock sl{ m_bottleneck };
+    Entry* entry = find( h );
+    assert( entry );
+    if ( !entry || --entry->refs ) return;
+
+    entry->retired = true;
+    m_retired.emplace_back( indexOf( h ) );
+    m_statistics.retired++;
+    m_statistics.sounds[ entry->channel ]--;
+    collectLocked();
+}
+
+SoundBank::Sound SoundBank::acquire( Handle h )
+{
+    std::scoped_lock sl{ m_bottleneck };
+    collectLocked();
+    Entry* entry = find( h );
+    if ( !entry ) return {};
+    entry->voices.fetch_add( 1, std::memory_order_relaxed );
+    return Sound{
+        .samples{ reinterpret_cast<const int16_t*>( entry->data.data() ), entry->data.size() / sizeof( int16_t ) },
+        .voices = &entry->voices,
+    };
+}
+
+void SoundBank::collectLocked()
+{
+    auto reclaim = [this]( uint32_t index )
+    {
+        Entry& entry = ( *m_chunks[ index / CHUNK ] )[ index % CHUNK ];
+        if ( entry.voices.load( std::memory_order_acquire ) ) return false;
+        m_statistics.bytes[ entry.channel ] -= entry.data.size();
+        m_statistics.retired--;
+        entry.data = {};
+        entry.retired = false;
+        // stale handles stop matching
+        entry.generation++;
+        m_free.emplace_back( index );
+        return true;
+    };
+    std::erase_if( m_retired, reclaim );
+}
+
+uint32_t SoundBank::collect()
+{
+    std::scoped_lock sl{ m_bottleneck };
+    const auto retired = m_retired.size();
+    collectLocked();
+    return static_cast<uint32_t>( retired - m_retired.size() );
+}
+
+SoundBank::Statistics SoundBank::statistics() const
+{
+    std::scoped_lock sl{ m_bottleneck };
+    return m_statistics;
+}
@@ -0,0 +1,61 @@
+#include <audio/spatial.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+float Spatial::attenuation( const Emitter& e, float distance )
+{
+    assert( e.minDistance > 0.0f );
+    assert( e.maxDistance > e.minDistance );
+    if ( distance >= e.maxDistance ) return 0.0f;
+    if ( distance <= e.minDistance ) return 1.0f;
+
+    switch ( e.curve ) {
+    case Curve::eInverse:
+        return e.minDistance / ( e.minDistance + e.rolloff * ( distance - e.minDistance ) );
+    case Curve::eLinear:
+        return std::max( 0.0f, 1.0f - e.rolloff * ( distance - e.minDistance ) / ( e.maxDistance - e.minDistance ) );
+    case Curve::eExponential:
+        return std::pow( distance / e.minDistance, -e.rolloff );
+    }
+    return 0.0f;
+}
+
+Spatial Spatial::compute( const Listener& l, const Emitter& e )
+{
+    const math::vec3 offset = e.position - l.position;
+    const float distance = math::length( offset );
+    const float gain = attenuation( e, distance );
+    if ( gain <= 0.0f ) return {};
+
+    // source at listener is centered, direction is undefined
+    if ( distance <= 0.0f ) return { gain, gain, 1.0f };
+    const math::vec3 direction = offset / distance;
+
+    // sources closer than minDistance drift to center instead of snapping between sides
+    const math::vec3 right = math::normalize( math::cross( l.forward, l.up ) );
+    const float pan = std::clamp( math::dot( direction, right ), -1.0f, 1.0f ) * std::min( distance / e.minDistance, 1.0f );
+    // constant power, scaled so centered source plays at unchanged gain on both sides
+    const float angle = ( pan + 1.0f ) * std::numbers::pi_v<float> * 0.25f;
+    Spatial ret{
+        .left = gain * std::min( std::numbers::sqrt2_v<float> * std::cos( angle ), 1.0f ),
+        .right = gain * std::min( std::numbers::sqrt2_v<float> * std::sin( angle ), 1.0f ),
+        .pitch = 1.0f,
+    };
+
+    if ( l.speedOfSound > 0.0f ) {
+        // positive when listener approaches source and when source moves away from listener
+        const float limit = l.speedOfSound * 0.5f;
+        const float listenerSpeed = std::clamp( math::dot( l.velocity, direction ), -limit, limit );
+        const float sourceSpeed = std::clamp( math::dot( e.velocity, direction ), -limit, limit );
+        ret.pitch = std::clamp( ( l.speedOfSound + listenerSpeed ) / ( l.speedOfSound + sourceSpeed ), MIN_PITCH, MAX_PITCH );
+    }
+    return ret;
+}
+
+bool Spatial::audible() const
+{
+    return std::max( left, right ) >= CULL_GAIN;
+}
@@ -0,0 +1,288 @@
+#include <audio/stream.hpp>
+
+#include <profiler.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+template <typename T>
+bool readAt( std::span<const uint8_t> data, size_t offset, T& t )
+{
+    if ( data.size() < offset + sizeof( T ) ) return false;
+    std::memcpy( &t, data.data() + offset, sizeof( T ) );
+    return true;
+}
+
+struct FormatChunk {
+    uint16_t format;
+    uint16_t channels;
+    uint32_t rate;
+    uint32_t byteRate;
+    uint16_t blockAlign;
+    uint16_t bits;
+};
+static_assert( sizeof( FormatChunk ) == 16 );
+
+static constexpr uint32_t RIFF = 'FFIR';
+static constexpr uint32_t WAVE = 'EVAW';
+static constexpr uint32_t FMT = ' tmf';
+static constexpr uint32_t DATA = 'atad';
+static constexpr uint16_t FORMAT_PCM = 1;
+static constexpr uint16_t FORMAT_FLOAT = 3;
+static constexpr uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+}
+
+bool AudioStream::open( std::span<const uint8_t> wav, Format device, bool loop )
+{
+    ZoneScoped;
+    assert( device.rate );
+    assert( device.channels );
+    uint32_t riff = 0;
+    uint32_t wave = 0;
+    if ( !readAt( wav, 0, riff ) || !readAt( wav, 8, wave ) || riff != RIFF || wave != WAVE ) return false;
+
+    FormatChunk fmt{};
+    std::span<const uint8_t> data{};
+    for ( size_t offset = 12; offset + 8 <= wav.size(); ) {
+        uint32_t id = 0;
+        uint32_t size = 0;
+        readAt( wav, offset, id );
+        readAt( wav, offset + 4, size );
+        offset += 8;
+        const size_t available = std::min<size_t>( size, wav.size() - offset );
+        switch ( id ) {
+        case FMT:
+            if ( !readAt( wav, offset, fmt ) ) return false;
+            if ( fmt.format == FORMAT_EXTENSIBLE ) {
+                // subformat guid starts with format tag
+                if ( !readAt( wav, offset + 24, fmt.format ) ) return false;
+            }
+            break;
+        case DATA:
+            data = wav.subspan( offset, available );
+            break;
+        default:
+            break;
+        }
+        // chunks are word aligned
+        offset += size + ( size & 1 );
+    }
+
+    Encoding encoding{};
+    switch ( fmt.format ) {
+    case FORMAT_PCM:
+        if ( fmt.bits == 8 ) encoding = Encoding::ePCM8;
+        else if ( fmt.bits == 16 ) encoding = Encoding::ePCM16;
+        else return false;
+        break;
+    case FORMAT_FLOAT:
+        if ( fmt.bits != 32 ) return false;
+        encoding = Encoding::eFloat32;
+        break;
+    default:
+        return false;
+    }
+    if ( !fmt.channels || !fmt.rate || data.empty() ) return false;
+    if ( fmt.blockAlign != fmt.channels * fmt.bits / 8 ) return false;
+
+    std::scoped_lock sl{ m_bottleneck };
+    assert( !m_free.load() );
+    m_source = wav;
+    m_data = data;
+    m_frames = static_cast<uint32_t>( data.size() / fmt.blockAlign );
+    m_channels = fmt.channels;
+    m_encoding = encoding;
+    m_device = device;
+    m_loop = loop;
+    m_position = 0;
+    m_step = ( static_cast<uint64_t>( fmt.rate ) << 32 ) / device.rate;
+    m_head.store( 0 );
+    m_tail.store( 0 );
+    m_stop.store( false );
+    m_decoded.store( m_frames == 0 );
+    m_generation.fetch_add( 1, std::memory_order_relaxed );
+    return true;
+}
+
+float AudioStream::sample( uint32_t frame, uint32_t channel ) const
+{
+    assert( frame < m_frames );
+    const size_t index = static_cast<size_t>( frame ) * m_channels + channel;
+    switch ( m_encoding ) {
+    case Encoding::ePCM8:
+        return ( static_cast<float>( m_data[ index ] ) - 128.0f ) * 256.0f;
+    case Encoding::ePCM16: {
+        int16_t s = 0;
+        std::memcpy( &s, m_data.data() + index * sizeof( s ), sizeof( s ) );
+        return static_cast<float>( s );
+    }
+    case Encoding::eFloat32: {
+        float f = 0.0f;
+        std::memcpy( &f, m_data.data() + index * sizeof( f ), sizeof( f ) );
+        return f * 32767.0f;
+    }
+    }
+    return 0.0f;
+}
+
+uint32_t AudioStream::decode()
+{
+    std::scoped_lock sl{ m_bottleneck };
+    if ( m_free.load() || m_stop.load() || m_decoded.load() ) return 0;
+
+    ZoneScoped;
+    const uint32_t channels = m_device.channels;
+    uint32_t head = m_head.load( std::memory_order_relaxed );
+    const uint32_t space = CAPACITY - ( head - m_tail.load( std::memory_order_acquire ) );
+    const uint32_t frames = std::min( space / channels, CHUNK );
+
+    const uint32_t begin = head;
+    for ( uint32_t i = 0; i < frames; ++i ) {
+        uint32_t frame = static_cast<uint32_t>( m_position >> 32 );
+        if ( frame >= m_frames ) {
+            if ( !m_loop ) break;
+            m_position -= static_cast<uint64_t>( m_frames ) << 32;
+            frame -= m_frames;
+        }
+        const uint32_t next = frame + 1 < m_frames ? frame + 1 : ( m_loop ? 0 : frame );
+        const float t = static_cast<float>( m_position & 0xFFFF'FFFFull ) * ( 1.0f / 4294967296.0f );
+        for ( uint32_t c = 0; c < channels; ++c ) {
+            // mono is duplicated, extra source channels are dropped
+            const uint32_t sc = std::min( c, m_channels - 1 );
+            const float a = sample( frame, sc );
+            const float b = sample( next, sc );
+            const float s = std::clamp( a + ( b - a ) * t, -32768.0f, 32767.0f );
+            m_ring[ head++ & ( CAPACITY - 1 ) ] = static_cast<int16_t>( std::lrint( s ) );
+        }
+        m_position += m_step;
+    }
+    m_head.store( head, std::memory_order_release );
+    // published after samples so consumer never sees end before last chunk
+    if ( static_cast<uint32_t>( m_position >> 32 ) >= m_frames && !m_loop ) {
+        m_decoded.store( true, std::memory_order_release );
+    }
+    return head - begin;
+}
+
+uint32_t AudioStream::read( std::span<int16_t> out )
+{
+    const uint32_t tail = m_tail.load( std::memory_order_relaxed );
+    const uint32_t head = m_head.load( std::memory_order_acquire );
+    const uint32_t count = std::min( static_cast<uint32_t>( out.size() ), head - tail );
+    const uint32_t begin = tail & ( CAPACITY - 1 );
+    const uint32_t first = std::min( count, CAPACITY - begin );
+    std::copy_n( m_ring.begin() + begin, first, out.begin() );
+    std::copy_n( m_ring.begin(), count - first, out.begin() + first );
+    m_tail.store( tail + count, std::memory_order_release );
+    return count;
+}
+
+bool AudioStream::finished() const
+{
+    if ( m_stop.load() ) return true;
+    return m_decoded.load( std::memory_order_acquire )
+        && m_head.load( std::memory_order_acquire ) == m_tail.load( std::memory_order_relaxed );
+}
+
+void AudioStream::stop()
+{
+    m_stop.store( true );
+}
+
+void AudioStream::stop( std::span<const uint8_t> wav )
+{
+    // decode() reads data under the lock, it is done with it once the lock is taken
+    std::scoped_lock sl{ m_bottleneck };
+    if ( m_source.data() != wav.data() ) return;
+    m_stop.store( true );
+}
+
+uint16_t AudioStream::generation() const
+{
+    return m_generation.load( std::memory_order_relaxed );
+}
+
+void AudioStream::release()
+{
+    m_free.store( true, std::memory_order_release );
+}
+
+bool AudioStream::claim()
+{
+    bool expected = true;
+    return m_free.compare_exchange_strong( expected, false, std::memory_order_acquire );
+}
+
+StreamDecoder::~StreamDecoder() noexcept
+{
+    {
+        std::scoped_lock sl{ m_bottleneck };
+        m_quit = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+StreamDecoder::StreamDecoder() noexcept
+{
+    m_thread = std::thread{ &StreamDecoder::decodeThread, this };
+}
+
+void StreamDecoder::decodeThread()
+{
+    std::unique_lock lock{ m_bottleneck };
+    while ( !m_quit ) {
+        lock.unlock();
+        uint32_t decoded = 0;
+        for ( auto& stream : m_streams ) {
+            decoded += stream.decode();
+        }
+        lock.lock();
+        // keep going while there is work, otherwise wake up well before ring buffers drain
+        if ( decoded ) continue;
+        m_wake.wait_for( lock, std::chrono::milliseconds( 5 ) );
+    }
+}
+
+AudioStream* StreamDecoder::open( std::span<const uint8_t> wav, AudioStream::Format device, bool loop )
+{
+    ZoneScoped;
+    for ( auto& stream : m_streams ) {
+        if ( !stream.claim() ) continue;
+        if ( !stream.open( wav, device, loop ) ) {
+            stream.release();
+            return nullptr;
+        }
+        // first chunk is ready before stream reaches the mixer
+        stream.decode();
+        m_wake.notify_one();
+        return &stream;
+    }
+    return nullptr;
+}
+
+void StreamDecoder::stop( std::span<const uint8_t> wav )
+{
+    ZoneScoped;
+    for ( auto& stream : m_streams ) {
+        stream.stop( wav );
+    }
+}
+
+AudioStream* StreamDecoder::operator [] ( uint32_t i )
+{
+    assert( i < m_streams.size() );
+    return &m_streams[ i ];
+}
+
+uint32_t StreamDecoder::indexOf( const AudioStream* stream ) const
+{
+    assert( stream >= m_streams.data() && stream < m_streams.data() + m_streams.size() );
+    return static_cast<uint32_t>( stream - m_streams.data() );
+}
@@ -4,6 +4,8 @@
 
 #include <extra/dds.hpp>
 #include <extra/args.hpp>
+#include <extra/bcn.hpp>
+#include <extra/mipgen.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -15,131 +17,46 @@
 #include <memory_resource>
 #include <span>
 #include <string>
-#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 using Format = dds::dxgi::Format;
 
-namespace detail {
-
-struct B8G8R8A8 {
-    uint32_t b : 8;
-    uint32_t g : 8;
-    uint32_t r : 8;
-    uint32_t a : 8;
-};
-
-struct B5G6R5 {
-    uint16_t b : 5;
-    uint16_t g : 6;
-    uint16_t r : 5;
-};
-
-template <size_t TWeight>
-static inline B5G6R5 lerp( B5G6R5 a, B5G6R5 b )
+static void compressToBC1( Image& img, bcn::Quality quality )
 {
-    return {
-        .b = dds::lerp<TWeight>( a.b, b.b ),
-        .g = dds::lerp<TWeight>( a.g, b.g ),
-        .r = dds::lerp<TWeight>( a.r, b.r ),
-    };
-}
+    if ( img.format != Format::B8G8R8A8_UNORM ) cooker::error( "Expected format B8G8R8A8" );
+    if ( img.pixels.empty() ) cooker::error( "no pixels to convert" );
 
-static inline uint16_t dot( B5G6R5 a, B5G6R5 b )
-{
-    uint16_t ret = 0;
-    ret += a.b * b.b;
-    ret += a.g * b.g;
-    ret += a.r * b.r;
-    return ret;
+    const std::pmr::vector<bcn::BC1> blocks = bcn::compressBC1( img.pixels, img.width, img.height, quality );
+    std::pmr::vector<uint8_t> imageOut( sizeof( bcn::BC1 ) * blocks.size() );
+    std::memcpy( imageOut.data(), blocks.data(), imageOut.size() );
+    std::swap( img.pixels, imageOut );
+    img.format = Format::BC1_UNORM;
 }
 
-static inline uint16_t dot( B5G6R5 a )
+static void compressToBC5( Image& img )
 {
-    return dot( a, a );
-}
+    if ( img.format != Format::B8G8R8A8_UNORM ) cooker::error( "Expected format B8G8R8A8" );
+    if ( img.pixels.empty() ) cooker::error( "no pixels to convert" );
 
+    const std::pmr::vector<bcn::BC5> blocks = bcn::compressBC5( img.pixels, img.width, img.height );
+    std::pmr::vector<uint8_t> imageOut( sizeof( bcn::BC5 ) * blocks.size() );
+    std::memcpy( imageOut.data(), blocks.data(), imageOut.size() );
+    std::swap( img.pixels, imageOut );
+    img.format = Format::BC5_UNORM;
 }
 
-struct BC1 {
-    union { detail::B5G6R5 c1; uint16_t r1; };
-    union { detail::B5G6R5 c2; uint16_t r2; };
-    uint32_t indexes;
-};
-
-inline BC1 compressor_bc1( std::span<const detail::B5G6R5, 16> block )
-{
-    std::array<uint16_t, 16> dots;
-    std::ranges::transform( block, dots.begin(), []( auto a ) { return detail::dot( a ); } );
-    auto [ min, max ] = std::ranges::minmax_element( dots );
-
-    BC1 ret{
-        .c1 = block[ (size_t)std::distance( dots.begin(), max ) ],
-        .c2 = block[ (size_t)std::distance( dots.begin(), min ) ],
-    };
-
-    if ( ret.r1 < ret.r2 ) std::swap( ret.r1, ret.r2 );
-
-    const std::array<uint16_t, 4> lut{
-        detail::dot( ret.c1 ),
-        detail::dot( ret.c2 ),
-        detail::dot( detail::lerp<42>( ret.c2, ret.c1 ) ),
-        detail::dot( detail::lerp<21>( ret.c2, ret.c1 ) ),
-    };
-    auto nearestIndice = [&lut]( uint16_t ref ) -> uint8_t
-    {
-        int dist = 0xFFFF;
-        uint8_t indice = 0;
-        for ( uint8_t i = 0; i < lut.size(); ++i ) {
-            int d = std::abs( (int)ref - (int)lut[ i ] );
-            if ( d == 0 ) return i;
-            if ( d >= dist ) continue;
-            dist = d;
-            indice = i;
-        }
-        return indice;
-    };
-
-    for ( auto it = dots.rbegin(); it != dots.rend(); ++it ) {
-        ret.indexes <<= 2;
-        ret.indexes |= nearestIndice(* it );
-    }
-
-    return ret;
-};
-
-
-void compressToBC1( Image& img )
+static void compressToBC7( Image& img, bcn::Quality quality )
 {
-    using namespace detail;
     if ( img.format != Format::B8G8R8A8_UNORM ) cooker::error( "Expected format B8G8R8A8" );
     if ( img.pixels.empty() ) cooker::error( "no pixels to convert" );
 
-    auto src = cooker::cast<B8G8R8A8>( img.pixels );
-    std::pmr::vector<B5G6R5> tmp( src.size() );
-    auto convert = []( auto c ) -> B5G6R5
-    {
-        return {
-            .b = (uint16_t)( c.b >> 3 ),
-            .g = (uint16_t)( c.g >> 2 ),
-            .r = (uint16_t)( c.r >> 3 ),
-        };
-    };
-    std::ranges::transform( src, tmp.begin(), convert );
-    const uint32_t blockCount = (uint32_t)tmp.size() / 16;
-
-    using Swizzler = dds::Swizzler<B5G6R5>;
-    std::pmr::vector<Swizzler::BlockType> swizzled( blockCount );
-    std::ranges::generate( swizzled, Swizzler{ tmp, img.width } );
-
-    std::pmr::vector<uint8_t> imageOut( sizeof( BC1 ) * blockCount );
-    auto bc1 = cooker::cast<BC1>( imageOut );
-    std::ranges::transform( swizzled, bc1.begin(), &compressor_bc1 );
-
+    const std::pmr::vector<bcn::BC7> blocks = bcn::compressBC7( img.pixels, img.width, img.height, quality );
+    std::pmr::vector<uint8_t> imageOut( sizeof( bcn::BC7 ) * blocks.size() );
+    std::memcpy( imageOut.data(), blocks.data(), imageOut.size() );
     std::swap( img.pixels, imageOut );
-    img.format = Format::BC1_UNORM;
+    img.format = Format::BC7_UNORM;
 }
 
 void compressToBC4( Image& img )
@@ -158,116 +75,25 @@ void compressToBC4( Image& img )
     img.format = Format::BC4_UNORM;
 }
 
-namespace mipgen {
-
-template <typename T>
-requires ( std::is_same_v<T, uint32_t> || std::is_same_v<T, uint8_t> )
-struct Generator {
-    std::span<const T> pixels{};
-    uint32_t srcWidth = 0;
-    uint32_t idx = 0;
-
-    Generator( std::span<const T> p, uint32_t w )
-    : pixels{ p }
-    , srcWidth{ w }
-    {
-        assert( !pixels.empty() );
-        assert( srcWidth > 0 );
-    }
-
-    static std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> indexes( uint32_t n, uint32_t srcWidth )
-    {
-        n <<= 1u;
-        n += ( n / srcWidth ) * srcWidth;
-        return { n, n + 1u, n + srcWidth, n + srcWidth + 1u };
-    }
-
-    static uint32_t average( uint32_t a, uint32_t b, uint32_t c, uint32_t d )
-    {
-        auto sampler = []( uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t mask, uint32_t shift )
-        {
-            uint32_t ret = ( ( a & mask ) >> shift )
-                + ( ( b & mask ) >> shift )
-                + ( ( c & mask ) >> shift )
-                + ( ( d & mask ) >> shift )
-                ;
-            return ( ret >> 2u ) << shift;
-        };
-        return sampler( a, b, c, d, 0xFFu, 0u )
-            |  sampler( a, b, c, d, 0xFF00u, 8u )
-            |  sampler( a, b, c, d, 0xFF0000u, 16u )
-            |  sampler( a, b, c, d, 0xFF000000u, 24u )
-            ;
-    };
-
-    static uint8_t average( uint8_t a, uint8_t b, uint8_t c, uint8_t d )
-    {
-        uint32_t r = a;
-        r += b;
-        r += c;
-        r += d;
-        return static_cast<uint8_t>( r >> 2u );
-    }
-    T operator () ()
-    {
-        auto [ a, b, c, d ] = indexes( idx++, srcWidth );
-        assert( a < pixels.size() );
-        assert( b < pixels.size() );
-        assert( c < pixels.size() );
-        assert( d < pixels.size() );
-        return average( pixels[ a ], pixels[ b ], pixels[ c ], pixels[ d ] );
-    }
-
-};
-
-template <typename T>
-static Image downscale( const Image& img )
+static uint32_t mipCountFor( const Image& img )
 {
-    assert( img.width );
-    assert( img.height );
-    assert( !img.pixels.empty() );
-    const size_t mipPixelCount = ( img.width * img.height ) >> 2u;
-    std::pmr::vector<uint8_t> ret( sizeof( T ) * mipPixelCount );
-
-    std::span<const T> pixels{ reinterpret_cast<const T*>( img.pixels.data() ), img.pixels.size() / sizeof( T ) };
-    std::span<T> mip{ reinterpret_cast<T*>( ret.data() ), mipPixelCount };
-
-    std::generate( mip.begin(), mip.end(), Generator<T>{ pixels, img.width } );
-    return Image{
-        .format = img.format,
-        .width = img.width >> 1,
-        .height = img.height >> 1,
-        .pixels = std::move( ret ),
-    };
-}
-
-static uint32_t genMips( std::pmr::list<Image>& ret )
-{
-    assert( !ret.empty() );
-    assert( ret.back().width );
-    assert( ret.back().height );
-    assert( !ret.back().pixels.empty() );
-    uint32_t mipToGen = 0u;
-    uint32_t width = ret.back().width;
-    uint32_t height = ret.back().height;
-    uint32_t pixelSize = 0u;
-    switch ( ret.back().format ) {
-    case Format::R8_UNORM: pixelSize = 1u; break;
-    default: pixelSize = 4u; break;
-    }
+    // smallest mip stays compressible into 4x4 blocks
     auto test = []( uint32_t d ) { return ( d % 8u ) == 0u; };
-    while ( test( width >> mipToGen ) && test( height >> mipToGen ) ) {
-        mipToGen++;
-    }
-    for ( uint32_t i = 0u; i < mipToGen; ++i ) {
-        switch ( pixelSize ) {
-        case 1: ret.emplace_back( downscale<uint8_t>( ret.back() ) ); break;
-        case 4: ret.emplace_back( downscale<uint32_t>( ret.back() ) ); break;
-        }
+    uint32_t ret = 0u;
+    while ( test( img.width >> ret ) && test( img.height >> ret ) ) {
+        ret++;
     }
-    return mipToGen;
+    return ret;
 }
 
+static uint32_t channelCount( Format format )
+{
+    switch ( format ) {
+    case Format::R8_UNORM: return 1u;
+    case Format::B8G8R8A8_UNORM: return 4u;
+    default:
+        cooker::error( "mip generation requires R8 or B8G8R8A8 format" );
+    }
 }
 
 inline dds::Header::Flags operator | ( dds::Header::Flags a, dds::Header::Flags b )
@@ -300,7 +126,11 @@ int main( int argc, const char** argv )
             "\nOptional arguments:\n"
             "\t-h --help \u2012 prints this message and exits\n"
             "\t--mipgen \u2012 generate mipmaps\n"
-            "\t--format <value> \u2012 specifiy output image format, supported formats: BC4\n"
+            "\t--mipfilter <value> \u2012 mipmap filter: box (default), kaiser, lanczos\n"
+            "\t--srgb \u2012 filter color channels of mipmaps in linear space\n"
+            "\t--alpha-coverage <float> \u2012 alpha test reference, preserves alpha coverage in mipmaps\n"
+            "\t--format <value> \u2012 specifiy output image format, supported formats: BC1, BC4, BC5, BC7\n"
+            "\t--quality <value> \u2012 block compression quality of BC1 and BC7: fast (default), high\n"
             ;
         return !args;
     }
@@ -317,8 +147,38 @@ int main( int argc, const char** argv )
         if ( !args.read( "--format", argsFormat ) ) return Format::UNKNOWN;
         if ( argsFormat == "BC1" ) return Format::BC1_UNORM;
         if ( argsFormat == "BC4" ) return Format::BC4_UNORM;
+        if ( argsFormat == "BC5" ) return Format::BC5_UNORM;
+        if ( argsFormat == "BC7" ) return Format::BC7_UNORM;
         cooker::error( "--format has unsupported value \u2012", argsFormat );
     }();
+    const bcn::Quality argQuality = [&args]()
+    {
+        std::string_view quality{};
+        if ( !args.read( "--quality", quality ) ) return bcn::Quality::eFast;
+        if ( quality == "fast" ) return bcn::Quality::eFast;
+        if ( quality == "high" ) return bcn::Quality::eHigh;
+        cooker::error( "--quality has unsupported value \u2012", quality );
+    }();
+    const mipgen::Options mipOptions = [&args]()
+    {
+        mipgen::Options ret{
+            .srgb = args.read( "--srgb" ),
+        };
+        std::string_view filter{};
+        if ( args.read( "--mipfilter", filter ) ) {
+            if ( filter == "box" ) ret.filter = mipgen::Filter::eBox;
+            else if ( filter == "kaiser" ) ret.filter = mipgen::Filter::eKaiser;
+            else if ( filter == "lanczos" ) ret.filter = mipgen::Filter::eLanczos;
+            else cooker::error( "--mipfilter has unsupported value \u2012", filter );
+        }
+        if ( args.read( "--alpha-coverage" ) ) {
+            const bool valid = args.read( "--alpha-coverage", ret.alphaCoverage )
+                && ret.alphaCoverage > 0.0f
+                && ret.alphaCoverage < 1.0f;
+            valid || cooker::error( "--alpha-coverage requires value in range (0, 1)" );
+        }
+        return ret;
+    }();
 
     auto commaSeparate = []( std::string_view sv ) -> std::pmr::vector<std::filesystem::path>
     {
@@ -355,18 +215,37 @@ int main( int argc, const char** argv )
     }
     const uint32_t arrayCount = static_cast<uint32_t>( images.size() );
     if ( argCubemap && arrayCount % 6 ) cooker::error( "cubemap requires 6 images" );
+    const uint32_t mipCount = argMipgen ? mipCountFor( images.front() ) : 0u;
+    std::pmr::vector<mipgen::Level> levels{};
+    if ( mipCount ) {
+        std::pmr::vector<std::span<const uint8_t>> layers{};
+        layers.reserve( images.size() );
+        for ( auto&& image : images ) layers.emplace_back( image.pixels );
+        const Image& base = images.front();
+        levels = mipgen::generate( layers, base.width, base.height, channelCount( base.format ), mipCount, mipOptions );
+    }
+
+    // layer major, each base level followed by its mips
     std::pmr::list<Image> mips{};
-    uint32_t mipCount = 0;
+    auto level = levels.begin();
     for ( auto&& image : images ) {
+        const Format format = image.format;
         mips.emplace_back( std::move( image ) );
-        if ( argMipgen ) {
-            mipCount = mipgen::genMips( mips );
+        for ( uint32_t i = 0; i < mipCount; ++i, ++level ) {
+            mips.emplace_back( Image{
+                .format = format,
+                .width = level->width,
+                .height = level->height,
+                .pixels = std::move( level->pixels ),
+            } );
         }
     }
     images.clear();
     switch ( argsFormat ) {
-        case Format::BC1_UNORM: std::ranges::for_each( mips, &compressToBC1 ); break;
+        case Format::BC1_UNORM: for ( auto&& mip : mips ) compressToBC1( mip, argQuality ); break;
         case Format::BC4_UNORM: std::ranges::for_each( mips, &compressToBC4 ); break;
+        case Format::BC5_UNORM: std::ranges::for_each( mips, &compressToBC5 ); break;
+        case Format::BC7_UNORM: for ( auto&& mip : mips ) compressToBC7( mip, argQuality ); break;
     default: break;
     };
 
@@ -95,10 +95,6 @@ struct ParserCSV {
             m_keys.emplace_back( Hash{}( std::string_view{ keyBegin, keyEnd } ), offset, size );
         }
     }
-    void sort()
-    {
-        std::sort( m_keys.begin(), m_keys.end() );
-    }
 };
 
 int main( int argc, const char** argv )
@@ -134,16 +130,19 @@ int main( int argc, const char** argv )
 
     ParserCSV parser( data );
     parser.process();
-    parser.sort();
+    std::pmr::vector<uint32_t> seeds{};
+    lang::perfectHash( parser.m_keys, seeds ) || cooker::error( "duplicate or colliding keys in", argsSrc );
 
     lang::Header header{
         .count = static_cast<uint32_t>( parser.m_keys.size() ),
         .string = static_cast<uint32_t>( parser.m_string.size() ),
+        .buckets = static_cast<uint32_t>( seeds.size() ),
     };
     std::ranges::copy( argsId, std::begin( header.id ) );
 
     auto ofs = cooker::openWrite( argsDst );
     cooker::write( ofs, header );
+    cooker::write( ofs, seeds );
     cooker::write( ofs, parser.m_keys );
     cooker::write( ofs, parser.m_string );
     return 0;
@@ -1,6 +1,8 @@
 #include <cooker/common.hpp>
 
+#include <extra/lz.hpp>
 #include <extra/pak.hpp>
+#include <shared/hash.hpp>
 
 #include <algorithm>
 #include <filesystem>
@@ -47,6 +49,22 @@ bool strcpyIntoBuffer( const auto& src, auto& dst )
     return true;
 }
 
+// compressed entry has to save at least 1/8 of its size to be worth decompression time at mount
+static std::span<const char> tryCompress( const std::pmr::vector<char>& src, std::pmr::vector<char>& dst, pak::Entry& entry )
+{
+    entry.uncompressedSize = static_cast<uint32_t>( src.size() );
+    entry.compression = pak::Entry::Compression::eNone;
+    dst.resize( src.size() - src.size() / 8 );
+    const std::size_t size = lz::compress(
+        std::span{ reinterpret_cast<const uint8_t*>( src.data() ), src.size() }
+        , std::span{ reinterpret_cast<uint8_t*>( dst.data() ), dst.size() }
+    );
+    if ( size == 0 ) return src;
+
+    entry.compression = pak::Entry::Compression::eLZ;
+    return std::span{ dst.data(), size };
+}
+
 std::ofstream& align( std::ofstream& o, size_t a )
 {
     uint64_t pos = static_cast<uint64_t>( o.tellp() );
@@ -55,22 +73,306 @@ std::ofstream& align( std::ofstream& o, size_t a )
     return o;
 }
 
-int main( int argc, const char** argv )
+static constexpr uint32_t alignUp( uint32_t v, uint32_t a )
 {
-    ( argc == 3 ) || cooker::error( "expected 2 arguments: archive.pak \"semi;colon;separated;list;of;files\"", "" );
+    return ( v + ( a - 1 ) ) & ~( a - 1 );
+}
+
+// Sidecar of archive.pak, one entry per pak::Entry in the same order.
+// Lets --incremental skip compression of sources with unchanged content.
+struct Manifest {
+    static constexpr inline uint32_t MAGIC = 'FNAM';
+    static constexpr inline uint32_t VERSION = 1;
+
+    struct Header {
+        uint32_t magic = MAGIC;
+        uint32_t version = VERSION;
+        uint32_t count = 0;
+        uint32_t reserved = 0;
+    };
+
+    struct Entry {
+        char name[ 48 ]{};
+        uint64_t hash = 0;
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+    static_assert( sizeof( Entry ) == 64 );
+};
+
+// fraction of unused bytes in data region above which incremental update repacks the archive
+static constexpr float COMPACTION_THRESHOLD = 0.25f;
+
+// FNV-1a
+static uint64_t contentHash( std::span<const char> data )
+{
+    uint64_t ret = 0xcbf29ce484222325ull;
+    for ( char c : data ) {
+        ret ^= static_cast<uint8_t>( c );
+        ret *= 0x100000001b3ull;
+    }
+    return ret;
+}
+
+struct Item {
+    pak::Entry entry{};
+    uint64_t hash = 0;
+    // compressed source, empty when stored bytes of previous archive are reused
+    std::pmr::vector<char> stored{};
+    // same named entry of previous archive
+    const pak::Entry* slot = nullptr;
+    bool reused = false;
+};
+
+struct Previous {
+    std::pmr::vector<pak::Entry> entries{};
+    std::pmr::vector<Manifest::Entry> manifest{};
+
+    // previous archive is usable only when archive and manifest agree on every entry
+    bool load( const std::string& pakPath, const std::string& manifestPath )
+    {
+        std::ifstream pakFile( pakPath, std::ios::binary );
+        std::ifstream manifestFile( manifestPath, std::ios::binary );
+        if ( !pakFile.is_open() || !manifestFile.is_open() ) return false;
+
+        pak::Header header{};
+        cooker::read( pakFile, header );
+        if ( !pakFile || header.magic != pak::Header::MAGIC || header.version != pak::Header::VERSION ) return false;
+        entries.resize( header.size / sizeof( pak::Entry ) );
+        pakFile.seekg( header.offset );
+        cooker::read( pakFile, entries );
+        if ( !pakFile ) return false;
+
+        Manifest::Header manifestHeader{};
+        cooker::read( manifestFile, manifestHeader );
+        if ( !manifestFile || manifestHeader.magic != Manifest::MAGIC || manifestHeader.version != Manifest::VERSION ) return false;
+        if ( manifestHeader.count != entries.size() ) return false;
+        manifest.resize( manifestHeader.count );
+        cooker::read( manifestFile, manifest );
+        if ( !manifestFile ) return false;
+
+        for ( size_t i = 0; i < entries.size(); ++i ) {
+            const bool same = std::string_view{ entries[ i ].name } == std::string_view{ manifest[ i ].name }
+                && entries[ i ].offset == manifest[ i ].offset
+                && entries[ i ].size == manifest[ i ].size;
+            if ( !same ) return false;
+        }
+        return true;
+    }
+
+    // entries are sorted by name
+    std::pair<const pak::Entry*, uint64_t> find( std::string_view name ) const
+    {
+        auto it = std::ranges::lower_bound( entries, name, {}, []( const pak::Entry& e ) { return std::string_view{ e.name }; } );
+        if ( it == entries.end() || std::string_view{ it->name } != name ) return {};
+        return { &*it, manifest[ static_cast<size_t>( std::distance( entries.begin(), it ) ) ].hash };
+    }
+};
+
+// entry table and name index follow data region, header is written last; returns archive size
+static uint32_t writeDirectory( std::ofstream& ofs, std::span<const Item> items, uint32_t dataEnd )
+{
+    std::pmr::vector<pak::Entry> entries( items.size() );
+    std::ranges::transform( items, entries.begin(), &Item::entry );
 
-    auto fileList = preparePathPairs( argv[ 2 ] );
     pak::Header header{};
-    std::pmr::vector<pak::Entry> entries;
-    entries.reserve( fileList.size() );
+    ofs.seekp( dataEnd );
+    align( ofs, 64 );
+    header.offset = static_cast<uint32_t>( ofs.tellp() );
+    header.size = static_cast<uint32_t>( entries.size() * sizeof( pak::Entry ) );
+    cooker::write( ofs, entries );
 
-    auto ofs = cooker::openWrite( argv[ 1 ] );
+    std::pmr::vector<pak::IndexEntry> index( entries.size() );
+    for ( uint32_t i = 0; i < entries.size(); ++i ) {
+        index[ i ] = pak::IndexEntry{ .hash = Hash{}( entries[ i ].name ), .entry = i };
+    }
+    std::ranges::sort( index, []( const auto& lhs, const auto& rhs )
+    {
+        return lhs.hash != rhs.hash ? lhs.hash < rhs.hash : lhs.entry < rhs.entry;
+    } );
+    align( ofs, 16 );
+    header.indexOffset = static_cast<uint32_t>( ofs.tellp() );
+    header.indexSize = static_cast<uint32_t>( index.size() * sizeof( pak::IndexEntry ) );
+    cooker::write( ofs, index );
+    const uint32_t ret = static_cast<uint32_t>( ofs.tellp() );
+
+    ofs.seekp( 0 );
     cooker::write( ofs, header );
+    return ret;
+}
+
+// Entries packed in name order, byte identical to rebuild from scratch.
+// Reused entries are block copied from previous archive, so new archive is written aside and renamed over.
+static void writePacked( const std::string& pakPath, std::span<Item> items )
+{
+    const std::string tmpPath = pakPath + ".tmp";
+    uint32_t size = 0;
+    {
+        std::ifstream previous{};
+        if ( std::ranges::any_of( items, &Item::reused ) ) {
+            previous.open( pakPath, std::ios::binary );
+            previous.is_open() || cooker::error( "cannot open file for reading:", pakPath );
+        }
+        auto ofs = cooker::openWrite( tmpPath );
+        cooker::write( ofs, pak::Header{} );
+        std::pmr::vector<char> tmp;
+        for ( auto&& item : items ) {
+            if ( item.reused ) {
+                tmp.resize( item.entry.size );
+                previous.seekg( item.slot->offset );
+                previous.read( tmp.data(), static_cast<std::streamsize>( tmp.size() ) );
+                previous || cooker::error( "cannot read entry of previous archive:", item.entry.name );
+            }
+            align( ofs, 16 );
+            item.entry.offset = static_cast<uint32_t>( ofs.tellp() );
+            cooker::write( ofs, item.reused ? tmp : item.stored );
+        }
+        size = writeDirectory( ofs, items, static_cast<uint32_t>( ofs.tellp() ) );
+        ofs || cooker::error( "failed to write archive", tmpPath );
+    }
+    // directory of empty archive is only seeked to
+    std::error_code ec{};
+    std::filesystem::resize_file( tmpPath, size, ec );
+    !ec || cooker::error( "cannot resize archive", tmpPath );
+    std::filesystem::rename( tmpPath, pakPath, ec );
+    !ec || cooker::error( "cannot replace archive", pakPath );
+}
+
+// Reused entries stay where they are, changed entries overwrite their previous slot when they fit,
+// otherwise are appended past data region. Returns false without writing when resulting archive
+// would be too fragmented.
+static bool writeInPlace( const std::string& pakPath, std::span<Item> items )
+{
+    uint32_t dataEnd = sizeof( pak::Header );
+    uint32_t used = 0;
+    for ( auto&& item : items ) {
+        used += alignUp( item.entry.size, 16 );
+        if ( !item.reused && item.slot && alignUp( item.entry.size, 16 ) <= alignUp( item.slot->size, 16 ) ) {
+            item.entry.offset = item.slot->offset;
+        }
+        if ( item.entry.offset ) dataEnd = std::max( dataEnd, item.entry.offset + item.entry.size );
+    }
+    for ( auto&& item : items ) {
+        if ( item.entry.offset ) continue;
+        item.entry.offset = alignUp( dataEnd, 16 );
+        dataEnd = item.entry.offset + item.entry.size;
+    }
+    const uint32_t span = std::max<uint32_t>( alignUp( dataEnd, 16 ) - static_cast<uint32_t>( sizeof( pak::Header ) ), 1u );
+    const float fragmentation = 1.0f - static_cast<float>( used ) / static_cast<float>( span );
+    if ( fragmentation > COMPACTION_THRESHOLD ) return false;
+
+    uint32_t size = 0;
+    {
+        std::ofstream ofs( pakPath, std::ios::binary | std::ios::in | std::ios::out );
+        ofs.is_open() || cooker::error( "cannot open file for writing", pakPath );
+        for ( auto&& item : items ) {
+            if ( item.reused ) continue;
+            ofs.seekp( item.entry.offset );
+            cooker::write( ofs, item.stored );
+        }
+        size = writeDirectory( ofs, items, dataEnd );
+        ofs || cooker::error( "failed to write archive", pakPath );
+    }
+    std::error_code ec{};
+    std::filesystem::resize_file( pakPath, size, ec );
+    !ec || cooker::error( "cannot truncate archive", pakPath );
+    return true;
+}
+
+// Archive a delta is built against, entries matching sources byte for byte are left out of delta.
+struct Base {
+    std::ifstream file{};
+    std::pmr::vector<pak::Entry> entries{};
+
+    void load( const std::string& path )
+    {
+        file.open( path, std::ios::binary );
+        file.is_open() || cooker::error( "cannot open base archive for reading:", path );
+        pak::Header header{};
+        cooker::read( file, header );
+        ( file && header.magic == pak::Header::MAGIC ) || cooker::error( "base archive is not .pak:", path );
+        header.version == pak::Header::VERSION || cooker::error( "base archive version mismatch, rebuild it:", path );
+        entries.resize( header.size / sizeof( pak::Entry ) );
+        file.seekg( header.offset );
+        cooker::read( file, entries );
+        file || cooker::error( "base archive truncated:", path );
+        std::ranges::sort( entries, {}, []( const pak::Entry& e ) { return std::string_view{ e.name }; } );
+    }
+
+    bool contains( std::string_view name, std::span<const char> content, std::pmr::vector<char>& tmp, std::pmr::vector<char>& decompressed )
+    {
+        auto it = std::ranges::lower_bound( entries, name, {}, []( const pak::Entry& e ) { return std::string_view{ e.name }; } );
+        if ( it == entries.end() || std::string_view{ it->name } != name ) return false;
+        if ( it->uncompressedSize != content.size() ) return false;
+
+        tmp.resize( it->size );
+        file.seekg( it->offset );
+        file.read( tmp.data(), static_cast<std::streamsize>( tmp.size() ) );
+        file || cooker::error( "cannot read entry of base archive:", name );
+        if ( it->compression == pak::Entry::Compression::eNone ) return std::ranges::equal( tmp, content );
+
+        decompressed.resize( it->uncompressedSize );
+        const bool ok = lz::decompress(
+            std::span{ reinterpret_cast<const uint8_t*>( tmp.data() ), tmp.size() }
+            , std::span{ reinterpret_cast<uint8_t*>( decompressed.data() ), decompressed.size() }
+        );
+        ok || cooker::error( "cannot decompress entry of base archive:", name );
+        return std::ranges::equal( decompressed, content );
+    }
+};
+
+static void writeManifest( const std::string& manifestPath, std::span<const Item> items )
+{
+    std::pmr::vector<Manifest::Entry> entries( items.size() );
+    std::ranges::transform( items, entries.begin(), []( const Item& item )
+    {
+        Manifest::Entry ret{ .hash = item.hash, .offset = item.entry.offset, .size = item.entry.size };
+        std::ranges::copy( item.entry.name, ret.name );
+        return ret;
+    } );
+    auto ofs = cooker::openWrite( manifestPath );
+    cooker::write( ofs, Manifest::Header{ .count = static_cast<uint32_t>( entries.size() ) } );
+    cooker::write( ofs, entries );
+}
+
+int main( int argc, const char** argv )
+{
+    static constexpr char USAGE[] = "expected arguments: archive.pak \"semi;colon;separated;list;of;files\" [--incremental] [--base base.pak]";
+    ( argc >= 3 ) || cooker::error( USAGE, "" );
+    bool incremental = false;
+    std::string basePath{};
+    for ( int i = 3; i < argc; ++i ) {
+        const std::string_view arg = argv[ i ];
+        if ( arg == "--incremental" ) incremental = true;
+        else if ( arg == "--base" && i + 1 < argc ) basePath = argv[ ++i ];
+        else cooker::error( USAGE, arg );
+    }
+
+    const std::string pakPath = argv[ 1 ];
+    const std::string manifestPath = pakPath + ".manifest";
+    Previous previous{};
+    const bool hasPrevious = incremental && previous.load( pakPath, manifestPath );
+    // delta archive holds only entries differing from base, meant to be mounted over it with higher priority
+    Base base{};
+    if ( !basePath.empty() ) base.load( basePath );
+
+    auto fileList = preparePathPairs( argv[ 2 ] );
+    if ( !basePath.empty() ) {
+        for ( auto&& entry : base.entries ) {
+            const bool listed = std::ranges::binary_search( fileList, std::string_view{ entry.name }, {}, []( const auto& p ) { return std::string_view{ p.second }; } );
+            if ( !listed ) cooker::warning( "removed entry stays visible from base archive:", entry.name );
+        }
+    }
+    std::pmr::vector<Item> items{};
+    items.reserve( fileList.size() );
 
     std::pmr::vector<char> tmp;
+    std::pmr::vector<char> compressed;
+    std::pmr::vector<char> baseTmp;
+    std::pmr::vector<char> baseDecompressed;
     for ( auto&& [ src, dst ] : fileList ) {
-        auto& entry = entries.emplace_back();
-        strcpyIntoBuffer( dst, entry.name ) || cooker::error( "path too long to fit into .name field", dst );
+        Item item{};
+        strcpyIntoBuffer( dst, item.entry.name ) || cooker::error( "path too long to fit into .name field", dst );
 
         std::ifstream ifs( src, std::ios::binary | std::ios::ate );
         ifs.is_open() || cooker::error( "cannot open file for reading:", src );
@@ -81,17 +383,28 @@ int main( int argc, const char** argv )
         ifs.read( tmp.data(), size );
         ifs.close();
 
-        align( ofs, 16 );
+        if ( !basePath.empty() && base.contains( dst, tmp, baseTmp, baseDecompressed ) ) continue;
 
-        entry.offset = static_cast<uint32_t>( ofs.tellp() );
-        entry.size = static_cast<uint32_t>( size );
-        cooker::write( ofs, tmp );
+        item.hash = contentHash( tmp );
+        if ( hasPrevious ) {
+            auto [ slot, hash ] = previous.find( dst );
+            item.slot = slot;
+            item.reused = slot && hash == item.hash && slot->uncompressedSize == tmp.size();
+        }
+        if ( item.reused ) {
+            item.entry = *item.slot;
+        }
+        else {
+            const std::span<const char> stored = tryCompress( tmp, compressed, item.entry );
+            item.entry.size = static_cast<uint32_t>( stored.size() );
+            item.stored.assign( stored.begin(), stored.end() );
+        }
+        items.emplace_back( std::move( item ) );
     }
-    align( ofs, 64 );
-    header.offset = static_cast<uint32_t>( ofs.tellp() );
-    cooker::write( ofs, entries );
-    ofs.seekp( 0 );
-    header.size = static_cast<uint32_t>( entries.size() * sizeof( pak::Entry ) );
-    cooker::write( ofs, header );
+
+    if ( !hasPrevious || !writeInPlace( pakPath, items ) ) {
+        writePacked( pakPath, items );
+    }
+    writeManifest( manifestPath, items );
     return 0;
 }
@@ -0,0 +1,142 @@
+#include <cooker/common.hpp>
+
+#include <config/config.hpp>
+#include <extra/args.hpp>
+#include <extra/uib.hpp>
+#include <shared/hash.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+struct Compiler {
+    uib::Header m_header{};
+    std::pmr::vector<uib::Node> m_nodes{};
+    std::pmr::vector<uib::Property> m_properties{};
+
+    static uint32_t value( const cfg::Entry& entry, uib::Kind kind )
+    {
+        switch ( kind ) {
+        case uib::Kind::eFloat: return std::bit_cast<uint32_t>( entry.toFloat() );
+        case uib::Kind::eUint: return entry.toInt<uint32_t>();
+        case uib::Kind::eHash: return Hash{}( entry.toString() );
+        default: return 0;
+        }
+    }
+
+    static bool findWidget( Hash::value_type h, bool inFooter, uib::Widget& type )
+    {
+        if ( inFooter ) {
+            type = uib::Widget::eFooterButton;
+            return h == "Button"_hash;
+        }
+        for ( uint32_t i = 0; i < static_cast<uint32_t>( uib::Widget::eFooterButton ); ++i ) {
+            if ( uib::WIDGET_NAMES[ i ] != h ) continue;
+            type = static_cast<uib::Widget>( i );
+            return true;
+        }
+        return false;
+    }
+
+    // properties of node go first, children are compiled after them so that nodes and properties
+    // are both stored depth-first
+    void compile( const cfg::Entry& entry, uib::Widget type )
+    {
+        Hash hash{};
+        const size_t nodeIndex = m_nodes.size();
+        m_nodes.emplace_back( uib::Node{ .type = type } );
+        auto& count = m_header.widgetCount[ static_cast<uint32_t>( type ) ];
+        if ( count == std::numeric_limits<uint16_t>::max() ) cooker::error( "too many widgets of same type" );
+        count++;
+
+        const bool isFooter = type == uib::Widget::eFooter;
+        uint32_t propertyCount = 0;
+        uint32_t childCount = 0;
+        uib::Widget childType{};
+        for ( auto&& property : entry ) {
+            const auto h = hash( property.name() );
+            if ( findWidget( h, isFooter, childType ) ) {
+                childCount++;
+                continue;
+            }
+            const uib::Kind kind = uib::propertyKind( h );
+            if ( kind == uib::Kind::eUnknown ) {
+                cooker::warning( "unknown property, ignored:", property.name() );
+                continue;
+            }
+            m_properties.emplace_back( uib::Property{ .key = h, .value = value( property, kind ) } );
+            propertyCount++;
+        }
+        if ( propertyCount > std::numeric_limits<uint8_t>::max() ) cooker::error( "too many properties in widget", propertyCount );
+        if ( childCount > std::numeric_limits<uint16_t>::max() ) cooker::error( "too many children in widget", childCount );
+        m_nodes[ nodeIndex ].propertyCount = static_cast<uint8_t>( propertyCount );
+        m_nodes[ nodeIndex ].childCount = static_cast<uint16_t>( childCount );
+
+        for ( auto&& property : entry ) {
+            if ( !findWidget( hash( property.name() ), isFooter, childType ) ) continue;
+            compile( property, childType );
+        }
+    }
+
+    void compileScreen( const cfg::Entry& entry )
+    {
+        Hash hash{};
+        uib::Widget type{};
+        for ( auto&& property : entry ) {
+            const auto h = hash( property.name() );
+            switch ( h ) {
+            case "width"_hash: m_header.width = property.toFloat(); continue;
+            case "height"_hash: m_header.height = property.toFloat(); continue;
+            case "name"_hash: m_header.name = hash( property.toString() ); continue;
+            case "scene"_hash: m_header.scene = hash( property.toString() ); continue;
+            case "glow"_hash: m_header.glow = property.toInt<bool>(); continue;
+            case "Footer"_hash: type = uib::Widget::eFooter; break;
+            default:
+                if ( findWidget( h, false, type ) ) break;
+                cooker::warning( "unknown screen property, ignored:", property.name() );
+                continue;
+            }
+            m_header.rootCount++;
+            compile( property, type );
+        }
+        m_header.nodeCount = static_cast<uint32_t>( m_nodes.size() );
+        m_header.propertyCount = static_cast<uint32_t>( m_properties.size() );
+    }
+};
+
+int main( int argc, const char** argv )
+{
+    Args args{ argc, argv };
+    if ( !args || args.read( "-h" ) || args.read( "--help" ) ) {
+        std::cout <<
+            "Required arguments:\n"
+            "\t--src \"src/file/path.ui\" \u2012 source screen description\n"
+            "\t--dst \"dst/file/path.ui\" \u2012 destination of cooked screen\n"
+            "\nOptional Arguments:\n"
+            "\t-h --help \u2012 prints this message and exit\n"
+            ;
+        return !args;
+    }
+    std::string_view argsSrc{};
+    std::string_view argsDst{};
+
+    args.read( "--src", argsSrc ) || cooker::error( "--src \"src/file/path.ui\" \u2012 argument not specified" );
+    args.read( "--dst", argsDst ) || cooker::error( "--dst \"dst/file/path.ui\" \u2012 argument not specified" );
+
+    const std::pmr::string text = cooker::readText( argsSrc );
+    const cfg::Entry entry = cfg::Entry::fromData( std::span<const char>{ text.data(), text.size() } );
+
+    Compiler compiler{};
+    compiler.compileScreen( entry );
+    if ( compiler.m_header.name == 0 ) cooker::error( "screen has no name", argsSrc );
+
+    auto ofs = cooker::openWrite( argsDst );
+    cooker::write( ofs, compiler.m_header );
+    cooker::write( ofs, compiler.m_nodes );
+    cooker::write( ofs, compiler.m_properties );
+    return 0;
+}
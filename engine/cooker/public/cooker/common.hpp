@@ -11,6 +11,16 @@
 #include <string_view>
 #include <vector>
 
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace cooker {
 
 static inline constexpr char FAIL[] = "[\x1b[31mFAIL\x1b[0m] ";
@@ -66,6 +76,63 @@ std::pmr::string readText( std::string_view path )
     return ret;
 }
 
+// read only memory mapped view of whole file
+class MappedFile {
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+#if defined( _WIN32 )
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+
+public:
+    MappedFile( std::string_view path )
+    {
+#if defined( _WIN32 )
+        m_file = CreateFileA( std::string{ path }.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+        if ( m_file == INVALID_HANDLE_VALUE ) cooker::error( "cannot open file for reading", path );
+        LARGE_INTEGER size{};
+        GetFileSizeEx( m_file, &size );
+        m_size = static_cast<std::size_t>( size.QuadPart );
+        if ( m_size == 0 ) return;
+        m_mapping = CreateFileMappingA( m_file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if ( !m_mapping ) cooker::error( "cannot map file", path );
+        m_data = static_cast<const char*>( MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+#else
+        m_fd = ::open( std::string{ path }.c_str(), O_RDONLY );
+        if ( m_fd < 0 ) cooker::error( "cannot open file for reading", path );
+        struct stat st{};
+        ::fstat( m_fd, &st );
+        m_size = static_cast<std::size_t>( st.st_size );
+        if ( m_size == 0 ) return;
+        void* ptr = ::mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0 );
+        if ( ptr == MAP_FAILED ) cooker::error( "cannot map file", path );
+        ::madvise( ptr, m_size, MADV_SEQUENTIAL );
+        m_data = static_cast<const char*>( ptr );
+#endif
+        if ( !m_data ) cooker::error( "cannot map file", path );
+    }
+
+    ~MappedFile() noexcept
+    {
+#if defined( _WIN32 )
+        if ( m_data ) UnmapViewOfFile( m_data );
+        if ( m_mapping ) CloseHandle( m_mapping );
+        if ( m_file != INVALID_HANDLE_VALUE ) CloseHandle( m_file );
+#else
+        if ( m_data ) ::munmap( const_cast<char*>( m_data ), m_size );
+        if ( m_fd >= 0 ) ::close( m_fd );
+#endif
+    }
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator = ( const MappedFile& ) = delete;
+
+    inline std::string_view text() const noexcept { return m_data ? std::string_view{ m_data, m_size } : std::string_view{}; }
+};
+
 [[nodiscard]]
 std::pmr::vector<uint8_t> read( std::ifstream& ifs, size_t size )
 {
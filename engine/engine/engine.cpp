@@ -1,5 +1,6 @@
 #include <engine/engine.hpp>
 
+#include <extra/bcn.hpp>
 #include <extra/dds.hpp>
 
 #include "controller_state.hpp"
@@ -24,6 +25,7 @@ Engine::~Engine() noexcept
 {
     ZoneScoped;
     m_audioPtr.reset();
+    m_textureStreamerPtr.reset();
     m_rendererPtr.reset();
     SDL_DestroyWindow( m_window );
     SDL_Quit();
@@ -73,6 +75,8 @@ Engine::Engine( const CreateInfo& ci ) noexcept
     assert( Renderer::create );
     m_renderer = Renderer::create( rci );
     m_rendererPtr = std::unique_ptr<Renderer>( m_renderer );
+    m_textureStreamerPtr = std::make_unique<TextureStreamer>( m_renderer, 256ull << 20 );
+    m_textureStreamer = m_textureStreamerPtr.get();
 
     m_audio = Audio::create();
     m_audioPtr = std::unique_ptr<Audio>( m_audio );
@@ -116,6 +120,8 @@ void Engine::gameThread()
         FrameMark;
         const auto targetFrameEnd = clock::now() + m_targetFrameDuration - averagePresentDuration - averageSleepOverhead;
 
+        m_io->processReloads();
+        m_textureStreamer->update();
         processEvents();
         auto now = clock::now();
         const auto dt = std::chrono::duration_cast<std::chrono::nanoseconds>( now - lastUpdate );
@@ -541,12 +547,25 @@ void Engine::loadDDS( Asset&& asset )
     if ( header.caps & Caps::fComplex ) {
         tci.array = std::max( dxgiHeader.arraySize, 1u );
     }
+    std::span<const uint8_t> data = asset.data;
+    std::pmr::vector<uint8_t> decoded{};
     using enum dds::dxgi::Format;
     switch ( dxgiHeader.format ) {
     case BC1_UNORM: tci.format = TextureFormat::eBC1_unorm; break;
     case BC2_UNORM: tci.format = TextureFormat::eBC2_unorm; break;
     case BC3_UNORM: tci.format = TextureFormat::eBC3_unorm; break;
     case BC4_UNORM: tci.format = TextureFormat::eBC4_unorm; break;
+    case BC5_UNORM: tci.format = TextureFormat::eBC5_unorm; break;
+    case BC7_UNORM:
+        if ( m_renderer->featureAvailable( Renderer::Feature::eBC7 ) ) {
+            tci.format = TextureFormat::eBC7_unorm;
+            break;
+        }
+        // device cannot sample BC7, upload decoded mip chain instead
+        decoded = bcn::decompressBC7( data, tci.width, tci.height, tci.mips, tci.array );
+        tci.format = TextureFormat::eBGRA;
+        tci.mip0ByteCount = tci.width * tci.height * 4;
+        break;
     case B8G8R8A8_UNORM: tci.format = TextureFormat::eBGRA; break;
     case R8_UNORM: tci.format = TextureFormat::eR; break;
     case B4G4R4A4_UNORM: tci.format = TextureFormat::eB4G4R4A4_unorm; break;
@@ -555,18 +574,41 @@ void Engine::loadDDS( Asset&& asset )
         return;
     }
 
-    Texture tex = m_renderer->createTexture( tci, asset.data );
+    // decoded chain of reloaded texture is replaced, previous one lives until streamer stops reading it
+    const Hash::value_type hash = Hash{}( asset.path );
+    auto previous = m_decodedTextures.extract( hash );
+    if ( !decoded.empty() ) {
+        data = m_decodedTextures.emplace( hash, std::move( decoded ) ).first->second;
+    }
+
+    if ( Texture reloaded = m_textures[ asset.path ]; reloaded ) {
+        m_textures.insertOrAssign( std::make_pair( asset.path, m_textureStreamer->add( tci, data, reloaded ) ) );
+        return;
+    }
+
+    Texture tex = m_textureStreamer->add( tci, data );
     assert( tex );
 
-    [[maybe_unused]] // TODO duplicates
+    [[maybe_unused]]
     auto&& [ it, inserted ] = m_textures.insert( std::make_pair( asset.path, tex ) );
 }
 
 void Engine::loadWAV( Asset&& asset )
 {
     ZoneScoped;
-    auto soundID = m_audio->load( asset.data );
+    if ( asset.path.starts_with( "music/" ) ) {
+        // streams of previous content stop before it is released after reload, game restarts them with new one
+        if ( auto previous = m_music[ asset.path ]; !previous.empty() ) {
+            m_audio->stop( previous );
+        }
+        m_music.insertOrAssign( std::make_pair( asset.path, asset.data ) );
+        return;
+    }
+    auto soundID = m_audio->load( asset.data, Audio::Channel::eSFX );
     assert( soundID );
-    [[maybe_unused]] // TODO duplicates
-    auto&& [ it, inserted ] = m_sounds.insert( std::make_pair( asset.path, soundID ) );
+    // reloaded sound replaces previous one, which is freed once its voices finish
+    if ( Audio::Slot previous = m_sounds[ asset.path ] ) {
+        m_audio->unload( previous );
+    }
+    m_sounds.insertOrAssign( std::make_pair( asset.path, soundID ) );
 }
@@ -1,33 +1,206 @@
 #include <engine/filesystem.hpp>
+#include <extra/lz.hpp>
 #include <extra/pak.hpp>
+#include <platform/linux.hpp>
 #include <platform/utils.hpp>
 
 #include <profiler.hpp>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cerrno>
 #include <cstring>
 #include <fstream>
 #include <iterator>
+#include <map>
 #include <numeric>
 #include <ranges>
+#include <thread>
 #include <utility>
 
+#if PLATFORM_LINUX
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// loose file names follow .pak naming: parent directory and file name
+static std::pmr::string looseName( const std::filesystem::path& path )
+{
+    std::pmr::string ret{ path.parent_path().filename().generic_string() };
+    ret += '/';
+    ret += path.filename().generic_string();
+    return ret;
+}
+
+static bool readFile( const std::filesystem::path& path, std::span<uint8_t> data )
+{
+    std::ifstream ifs( path, std::ios::binary );
+    ifs.read( reinterpret_cast<char*>( data.data() ), static_cast<std::streamsize>( data.size() ) );
+    return ifs.gcount() == static_cast<std::streamsize>( data.size() );
+}
+
+// Watches directory tree of a loose mount and queues changed files for processReloads().
+struct Filesystem::Watcher {
+    uint32_t m_priority = 0;
+#if PLATFORM_LINUX
+    int m_inotify = -1;
+    int m_stop = -1;
+    // watch descriptor to directory
+    std::pmr::map<int, std::filesystem::path> m_directories{};
+    std::thread m_thread{};
+
+    ~Watcher() noexcept
+    {
+        if ( m_thread.joinable() ) {
+            const uint64_t one = 1;
+            [[maybe_unused]]
+            const auto written = ::write( m_stop, &one, sizeof( one ) );
+            m_thread.join();
+        }
+        if ( m_stop != -1 ) ::close( m_stop );
+        if ( m_inotify != -1 ) ::close( m_inotify );
+    }
+
+    Watcher( const std::filesystem::path& root, uint32_t priority ) noexcept
+    : m_priority{ priority }
+    , m_inotify{ inotify_init1( IN_CLOEXEC | IN_NONBLOCK ) }
+    , m_stop{ eventfd( 0, EFD_CLOEXEC ) }
+    {
+        assert( m_inotify != -1 );
+        assert( m_stop != -1 );
+        watch( root );
+        std::error_code ec{};
+        for ( const auto& it : std::filesystem::recursive_directory_iterator( root, ec ) ) {
+            if ( it.is_directory() ) watch( it.path() );
+        }
+    }
+
+    void watch( const std::filesystem::path& directory )
+    {
+        const int wd = inotify_add_watch( m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR );
+        if ( wd == -1 ) [[unlikely]] return;
+        m_directories[ wd ] = directory;
+    }
+
+    void run( Filesystem* filesystem )
+    {
+        m_thread = std::thread{ [this, filesystem]() { loop( filesystem ); } };
+    }
+
+    void loop( Filesystem* filesystem )
+    {
+        alignas( inotify_event ) char buffer[ 4096 ];
+        std::array<pollfd, 2> fds{
+            pollfd{ .fd = m_inotify, .events = POLLIN, .revents = 0 },
+            pollfd{ .fd = m_stop, .events = POLLIN, .revents = 0 },
+        };
+        while ( true ) {
+            if ( ::poll( fds.data(), fds.size(), -1 ) < 0 ) {
+                if ( errno == EINTR ) continue;
+                return;
+            }
+            if ( fds[ 1 ].revents ) return;
+            if ( !fds[ 0 ].revents ) continue;
+            for ( ssize_t len = ::read( m_inotify, buffer, sizeof( buffer ) ); len > 0; len = ::read( m_inotify, buffer, sizeof( buffer ) ) ) {
+                for ( ssize_t i = 0; i < len; ) {
+                    const auto* event = reinterpret_cast<const inotify_event*>( buffer + i );
+                    i += static_cast<ssize_t>( sizeof( inotify_event ) + event->len );
+                    auto dir = m_directories.find( event->wd );
+                    if ( !event->len || dir == m_directories.end() ) continue;
+                    const std::filesystem::path path = dir->second / event->name;
+                    if ( event->mask & IN_ISDIR ) {
+                        if ( event->mask & ( IN_CREATE | IN_MOVED_TO ) ) watch( path );
+                        continue;
+                    }
+                    // IN_CREATE of a file is followed by IN_CLOSE_WRITE once written
+                    if ( event->mask & IN_CREATE ) continue;
+                    reload( filesystem, path );
+                }
+            }
+        }
+    }
+
+    void reload( Filesystem* filesystem, const std::filesystem::path& path )
+    {
+        ZoneScopedN( "Filesystem reload" );
+        Reload r{ .name = looseName( path ), .priority = m_priority };
+        // must fit in pak::Entry::name with null terminator
+        if ( r.name.size() >= sizeof( pak::Entry::name ) ) [[unlikely]] return;
+        std::error_code ec{};
+        const auto size = std::filesystem::file_size( path, ec );
+        if ( ec || size > 0xFFFF'FFFFu ) [[unlikely]] return;
+        r.data.resize( size );
+        // file could have been replaced again meanwhile, next event will catch it up
+        if ( !readFile( path, r.data ) ) [[unlikely]] return;
+        filesystem->queueReload( std::move( r ) );
+    }
+#else
+    Watcher( const std::filesystem::path&, uint32_t priority ) noexcept
+    : m_priority{ priority }
+    {}
+
+    void run( Filesystem* ) {}
+#endif
+};
+
 Filesystem::~Filesystem() noexcept = default;
 
 Filesystem::Filesystem() noexcept = default;
 
+// slot of calling thread in Filesystem::m_readers, threads are assigned round robin
+static uint32_t readerSlot( uint32_t slotCount )
+{
+    static std::atomic<uint32_t> next = 0;
+    thread_local const uint32_t slot = next++;
+    return slot % slotCount;
+}
+
+const Filesystem::Snapshot* Filesystem::acquireSnapshot()
+{
+    // seq_cst pairs with publish() and reclaim(): either reclaim() sees this reader or the reader sees newer snapshot
+    m_readers[ readerSlot( m_readers.size() ) ].count.fetch_add( 1, std::memory_order_seq_cst );
+    return m_snapshot.load( std::memory_order_seq_cst );
+}
+
+void Filesystem::releaseSnapshot()
+{
+    m_readers[ readerSlot( m_readers.size() ) ].count.fetch_sub( 1, std::memory_order_release );
+}
+
+void Filesystem::reclaim()
+{
+    const bool idle = std::ranges::all_of( m_readers, []( const ReaderSlot& r ) { return r.count.load( std::memory_order_seq_cst ) == 0; } );
+    if ( !idle ) return;
+    if ( !m_snapshots.empty() ) m_snapshots.erase( m_snapshots.begin(), std::prev( m_snapshots.end() ) );
+    m_retiredMounts.clear();
+}
+
 std::span<const uint8_t> Filesystem::viewWait( std::string_view path )
 {
     ZoneScopedN( "Filesystem viewWait" );
-    std::pmr::string key( path );
-    std::scoped_lock<std::mutex> sl( m_bottleneckFs );
-    for ( auto&& mount : m_mounts ) {
-        auto it = mount.m_toc.find( key );
-        if ( it != mount.m_toc.end() ) { return it->second; }
+    std::span<const uint8_t> ret{};
+    [[maybe_unused]]
+    bool found = false;
+    if ( const Snapshot* snapshot = acquireSnapshot(); snapshot ) [[likely]] {
+        const auto [ begin, end ] = std::ranges::equal_range( snapshot->m_lookup, Hash{}( path ), {}, &Lookup::hash );
+        const auto it = std::ranges::find( begin, end, path, &Lookup::name );
+        if ( it != end ) [[likely]] {
+            ret = it->data;
+            found = true;
+        }
     }
-    assert( !"file not found" );
-    return {};
+    releaseSnapshot();
+    assert( found && "file not found" );
+    return ret;
+}
+
+static bool indexOrder( const pak::IndexEntry& lhs, const pak::IndexEntry& rhs )
+{
+    return lhs.hash != rhs.hash ? lhs.hash < rhs.hash : lhs.entry < rhs.entry;
 }
 
 static void readRaw( std::ifstream& ifs, pak::Header& h )
@@ -48,7 +221,15 @@ static inline auto align16( auto v )
     return (decltype(v))( ( (uintptr_t)v + 15ull ) & ~15ull );
 };
 
-void Filesystem::mount( const std::filesystem::path& path )
+template <typename TLookup>
+static bool isShadowed( std::span<const TLookup> lookup, Hash::value_type hash, std::string_view name, uint32_t priority )
+{
+    const auto [ begin, end ] = std::ranges::equal_range( lookup, hash, {}, &TLookup::hash );
+    const auto it = std::ranges::find( begin, end, name, &TLookup::name );
+    return it != end && it->priority > priority;
+}
+
+void Filesystem::mount( const std::filesystem::path& path, uint32_t priority )
 {
     ZoneScoped;
     if ( path.extension() != ".pak" ) {
@@ -72,23 +253,38 @@ void Filesystem::mount( const std::filesystem::path& path )
     if ( header.magic != header.MAGIC ) {
         platform::showFatalError( "Data corruption error", ".pak magic field mismatch" );
     };
+    if ( header.version != header.VERSION ) {
+        platform::showFatalError( "Data error", ".pak version mismatch, rebuild archive" );
+    }
     if ( ( (size_type)header.offset + header.size ) > MAX_SIZE ) {
         platform::showFatalError( "Data corruption error", ".pak entries exceeds file size limit" );
     }
     if ( header.size % 64 ) {
         platform::showFatalError( "Data corruption error", ".pak header::size % 64 != 0" );
     }
+    if ( header.indexSize / sizeof( pak::IndexEntry ) != header.size / sizeof( pak::Entry ) ) {
+        platform::showFatalError( "Data corruption error", ".pak index size does not match entry count" );
+    }
+    if ( ( (size_type)header.indexOffset + header.indexSize ) > fileSize ) {
+        platform::showFatalError( "Data corruption error", ".pak index exceeds file size" );
+    }
 
     std::pmr::vector<pak::Entry> entries( header.size / sizeof( pak::Entry ) );
-    assert( !entries.empty() );
+    std::pmr::vector<pak::IndexEntry> index( entries.size() );
+    std::pmr::vector<uint32_t> loadOrder{};
+    std::pmr::vector<Hash::value_type> hashes( entries.size() );
     size_type preallocSize = 0;
+    size_type compressedSize = 0;
     {
         ZoneScopedN( "read & process .pak TOC" );
         ifs.seekg( header.offset );
         readRaw( ifs, std::span<pak::Entry>( entries ) );
 
-        std::ranges::for_each( entries, [fileSize, &preallocSize]( const auto& it )
+        std::ranges::for_each( entries, [fileSize]( const auto& it )
         {
+            if ( it.name[ std::size( it.name ) - 1 ] != 0 ) [[unlikely]] {
+                platform::showFatalError( "Data corruption error", ".pak entry name not terminated" );
+            }
             if ( (size_type)it.offset + it.size > fileSize ) [[unlikely]] {
                 platform::showFatalError( "Data corruption error", ".pak out of bounds file entry" );
             }
@@ -96,22 +292,45 @@ void Filesystem::mount( const std::filesystem::path& path )
             {
                 platform::showFatalError( "Data corruption error", ".pak entry overwrites pak header" );
             }
-            // NOTE: align file sizes by 16 for easier debugging
-            preallocSize += align16( it.size );
+            switch ( it.compression ) {
+            case pak::Entry::Compression::eNone:
+                if ( it.uncompressedSize != it.size ) [[unlikely]] {
+                    platform::showFatalError( "Data corruption error", ".pak uncompressed entry size mismatch" );
+                }
+                break;
+            case pak::Entry::Compression::eLZ:
+                break;
+            [[unlikely]] default:
+                platform::showFatalError( "Data corruption error", ".pak entry compression unknown" );
+            }
         } );
-        assert( preallocSize != 0 );
+
+        ifs.seekg( header.indexOffset );
+        readRaw( ifs, std::span<pak::IndexEntry>( index ) );
+        const bool indexValid = std::ranges::is_sorted( index, indexOrder )
+            && std::ranges::all_of( index, [size = entries.size()]( const auto& it ) { return it.entry < size; } );
+        if ( !indexValid ) [[unlikely]] {
+            platform::showFatalError( "Data corruption error", ".pak index malformed" );
+        }
+        assert( std::ranges::all_of( index, [&entries]( const auto& it ) { return it.hash == Hash{}( entries[ it.entry ].name ); } ) );
+        std::ranges::for_each( index, [&hashes]( const auto& it ) { hashes[ it.entry ] = it.hash; } );
+
+        // entries shadowed already cannot become visible, skipping them keeps overlay mount I/O proportional to its content
+        const Snapshot* current = acquireSnapshot();
+        loadOrder.reserve( entries.size() );
+        for ( uint32_t i = 0; i < entries.size(); ++i ) {
+            const bool shadowed = current
+                && isShadowed<Lookup>( current->m_lookup, hashes[ i ], std::begin( entries[ i ].name ), priority );
+            if ( shadowed ) continue;
+            loadOrder.emplace_back( i );
+            // NOTE: align file sizes by 16 for easier debugging
+            preallocSize += align16( entries[ i ].uncompressedSize );
+            if ( entries[ i ].compression == pak::Entry::Compression::eLZ ) compressedSize += entries[ i ].size;
+        }
+        releaseSnapshot();
         assert( preallocSize <= MAX_SIZE );
-        std::ranges::sort( entries, [this]( const auto& lhs, const auto& rhs )
-        {
-            std::string_view l{ std::begin( lhs.name ) };
-            std::string_view r{ std::begin( rhs.name ) };
-            auto itl = std::ranges::find_if( m_callbacks, [l]( const auto& a ) { return l.ends_with( a.first ); } );
-            auto itr = std::ranges::find_if( m_callbacks, [r]( const auto& a ) { return r.ends_with( a.first ); } );
-            auto dl = std::distance( m_callbacks.begin(), itl );
-            auto dr = std::distance( m_callbacks.begin(), itr );
-            if ( dl != dr ) return dl < dr;
-            return l < r;
-        } );
+
+        sortByCallback( loadOrder, entries );
     }
 
 
@@ -121,30 +340,296 @@ void Filesystem::mount( const std::filesystem::path& path )
         mount = &m_mounts.emplace_front();
         // NOTE: I have no guarantees default allocator will give me 16 byte aligned pointer
         mount->m_blob.resize( preallocSize + 16 );
+        mount->m_entries = std::move( entries );
     }
     auto* ptr = mount->m_blob.data();
 
-    std::ranges::for_each( entries, [this, mount, &ifs, &ptr]( const auto& entry )
+    struct Decompress {
+        std::span<const uint8_t> src{};
+        std::span<uint8_t> dst{};
+    };
+    std::pmr::vector<uint8_t> compressed( compressedSize );
+    std::pmr::vector<Decompress> decompress{};
+    std::pmr::vector<std::span<uint8_t>> views( mount->m_entries.size() );
     {
-        std::string_view name{ std::begin( entry.name ) };
-        ptr = align16( ptr );
-        ifs.seekg( entry.offset );
-        std::span<uint8_t> data{ ptr, entry.size };
-        ptr += entry.size;
-        readRaw( ifs, data );
+        ZoneScopedN( "read .pak entries" );
+        auto* compressedPtr = compressed.data();
+        for ( uint32_t i : loadOrder ) {
+            const pak::Entry& entry = mount->m_entries[ i ];
+            ptr = align16( ptr );
+            std::span<uint8_t> data{ ptr, entry.uncompressedSize };
+            ptr += entry.uncompressedSize;
+            views[ i ] = data;
+            ifs.seekg( entry.offset );
+            if ( entry.compression == pak::Entry::Compression::eNone ) {
+                readRaw( ifs, data );
+                continue;
+            }
+            std::span<uint8_t> src{ compressedPtr, entry.size };
+            compressedPtr += entry.size;
+            readRaw( ifs, src );
+            decompress.emplace_back( src, data );
+        }
+    }
+
+    if ( !decompress.empty() ) {
+        ZoneScopedN( "decompress .pak entries" );
+        std::atomic<size_t> next = 0;
+        std::atomic<bool> corrupted = false;
+        auto worker = [&next, &corrupted, &decompress]()
         {
-            std::scoped_lock sl{ m_bottleneckFs };
-            [[maybe_unused]]
-            auto [ it, inserted ] = mount->m_toc.insert( std::make_pair( name, data ) );
-            assert( inserted );
+            for ( size_t i = next++; i < decompress.size(); i = next++ ) {
+                if ( !lz::decompress( decompress[ i ].src, decompress[ i ].dst ) ) [[unlikely]] {
+                    corrupted.store( true );
+                }
+            }
+        };
+        const size_t threadCount = std::clamp<size_t>( std::thread::hardware_concurrency(), 1, decompress.size() );
+        std::pmr::vector<std::thread> threads{};
+        threads.reserve( threadCount - 1 );
+        for ( size_t i = 1; i < threadCount; ++i ) {
+            threads.emplace_back( worker );
         }
+        worker();
+        std::ranges::for_each( threads, []( auto& t ) { t.join(); } );
+        if ( corrupted ) [[unlikely]] {
+            platform::showFatalError( "Data corruption error", ".pak entry failed to decompress" );
+        }
+    }
+
+    const auto published = publish( *mount, index, views, priority );
+    invokeCallbacks( *mount, loadOrder, views, published );
+}
+
+void Filesystem::sortByCallback( std::span<uint32_t> loadOrder, std::span<const pak::Entry> entries )
+{
+    std::ranges::sort( loadOrder, [this, entries]( uint32_t lhs, uint32_t rhs )
+    {
+        std::string_view l{ std::begin( entries[ lhs ].name ) };
+        std::string_view r{ std::begin( entries[ rhs ].name ) };
+        auto itl = std::ranges::find_if( m_callbacks, [l]( const auto& a ) { return l.ends_with( a.first ); } );
+        auto itr = std::ranges::find_if( m_callbacks, [r]( const auto& a ) { return r.ends_with( a.first ); } );
+        auto dl = std::distance( m_callbacks.begin(), itl );
+        auto dr = std::distance( m_callbacks.begin(), itr );
+        if ( dl != dr ) return dl < dr;
+        return l < r;
+    } );
+}
+
+// returns mask of mount entries that made it into published snapshot
+std::pmr::vector<uint8_t> Filesystem::publish( const Mount& mount, std::span<const pak::IndexEntry> index, std::span<const std::span<uint8_t>> views, uint32_t priority )
+{
+    ZoneScopedN( "publish .pak TOC" );
+    std::pmr::vector<uint8_t> published( mount.m_entries.size() );
+    std::scoped_lock sl{ m_bottleneckFs };
+    const Snapshot* current = m_snapshot.load( std::memory_order_relaxed );
+    std::pmr::vector<Lookup> lookup{};
+    lookup.reserve( index.size() );
+    for ( const auto& it : index ) {
+        const std::string_view name = std::begin( mount.m_entries[ it.entry ].name );
+        // skipped entries are still shadowed, other mounts may have been published meanwhile
+        if ( current && isShadowed<Lookup>( current->m_lookup, it.hash, name, priority ) ) continue;
+        published[ it.entry ] = 1;
+        lookup.emplace_back( Lookup{
+            .hash = it.hash,
+            .priority = priority,
+            .name = name,
+            .data = views[ it.entry ],
+        } );
+    }
+
+    Snapshot& snapshot = m_snapshots.emplace_back();
+    if ( current ) {
+        std::pmr::vector<Lookup> merged( lookup.size() + current->m_lookup.size() );
+        // stable, within same hash new entries come first
+        std::ranges::merge( lookup, current->m_lookup, merged.begin(), {}, &Lookup::hash, &Lookup::hash );
+        // keep first of every name in hash run, new entries are never shadowed at this point
+        snapshot.m_lookup.reserve( merged.size() );
+        for ( auto runBegin = merged.begin(); runBegin != merged.end(); ) {
+            const auto runEnd = std::find_if( runBegin, merged.end(), [hash = runBegin->hash]( const Lookup& l ) { return l.hash != hash; } );
+            const auto firstKept = snapshot.m_lookup.size();
+            for ( auto it = runBegin; it != runEnd; ++it ) {
+                const auto kept = std::span{ snapshot.m_lookup }.subspan( firstKept );
+                if ( std::ranges::find( kept, it->name, &Lookup::name ) != kept.end() ) continue;
+                snapshot.m_lookup.emplace_back( *it );
+            }
+            runBegin = runEnd;
+        }
+    }
+    else {
+        snapshot.m_lookup = std::move( lookup );
+    }
+    m_snapshot.store( &snapshot, std::memory_order_seq_cst );
+    reclaim();
+    return published;
+}
+
+void Filesystem::invokeCallbacks( const Mount& mount, std::span<const uint32_t> loadOrder, std::span<const std::span<uint8_t>> views, std::span<const uint8_t> published )
+{
+    for ( uint32_t i : loadOrder ) {
+        if ( !published[ i ] ) continue;
+        std::string_view name{ std::begin( mount.m_entries[ i ].name ) };
+        std::span<uint8_t> data = views[ i ];
         std::scoped_lock sl{ m_bottleneckCb };
         auto cb = std::ranges::find_if( m_callbacks, [name]( const auto& a ) { return name.ends_with( a.first ); } );
-        if ( cb == m_callbacks.end() ) return;
+        if ( cb == m_callbacks.end() ) continue;
         // TODO: move to async once file dependency is solved
         std::invoke( cb->second, Asset{ name, data } );
-    } );
+    }
+}
+
+void Filesystem::mountLoose( const std::filesystem::path& path, uint32_t priority )
+{
+    ZoneScoped;
+    std::error_code ec{};
+    if ( !std::filesystem::is_directory( path, ec ) ) {
+        platform::showFatalError( "Data error", "Loose mount is not a directory" );
+    }
+    {
+        // watching before scan, files changed meanwhile are reloaded rather than missed
+        std::scoped_lock sl{ m_bottleneckReload };
+        m_watchers.emplace_back( path, priority ).run( this );
+    }
 
+    using size_type = decltype( Mount::m_blob )::size_type;
+    static constexpr size_type MAX_SIZE = 0xFFFF'FFFFu;
+    std::pmr::vector<std::filesystem::path> paths{};
+    std::pmr::vector<pak::Entry> entries{};
+    std::pmr::vector<pak::IndexEntry> index{};
+    std::pmr::vector<uint32_t> loadOrder{};
+    size_type preallocSize = 0;
+    {
+        ZoneScopedN( "scan loose files" );
+        const Snapshot* current = acquireSnapshot();
+        for ( const auto& it : std::filesystem::recursive_directory_iterator( path, ec ) ) {
+            if ( !it.is_regular_file() ) continue;
+            const std::pmr::string name = looseName( it.path() );
+            pak::Entry& entry = entries.emplace_back();
+            if ( name.size() >= std::size( entry.name ) ) {
+                platform::showFatalError( "Data error", "Loose file name exceeds .pak entry name limit" );
+            }
+            std::ranges::copy( name, std::begin( entry.name ) );
+            const size_type size = static_cast<size_type>( it.file_size( ec ) );
+            if ( size > MAX_SIZE ) {
+                platform::showFatalError( "Data error", "Loose file size exceeds size limit" );
+            }
+            entry.size = entry.uncompressedSize = static_cast<uint32_t>( size );
+            paths.emplace_back( it.path() );
+
+            const uint32_t i = static_cast<uint32_t>( index.size() );
+            const Hash::value_type hash = Hash{}( name );
+            index.emplace_back( pak::IndexEntry{ .hash = hash, .entry = i } );
+            if ( current && isShadowed<Lookup>( current->m_lookup, hash, name, priority ) ) continue;
+            loadOrder.emplace_back( i );
+            preallocSize += align16( size );
+        }
+        releaseSnapshot();
+        if ( preallocSize > MAX_SIZE ) {
+            platform::showFatalError( "Data error", "Loose files exceed size limit" );
+        }
+        std::ranges::sort( index, indexOrder );
+        sortByCallback( loadOrder, entries );
+    }
+
+    Filesystem::Mount* mount{};
+    {
+        std::scoped_lock sl{ m_bottleneckFs };
+        mount = &m_mounts.emplace_front();
+        mount->m_blob.resize( preallocSize + 16 );
+        mount->m_entries = std::move( entries );
+    }
+
+    std::pmr::vector<std::span<uint8_t>> views( mount->m_entries.size() );
+    {
+        ZoneScopedN( "read loose files" );
+        auto* ptr = mount->m_blob.data();
+        for ( uint32_t i : loadOrder ) {
+            ptr = align16( ptr );
+            views[ i ] = std::span<uint8_t>{ ptr, mount->m_entries[ i ].size };
+            ptr += mount->m_entries[ i ].size;
+            if ( !readFile( paths[ i ], views[ i ] ) ) [[unlikely]] {
+                platform::showFatalError( "Data error", "Cannot read loose file" );
+            }
+        }
+    }
+
+    const auto published = publish( *mount, index, views, priority );
+    invokeCallbacks( *mount, loadOrder, views, published );
+}
+
+void Filesystem::queueReload( Reload&& reload )
+{
+    std::scoped_lock sl{ m_bottleneckReload };
+    // editors tend to write more than once, only latest content matters
+    auto it = std::ranges::find( m_reloads, reload.name, &Reload::name );
+    if ( it != m_reloads.end() ) *it = std::move( reload );
+    else m_reloads.emplace_back( std::move( reload ) );
+}
+
+uint32_t Filesystem::processReloads()
+{
+    decltype( m_reloads ) reloads{};
+    {
+        std::scoped_lock sl{ m_bottleneckReload };
+        if ( m_reloads.empty() ) [[likely]] return 0;
+        std::swap( reloads, m_reloads );
+    }
+
+    ZoneScoped;
+    // every reload is a single entry mount published over previous content
+    std::pmr::vector<Mount*> mounts( reloads.size() );
+    {
+        std::scoped_lock sl{ m_bottleneckFs };
+        for ( uint32_t i = 0; i < reloads.size(); ++i ) {
+            Mount* mount = mounts[ i ] = &m_mounts.emplace_front();
+            mount->m_reload = true;
+            mount->m_priority = reloads[ i ].priority;
+            mount->m_blob = std::move( reloads[ i ].data );
+            pak::Entry& entry = mount->m_entries.emplace_back();
+            std::ranges::copy( reloads[ i ].name, std::begin( entry.name ) );
+            entry.size = entry.uncompressedSize = static_cast<uint32_t>( mount->m_blob.size() );
+        }
+    }
+
+    // callbacks are invoked in registration order of extensions, same as during mount
+    std::pmr::vector<pak::Entry> entries( reloads.size() );
+    std::ranges::transform( mounts, entries.begin(), []( const Mount* m ) { return m->m_entries.front(); } );
+    std::pmr::vector<uint32_t> loadOrder( reloads.size() );
+    std::iota( loadOrder.begin(), loadOrder.end(), 0u );
+    sortByCallback( loadOrder, entries );
+
+    static constexpr uint32_t FIRST = 0;
+    for ( uint32_t i : loadOrder ) {
+        Mount& mount = *mounts[ i ];
+        const std::array index{ pak::IndexEntry{ .hash = Hash{}( std::begin( mount.m_entries.front().name ) ), .entry = 0 } };
+        const std::array views{ std::span<uint8_t>{ mount.m_blob } };
+        const auto published = publish( mount, index, views, reloads[ i ].priority );
+        invokeCallbacks( mount, std::span{ &FIRST, 1 }, views, published );
+    }
+
+    // previous reload of same file is no longer visible and its consumers re-pointed and drained in callbacks above,
+    // it is freed once readers of older snapshots are done
+    std::scoped_lock sl{ m_bottleneckFs };
+    for ( const Mount* mount : mounts ) {
+        const std::string_view name = std::begin( mount->m_entries.front().name );
+        auto superseded = std::ranges::find_if( m_mounts, [mount, name]( const Mount& m )
+        {
+            return &m != mount && m.m_reload && m.m_priority == mount->m_priority
+                && name == std::begin( m.m_entries.front().name );
+        } );
+        if ( superseded != m_mounts.end() ) m_retiredMounts.splice( m_retiredMounts.end(), m_mounts, superseded );
+    }
+    reclaim();
+    return static_cast<uint32_t>( reloads.size() );
+}
+
+Filesystem::Statistics Filesystem::statistics()
+{
+    std::scoped_lock sl{ m_bottleneckFs };
+    return Statistics{
+        .mounts = static_cast<uint32_t>( m_mounts.size() + m_retiredMounts.size() ),
+        .snapshots = static_cast<uint32_t>( m_snapshots.size() ),
+    };
 }
 
 void Filesystem::setCallback( std::string_view ext, Callback&& cb )
@@ -140,6 +140,9 @@ uint32_t vertexAssembly( ccmd::Vm* vm, void* ctx )
     case "f3"_hash: assembly.m_input = eF3; break;
     case "u"_hash: assembly.m_input = eU; break;
     case "u2"_hash: assembly.m_input = eU2; break;
+    case "un16x2"_hash: assembly.m_input = eUN16x2; break;
+    case "un16x4"_hash: assembly.m_input = eUN16x4; break;
+    case "sn16x2"_hash: assembly.m_input = eSN16x2; break;
     default: assert( !"unknown inputType" ); return 1;
     }
     ccmd::argv( vm, 1, assembly.m_location );
@@ -183,9 +186,13 @@ void MaterialSetup::operator () ( Asset&& a )
     if ( vertexShader.size() ) pci.m_vertexShaderData = m_filesystem->viewWait( vertexShader );
     if ( fragmentShader.size() ) pci.m_fragmentShaderData = m_filesystem->viewWait( fragmentShader );
     if ( computeShader.size() ) pci.m_computeShaderData = m_filesystem->viewWait( computeShader );
+    assert( pci.m_userHint );
+    if ( PipelineSlot reloaded = m_map->find( pci.m_userHint ); reloaded ) {
+        m_renderer->replacePipeline( reloaded, pci );
+        return;
+    }
     auto pip = m_renderer->createPipeline( pci );
     assert( pip );
-    assert( pci.m_userHint );
     [[maybe_unused]]
     auto [ it, inserted ] = m_map->insert( std::make_pair( pci.m_userHint, pip ) );
     assert( inserted );
@@ -4,6 +4,7 @@
 #include <engine/filesystem.hpp>
 #include <engine/fps_limiter.hpp>
 #include <engine/savesystem.hpp>
+#include <engine/texture_streamer.hpp>
 #include <input/actuator.hpp>
 #include <input/mouse_event.hpp>
 #include <renderer/pipeline.hpp>
@@ -19,6 +20,7 @@
 #include <map>
 #include <memory>
 #include <memory_resource>
+#include <span>
 #include <tuple>
 #include <vector>
 
@@ -41,6 +43,9 @@ private:
     std::unique_ptr<Filesystem> m_ioPtr{};
     std::unique_ptr<Audio> m_audioPtr{};
     std::unique_ptr<Renderer> m_rendererPtr{};
+    std::unique_ptr<TextureStreamer> m_textureStreamerPtr{};
+    // BC7 mip chains decoded for devices without BC7 support by path hash, streamed from here
+    std::pmr::map<Hash::value_type, std::pmr::vector<uint8_t>> m_decodedTextures{};
 
     std::mutex m_eventsBottleneck{};
     std::pmr::vector<SDL_Event> m_events{};
@@ -52,11 +57,14 @@ protected:
     Filesystem* m_io = nullptr;
     Audio* m_audio = nullptr;
     Renderer* m_renderer = nullptr;
+    TextureStreamer* m_textureStreamer = nullptr;
 
     ResourceMap<Texture> m_textures{};
     void loadDDS( Asset&& );
 
     ResourceMap<Audio::Slot> m_sounds{};
+    // wav files under music/ are not decoded upfront, they are played with Audio::stream()
+    ResourceMap<std::span<const uint8_t>> m_music{};
     void loadWAV( Asset&& );
 
     ResourceMap<PipelineSlot> m_materials{};
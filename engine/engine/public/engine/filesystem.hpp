@@ -1,10 +1,14 @@
 #pragma once
 
+#include <extra/pak.hpp>
+#include <shared/hash.hpp>
+
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <list>
-#include <map>
 #include <memory_resource>
 #include <mutex>
 #include <vector>
@@ -29,23 +33,93 @@ struct Asset {
 };
 
 class Filesystem {
+public:
+    struct Statistics {
+        uint32_t mounts = 0;
+        // current one and retired ones not reclaimed yet
+        uint32_t snapshots = 0;
+    };
+
 private:
     std::mutex m_bottleneckFs;
     std::mutex m_bottleneckCb;
     struct Mount {
         std::pmr::vector<uint8_t> m_blob{};
-        std::pmr::map<std::pmr::string, std::span<uint8_t>> m_toc{};
+        std::pmr::vector<pak::Entry> m_entries{};
+        // single entry mount of reloaded loose file, dropped once newer reload of same name supersedes it
+        bool m_reload = false;
+        uint32_t m_priority = 0;
     };
     std::pmr::list<Mount> m_mounts{};
+    std::pmr::list<Mount> m_retiredMounts{};
+
+    struct Lookup {
+        Hash::value_type hash = 0;
+        uint32_t priority = 0;
+        std::string_view name{};
+        std::span<const uint8_t> data{};
+    };
+    // Immutable once published, sorted by hash, holds only visible entry of every name.
+    // Back of list is current, retired ones are reclaimed once no reader is in flight.
+    struct Snapshot {
+        std::pmr::vector<Lookup> m_lookup{};
+    };
+    std::pmr::list<Snapshot> m_snapshots{};
+    std::atomic<const Snapshot*> m_snapshot = nullptr;
+
+    // readers in flight, threads are spread over padded slots so lookups do not contend on one cache line
+    struct alignas( 64 ) ReaderSlot {
+        std::atomic<uint32_t> count = 0;
+    };
+    std::array<ReaderSlot, 16> m_readers{};
 
     using Callback = std::function<void( Asset&& )>;
     std::pmr::list<std::pair<std::pmr::string, Callback>> m_callbacks{};
 
+    // changed loose files read by watchers, waiting for processReloads()
+    struct Reload {
+        std::pmr::string name{};
+        uint32_t priority = 0;
+        std::pmr::vector<uint8_t> data{};
+    };
+    std::mutex m_bottleneckReload;
+    std::pmr::vector<Reload> m_reloads{};
+
+    struct Watcher;
+    // no default member initializer, it would require complete Watcher outside of filesystem.cpp
+    std::pmr::list<Watcher> m_watchers;
+
+    void sortByCallback( std::span<uint32_t>, std::span<const pak::Entry> );
+    std::pmr::vector<uint8_t> publish( const Mount&, std::span<const pak::IndexEntry>, std::span<const std::span<uint8_t>>, uint32_t priority );
+    void invokeCallbacks( const Mount&, std::span<const uint32_t>, std::span<const std::span<uint8_t>>, std::span<const uint8_t> published );
+    void queueReload( Reload&& );
+    // current snapshot is not reclaimed until released on same thread
+    const Snapshot* acquireSnapshot();
+    void releaseSnapshot();
+    // requires m_bottleneckFs
+    void reclaim();
+
 public:
     ~Filesystem() noexcept;
     Filesystem() noexcept;
 
-    void mount( const std::filesystem::path& );
+    // Entries of higher priority mount shadow same named entries of lower ones, within same priority
+    // later mount shadows earlier. Shadowed entries are neither read nor passed to callbacks,
+    // entries replacing already visible ones are passed to callbacks again.
+    void mount( const std::filesystem::path&, uint32_t priority = 0 );
+
+    // Development mount, serves files under directory with same naming and shadowing rules as .pak entries.
+    // On Linux the directory is watched for changes, see processReloads().
+    void mountLoose( const std::filesystem::path&, uint32_t priority = 0 );
+
+    // Publishes loose files changed since last call and invokes their callbacks on calling thread.
+    // Data of previous reload of same file is released afterwards, consumers have to re-point in callbacks
+    // and be done reading it before callbacks return, see TextureStreamer::add() and Audio::stop().
+    // Returns number of files reloaded.
+    uint32_t processReloads();
+
+    Statistics statistics();
+
     void setCallback( std::string_view, Callback&& );
     inline void setCallback( std::string_view ext, auto* ptr, auto&& memFn )
     {
@@ -54,6 +128,7 @@ public:
             std::invoke( memFn, ptr, std::forward<decltype(data)>( data ) );
         } );
     }
+    // lock-free
     std::span<const uint8_t> viewWait( std::string_view );
 
 };
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <renderer/texture.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+class Renderer;
+
+// Keeps mip chains of textures partially resident in video memory.
+// Textures are registered with only their mip tail uploaded, finer mips are streamed in when requested
+// and least recently used ones are dropped to stay within memory budget.
+class TextureStreamer {
+public:
+    // mips of at most this extent are uploaded at registration and never evicted
+    static constexpr inline uint32_t TAIL_EXTENT = 64;
+
+    struct Statistics {
+        uint64_t budgetBytes = 0;
+        // bytes of currently uploaded mip chains
+        uint64_t residentBytes = 0;
+        // bytes of mip chains resident once pending uploads complete
+        uint64_t committedBytes = 0;
+        uint64_t uploadedBytes = 0;
+        uint32_t textures = 0;
+        uint32_t fullyResident = 0;
+        uint32_t pendingUploads = 0;
+        uint32_t streamedIn = 0;
+        uint32_t evicted = 0;
+        // requests which could not be satisfied within budget
+        uint32_t overBudget = 0;
+    };
+
+private:
+    struct Entry {
+        Texture texture{};
+        TextureCreateInfo tci{};
+        // DX10 layout: every array layer holds its mip chain, from largest mip
+        std::span<const uint8_t> data{};
+        uint32_t tail = 0;
+        uint32_t resident = 0;
+        uint32_t target = 0;
+        uint32_t wanted = 0;
+        // bumped on reload, reads of previous content are discarded
+        uint32_t generation = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    struct Job {
+        uint32_t entry = 0;
+        uint32_t level = 0;
+        uint32_t generation = 0;
+        TextureCreateInfo tci{};
+        std::span<const uint8_t> data{};
+    };
+
+    struct Ready {
+        uint32_t entry = 0;
+        uint32_t level = 0;
+        uint32_t generation = 0;
+        std::pmr::vector<uint8_t> data{};
+    };
+
+    static constexpr inline uint32_t NO_ENTRY = ~0u;
+
+    Renderer* m_renderer = nullptr;
+
+    mutable std::mutex m_bottleneck{};
+    std::pmr::vector<Entry> m_entries{};
+    std::pmr::map<Texture, uint32_t> m_index{};
+    Statistics m_statistics{};
+    uint64_t m_frame = 1;
+    uint64_t m_uploadLimit = 8ull << 20;
+
+    mutable std::mutex m_bottleneckJobs{};
+    std::condition_variable m_jobsReady{};
+    std::condition_variable m_jobsDone{};
+    std::pmr::vector<Job> m_jobs{};
+    std::pmr::vector<Ready> m_ready{};
+    uint32_t m_jobsInFlight = 0;
+    // entry read by reader thread, data of it is in use until the read completes
+    uint32_t m_jobEntry = NO_ENTRY;
+    bool m_stop = false;
+    std::thread m_reader{};
+
+    void readerThread();
+    void schedule( uint32_t entry );
+    // requires m_bottleneck; drops queued reads of entry and waits for one in flight
+    void drain( uint32_t entry );
+    bool evictFor( uint64_t bytes, uint64_t frame );
+
+public:
+    ~TextureStreamer() noexcept;
+    TextureStreamer( Renderer*, uint64_t budgetBytes ) noexcept;
+
+    // Data has to stay valid until the texture is re-registered or the streamer is destroyed.
+    // Textures without mips are uploaded whole and not streamed.
+    // Re-registering a texture replaces its content and keeps the handle, once it returns
+    // reads of previous data are finished and previous data can be released.
+    [[nodiscard]]
+    Texture add( const TextureCreateInfo&, std::span<const uint8_t> data, Texture reloaded = {} );
+
+    // thread-safe; extent is on screen size in pixels of the largest texture dimension
+    void request( Texture, float extent );
+
+    // game thread, once per frame: applies finished reads, schedules new ones and evicts to fit budget
+    void update();
+
+    // blocks until all scheduled reads are ready for next update()
+    void flush();
+
+    void setBudget( uint64_t bytes );
+    inline void setUploadLimit( uint64_t bytesPerFrame ) { m_uploadLimit = bytesPerFrame; }
+    Statistics statistics() const;
+
+    // first mip level sampled at given on screen extent
+    static uint32_t mipForExtent( const TextureCreateInfo&, float extent );
+    // bytes of mip chain starting at level, all array layers
+    static uint64_t chainBytes( const TextureCreateInfo&, uint32_t level );
+};
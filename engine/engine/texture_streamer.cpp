@@ -0,0 +1,331 @@
+#include <engine/texture_streamer.hpp>
+
+#include <renderer/renderer.hpp>
+
+#include <profiler.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+static uint64_t mipBytes( const TextureCreateInfo& tci, uint32_t level )
+{
+    // same progression as texture upload regions
+    return static_cast<uint64_t>( tci.mip0ByteCount ) >> ( level * 2 );
+}
+
+// bytes preceding level within one array layer
+static uint64_t levelOffset( const TextureCreateInfo& tci, uint32_t level )
+{
+    uint64_t ret = 0;
+    for ( uint32_t i = 0; i < level; ++i ) ret += mipBytes( tci, i );
+    return ret;
+}
+
+static TextureCreateInfo levelInfo( const TextureCreateInfo& tci, uint32_t level )
+{
+    TextureCreateInfo ret = tci;
+    ret.width = std::max( tci.width >> level, 1u );
+    ret.height = std::max( tci.height >> level, 1u );
+    ret.mip0ByteCount = static_cast<uint32_t>( mipBytes( tci, level ) );
+    ret.mips = tci.mips - level;
+    return ret;
+}
+
+static uint32_t tailLevel( const TextureCreateInfo& tci )
+{
+    uint32_t level = 0;
+    while ( level + 1 < tci.mips && std::max( tci.width >> level, tci.height >> level ) > TextureStreamer::TAIL_EXTENT ) ++level;
+    return level;
+}
+
+// mip chain starting at level of every array layer, packed for upload
+static std::pmr::vector<uint8_t> gather( const TextureCreateInfo& tci, std::span<const uint8_t> data, uint32_t level )
+{
+    ZoneScoped;
+    const uint64_t layerBytes = TextureStreamer::chainBytes( tci, 0 ) / tci.array;
+    const uint64_t offset = levelOffset( tci, level );
+    const uint64_t size = layerBytes - offset;
+    std::pmr::vector<uint8_t> ret( size * tci.array );
+    for ( uint32_t i = 0; i < tci.array; ++i ) {
+        std::memcpy( ret.data() + i * size, data.data() + i * layerBytes + offset, size );
+    }
+    return ret;
+}
+
+uint64_t TextureStreamer::chainBytes( const TextureCreateInfo& tci, uint32_t level )
+{
+    uint64_t ret = 0;
+    for ( uint32_t i = level; i < tci.mips; ++i ) ret += mipBytes( tci, i );
+    return ret * tci.array;
+}
+
+uint32_t TextureStreamer::mipForExtent( const TextureCreateInfo& tci, float extent )
+{
+    const uint32_t size = std::max( tci.width, tci.height );
+    uint32_t level = 0;
+    while ( level + 1 < tci.mips && static_cast<float>( size >> ( level + 1 ) ) >= extent ) ++level;
+    return level;
+}
+
+TextureStreamer::~TextureStreamer() noexcept
+{
+    {
+        std::scoped_lock sl{ m_bottleneckJobs };
+        m_stop = true;
+    }
+    m_jobsReady.notify_all();
+    m_reader.join();
+}
+
+TextureStreamer::TextureStreamer( Renderer* renderer, uint64_t budgetBytes ) noexcept
+: m_renderer{ renderer }
+{
+    assert( m_renderer );
+    m_statistics.budgetBytes = budgetBytes;
+    m_reader = std::thread{ &TextureStreamer::readerThread, this };
+}
+
+void TextureStreamer::readerThread()
+{
+    std::unique_lock lock{ m_bottleneckJobs };
+    while ( true ) {
+        m_jobsReady.wait( lock, [this]() { return m_stop || !m_jobs.empty(); } );
+        if ( m_stop ) return;
+        const Job job = m_jobs.front();
+        m_jobs.erase( m_jobs.begin() );
+        m_jobsInFlight++;
+        m_jobEntry = job.entry;
+        lock.unlock();
+
+        Ready ready{
+            .entry = job.entry,
+            .level = job.level,
+            .generation = job.generation,
+            .data = gather( job.tci, job.data, job.level ),
+        };
+
+        lock.lock();
+        m_jobsInFlight--;
+        m_jobEntry = NO_ENTRY;
+        m_ready.emplace_back( std::move( ready ) );
+        m_jobsDone.notify_all();
+    }
+}
+
+Texture TextureStreamer::add( const TextureCreateInfo& tci, std::span<const uint8_t> data, Texture reloaded )
+{
+    ZoneScoped;
+    const bool streamed = tci.mips > 1 && tci.array > 0 && data.size() >= chainBytes( tci, 0 );
+    if ( !streamed ) {
+        if ( reloaded ) {
+            std::scoped_lock sl{ m_bottleneck };
+            // texture stops being streamed, entry stays as tombstone for reads in flight
+            if ( auto it = m_index.find( reloaded ); it != m_index.end() ) {
+                drain( it->second );
+                Entry& entry = m_entries[ it->second ];
+                m_statistics.residentBytes -= chainBytes( entry.tci, entry.resident );
+                m_statistics.committedBytes -= chainBytes( entry.tci, entry.target );
+                m_statistics.textures--;
+                entry = Entry{ .generation = entry.generation + 1 };
+                m_index.erase( it );
+            }
+        }
+        return reloaded ? m_renderer->replaceTexture( reloaded, tci, data ) : m_renderer->createTexture( tci, data );
+    }
+
+    Entry entry{ .tci = tci, .data = data, .tail = tailLevel( tci ) };
+    entry.resident = entry.target = entry.wanted = entry.tail;
+    const auto tail = gather( tci, data, entry.tail );
+    entry.texture = reloaded
+        ? m_renderer->replaceTexture( reloaded, levelInfo( tci, entry.tail ), tail )
+        : m_renderer->createTexture( levelInfo( tci, entry.tail ), tail );
+
+    std::scoped_lock sl{ m_bottleneck };
+    const uint64_t tailBytes = chainBytes( tci, entry.tail );
+    m_statistics.residentBytes += tailBytes;
+    m_statistics.committedBytes += tailBytes;
+    if ( auto it = reloaded ? m_index.find( reloaded ) : m_index.end(); it != m_index.end() ) {
+        const uint32_t idx = it->second;
+        drain( idx );
+        Entry& old = m_entries[ idx ];
+        m_statistics.residentBytes -= chainBytes( old.tci, old.resident );
+        m_statistics.committedBytes -= chainBytes( old.tci, old.target );
+        entry.generation = old.generation + 1;
+        old = entry;
+        m_index.erase( it );
+        m_index.emplace( entry.texture, idx );
+        return entry.texture;
+    }
+    m_index.emplace( entry.texture, static_cast<uint32_t>( m_entries.size() ) );
+    m_entries.emplace_back( entry );
+    m_statistics.textures++;
+    return entry.texture;
+}
+
+void TextureStreamer::drain( uint32_t idx )
+{
+    ZoneScoped;
+    // scheduling takes m_bottleneck which caller holds, no new reads of entry can be queued meanwhile
+    std::unique_lock lock{ m_bottleneckJobs };
+    std::erase_if( m_jobs, [idx]( const Job& job ) { return job.entry == idx; } );
+    m_jobsDone.wait( lock, [this, idx]() { return m_jobEntry != idx; } );
+}
+
+void TextureStreamer::request( Texture texture, float extent )
+{
+    std::scoped_lock sl{ m_bottleneck };
+    auto it = m_index.find( texture );
+    if ( it == m_index.end() ) return;
+    Entry& entry = m_entries[ it->second ];
+    entry.wanted = std::min( entry.wanted, mipForExtent( entry.tci, extent ) );
+    entry.lastUsed = m_frame;
+}
+
+void TextureStreamer::schedule( uint32_t idx )
+{
+    const Entry& entry = m_entries[ idx ];
+    // dropping back to what is already uploaded needs no read, pending reads of other levels get discarded
+    if ( entry.target == entry.resident ) return;
+    {
+        std::scoped_lock sl{ m_bottleneckJobs };
+        m_jobs.emplace_back( Job{
+            .entry = idx,
+            .level = entry.target,
+            .generation = entry.generation,
+            .tci = entry.tci,
+            .data = entry.data,
+        } );
+    }
+    m_jobsReady.notify_one();
+}
+
+// Drops one mip at a time from least recently used textures, then from textures holding finer mips than
+// requested this frame, until bytes fit in budget. Mip tails are never dropped.
+bool TextureStreamer::evictFor( uint64_t bytes, uint64_t frame )
+{
+    while ( m_statistics.committedBytes + bytes > m_statistics.budgetBytes ) {
+        auto victim = m_entries.end();
+        for ( auto it = m_entries.begin(); it != m_entries.end(); ++it ) {
+            if ( !it->texture || it->target >= it->tail ) continue;
+            const bool unused = it->lastUsed < frame;
+            const bool oversized = !unused && it->target < it->wanted;
+            if ( !unused && !oversized ) continue;
+            if ( victim == m_entries.end() ) {
+                victim = it;
+                continue;
+            }
+            const bool victimUnused = victim->lastUsed < frame;
+            if ( unused != victimUnused ) {
+                if ( unused ) victim = it;
+                continue;
+            }
+            if ( it->lastUsed < victim->lastUsed ) victim = it;
+        }
+        if ( victim == m_entries.end() ) return false;
+
+        m_statistics.committedBytes -= chainBytes( victim->tci, victim->target ) - chainBytes( victim->tci, victim->target + 1 );
+        victim->target++;
+        schedule( static_cast<uint32_t>( std::distance( m_entries.begin(), victim ) ) );
+    }
+    return true;
+}
+
+void TextureStreamer::update()
+{
+    ZoneScoped;
+    decltype( m_ready ) ready{};
+    {
+        std::scoped_lock sl{ m_bottleneckJobs };
+        std::swap( ready, m_ready );
+    }
+
+    std::scoped_lock sl{ m_bottleneck };
+    {
+        ZoneScopedN( "upload streamed mips" );
+        uint64_t uploaded = 0;
+        auto it = ready.begin();
+        for ( ; it != ready.end() && uploaded < m_uploadLimit; ++it ) {
+            Entry& entry = m_entries[ it->entry ];
+            // superseded by reload or by later decision
+            if ( it->generation != entry.generation || it->level != entry.target || it->level == entry.resident ) continue;
+            [[maybe_unused]]
+            const Texture texture = m_renderer->replaceTexture( entry.texture, levelInfo( entry.tci, it->level ), it->data );
+            assert( texture == entry.texture );
+            m_statistics.residentBytes += chainBytes( entry.tci, it->level );
+            m_statistics.residentBytes -= chainBytes( entry.tci, entry.resident );
+            if ( it->level < entry.resident ) m_statistics.streamedIn++;
+            else m_statistics.evicted++;
+            entry.resident = it->level;
+            uploaded += it->data.size();
+        }
+        m_statistics.uploadedBytes += uploaded;
+        if ( it != ready.end() ) {
+            // over upload limit, rest waits for next frame
+            std::scoped_lock sl2{ m_bottleneckJobs };
+            m_ready.insert( m_ready.begin(), std::make_move_iterator( it ), std::make_move_iterator( ready.end() ) );
+        }
+    }
+
+    const uint64_t frame = m_frame++;
+    // budget may have been lowered
+    evictFor( 0, frame );
+
+    std::pmr::vector<uint32_t> demand{};
+    for ( uint32_t i = 0; i < m_entries.size(); ++i ) {
+        const Entry& entry = m_entries[ i ];
+        if ( entry.texture && entry.lastUsed == frame && entry.wanted < entry.target ) demand.emplace_back( i );
+    }
+    // most starved first
+    std::ranges::sort( demand, [this]( uint32_t lhs, uint32_t rhs )
+    {
+        const Entry& l = m_entries[ lhs ];
+        const Entry& r = m_entries[ rhs ];
+        const uint32_t dl = l.target - l.wanted;
+        const uint32_t dr = r.target - r.wanted;
+        return dl != dr ? dl > dr : lhs < rhs;
+    } );
+
+    for ( uint32_t i : demand ) {
+        Entry& entry = m_entries[ i ];
+        // finest level which fits, coarser ones are better than nothing
+        uint32_t level = entry.wanted;
+        for ( ; level < entry.target; ++level ) {
+            const uint64_t bytes = chainBytes( entry.tci, level ) - chainBytes( entry.tci, entry.target );
+            if ( evictFor( bytes, frame ) ) {
+                m_statistics.committedBytes += bytes;
+                break;
+            }
+        }
+        if ( level != entry.wanted ) m_statistics.overBudget++;
+        if ( level == entry.target ) continue;
+        entry.target = level;
+        schedule( i );
+    }
+
+    std::ranges::for_each( m_entries, []( Entry& e ) { e.wanted = e.tail; } );
+}
+
+void TextureStreamer::flush()
+{
+    ZoneScoped;
+    std::unique_lock lock{ m_bottleneckJobs };
+    m_jobsDone.wait( lock, [this]() { return m_jobs.empty() && !m_jobsInFlight; } );
+}
+
+void TextureStreamer::setBudget( uint64_t bytes )
+{
+    std::scoped_lock sl{ m_bottleneck };
+    m_statistics.budgetBytes = bytes;
+}
+
+TextureStreamer::Statistics TextureStreamer::statistics() const
+{
+    std::scoped_lock sl{ m_bottleneck, m_bottleneckJobs };
+    Statistics ret = m_statistics;
+    ret.fullyResident = static_cast<uint32_t>( std::ranges::count_if( m_entries, []( const Entry& e ) { return e.texture && e.resident == 0; } ) );
+    ret.pendingUploads = static_cast<uint32_t>( m_jobs.size() + m_ready.size() + m_jobsInFlight );
+    return ret;
+}
@@ -0,0 +1,1040 @@
+#include <extra/bcn.hpp>
+#include <extra/parallel.hpp>
+
+#include <profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace bcn {
+
+namespace {
+
+using RGB = std::array<uint8_t, 3>;
+using Vec3 = std::array<float, 3>;
+using Block = std::array<RGB, 16>;
+
+struct B5G6R5 {
+    uint16_t b : 5;
+    uint16_t g : 6;
+    uint16_t r : 5;
+};
+
+}
+
+// perceptual weights of squared error, rgb order
+static constexpr Vec3 METRIC{ 0.2126f, 0.7152f, 0.0722f };
+static constexpr uint32_t MAX_ITERATIONS = 4;
+
+static inline Vec3 operator * ( const Vec3& a, const Vec3& b ) noexcept { return { a[ 0 ] * b[ 0 ], a[ 1 ] * b[ 1 ], a[ 2 ] * b[ 2 ] }; }
+static inline Vec3 operator * ( const Vec3& a, float b ) noexcept { return { a[ 0 ] * b, a[ 1 ] * b, a[ 2 ] * b }; }
+static inline Vec3 operator + ( const Vec3& a, const Vec3& b ) noexcept { return { a[ 0 ] + b[ 0 ], a[ 1 ] + b[ 1 ], a[ 2 ] + b[ 2 ] }; }
+static inline Vec3 operator - ( const Vec3& a, const Vec3& b ) noexcept { return { a[ 0 ] - b[ 0 ], a[ 1 ] - b[ 1 ], a[ 2 ] - b[ 2 ] }; }
+static inline float dot( const Vec3& a, const Vec3& b ) noexcept { return a[ 0 ] * b[ 0 ] + a[ 1 ] * b[ 1 ] + a[ 2 ] * b[ 2 ]; }
+
+static inline uint8_t expand5( uint32_t v ) noexcept { return static_cast<uint8_t>( ( v << 3 ) | ( v >> 2 ) ); }
+static inline uint8_t expand6( uint32_t v ) noexcept { return static_cast<uint8_t>( ( v << 2 ) | ( v >> 4 ) ); }
+
+static inline RGB unpack565( uint16_t c ) noexcept
+{
+    return { expand5( c >> 11u ), expand6( ( c >> 5u ) & 0x3Fu ), expand5( c & 0x1Fu ) };
+}
+
+// color0 > color1 selects 4 color mode, otherwise 3 colors and transparent black
+static std::array<RGB, 4> palette( uint16_t color0, uint16_t color1 ) noexcept
+{
+    const RGB a = unpack565( color0 );
+    const RGB b = unpack565( color1 );
+    std::array<RGB, 4> ret{ a, b };
+    for ( uint32_t c = 0; c < 3; ++c ) {
+        if ( color0 > color1 ) {
+            ret[ 2 ][ c ] = static_cast<uint8_t>( ( 2u * a[ c ] + b[ c ] + 1u ) / 3u );
+            ret[ 3 ][ c ] = static_cast<uint8_t>( ( a[ c ] + 2u * b[ c ] + 1u ) / 3u );
+        }
+        else {
+            ret[ 2 ][ c ] = static_cast<uint8_t>( ( a[ c ] + b[ c ] + 1u ) / 2u );
+        }
+    }
+    return ret;
+}
+
+template <size_t TWeight>
+static inline uint8_t lerp( uint16_t e0, uint16_t e1 )
+{
+    static_assert( TWeight <= 64 );
+    return static_cast<uint8_t>( ( ( 64 - TWeight ) * e0 + TWeight * e1 + 32 ) >> 6 );
+}
+
+template <size_t TWeight>
+static inline B5G6R5 lerp( B5G6R5 a, B5G6R5 b )
+{
+    return {
+        .b = lerp<TWeight>( a.b, b.b ),
+        .g = lerp<TWeight>( a.g, b.g ),
+        .r = lerp<TWeight>( a.r, b.r ),
+    };
+}
+
+static inline uint16_t magnitude( B5G6R5 a )
+{
+    return static_cast<uint16_t>( a.b * a.b + a.g * a.g + a.r * a.r );
+}
+
+static BC1 encodeFast( const Block& block )
+{
+    std::array<B5G6R5, 16> colors{};
+    std::ranges::transform( block, colors.begin(), []( const RGB& c ) -> B5G6R5
+    {
+        return {
+            .b = static_cast<uint16_t>( c[ 2 ] >> 3 ),
+            .g = static_cast<uint16_t>( c[ 1 ] >> 2 ),
+            .r = static_cast<uint16_t>( c[ 0 ] >> 3 ),
+        };
+    } );
+    std::array<uint16_t, 16> dots;
+    std::ranges::transform( colors, dots.begin(), &magnitude );
+    auto [ min, max ] = std::ranges::minmax_element( dots );
+
+    auto pack = []( B5G6R5 c ) { return static_cast<uint16_t>( ( c.r << 11u ) | ( c.g << 5u ) | c.b ); };
+    BC1 ret{
+        .color0 = pack( colors[ static_cast<size_t>( std::distance( dots.begin(), max ) ) ] ),
+        .color1 = pack( colors[ static_cast<size_t>( std::distance( dots.begin(), min ) ) ] ),
+    };
+    if ( ret.color0 < ret.color1 ) std::swap( ret.color0, ret.color1 );
+
+    auto unpack = []( uint16_t c ) -> B5G6R5
+    {
+        return { .b = static_cast<uint16_t>( c & 0x1Fu ), .g = static_cast<uint16_t>( ( c >> 5u ) & 0x3Fu ), .r = static_cast<uint16_t>( c >> 11u ) };
+    };
+    const B5G6R5 c0 = unpack( ret.color0 );
+    const B5G6R5 c1 = unpack( ret.color1 );
+    const std::array<uint16_t, 4> lut{
+        magnitude( c0 ),
+        magnitude( c1 ),
+        magnitude( lerp<42>( c1, c0 ) ),
+        magnitude( lerp<21>( c1, c0 ) ),
+    };
+    auto nearestIndice = [&lut]( uint16_t ref ) -> uint8_t
+    {
+        int dist = 0xFFFF;
+        uint8_t indice = 0;
+        for ( uint8_t i = 0; i < lut.size(); ++i ) {
+            int d = std::abs( (int)ref - (int)lut[ i ] );
+            if ( d == 0 ) return i;
+            if ( d >= dist ) continue;
+            dist = d;
+            indice = i;
+        }
+        return indice;
+    };
+
+    for ( auto it = dots.rbegin(); it != dots.rend(); ++it ) {
+        ret.indices <<= 2;
+        ret.indices |= nearestIndice( *it );
+    }
+    return ret;
+}
+
+// endpoint in metric space snapped to representable 565 color
+static inline Vec3 snap( const Vec3& v, const Vec3& scale, uint16_t& packed ) noexcept
+{
+    auto q = []( float x, float s, uint32_t max )
+    {
+        return static_cast<uint32_t>( std::lround( std::clamp( x / s, 0.0f, 255.0f ) * static_cast<float>( max ) / 255.0f ) );
+    };
+    const uint32_t r = q( v[ 0 ], scale[ 0 ], 31 );
+    const uint32_t g = q( v[ 1 ], scale[ 1 ], 63 );
+    const uint32_t b = q( v[ 2 ], scale[ 2 ], 31 );
+    packed = static_cast<uint16_t>( ( r << 11u ) | ( g << 5u ) | b );
+    return Vec3{ static_cast<float>( expand5( r ) ), static_cast<float>( expand6( g ) ), static_cast<float>( expand5( b ) ) } * scale;
+}
+
+// principal axis of weighted points by power iteration over covariance
+static Vec3 principalAxis( std::span<const Vec3> points, std::span<const float> weights ) noexcept
+{
+    Vec3 centroid{};
+    float total = 0.0f;
+    for ( size_t i = 0; i < points.size(); ++i ) {
+        centroid = centroid + points[ i ] * weights[ i ];
+        total += weights[ i ];
+    }
+    centroid = centroid * ( 1.0f / total );
+
+    std::array<float, 6> cov{};
+    for ( size_t i = 0; i < points.size(); ++i ) {
+        const Vec3 d = points[ i ] - centroid;
+        cov[ 0 ] += weights[ i ] * d[ 0 ] * d[ 0 ];
+        cov[ 1 ] += weights[ i ] * d[ 0 ] * d[ 1 ];
+        cov[ 2 ] += weights[ i ] * d[ 0 ] * d[ 2 ];
+        cov[ 3 ] += weights[ i ] * d[ 1 ] * d[ 1 ];
+        cov[ 4 ] += weights[ i ] * d[ 1 ] * d[ 2 ];
+        cov[ 5 ] += weights[ i ] * d[ 2 ] * d[ 2 ];
+    }
+    Vec3 axis{ 1.0f, 1.0f, 1.0f };
+    for ( uint32_t i = 0; i < 8; ++i ) {
+        axis = Vec3{
+            cov[ 0 ] * axis[ 0 ] + cov[ 1 ] * axis[ 1 ] + cov[ 2 ] * axis[ 2 ],
+            cov[ 1 ] * axis[ 0 ] + cov[ 3 ] * axis[ 1 ] + cov[ 4 ] * axis[ 2 ],
+            cov[ 2 ] * axis[ 0 ] + cov[ 4 ] * axis[ 1 ] + cov[ 5 ] * axis[ 2 ],
+        };
+        const float len = std::max( { std::abs( axis[ 0 ] ), std::abs( axis[ 1 ] ), std::abs( axis[ 2 ] ) } );
+        if ( len <= 0.0f ) return Vec3{ 1.0f, 1.0f, 1.0f };
+        axis = axis * ( 1.0f / len );
+    }
+    return axis;
+}
+
+// Cluster fit as in Simon Brown's squish: points ordered along axis are split into 4 ordered clusters,
+// endpoints of every split are least squares solved and snapped to 565, best split refines axis.
+static BC1 encodeHigh( const Block& block )
+{
+    const Vec3 scale{ std::sqrt( METRIC[ 0 ] ), std::sqrt( METRIC[ 1 ] ), std::sqrt( METRIC[ 2 ] ) };
+    auto toMetric = [&scale]( const RGB& c )
+    {
+        return Vec3{ static_cast<float>( c[ 0 ] ), static_cast<float>( c[ 1 ] ), static_cast<float>( c[ 2 ] ) } * scale;
+    };
+
+    std::array<Vec3, 16> points{};
+    std::array<float, 16> weights{};
+    uint32_t count = 0;
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        const auto same = std::find( block.begin(), block.begin() + i, block[ i ] );
+        if ( same != block.begin() + i ) {
+            const Vec3 p = toMetric( *same );
+            weights[ static_cast<size_t>( std::distance( points.begin(), std::find( points.begin(), points.begin() + count, p ) ) ) ] += 1.0f;
+            continue;
+        }
+        points[ count ] = toMetric( block[ i ] );
+        weights[ count++ ] = 1.0f;
+    }
+
+    BC1 ret{};
+    if ( count == 1 ) {
+        snap( points[ 0 ], scale, ret.color0 );
+        ret.color1 = ret.color0;
+        return ret;
+    }
+
+    Vec3 axis = principalAxis( std::span{ points.data(), count }, std::span{ weights.data(), count } );
+    std::array<uint8_t, 16> order{};
+    std::array<uint8_t, 16> lastOrder{};
+    float bestError = std::numeric_limits<float>::max();
+    uint16_t best0 = 0;
+    uint16_t best1 = 0;
+    Vec3 bestA{};
+    Vec3 bestB{};
+    for ( uint32_t iteration = 0; iteration < MAX_ITERATIONS; ++iteration ) {
+        std::array<float, 16> projection{};
+        for ( uint32_t i = 0; i < count; ++i ) {
+            order[ i ] = static_cast<uint8_t>( i );
+            projection[ i ] = dot( points[ i ], axis );
+        }
+        std::sort( order.begin(), order.begin() + count, [&projection]( uint8_t a, uint8_t b ) { return projection[ a ] < projection[ b ]; } );
+        if ( iteration && std::equal( order.begin(), order.begin() + count, lastOrder.begin() ) ) break;
+        lastOrder = order;
+
+        std::array<float, 17> prefixW{};
+        std::array<Vec3, 17> prefixX{};
+        for ( uint32_t i = 0; i < count; ++i ) {
+            const float w = weights[ order[ i ] ];
+            prefixW[ i + 1 ] = prefixW[ i ] + w;
+            prefixX[ i + 1 ] = prefixX[ i ] + points[ order[ i ] ] * w;
+        }
+
+        const float improvedFrom = bestError;
+        for ( uint32_t i = 0; i <= count; ++i ) {
+            for ( uint32_t j = i; j <= count; ++j ) {
+                for ( uint32_t k = j; k <= count; ++k ) {
+                    const float w0 = prefixW[ i ];
+                    const float w1 = prefixW[ j ] - prefixW[ i ];
+                    const float w2 = prefixW[ k ] - prefixW[ j ];
+                    const float w3 = prefixW[ count ] - prefixW[ k ];
+                    const Vec3 x0 = prefixX[ i ];
+                    const Vec3 x1 = prefixX[ j ] - prefixX[ i ];
+                    const Vec3 x2 = prefixX[ k ] - prefixX[ j ];
+                    const Vec3 x3 = prefixX[ count ] - prefixX[ k ];
+
+                    const float alpha2 = w0 + w1 * ( 4.0f / 9.0f ) + w2 * ( 1.0f / 9.0f );
+                    const float beta2 = w3 + w1 * ( 1.0f / 9.0f ) + w2 * ( 4.0f / 9.0f );
+                    const float alphaBeta = ( w1 + w2 ) * ( 2.0f / 9.0f );
+                    const float det = alpha2 * beta2 - alphaBeta * alphaBeta;
+                    if ( det < 1e-6f ) continue;
+                    const Vec3 alphaX = x0 + x1 * ( 2.0f / 3.0f ) + x2 * ( 1.0f / 3.0f );
+                    const Vec3 betaX = x3 + x1 * ( 1.0f / 3.0f ) + x2 * ( 2.0f / 3.0f );
+                    const float factor = 1.0f / det;
+                    uint16_t c0 = 0;
+                    uint16_t c1 = 0;
+                    const Vec3 a = snap( ( alphaX * beta2 - betaX * alphaBeta ) * factor, scale, c0 );
+                    const Vec3 b = snap( ( betaX * alpha2 - alphaX * alphaBeta ) * factor, scale, c1 );
+
+                    // squared error without constant sum of x^2
+                    const Vec3 e = a * a * alpha2 + b * b * beta2 + ( a * b * alphaBeta - a * alphaX - b * betaX ) * 2.0f;
+                    const float error = e[ 0 ] + e[ 1 ] + e[ 2 ];
+                    if ( error >= bestError ) continue;
+                    bestError = error;
+                    best0 = c0;
+                    best1 = c1;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+        if ( bestError >= improvedFrom ) break;
+        const Vec3 next = bestB - bestA;
+        if ( dot( next, next ) <= 0.0f ) break;
+        axis = next;
+    }
+
+    ret.color0 = std::max( best0, best1 );
+    ret.color1 = std::min( best0, best1 );
+    if ( ret.color0 == ret.color1 ) return ret;
+
+    const std::array<RGB, 4> colors = palette( ret.color0, ret.color1 );
+    std::array<Vec3, 4> lut{};
+    std::ranges::transform( colors, lut.begin(), toMetric );
+    for ( auto it = block.rbegin(); it != block.rend(); ++it ) {
+        const Vec3 p = toMetric( *it );
+        uint32_t indice = 0;
+        float dist = std::numeric_limits<float>::max();
+        for ( uint32_t i = 0; i < 4; ++i ) {
+            const Vec3 d = p - lut[ i ];
+            const float e = dot( d, d );
+            if ( e >= dist ) continue;
+            dist = e;
+            indice = i;
+        }
+        ret.indices <<= 2;
+        ret.indices |= indice;
+    }
+    return ret;
+}
+
+std::pmr::vector<BC1> compressBC1( std::span<const uint8_t> pixels, uint32_t width, uint32_t height, Quality quality, uint32_t threadCount )
+{
+    ZoneScoped;
+    assert( width % 4 == 0 );
+    assert( height % 4 == 0 );
+    assert( pixels.size() == static_cast<size_t>( width ) * height * 4 );
+    const uint32_t blocksInRow = width / 4;
+    const uint32_t blockRows = height / 4;
+    std::pmr::vector<BC1> ret( static_cast<size_t>( blocksInRow ) * blockRows );
+
+    parallel::forEach( blockRows, parallel::threadCount( threadCount ), [&]( size_t row, uint32_t )
+    {
+        for ( uint32_t col = 0; col < blocksInRow; ++col ) {
+            Block block{};
+            for ( uint32_t i = 0; i < 16; ++i ) {
+                const size_t x = col * 4 + ( i & 3u );
+                const size_t y = row * 4 + ( i >> 2u );
+                const uint8_t* px = pixels.data() + ( y * width + x ) * 4;
+                block[ i ] = RGB{ px[ 2 ], px[ 1 ], px[ 0 ] };
+            }
+            ret[ row * blocksInRow + col ] = quality == Quality::eHigh ? encodeHigh( block ) : encodeFast( block );
+        }
+    } );
+    return ret;
+}
+
+std::pmr::vector<uint8_t> decompressBC1( std::span<const BC1> blocks, uint32_t width, uint32_t height )
+{
+    assert( width % 4 == 0 );
+    assert( height % 4 == 0 );
+    const uint32_t blocksInRow = width / 4;
+    assert( blocks.size() == static_cast<size_t>( blocksInRow ) * ( height / 4 ) );
+    std::pmr::vector<uint8_t> ret( static_cast<size_t>( width ) * height * 4 );
+    for ( size_t b = 0; b < blocks.size(); ++b ) {
+        const std::array<RGB, 4> colors = palette( blocks[ b ].color0, blocks[ b ].color1 );
+        const bool transparent = blocks[ b ].color0 <= blocks[ b ].color1;
+        for ( uint32_t i = 0; i < 16; ++i ) {
+            const uint32_t indice = ( blocks[ b ].indices >> ( i * 2 ) ) & 3u;
+            const size_t x = ( b % blocksInRow ) * 4 + ( i & 3u );
+            const size_t y = ( b / blocksInRow ) * 4 + ( i >> 2u );
+            uint8_t* px = ret.data() + ( y * width + x ) * 4;
+            px[ 0 ] = colors[ indice ][ 2 ];
+            px[ 1 ] = colors[ indice ][ 1 ];
+            px[ 2 ] = colors[ indice ][ 0 ];
+            px[ 3 ] = transparent && indice == 3 ? 0x00 : 0xFF;
+        }
+    }
+    return ret;
+}
+
+static std::array<uint8_t, 8> paletteBC4( uint8_t red0, uint8_t red1 ) noexcept
+{
+    std::array<uint8_t, 8> ret{ red0, red1 };
+    if ( red0 > red1 ) {
+        for ( uint32_t i = 2; i < 8; ++i ) {
+            ret[ i ] = static_cast<uint8_t>( ( ( 8u - i ) * red0 + ( i - 1u ) * red1 + 3u ) / 7u );
+        }
+        return ret;
+    }
+    for ( uint32_t i = 2; i < 6; ++i ) {
+        ret[ i ] = static_cast<uint8_t>( ( ( 6u - i ) * red0 + ( i - 1u ) * red1 + 2u ) / 5u );
+    }
+    ret[ 6 ] = 0x00;
+    ret[ 7 ] = 0xFF;
+    return ret;
+}
+
+// 8 level mode spanning block range
+static BC4 encodeBC4( const std::array<uint8_t, 16>& values ) noexcept
+{
+    const auto [ min, max ] = std::ranges::minmax( values );
+    BC4 ret{ .red0 = max, .red1 = min };
+    if ( min == max ) return ret;
+
+    const std::array<uint8_t, 8> levels = paletteBC4( max, min );
+    uint64_t indices = 0;
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        uint32_t indice = 0;
+        int dist = 0xFFFF;
+        for ( uint32_t j = 0; j < 8; ++j ) {
+            const int d = std::abs( (int)values[ i ] - (int)levels[ j ] );
+            if ( d >= dist ) continue;
+            dist = d;
+            indice = j;
+        }
+        indices |= static_cast<uint64_t>( indice ) << ( i * 3 );
+    }
+    for ( uint32_t i = 0; i < 6; ++i ) {
+        ret.indices[ i ] = static_cast<uint8_t>( indices >> ( i * 8 ) );
+    }
+    return ret;
+}
+
+static std::array<uint8_t, 16> decodeBC4( const BC4& block ) noexcept
+{
+    const std::array<uint8_t, 8> levels = paletteBC4( block.red0, block.red1 );
+    uint64_t indices = 0;
+    for ( uint32_t i = 0; i < 6; ++i ) {
+        indices |= static_cast<uint64_t>( block.indices[ i ] ) << ( i * 8 );
+    }
+    std::array<uint8_t, 16> ret{};
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        ret[ i ] = levels[ ( indices >> ( i * 3 ) ) & 7u ];
+    }
+    return ret;
+}
+
+std::pmr::vector<BC5> compressBC5( std::span<const uint8_t> pixels, uint32_t width, uint32_t height, uint32_t threadCount )
+{
+    ZoneScoped;
+    assert( width % 4 == 0 );
+    assert( height % 4 == 0 );
+    assert( pixels.size() == static_cast<size_t>( width ) * height * 4 );
+    const uint32_t blocksInRow = width / 4;
+    const uint32_t blockRows = height / 4;
+    std::pmr::vector<BC5> ret( static_cast<size_t>( blocksInRow ) * blockRows );
+
+    parallel::forEach( blockRows, parallel::threadCount( threadCount ), [&]( size_t row, uint32_t )
+    {
+        for ( uint32_t col = 0; col < blocksInRow; ++col ) {
+            std::array<uint8_t, 16> red{};
+            std::array<uint8_t, 16> green{};
+            for ( uint32_t i = 0; i < 16; ++i ) {
+                const size_t x = col * 4 + ( i & 3u );
+                const size_t y = row * 4 + ( i >> 2u );
+                const uint8_t* px = pixels.data() + ( y * width + x ) * 4;
+                red[ i ] = px[ 2 ];
+                green[ i ] = px[ 1 ];
+            }
+            ret[ row * blocksInRow + col ] = BC5{ .red = encodeBC4( red ), .green = encodeBC4( green ) };
+        }
+    } );
+    return ret;
+}
+
+std::pmr::vector<uint8_t> decompressBC5( std::span<const BC5> blocks, uint32_t width, uint32_t height )
+{
+    assert( width % 4 == 0 );
+    assert( height % 4 == 0 );
+    const uint32_t blocksInRow = width / 4;
+    assert( blocks.size() == static_cast<size_t>( blocksInRow ) * ( height / 4 ) );
+    std::pmr::vector<uint8_t> ret( static_cast<size_t>( width ) * height * 4 );
+    for ( size_t b = 0; b < blocks.size(); ++b ) {
+        const std::array<uint8_t, 16> red = decodeBC4( blocks[ b ].red );
+        const std::array<uint8_t, 16> green = decodeBC4( blocks[ b ].green );
+        for ( uint32_t i = 0; i < 16; ++i ) {
+            const size_t x = ( b % blocksInRow ) * 4 + ( i & 3u );
+            const size_t y = ( b / blocksInRow ) * 4 + ( i >> 2u );
+            uint8_t* px = ret.data() + ( y * width + x ) * 4;
+            px[ 0 ] = 0x00;
+            px[ 1 ] = green[ i ];
+            px[ 2 ] = red[ i ];
+            px[ 3 ] = 0xFF;
+        }
+    }
+    return ret;
+}
+
+namespace {
+
+using RGBA = std::array<uint8_t, 4>;
+using Vec4 = std::array<float, 4>;
+using BlockRGBA = std::array<RGBA, 16>;
+
+struct ModeInfo {
+    uint8_t subsets = 0;
+    uint8_t partitionBits = 0;
+    uint8_t rotationBits = 0;
+    uint8_t indexSelectionBits = 0;
+    uint8_t colorBits = 0;
+    uint8_t alphaBits = 0;
+    uint8_t endpointPBits = 0;
+    uint8_t sharedPBits = 0;
+    uint8_t indexBits = 0;
+    uint8_t index2Bits = 0;
+};
+
+struct BitWriter {
+    BC7 block{};
+    uint32_t offset = 0;
+
+    void operator () ( uint32_t value, uint32_t count ) noexcept
+    {
+        for ( uint32_t i = 0; i < count; ++i, ++offset ) {
+            assert( offset < 128 );
+            block.bits[ offset >> 6u ] |= static_cast<uint64_t>( ( value >> i ) & 1u ) << ( offset & 63u );
+        }
+    }
+};
+
+struct BitReader {
+    const BC7& block;
+    uint32_t offset = 0;
+
+    uint32_t operator () ( uint32_t count ) noexcept
+    {
+        uint32_t ret = 0;
+        for ( uint32_t i = 0; i < count; ++i, ++offset ) {
+            assert( offset < 128 );
+            ret |= static_cast<uint32_t>( ( block.bits[ offset >> 6u ] >> ( offset & 63u ) ) & 1u ) << i;
+        }
+        return ret;
+    }
+};
+
+// quantized endpoints without p-bits and the error of their best indices
+struct SubsetFit {
+    std::array<RGBA, 2> endpoints{};
+    std::array<uint8_t, 2> pbits{};
+    uint32_t error = std::numeric_limits<uint32_t>::max();
+};
+
+}
+
+static constexpr std::array<ModeInfo, 8> BC7_MODES{
+    ModeInfo{ .subsets = 3, .partitionBits = 4, .colorBits = 4, .endpointPBits = 1, .indexBits = 3 },
+    ModeInfo{ .subsets = 2, .partitionBits = 6, .colorBits = 6, .sharedPBits = 1, .indexBits = 3 },
+    ModeInfo{ .subsets = 3, .partitionBits = 6, .colorBits = 5, .indexBits = 2 },
+    ModeInfo{ .subsets = 2, .partitionBits = 6, .colorBits = 7, .endpointPBits = 1, .indexBits = 2 },
+    ModeInfo{ .subsets = 1, .rotationBits = 2, .indexSelectionBits = 1, .colorBits = 5, .alphaBits = 6, .indexBits = 2, .index2Bits = 3 },
+    ModeInfo{ .subsets = 1, .rotationBits = 2, .colorBits = 7, .alphaBits = 8, .indexBits = 2, .index2Bits = 2 },
+    ModeInfo{ .subsets = 1, .colorBits = 7, .alphaBits = 7, .endpointPBits = 1, .indexBits = 4 },
+    ModeInfo{ .subsets = 2, .partitionBits = 6, .colorBits = 5, .alphaBits = 5, .endpointPBits = 1, .indexBits = 2 },
+};
+
+static constexpr std::array<uint8_t, 4> BC7_WEIGHTS2{ 0, 21, 43, 64 };
+static constexpr std::array<uint8_t, 8> BC7_WEIGHTS3{ 0, 9, 18, 27, 37, 46, 55, 64 };
+static constexpr std::array<uint8_t, 16> BC7_WEIGHTS4{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// bit i is subset of pixel i
+static constexpr std::array<uint16_t, 64> BC7_PARTITIONS2{
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// anchor pixel of second subset, first subset is always anchored at pixel 0
+static constexpr std::array<uint8_t, 64> BC7_ANCHORS2{
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+    15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+    6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15,
+};
+
+static constexpr uint32_t BC7_CANDIDATE_PARTITIONS = 4;
+
+static inline std::span<const uint8_t> weightsBC7( uint32_t indexBits ) noexcept
+{
+    switch ( indexBits ) {
+    case 2: return BC7_WEIGHTS2;
+    case 3: return BC7_WEIGHTS3;
+    default:
+        assert( indexBits == 4 );
+        return BC7_WEIGHTS4;
+    }
+}
+
+static inline uint8_t interpolateBC7( uint32_t e0, uint32_t e1, uint32_t weight ) noexcept
+{
+    return static_cast<uint8_t>( ( ( 64u - weight ) * e0 + weight * e1 + 32u ) >> 6u );
+}
+
+// bits include p-bit
+static inline uint8_t expandBC7( uint32_t value, uint32_t bits ) noexcept
+{
+    return static_cast<uint8_t>( bits >= 8 ? value : ( value << ( 8u - bits ) ) | ( value >> ( 2u * bits - 8u ) ) );
+}
+
+static inline uint8_t quantizeBC7( float value, uint32_t pbit, uint32_t colorBits ) noexcept
+{
+    const float target = value * static_cast<float>( ( 2u << colorBits ) - 1u ) / 255.0f;
+    const long q = std::lround( ( target - static_cast<float>( pbit ) ) * 0.5f );
+    return static_cast<uint8_t>( std::clamp<long>( q, 0, ( 1l << colorBits ) - 1 ) );
+}
+
+static inline RGBA unquantizeBC7( const RGBA& q, uint32_t pbit, uint32_t colorBits ) noexcept
+{
+    RGBA ret{};
+    for ( uint32_t c = 0; c < 4; ++c ) {
+        ret[ c ] = expandBC7( ( static_cast<uint32_t>( q[ c ] ) << 1u ) | pbit, colorBits + 1u );
+    }
+    return ret;
+}
+
+// indices of subset pixels to nearest palette entry, returns squared error
+static uint32_t assignBC7( const BlockRGBA& block, uint16_t subset, uint32_t channels, uint32_t indexBits
+    , const RGBA& e0, const RGBA& e1, std::array<uint8_t, 16>& indices ) noexcept
+{
+    const std::span<const uint8_t> weights = weightsBC7( indexBits );
+    std::array<RGBA, 16> palette{};
+    for ( size_t i = 0; i < weights.size(); ++i ) {
+        for ( uint32_t c = 0; c < 4; ++c ) {
+            palette[ i ][ c ] = interpolateBC7( e0[ c ], e1[ c ], weights[ i ] );
+        }
+    }
+    uint32_t error = 0;
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        if ( !( subset & ( 1u << i ) ) ) continue;
+        uint32_t dist = std::numeric_limits<uint32_t>::max();
+        for ( uint32_t j = 0; j < weights.size(); ++j ) {
+            uint32_t e = 0;
+            for ( uint32_t c = 0; c < channels; ++c ) {
+                const int d = (int)block[ i ][ c ] - (int)palette[ j ][ c ];
+                e += static_cast<uint32_t>( d * d );
+            }
+            if ( e >= dist ) continue;
+            dist = e;
+            indices[ i ] = static_cast<uint8_t>( j );
+        }
+        error += dist;
+    }
+    return error;
+}
+
+// mean and principal axis of rgb or rgba subset pixels, axis is zero when all pixels are equal
+static void principalAxisBC7( const BlockRGBA& block, uint16_t subset, uint32_t channels, Vec4& mean, Vec4& axis, std::array<float, 16>& cov ) noexcept
+{
+    mean = Vec4{};
+    float count = 0.0f;
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        if ( !( subset & ( 1u << i ) ) ) continue;
+        for ( uint32_t c = 0; c < channels; ++c ) mean[ c ] += block[ i ][ c ];
+        count += 1.0f;
+    }
+    for ( float& m : mean ) m /= count;
+
+    cov = std::array<float, 16>{};
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        if ( !( subset & ( 1u << i ) ) ) continue;
+        for ( uint32_t a = 0; a < channels; ++a ) {
+            for ( uint32_t b = 0; b < channels; ++b ) {
+                cov[ a * 4 + b ] += ( block[ i ][ a ] - mean[ a ] ) * ( block[ i ][ b ] - mean[ b ] );
+            }
+        }
+    }
+    axis = Vec4{ 1.0f, 1.0f, 1.0f, 1.0f };
+    for ( uint32_t iteration = 0; iteration < 8; ++iteration ) {
+        Vec4 next{};
+        for ( uint32_t a = 0; a < channels; ++a ) {
+            for ( uint32_t b = 0; b < channels; ++b ) next[ a ] += cov[ a * 4 + b ] * axis[ b ];
+        }
+        float len = 0.0f;
+        for ( float v : next ) len = std::max( len, std::abs( v ) );
+        if ( len <= 0.0f ) {
+            axis = Vec4{};
+            return;
+        }
+        for ( uint32_t c = 0; c < 4; ++c ) axis[ c ] = next[ c ] / len;
+    }
+}
+
+// squared rgb distance of subset pixels to their principal axis
+static float residualBC7( const BlockRGBA& block, uint16_t subset ) noexcept
+{
+    Vec4 mean{};
+    Vec4 axis{};
+    std::array<float, 16> cov{};
+    principalAxisBC7( block, subset, 3, mean, axis, cov );
+    const float variance = cov[ 0 ] + cov[ 5 ] + cov[ 10 ];
+    float len2 = 0.0f;
+    float along = 0.0f;
+    for ( uint32_t a = 0; a < 3; ++a ) {
+        len2 += axis[ a ] * axis[ a ];
+        for ( uint32_t b = 0; b < 3; ++b ) along += axis[ a ] * cov[ a * 4 + b ] * axis[ b ];
+    }
+    return len2 > 0.0f ? variance - along / len2 : variance;
+}
+
+// Principal axis end points of subset, quantized with the best p-bits and refined by least squares over assigned indices.
+static SubsetFit fitSubsetBC7( const BlockRGBA& block, uint16_t subset, const ModeInfo& mode, uint32_t refinements, std::array<uint8_t, 16>& indices ) noexcept
+{
+    const uint32_t channels = mode.alphaBits ? 4 : 3;
+    Vec4 mean{};
+    Vec4 axis{};
+    std::array<float, 16> cov{};
+    principalAxisBC7( block, subset, channels, mean, axis, cov );
+
+    float minProjection = 0.0f;
+    float maxProjection = 0.0f;
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        if ( !( subset & ( 1u << i ) ) ) continue;
+        float p = 0.0f;
+        for ( uint32_t c = 0; c < channels; ++c ) p += ( block[ i ][ c ] - mean[ c ] ) * axis[ c ];
+        minProjection = std::min( minProjection, p );
+        maxProjection = std::max( maxProjection, p );
+    }
+    float len2 = 0.0f;
+    for ( float v : axis ) len2 += v * v;
+    Vec4 lo = mean;
+    Vec4 hi = mean;
+    if ( len2 > 0.0f ) {
+        for ( uint32_t c = 0; c < channels; ++c ) {
+            lo[ c ] += axis[ c ] * minProjection / len2;
+            hi[ c ] += axis[ c ] * maxProjection / len2;
+        }
+    }
+
+    // opaque stays exactly opaque only with both p-bits set
+    bool opaque = channels == 4;
+    for ( uint32_t i = 0; i < 16 && opaque; ++i ) {
+        opaque = !( subset & ( 1u << i ) ) || block[ i ][ 3 ] == 0xFF;
+    }
+    const uint32_t pbitCombinations = mode.endpointPBits ? 4 : 2;
+    const std::span<const uint8_t> weights = weightsBC7( mode.indexBits );
+    SubsetFit best{};
+    std::array<uint8_t, 16> candidate{};
+    for ( uint32_t iteration = 0; iteration <= refinements; ++iteration ) {
+        for ( uint32_t p = opaque ? pbitCombinations - 1 : 0; p < pbitCombinations; ++p ) {
+            SubsetFit fit{};
+            fit.pbits = mode.endpointPBits
+                ? std::array<uint8_t, 2>{ static_cast<uint8_t>( p & 1u ), static_cast<uint8_t>( p >> 1u ) }
+                : std::array<uint8_t, 2>{ static_cast<uint8_t>( p ), static_cast<uint8_t>( p ) };
+            for ( uint32_t c = 0; c < 4; ++c ) {
+                fit.endpoints[ 0 ][ c ] = quantizeBC7( c < channels ? lo[ c ] : 255.0f, fit.pbits[ 0 ], mode.colorBits );
+                fit.endpoints[ 1 ][ c ] = quantizeBC7( c < channels ? hi[ c ] : 255.0f, fit.pbits[ 1 ], mode.colorBits );
+            }
+            fit.error = assignBC7( block, subset, channels, mode.indexBits
+                , unquantizeBC7( fit.endpoints[ 0 ], fit.pbits[ 0 ], mode.colorBits )
+                , unquantizeBC7( fit.endpoints[ 1 ], fit.pbits[ 1 ], mode.colorBits )
+                , candidate );
+            if ( fit.error >= best.error ) continue;
+            best = fit;
+            for ( uint32_t i = 0; i < 16; ++i ) {
+                if ( subset & ( 1u << i ) ) indices[ i ] = candidate[ i ];
+            }
+        }
+        if ( iteration == refinements || best.error == 0 ) break;
+
+        float alpha2 = 0.0f;
+        float beta2 = 0.0f;
+        float alphaBeta = 0.0f;
+        Vec4 alphaX{};
+        Vec4 betaX{};
+        for ( uint32_t i = 0; i < 16; ++i ) {
+            if ( !( subset & ( 1u << i ) ) ) continue;
+            const float t = static_cast<float>( weights[ indices[ i ] ] ) / 64.0f;
+            alpha2 += ( 1.0f - t ) * ( 1.0f - t );
+            beta2 += t * t;
+            alphaBeta += t * ( 1.0f - t );
+            for ( uint32_t c = 0; c < channels; ++c ) {
+                alphaX[ c ] += ( 1.0f - t ) * block[ i ][ c ];
+                betaX[ c ] += t * block[ i ][ c ];
+            }
+        }
+        const float det = alpha2 * beta2 - alphaBeta * alphaBeta;
+        if ( det < 1e-6f ) break;
+        for ( uint32_t c = 0; c < channels; ++c ) {
+            lo[ c ] = std::clamp( ( alphaX[ c ] * beta2 - betaX[ c ] * alphaBeta ) / det, 0.0f, 255.0f );
+            hi[ c ] = std::clamp( ( betaX[ c ] * alpha2 - alphaX[ c ] * alphaBeta ) / det, 0.0f, 255.0f );
+        }
+    }
+    return best;
+}
+
+// anchor indice has implicit zero msb, swaps endpoints when set
+static void fixAnchorBC7( SubsetFit& fit, uint16_t subset, uint32_t anchor, uint32_t indexBits, std::array<uint8_t, 16>& indices ) noexcept
+{
+    const uint32_t max = ( 1u << indexBits ) - 1u;
+    if ( !( indices[ anchor ] & ( 1u << ( indexBits - 1u ) ) ) ) return;
+    std::swap( fit.endpoints[ 0 ], fit.endpoints[ 1 ] );
+    std::swap( fit.pbits[ 0 ], fit.pbits[ 1 ] );
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        if ( subset & ( 1u << i ) ) indices[ i ] = static_cast<uint8_t>( max - indices[ i ] );
+    }
+}
+
+// single subset, rgba 7.7.7.7 with unique p-bits, 4 bit indices
+static BC7 encodeBC7Mode6( const BlockRGBA& block, uint32_t refinements, uint32_t& error ) noexcept
+{
+    const ModeInfo& mode = BC7_MODES[ 6 ];
+    std::array<uint8_t, 16> indices{};
+    SubsetFit fit = fitSubsetBC7( block, 0xFFFF, mode, refinements, indices );
+    fixAnchorBC7( fit, 0xFFFF, 0, mode.indexBits, indices );
+    error = fit.error;
+
+    BitWriter write{};
+    write( 1u << 6u, 7 );
+    for ( uint32_t c = 0; c < 4; ++c ) {
+        write( fit.endpoints[ 0 ][ c ], mode.colorBits );
+        write( fit.endpoints[ 1 ][ c ], mode.colorBits );
+    }
+    write( fit.pbits[ 0 ], 1 );
+    write( fit.pbits[ 1 ], 1 );
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        write( indices[ i ], i ? mode.indexBits : mode.indexBits - 1u );
+    }
+    return write.block;
+}
+
+// two subsets, rgb 6.6.6 with shared p-bit per subset, 3 bit indices;
+// partitions are screened by distance of subsets to their principal axes and only the best few are fitted
+static BC7 encodeBC7Mode1( const BlockRGBA& block, uint32_t& error ) noexcept
+{
+    const ModeInfo& mode = BC7_MODES[ 1 ];
+    std::array<std::pair<float, uint8_t>, 64> screened{};
+    for ( uint32_t p = 0; p < 64; ++p ) {
+        const uint16_t mask = BC7_PARTITIONS2[ p ];
+        const float e = residualBC7( block, static_cast<uint16_t>( ~mask ) ) + residualBC7( block, mask );
+        screened[ p ] = { e, static_cast<uint8_t>( p ) };
+    }
+    std::partial_sort( screened.begin(), screened.begin() + BC7_CANDIDATE_PARTITIONS, screened.end() );
+
+    error = std::numeric_limits<uint32_t>::max();
+    uint32_t partition = 0;
+    std::array<SubsetFit, 2> fits{};
+    std::array<uint8_t, 16> indices{};
+    for ( uint32_t c = 0; c < BC7_CANDIDATE_PARTITIONS; ++c ) {
+        const uint32_t p = screened[ c ].second;
+        const uint16_t mask = BC7_PARTITIONS2[ p ];
+        std::array<uint8_t, 16> candidate{};
+        const SubsetFit fit0 = fitSubsetBC7( block, static_cast<uint16_t>( ~mask ), mode, 2, candidate );
+        const SubsetFit fit1 = fitSubsetBC7( block, mask, mode, 2, candidate );
+        if ( fit0.error + fit1.error >= error ) continue;
+        error = fit0.error + fit1.error;
+        partition = p;
+        fits = { fit0, fit1 };
+        indices = candidate;
+    }
+    const uint16_t mask = BC7_PARTITIONS2[ partition ];
+    fixAnchorBC7( fits[ 0 ], static_cast<uint16_t>( ~mask ), 0, mode.indexBits, indices );
+    fixAnchorBC7( fits[ 1 ], mask, BC7_ANCHORS2[ partition ], mode.indexBits, indices );
+
+    BitWriter write{};
+    write( 1u << 1u, 2 );
+    write( partition, mode.partitionBits );
+    for ( uint32_t c = 0; c < 3; ++c ) {
+        for ( const SubsetFit& fit : fits ) {
+            write( fit.endpoints[ 0 ][ c ], mode.colorBits );
+            write( fit.endpoints[ 1 ][ c ], mode.colorBits );
+        }
+    }
+    write( fits[ 0 ].pbits[ 0 ], 1 );
+    write( fits[ 1 ].pbits[ 0 ], 1 );
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        const bool anchor = i == 0 || i == BC7_ANCHORS2[ partition ];
+        write( indices[ i ], anchor ? mode.indexBits - 1u : mode.indexBits );
+    }
+    return write.block;
+}
+
+static BC7 encodeBC7( const BlockRGBA& block, Quality quality ) noexcept
+{
+    uint32_t error = 0;
+    const BC7 mode6 = encodeBC7Mode6( block, quality == Quality::eHigh ? 2 : 1, error );
+    if ( quality != Quality::eHigh || error == 0 ) return mode6;
+    const bool opaque = std::ranges::all_of( block, []( const RGBA& c ) { return c[ 3 ] == 0xFF; } );
+    if ( !opaque ) return mode6;
+
+    uint32_t error1 = 0;
+    const BC7 mode1 = encodeBC7Mode1( block, error1 );
+    return error1 < error ? mode1 : mode6;
+}
+
+static BlockRGBA decodeBC7( const BC7& block ) noexcept
+{
+    BitReader read{ block };
+    uint32_t modeIndex = 0;
+    while ( modeIndex < 8 && !read( 1 ) ) ++modeIndex;
+    BlockRGBA ret{};
+    if ( modeIndex == 8 ) return ret;
+
+    const ModeInfo& mode = BC7_MODES[ modeIndex ];
+    if ( mode.subsets == 3 ) {
+        ret.fill( RGBA{ 0xFF, 0x00, 0xFF, 0xFF } );
+        return ret;
+    }
+
+    const uint32_t partition = read( mode.partitionBits );
+    const uint32_t rotation = read( mode.rotationBits );
+    const uint32_t indexSelection = read( mode.indexSelectionBits );
+    const uint32_t endpointCount = mode.subsets * 2u;
+    std::array<std::array<uint32_t, 4>, 4> raw{};
+    for ( uint32_t c = 0; c < 3; ++c ) {
+        for ( uint32_t e = 0; e < endpointCount; ++e ) raw[ e ][ c ] = read( mode.colorBits );
+    }
+    for ( uint32_t e = 0; e < endpointCount; ++e ) raw[ e ][ 3 ] = read( mode.alphaBits );
+    std::array<uint32_t, 4> pbits{};
+    for ( uint32_t e = 0; e < endpointCount && mode.endpointPBits; ++e ) pbits[ e ] = read( 1 );
+    for ( uint32_t s = 0; s < mode.subsets && mode.sharedPBits; ++s ) pbits[ s * 2 ] = pbits[ s * 2 + 1 ] = read( 1 );
+
+    const uint32_t pbitCount = mode.endpointPBits + mode.sharedPBits;
+    std::array<RGBA, 4> endpoints{};
+    for ( uint32_t e = 0; e < endpointCount; ++e ) {
+        for ( uint32_t c = 0; c < 4; ++c ) {
+            const uint32_t bits = c < 3 ? mode.colorBits : mode.alphaBits;
+            if ( !bits ) {
+                endpoints[ e ][ c ] = 0xFF;
+                continue;
+            }
+            endpoints[ e ][ c ] = expandBC7( ( raw[ e ][ c ] << pbitCount ) | ( pbitCount ? pbits[ e ] : 0u ), bits + pbitCount );
+        }
+    }
+
+    const uint16_t mask = mode.subsets == 2 ? BC7_PARTITIONS2[ partition ] : 0;
+    std::array<uint8_t, 16> indices{};
+    std::array<uint8_t, 16> indices2{};
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        const bool anchor = i == 0 || ( mode.subsets == 2 && i == BC7_ANCHORS2[ partition ] );
+        indices[ i ] = static_cast<uint8_t>( read( anchor ? mode.indexBits - 1u : mode.indexBits ) );
+    }
+    for ( uint32_t i = 0; i < 16 && mode.index2Bits; ++i ) {
+        indices2[ i ] = static_cast<uint8_t>( read( i ? mode.index2Bits : mode.index2Bits - 1u ) );
+    }
+
+    const bool swapIndices = mode.index2Bits && indexSelection;
+    const std::span<const uint8_t> colorWeights = weightsBC7( swapIndices ? mode.index2Bits : mode.indexBits );
+    const std::span<const uint8_t> alphaWeights = weightsBC7( mode.index2Bits && !swapIndices ? mode.index2Bits : mode.indexBits );
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        const uint32_t s = ( mask >> i ) & 1u;
+        const RGBA& e0 = endpoints[ s * 2 ];
+        const RGBA& e1 = endpoints[ s * 2 + 1 ];
+        const uint32_t colorIndice = swapIndices ? indices2[ i ] : indices[ i ];
+        const uint32_t alphaIndice = mode.index2Bits && !swapIndices ? indices2[ i ] : indices[ i ];
+        for ( uint32_t c = 0; c < 3; ++c ) {
+            ret[ i ][ c ] = interpolateBC7( e0[ c ], e1[ c ], colorWeights[ colorIndice ] );
+        }
+        ret[ i ][ 3 ] = interpolateBC7( e0[ 3 ], e1[ 3 ], alphaWeights[ alphaIndice ] );
+        if ( rotation ) std::swap( ret[ i ][ 3 ], ret[ i ][ rotation - 1u ] );
+    }
+    return ret;
+}
+
+std::pmr::vector<BC7> compressBC7( std::span<const uint8_t> pixels, uint32_t width, uint32_t height, Quality quality, uint32_t threadCount )
+{
+    ZoneScoped;
+    assert( width % 4 == 0 );
+    assert( height % 4 == 0 );
+    assert( pixels.size() == static_cast<size_t>( width ) * height * 4 );
+    const uint32_t blocksInRow = width / 4;
+    const uint32_t blockRows = height / 4;
+    std::pmr::vector<BC7> ret( static_cast<size_t>( blocksInRow ) * blockRows );
+
+    parallel::forEach( blockRows, parallel::threadCount( threadCount ), [&]( size_t row, uint32_t )
+    {
+        for ( uint32_t col = 0; col < blocksInRow; ++col ) {
+            BlockRGBA block{};
+            for ( uint32_t i = 0; i < 16; ++i ) {
+                const size_t x = col * 4 + ( i & 3u );
+                const size_t y = row * 4 + ( i >> 2u );
+                const uint8_t* px = pixels.data() + ( y * width + x ) * 4;
+                block[ i ] = RGBA{ px[ 2 ], px[ 1 ], px[ 0 ], px[ 3 ] };
+            }
+            ret[ row * blocksInRow + col ] = encodeBC7( block, quality );
+        }
+    } );
+    return ret;
+}
+
+// pixels past width and height of partial blocks are dropped
+static void decodeBC7Into( std::span<const BC7> blocks, uint32_t width, uint32_t height, uint8_t* dst ) noexcept
+{
+    const uint32_t blocksInRow = ( width + 3 ) / 4;
+    for ( size_t b = 0; b < blocks.size(); ++b ) {
+        const BlockRGBA colors = decodeBC7( blocks[ b ] );
+        for ( uint32_t i = 0; i < 16; ++i ) {
+            const size_t x = ( b % blocksInRow ) * 4 + ( i & 3u );
+            const size_t y = ( b / blocksInRow ) * 4 + ( i >> 2u );
+            if ( x >= width || y >= height ) continue;
+            uint8_t* px = dst + ( y * width + x ) * 4;
+            px[ 0 ] = colors[ i ][ 2 ];
+            px[ 1 ] = colors[ i ][ 1 ];
+            px[ 2 ] = colors[ i ][ 0 ];
+            px[ 3 ] = colors[ i ][ 3 ];
+        }
+    }
+}
+
+std::pmr::vector<uint8_t> decompressBC7( std::span<const BC7> blocks, uint32_t width, uint32_t height )
+{
+    assert( width % 4 == 0 );
+    assert( height % 4 == 0 );
+    assert( blocks.size() == static_cast<size_t>( width / 4 ) * ( height / 4 ) );
+    std::pmr::vector<uint8_t> ret( static_cast<size_t>( width ) * height * 4 );
+    decodeBC7Into( blocks, width, height, ret.data() );
+    return ret;
+}
+
+std::pmr::vector<uint8_t> decompressBC7( std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t mips, uint32_t layers )
+{
+    ZoneScoped;
+    size_t pixelCount = 0;
+    size_t blockCount = 0;
+    for ( uint32_t mip = 0; mip < mips; ++mip ) {
+        const uint32_t w = std::max( width >> mip, 1u );
+        const uint32_t h = std::max( height >> mip, 1u );
+        pixelCount += static_cast<size_t>( w ) * h;
+        blockCount += static_cast<size_t>( ( w + 3 ) / 4 ) * ( ( h + 3 ) / 4 );
+    }
+    assert( data.size() >= blockCount * layers * sizeof( BC7 ) );
+
+    std::pmr::vector<uint8_t> ret( pixelCount * layers * 4 );
+    const BC7* src = reinterpret_cast<const BC7*>( data.data() );
+    uint8_t* dst = ret.data();
+    for ( uint32_t layer = 0; layer < layers; ++layer ) {
+        for ( uint32_t mip = 0; mip < mips; ++mip ) {
+            const uint32_t w = std::max( width >> mip, 1u );
+            const uint32_t h = std::max( height >> mip, 1u );
+            const size_t count = static_cast<size_t>( ( w + 3 ) / 4 ) * ( ( h + 3 ) / 4 );
+            decodeBC7Into( std::span{ src, count }, w, h, dst );
+            src += count;
+            dst += static_cast<size_t>( w ) * h * 4;
+        }
+    }
+    return ret;
+}
+
+double psnr( std::span<const uint8_t> a, std::span<const uint8_t> b, bool alpha )
+{
+    assert( a.size() == b.size() );
+    assert( a.size() % 4 == 0 );
+    double mse = 0.0;
+    for ( size_t i = 0; i < a.size(); ++i ) {
+        if ( !alpha && ( i & 3u ) == 3u ) continue;
+        const double d = static_cast<double>( a[ i ] ) - static_cast<double>( b[ i ] );
+        mse += d * d;
+    }
+    mse /= static_cast<double>( alpha ? a.size() : a.size() / 4 * 3 );
+    return mse == 0.0 ? 99.0 : 10.0 * std::log10( 255.0 * 255.0 / mse );
+}
+
+}
@@ -0,0 +1,61 @@
+#include <extra/lang.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace lang {
+
+// hash-and-displace: largest buckets pick their seed first while most slots are still free
+bool perfectHash( std::span<KeyType> keys, std::pmr::vector<uint32_t>& seeds )
+{
+    static constexpr uint32_t MAX_SEED = 1u << 20;
+    const uint32_t count = static_cast<uint32_t>( keys.size() );
+    const uint32_t bucketCount = ( count + KEYS_PER_BUCKET - 1 ) / KEYS_PER_BUCKET;
+    seeds.assign( bucketCount, 0 );
+    if ( count == 0 ) return true;
+
+    std::pmr::vector<Hash::value_type> hashes( count );
+    std::ranges::transform( keys, hashes.begin(), &KeyType::hash );
+    std::ranges::sort( hashes );
+    if ( std::ranges::adjacent_find( hashes ) != hashes.end() ) return false;
+
+    std::pmr::vector<std::pmr::vector<uint32_t>> buckets( bucketCount );
+    for ( uint32_t i = 0; i < count; ++i ) {
+        buckets[ keys[ i ].hash % bucketCount ].emplace_back( i );
+    }
+    std::pmr::vector<uint32_t> order( bucketCount );
+    std::iota( order.begin(), order.end(), 0u );
+    std::ranges::stable_sort( order, []( const auto& lhs, const auto& rhs ) { return lhs.size() > rhs.size(); }
+        , [&buckets]( uint32_t i ) -> const auto& { return buckets[ i ]; } );
+
+    std::pmr::vector<KeyType> slots( count );
+    std::pmr::vector<bool> taken( count );
+    std::pmr::vector<uint32_t> bucketSlots{};
+    for ( uint32_t b : order ) {
+        const auto& bucket = buckets[ b ];
+        if ( bucket.empty() ) break;
+
+        uint32_t seed = 0;
+        for ( ; seed < MAX_SEED; ++seed ) {
+            bucketSlots.clear();
+            for ( uint32_t i : bucket ) {
+                const uint32_t s = slot( keys[ i ].hash, seed, count );
+                if ( taken[ s ] || std::ranges::find( bucketSlots, s ) != bucketSlots.end() ) break;
+                bucketSlots.emplace_back( s );
+            }
+            if ( bucketSlots.size() == bucket.size() ) break;
+        }
+        if ( seed == MAX_SEED ) return false;
+
+        seeds[ b ] = seed;
+        for ( size_t i = 0; i < bucket.size(); ++i ) {
+            taken[ bucketSlots[ i ] ] = true;
+            slots[ bucketSlots[ i ] ] = keys[ bucket[ i ] ];
+        }
+    }
+    std::ranges::copy( slots, keys.begin() );
+    return true;
+}
+
+}
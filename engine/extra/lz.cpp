@@ -0,0 +1,172 @@
+#include <extra/lz.hpp>
+
+#include <profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+
+namespace lz {
+
+static constexpr std::size_t MIN_MATCH = 4;
+static constexpr std::size_t LAST_LITERALS = 5;
+static constexpr std::size_t MATCH_LIMIT = 12;
+static constexpr std::size_t MAX_OFFSET = 0xFFFF;
+static constexpr uint32_t HASH_BITS = 14;
+
+static inline uint32_t read32( const uint8_t* p ) noexcept
+{
+    uint32_t ret = 0;
+    std::memcpy( &ret, p, sizeof( ret ) );
+    return ret;
+}
+
+static inline uint32_t hash( uint32_t sequence ) noexcept
+{
+    return ( sequence * 2654435761u ) >> ( 32 - HASH_BITS );
+}
+
+namespace {
+struct Writer {
+    uint8_t* ptr = nullptr;
+    uint8_t* end = nullptr;
+
+    inline bool length( std::size_t len ) noexcept
+    {
+        for ( ; len >= 255; len -= 255 ) {
+            if ( ptr == end ) return false;
+            *ptr++ = 255;
+        }
+        if ( ptr == end ) return false;
+        *ptr++ = static_cast<uint8_t>( len );
+        return true;
+    }
+
+    inline bool sequence( const uint8_t* literals, std::size_t literalCount, std::size_t offset, std::size_t matchLength ) noexcept
+    {
+        if ( ptr == end ) return false;
+        const std::size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+        uint8_t* token = ptr++;
+        *token = static_cast<uint8_t>( ( std::min<std::size_t>( literalCount, 15 ) << 4 ) | std::min<std::size_t>( matchCode, 15 ) );
+        if ( literalCount >= 15 && !length( literalCount - 15 ) ) return false;
+        if ( static_cast<std::size_t>( end - ptr ) < literalCount ) return false;
+        std::memcpy( ptr, literals, literalCount );
+        ptr += literalCount;
+        if ( !matchLength ) return true;
+
+        if ( end - ptr < 2 ) return false;
+        *ptr++ = static_cast<uint8_t>( offset );
+        *ptr++ = static_cast<uint8_t>( offset >> 8 );
+        return matchCode < 15 || length( matchCode - 15 );
+    }
+};
+
+struct Reader {
+    const uint8_t* ptr = nullptr;
+    const uint8_t* end = nullptr;
+
+    inline bool length( std::size_t& len ) noexcept
+    {
+        uint8_t b = 0;
+        do {
+            if ( ptr == end ) return false;
+            b = *ptr++;
+            len += b;
+        } while ( b == 255 );
+        return true;
+    }
+};
+}
+
+std::size_t compressBound( std::size_t size ) noexcept
+{
+    return size + size / 255 + 16;
+}
+
+std::size_t compress( std::span<const uint8_t> src, std::span<uint8_t> dst ) noexcept
+{
+    ZoneScoped;
+    Writer out{ dst.data(), dst.data() + dst.size() };
+    const uint8_t* base = src.data();
+    const std::size_t size = src.size();
+    std::size_t anchor = 0;
+
+    if ( size > MATCH_LIMIT ) {
+        std::array<uint32_t, 1u << HASH_BITS> table{};
+        const std::size_t matchLimit = size - MATCH_LIMIT;
+        std::size_t pos = 0;
+        while ( pos < matchLimit ) {
+            const uint32_t sequence = read32( base + pos );
+            uint32_t& slot = table[ hash( sequence ) ];
+            const std::size_t candidate = slot;
+            slot = static_cast<uint32_t>( pos );
+
+            if ( candidate >= pos || pos - candidate > MAX_OFFSET || read32( base + candidate ) != sequence ) {
+                // skip faster through incompressible data
+                pos += 1 + ( ( pos - anchor ) >> 6 );
+                continue;
+            }
+
+            const std::size_t maxLength = size - LAST_LITERALS - pos;
+            std::size_t length = MIN_MATCH;
+            while ( length < maxLength && base[ candidate + length ] == base[ pos + length ] ) {
+                ++length;
+            }
+            if ( !out.sequence( base + anchor, pos - anchor, pos - candidate, length ) ) return 0;
+            pos += length;
+            anchor = pos;
+        }
+    }
+
+    if ( !out.sequence( base + anchor, size - anchor, 0, 0 ) ) return 0;
+    return static_cast<std::size_t>( out.ptr - dst.data() );
+}
+
+bool decompress( std::span<const uint8_t> src, std::span<uint8_t> dst ) noexcept
+{
+    ZoneScoped;
+    Reader in{ src.data(), src.data() + src.size() };
+    uint8_t* out = dst.data();
+    uint8_t* const outEnd = dst.data() + dst.size();
+
+    while ( in.ptr != in.end ) {
+        const uint8_t token = *in.ptr++;
+
+        std::size_t literalCount = token >> 4;
+        if ( literalCount == 15 && !in.length( literalCount ) ) return false;
+        if ( static_cast<std::size_t>( in.end - in.ptr ) < literalCount ) return false;
+        if ( static_cast<std::size_t>( outEnd - out ) < literalCount ) return false;
+        std::memcpy( out, in.ptr, literalCount );
+        in.ptr += literalCount;
+        out += literalCount;
+
+        // last sequence carries literals only
+        if ( in.ptr == in.end ) break;
+
+        if ( in.end - in.ptr < 2 ) return false;
+        const std::size_t offset = static_cast<std::size_t>( in.ptr[ 0 ] ) | ( static_cast<std::size_t>( in.ptr[ 1 ] ) << 8 );
+        in.ptr += 2;
+        if ( offset == 0 || offset > static_cast<std::size_t>( out - dst.data() ) ) return false;
+
+        std::size_t matchLength = token & 15u;
+        if ( matchLength == 15 && !in.length( matchLength ) ) return false;
+        matchLength += MIN_MATCH;
+        if ( static_cast<std::size_t>( outEnd - out ) < matchLength ) return false;
+
+        const uint8_t* match = out - offset;
+        if ( offset >= matchLength ) {
+            std::memcpy( out, match, matchLength );
+            out += matchLength;
+        }
+        else {
+            // overlapping copy repeats the pattern
+            for ( std::size_t i = 0; i < matchLength; ++i ) {
+                *out++ = *match++;
+            }
+        }
+    }
+    return out == outEnd;
+}
+
+}
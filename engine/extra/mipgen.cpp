@@ -0,0 +1,278 @@
+#include <extra/mipgen.hpp>
+#include <extra/parallel.hpp>
+
+#include <profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace mipgen {
+
+static constexpr uint32_t TILE_ROWS = 32;
+// radius of windowed sinc filters, in destination pixels
+static constexpr float FILTER_RADIUS = 3.0f;
+static constexpr float KAISER_ALPHA = 4.0f;
+static constexpr uint32_t COVERAGE_ITERATIONS = 16;
+static constexpr float COVERAGE_MAX_SCALE = 4.0f;
+
+static float sinc( float x ) noexcept
+{
+    if ( std::abs( x ) < 1e-5f ) return 1.0f;
+    x *= std::numbers::pi_v<float>;
+    return std::sin( x ) / x;
+}
+
+// zeroth order modified Bessel function of the first kind
+static float bessel0( float x ) noexcept
+{
+    float ret = 1.0f;
+    float term = 1.0f;
+    const float halfSq = x * x * 0.25f;
+    for ( uint32_t k = 1; k < 32 && term > ret * 1e-7f; ++k ) {
+        term *= halfSq / static_cast<float>( k * k );
+        ret += term;
+    }
+    return ret;
+}
+
+static float weight( Filter filter, float x ) noexcept
+{
+    switch ( filter ) {
+    case Filter::eBox:
+        return std::abs( x ) <= 0.5f ? 1.0f : 0.0f;
+    case Filter::eKaiser: {
+        if ( std::abs( x ) >= FILTER_RADIUS ) return 0.0f;
+        const float t = x / FILTER_RADIUS;
+        return sinc( x ) * bessel0( KAISER_ALPHA * std::sqrt( 1.0f - t * t ) ) / bessel0( KAISER_ALPHA );
+    }
+    case Filter::eLanczos:
+        if ( std::abs( x ) >= FILTER_RADIUS ) return 0.0f;
+        return sinc( x ) * sinc( x / FILTER_RADIUS );
+    }
+    return 0.0f;
+}
+
+// 2:1 downscale is periodic, destination pixel x samples source pixels 2x + first + i
+struct Kernel {
+    int32_t first = 0;
+    std::pmr::vector<float> weights{};
+};
+
+static Kernel makeKernel( Filter filter )
+{
+    const int32_t taps = filter == Filter::eBox ? 1 : static_cast<int32_t>( std::ceil( FILTER_RADIUS * 2.0f ) );
+    Kernel ret{ .first = 1 - taps };
+    for ( int32_t k = ret.first; k <= taps; ++k ) {
+        // distance between source and destination pixel centers, in destination pixels
+        ret.weights.emplace_back( weight( filter, ( static_cast<float>( k ) - 0.5f ) * 0.5f ) );
+    }
+    float sum = 0.0f;
+    for ( float w : ret.weights ) sum += w;
+    for ( float& w : ret.weights ) w /= sum;
+    return ret;
+}
+
+static const std::array<float, 256>& toLinearLut()
+{
+    static const std::array<float, 256> lut = []()
+    {
+        std::array<float, 256> ret{};
+        for ( uint32_t i = 0; i < ret.size(); ++i ) {
+            const float s = static_cast<float>( i ) / 255.0f;
+            ret[ i ] = s <= 0.04045f ? s / 12.92f : std::pow( ( s + 0.055f ) / 1.055f, 2.4f );
+        }
+        return ret;
+    }();
+    return lut;
+}
+
+static const std::array<uint8_t, 65536>& toSrgbLut()
+{
+    static const std::array<uint8_t, 65536> lut = []()
+    {
+        std::array<uint8_t, 65536> ret{};
+        for ( uint32_t i = 0; i < ret.size(); ++i ) {
+            const double l = static_cast<double>( i ) / 65535.0;
+            const double s = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow( l, 1.0 / 2.4 ) - 0.055;
+            ret[ i ] = static_cast<uint8_t>( std::lround( std::clamp( s, 0.0, 1.0 ) * 255.0 ) );
+        }
+        return ret;
+    }();
+    return lut;
+}
+
+// filters destination rows [y0, y1) of a 2:1 downscale, separable: horizontal pass into scratch, then vertical
+static void filterTile( const Kernel& kernel
+    , std::span<const float> src
+    , uint32_t srcWidth
+    , uint32_t srcHeight
+    , uint32_t channels
+    , uint32_t y0
+    , uint32_t y1
+    , std::span<float> dst
+    , std::pmr::vector<float>& scratch )
+{
+    const uint32_t dstWidth = srcWidth >> 1;
+    const uint32_t rowSize = dstWidth * channels;
+    const int32_t taps = static_cast<int32_t>( kernel.weights.size() );
+    const int32_t maxX = static_cast<int32_t>( srcWidth ) - 1;
+    const int32_t maxY = static_cast<int32_t>( srcHeight ) - 1;
+    const int32_t rowBegin = std::max( static_cast<int32_t>( y0 * 2 ) + kernel.first, 0 );
+    const int32_t rowEnd = std::min( static_cast<int32_t>( ( y1 - 1 ) * 2 ) + kernel.first + taps, maxY + 1 );
+
+    scratch.resize( static_cast<std::size_t>( rowEnd - rowBegin ) * rowSize );
+    for ( int32_t sy = rowBegin; sy < rowEnd; ++sy ) {
+        const float* srcRow = src.data() + static_cast<std::size_t>( sy ) * srcWidth * channels;
+        float* tmpRow = scratch.data() + static_cast<std::size_t>( sy - rowBegin ) * rowSize;
+        for ( uint32_t x = 0; x < dstWidth; ++x ) {
+            std::array<float, 4> acc{};
+            const int32_t sx0 = static_cast<int32_t>( x * 2 ) + kernel.first;
+            for ( int32_t t = 0; t < taps; ++t ) {
+                const float w = kernel.weights[ static_cast<std::size_t>( t ) ];
+                const float* px = srcRow + static_cast<std::size_t>( std::clamp( sx0 + t, 0, maxX ) ) * channels;
+                for ( uint32_t c = 0; c < channels; ++c ) acc[ c ] += w * px[ c ];
+            }
+            std::copy_n( acc.begin(), channels, tmpRow + x * channels );
+        }
+    }
+
+    for ( uint32_t y = y0; y < y1; ++y ) {
+        float* dstRow = dst.data() + static_cast<std::size_t>( y ) * rowSize;
+        std::fill_n( dstRow, rowSize, 0.0f );
+        const int32_t sy0 = static_cast<int32_t>( y * 2 ) + kernel.first;
+        for ( int32_t t = 0; t < taps; ++t ) {
+            const float w = kernel.weights[ static_cast<std::size_t>( t ) ];
+            const float* tmpRow = scratch.data() + static_cast<std::size_t>( std::clamp( sy0 + t, 0, maxY ) - rowBegin ) * rowSize;
+            for ( uint32_t i = 0; i < rowSize; ++i ) dstRow[ i ] += w * tmpRow[ i ];
+        }
+        // negative lobes ring around edges
+        for ( uint32_t i = 0; i < rowSize; ++i ) dstRow[ i ] = std::clamp( dstRow[ i ], 0.0f, 1.0f );
+    }
+}
+
+static float coverage( std::span<const float> pixels, uint32_t channels, float reference, float scale ) noexcept
+{
+    const std::size_t count = pixels.size() / channels;
+    std::size_t covered = 0;
+    for ( std::size_t i = channels - 1; i < pixels.size(); i += channels ) {
+        covered += pixels[ i ] * scale > reference;
+    }
+    return static_cast<float>( covered ) / static_cast<float>( count );
+}
+
+// bisection of alpha scale so that coverage matches target, coverage is monotonic in scale
+static float coverageScale( std::span<const float> pixels, uint32_t channels, float reference, float target ) noexcept
+{
+    float lo = 0.0f;
+    float hi = COVERAGE_MAX_SCALE;
+    for ( uint32_t i = 0; i < COVERAGE_ITERATIONS; ++i ) {
+        const float mid = ( lo + hi ) * 0.5f;
+        if ( coverage( pixels, channels, reference, mid ) < target ) lo = mid;
+        else hi = mid;
+    }
+    return ( lo + hi ) * 0.5f;
+}
+
+float alphaCoverage( std::span<const uint8_t> pixels, uint32_t channels, float reference )
+{
+    assert( channels );
+    assert( !pixels.empty() );
+    const uint32_t threshold = static_cast<uint32_t>( std::clamp( reference, 0.0f, 1.0f ) * 255.0f );
+    std::size_t covered = 0;
+    for ( std::size_t i = channels - 1; i < pixels.size(); i += channels ) {
+        covered += pixels[ i ] > threshold;
+    }
+    return static_cast<float>( covered ) / static_cast<float>( pixels.size() / channels );
+}
+
+std::pmr::vector<Level> generate( std::span<const std::span<const uint8_t>> layers
+    , uint32_t width
+    , uint32_t height
+    , uint32_t channels
+    , uint32_t levelCount
+    , const Options& options )
+{
+    ZoneScoped;
+    assert( channels == 1 || channels == 4 );
+    assert( width && height );
+    assert( ( width % ( 1u << levelCount ) ) == 0 );
+    assert( ( height % ( 1u << levelCount ) ) == 0 );
+
+    std::pmr::vector<Level> ret( layers.size() * levelCount );
+    if ( layers.empty() || levelCount == 0 ) return ret;
+
+    const bool coverageEnabled = options.alphaCoverage > 0.0f;
+    std::array<bool, 4> linear{};
+    for ( uint32_t c = 0; c < channels; ++c ) {
+        const bool alpha = c == channels - 1 && ( channels == 4 || coverageEnabled );
+        linear[ c ] = !options.srgb || alpha;
+    }
+    const uint32_t threadCount = parallel::threadCount( options.threadCount );
+    const Kernel kernel = makeKernel( options.filter );
+    const auto& toLinear = toLinearLut();
+    const auto& toSrgb = toSrgbLut();
+
+    std::pmr::vector<std::pmr::vector<float>> current( layers.size() );
+    std::pmr::vector<std::pmr::vector<float>> next( layers.size() );
+    std::pmr::vector<float> targetCoverage( layers.size() );
+    std::pmr::vector<std::pmr::vector<float>> scratch( threadCount );
+    parallel::forEach( layers.size(), threadCount, [&]( std::size_t layer, uint32_t )
+    {
+        const std::span<const uint8_t> src = layers[ layer ];
+        assert( src.size() == static_cast<std::size_t>( width ) * height * channels );
+        auto& dst = current[ layer ];
+        dst.resize( src.size() );
+        for ( std::size_t i = 0; i < src.size(); ++i ) {
+            dst[ i ] = linear[ i % channels ] ? static_cast<float>( src[ i ] ) / 255.0f : toLinear[ src[ i ] ];
+        }
+        if ( coverageEnabled ) {
+            targetCoverage[ layer ] = alphaCoverage( src, channels, options.alphaCoverage );
+        }
+    } );
+
+    for ( uint32_t level = 1; level <= levelCount; ++level ) {
+        ZoneScopedN( "mip level" );
+        const uint32_t srcWidth = width >> ( level - 1 );
+        const uint32_t srcHeight = height >> ( level - 1 );
+        const uint32_t dstWidth = srcWidth >> 1;
+        const uint32_t dstHeight = srcHeight >> 1;
+        const std::size_t dstSize = static_cast<std::size_t>( dstWidth ) * dstHeight * channels;
+        for ( auto& it : next ) it.resize( dstSize );
+
+        const uint32_t tilesPerLayer = ( dstHeight + TILE_ROWS - 1 ) / TILE_ROWS;
+        parallel::forEach( layers.size() * tilesPerLayer, threadCount, [&]( std::size_t job, uint32_t worker )
+        {
+            const std::size_t layer = job / tilesPerLayer;
+            const uint32_t y0 = static_cast<uint32_t>( job % tilesPerLayer ) * TILE_ROWS;
+            const uint32_t y1 = std::min( y0 + TILE_ROWS, dstHeight );
+            filterTile( kernel, current[ layer ], srcWidth, srcHeight, channels, y0, y1, next[ layer ], scratch[ worker ] );
+        } );
+
+        parallel::forEach( layers.size(), threadCount, [&]( std::size_t layer, uint32_t )
+        {
+            const std::pmr::vector<float>& src = next[ layer ];
+            const float alphaScale = coverageEnabled
+                ? coverageScale( src, channels, options.alphaCoverage, targetCoverage[ layer ] )
+                : 1.0f;
+            Level& dst = ret[ layer * levelCount + level - 1 ];
+            dst.width = dstWidth;
+            dst.height = dstHeight;
+            dst.pixels.resize( dstSize );
+            for ( std::size_t i = 0; i < dstSize; ++i ) {
+                const uint32_t c = static_cast<uint32_t>( i % channels );
+                float v = src[ i ];
+                if ( c == channels - 1 ) v = std::min( v * alphaScale, 1.0f );
+                dst.pixels[ i ] = linear[ c ]
+                    ? static_cast<uint8_t>( v * 255.0f + 0.5f )
+                    : toSrgb[ static_cast<uint32_t>( v * 65535.0f + 0.5f ) ];
+            }
+        } );
+        std::swap( current, next );
+    }
+    return ret;
+}
+
+}
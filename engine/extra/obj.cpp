@@ -2,13 +2,15 @@
 
 #include <profiler.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <fstream>
 
 namespace obj {
 
-std::pmr::vector<std::pair<Chunk, std::pmr::vector<float>>> parse( std::pmr::vector<uint8_t>&& data )
+std::pmr::vector<Object> parse( std::pmr::vector<uint8_t>&& data )
 {
     ZoneScoped;
     assert( data.size() >= sizeof( Header ) );
@@ -18,25 +20,173 @@ std::pmr::vector<std::pair<Chunk, std::pmr::vector<float>>> parse( std::pmr::vec
     std::advance( ptr, sizeof( Header ) );
 
     assert( header.magic == Header::MAGIC );
-    assert( header.version == Header::VERSION );
+    assert( header.version >= Header::VERSION_NON_INDEXED && header.version <= Header::VERSION );
 
-    std::pmr::vector<std::pair<Chunk, std::pmr::vector<float>>> ret( header.chunkCount );
+    std::pmr::vector<Object> ret( header.chunkCount );
 
     [[maybe_unused]]
     const uint8_t* end = data.data() + data.size();
     for ( auto& it : ret ) {
         assert( ptr + sizeof( Chunk ) <= end );
-        std::memcpy( &it.first, ptr, sizeof( Chunk ) );
+        std::memcpy( &it.chunk, ptr, sizeof( Chunk ) );
         std::advance( ptr, sizeof( Chunk ) );
 
-        assert( it.first.magic == Chunk::MAGIC );
-        const size_t bytesToLoad = it.first.floatCount * sizeof( float );
-        assert( ptr + bytesToLoad <= end );
-        it.second.resize( it.first.floatCount );
-        std::memcpy( it.second.data(), ptr, bytesToLoad );
+        assert( it.chunk.magic == Chunk::MAGIC );
+        const size_t bytesToLoad = it.chunk.floatCount * sizeof( float );
+        if ( it.chunk.vertexAssembly == VertexAssembly::vtnq ) {
+            assert( ptr + sizeof( Quantization ) <= end );
+            std::memcpy( &it.quantization, ptr, sizeof( Quantization ) );
+            std::advance( ptr, sizeof( Quantization ) );
+            assert( it.quantization.magic == Quantization::MAGIC );
+            assert( bytesToLoad % sizeof( PackedVertex ) == 0 );
+            assert( ptr + bytesToLoad <= end );
+            it.packed.resize( bytesToLoad / sizeof( PackedVertex ) );
+            std::memcpy( it.packed.data(), ptr, bytesToLoad );
+        }
+        else {
+            assert( ptr + bytesToLoad <= end );
+            it.vertices.resize( it.chunk.floatCount );
+            std::memcpy( it.vertices.data(), ptr, bytesToLoad );
+        }
         std::advance( ptr, bytesToLoad );
+
+        if ( header.version == Header::VERSION_NON_INDEXED ) continue;
+        if ( ptr + sizeof( Indices ) > end ) continue;
+        Indices indices{};
+        std::memcpy( &indices, ptr, sizeof( Indices ) );
+        if ( indices.magic != Indices::MAGIC ) continue;
+        std::advance( ptr, sizeof( Indices ) );
+
+        assert( ptr + Indices::paddedSize( indices.indexCount ) <= end );
+        it.indices.resize( indices.indexCount );
+        std::memcpy( it.indices.data(), ptr, indices.indexCount * sizeof( uint16_t ) );
+        std::advance( ptr, Indices::paddedSize( indices.indexCount ) );
+    }
+
+    return ret;
+}
+
+static constexpr float UNORM16_MAX = 65535.0f;
+static constexpr float SNORM16_MAX = 32767.0f;
+
+static uint16_t toUnorm16( float v, float scale, float bias ) noexcept
+{
+    if ( scale == 0.0f ) return 0;
+    const float n = std::clamp( ( v - bias ) / scale, 0.0f, 1.0f );
+    return static_cast<uint16_t>( std::lround( n * UNORM16_MAX ) );
+}
+
+static float fromUnorm16( uint16_t v, float scale, float bias ) noexcept
+{
+    return static_cast<float>( v ) / UNORM16_MAX * scale + bias;
+}
+
+static float fromSnorm16( int16_t v ) noexcept
+{
+    return std::max( static_cast<float>( v ) / SNORM16_MAX, -1.0f );
+}
+
+static void octDecode( const int16_t* e, float* n ) noexcept
+{
+    n[ 0 ] = fromSnorm16( e[ 0 ] );
+    n[ 1 ] = fromSnorm16( e[ 1 ] );
+    n[ 2 ] = 1.0f - std::abs( n[ 0 ] ) - std::abs( n[ 1 ] );
+    const float t = std::max( -n[ 2 ], 0.0f );
+    n[ 0 ] += n[ 0 ] >= 0.0f ? -t : t;
+    n[ 1 ] += n[ 1 ] >= 0.0f ? -t : t;
+    const float len = std::sqrt( n[ 0 ] * n[ 0 ] + n[ 1 ] * n[ 1 ] + n[ 2 ] * n[ 2 ] );
+    n[ 0 ] /= len;
+    n[ 1 ] /= len;
+    n[ 2 ] /= len;
+}
+
+// projects onto octahedron and unfolds lower hemisphere, then picks the closest of neighbouring snorm codes
+static void octEncode( const float* n, int16_t* e ) noexcept
+{
+    const float l1 = std::abs( n[ 0 ] ) + std::abs( n[ 1 ] ) + std::abs( n[ 2 ] );
+    float x = l1 > 0.0f ? n[ 0 ] / l1 : 0.0f;
+    float y = l1 > 0.0f ? n[ 1 ] / l1 : 0.0f;
+    if ( n[ 2 ] < 0.0f ) {
+        const float ox = x;
+        x = ( 1.0f - std::abs( y ) ) * ( ox >= 0.0f ? 1.0f : -1.0f );
+        y = ( 1.0f - std::abs( ox ) ) * ( y >= 0.0f ? 1.0f : -1.0f );
     }
 
+    const float fx = std::floor( x * SNORM16_MAX );
+    const float fy = std::floor( y * SNORM16_MAX );
+    float bestDot = -2.0f;
+    for ( uint32_t i = 0; i < 4; ++i ) {
+        const int16_t candidate[ 2 ]{
+            static_cast<int16_t>( std::clamp( fx + static_cast<float>( i & 1 ), -SNORM16_MAX, SNORM16_MAX ) ),
+            static_cast<int16_t>( std::clamp( fy + static_cast<float>( i >> 1 ), -SNORM16_MAX, SNORM16_MAX ) ),
+        };
+        float d[ 3 ]{};
+        octDecode( candidate, d );
+        const float dot = d[ 0 ] * n[ 0 ] + d[ 1 ] * n[ 1 ] + d[ 2 ] * n[ 2 ];
+        if ( dot <= bestDot ) continue;
+        bestDot = dot;
+        e[ 0 ] = candidate[ 0 ];
+        e[ 1 ] = candidate[ 1 ];
+    }
+}
+
+Quantization quantize( std::span<const float> vtn, std::pmr::vector<PackedVertex>& out )
+{
+    ZoneScoped;
+    assert( vtn.size() % VTN_STRIDE == 0 );
+    const std::size_t count = vtn.size() / VTN_STRIDE;
+
+    Quantization ret{};
+    out.resize( count );
+    if ( count == 0 ) return ret;
+
+    float min[ 5 ]{};
+    float max[ 5 ]{};
+    std::copy_n( vtn.data(), 5, min );
+    std::copy_n( vtn.data(), 5, max );
+    for ( std::size_t i = 0; i < count; ++i ) {
+        for ( uint32_t j = 0; j < 5; ++j ) {
+            min[ j ] = std::min( min[ j ], vtn[ i * VTN_STRIDE + j ] );
+            max[ j ] = std::max( max[ j ], vtn[ i * VTN_STRIDE + j ] );
+        }
+    }
+    for ( uint32_t j = 0; j < 3; ++j ) {
+        ret.positionBias[ j ] = min[ j ];
+        ret.positionScale[ j ] = max[ j ] - min[ j ];
+    }
+    for ( uint32_t j = 0; j < 2; ++j ) {
+        ret.uvBias[ j ] = min[ j + 3 ];
+        ret.uvScale[ j ] = max[ j + 3 ] - min[ j + 3 ];
+    }
+
+    for ( std::size_t i = 0; i < count; ++i ) {
+        const float* v = vtn.data() + i * VTN_STRIDE;
+        PackedVertex& p = out[ i ];
+        for ( uint32_t j = 0; j < 3; ++j ) {
+            p.position[ j ] = toUnorm16( v[ j ], ret.positionScale[ j ], ret.positionBias[ j ] );
+        }
+        for ( uint32_t j = 0; j < 2; ++j ) {
+            p.uv[ j ] = toUnorm16( v[ j + 3 ], ret.uvScale[ j ], ret.uvBias[ j ] );
+        }
+        octEncode( v + 5, p.normal );
+    }
+    return ret;
+}
+
+std::pmr::vector<float> dequantize( const Quantization& q, std::span<const PackedVertex> packed )
+{
+    std::pmr::vector<float> ret( packed.size() * VTN_STRIDE );
+    float* v = ret.data();
+    for ( const PackedVertex& p : packed ) {
+        for ( uint32_t j = 0; j < 3; ++j ) {
+            v[ j ] = fromUnorm16( p.position[ j ], q.positionScale[ j ], q.positionBias[ j ] );
+        }
+        for ( uint32_t j = 0; j < 2; ++j ) {
+            v[ j + 3 ] = fromUnorm16( p.uv[ j ], q.uvScale[ j ], q.uvBias[ j ] );
+        }
+        octDecode( p.normal, v + 5 );
+        v += VTN_STRIDE;
+    }
     return ret;
 }
 
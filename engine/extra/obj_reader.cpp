@@ -0,0 +1,254 @@
+#include <extra/obj_reader.hpp>
+
+#include <profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <cstring>
+#include <iterator>
+
+namespace obj {
+
+namespace {
+
+struct Reader {
+    const char* m_ptr = nullptr;
+    const char* m_end = nullptr;
+    std::pmr::vector<SourceObject>* m_objects = nullptr;
+    ReadContext* m_ctx = nullptr;
+    uint32_t m_line = 1;
+
+    std::pmr::vector<std::array<float, 3>> m_vertex{};
+    std::pmr::vector<std::array<float, 2>> m_uv{};
+    std::pmr::vector<std::array<float, 3>> m_normal{};
+    std::pmr::vector<std::array<uint32_t, 3>> m_corners{};
+
+    // Blender exports hardpoints as loose vertices of an object without faces
+    std::size_t m_verticeIndexForChunk = 0;
+
+    bool fail( std::string_view msg )
+    {
+        if ( !m_ctx ) return false;
+        m_ctx->errorMessage = msg;
+        m_ctx->errorLine = m_line;
+        m_ctx->errorObject = m_objects->empty() ? "" : m_objects->back().name;
+        return false;
+    }
+
+    static bool isSpace( char c ) noexcept
+    {
+        switch ( c ) {
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\f':
+        case '\v':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    inline void skipSpace() noexcept
+    {
+        while ( m_ptr != m_end && isSpace( *m_ptr ) ) ++m_ptr;
+    }
+
+    inline bool atLineEnd() noexcept
+    {
+        skipSpace();
+        return m_ptr == m_end || *m_ptr == '\n' || *m_ptr == '#';
+    }
+
+    inline void nextLine() noexcept
+    {
+        const void* nl = std::memchr( m_ptr, '\n', static_cast<std::size_t>( m_end - m_ptr ) );
+        m_ptr = nl ? static_cast<const char*>( nl ) + 1 : m_end;
+        m_line++;
+    }
+
+    inline std::string_view word() noexcept
+    {
+        skipSpace();
+        const char* begin = m_ptr;
+        while ( m_ptr != m_end && *m_ptr != '\n' && !isSpace( *m_ptr ) ) ++m_ptr;
+        return { begin, m_ptr };
+    }
+
+    template <typename T>
+    inline bool number( T& value ) noexcept
+    {
+        skipSpace();
+        if ( m_ptr != m_end && *m_ptr == '+' ) ++m_ptr;
+        auto [ ptr, ec ] = std::from_chars( m_ptr, m_end, value );
+        if ( ec != std::errc{} ) [[unlikely]] return false;
+        m_ptr = ptr;
+        return true;
+    }
+
+    template <std::size_t N>
+    inline bool numbers( std::array<float, N>& value ) noexcept
+    {
+        for ( float& it : value ) {
+            if ( !number( it ) ) return false;
+        }
+        return true;
+    }
+
+    // 1 based, negative indices are relative to the end of list
+    static inline bool resolve( int32_t idx, std::size_t size, uint32_t& ret ) noexcept
+    {
+        const int64_t i = idx < 0 ? static_cast<int64_t>( size ) + idx : static_cast<int64_t>( idx ) - 1;
+        ret = static_cast<uint32_t>( i );
+        return i >= 0 && static_cast<std::size_t>( i ) < size;
+    }
+
+    bool corner( std::array<uint32_t, 3>& ret ) noexcept
+    {
+        int32_t v = 0;
+        int32_t t = 0;
+        int32_t n = 0;
+        if ( !number( v ) ) return false;
+        if ( m_ptr == m_end || *m_ptr++ != '/' ) return false;
+        if ( !number( t ) ) return false;
+        if ( m_ptr == m_end || *m_ptr++ != '/' ) return false;
+        if ( !number( n ) ) return false;
+        return resolve( v, m_vertex.size(), ret[ 0 ] )
+            && resolve( t, m_uv.size(), ret[ 1 ] )
+            && resolve( n, m_normal.size(), ret[ 2 ] );
+    }
+
+    void blenderHackMissingPoints()
+    {
+        const std::size_t idx = std::exchange( m_verticeIndexForChunk, m_vertex.size() );
+        if ( m_objects->empty() ) return;
+        SourceObject& o = m_objects->back();
+        if ( !o.data.empty() ) return;
+        assert( idx <= m_vertex.size() );
+        for ( auto it = m_vertex.begin() + static_cast<std::ptrdiff_t>( idx ); it != m_vertex.end(); ++it ) {
+            o.data.insert( o.data.end(), it->begin(), it->end() );
+        }
+    }
+
+    bool object()
+    {
+        blenderHackMissingPoints();
+        const std::string_view name = word();
+        if ( name.empty() ) return fail( "cannot get object name" );
+        SourceObject& o = m_objects->emplace_back();
+        if ( name.size() >= std::size( o.name ) ) return fail( "object name too long" );
+        std::ranges::copy( name, std::begin( o.name ) );
+        return true;
+    }
+
+    // groups split object by material, their faces stay in current object, only first one opens an object
+    bool group()
+    {
+        if ( !m_objects->empty() ) return true;
+        if ( !atLineEnd() ) return object();
+        blenderHackMissingPoints();
+        m_objects->emplace_back();
+        return true;
+    }
+
+    bool face()
+    {
+        if ( m_objects->empty() ) return fail( "requesting to add face to null object" );
+        SourceObject& o = m_objects->back();
+        if ( o.vertexAssembly == VertexAssembly::invalid ) o.vertexAssembly = VertexAssembly::vtn;
+        if ( o.vertexAssembly != VertexAssembly::vtn ) return fail( "mixing face with non-face element in object" );
+
+        m_corners.clear();
+        while ( !atLineEnd() ) {
+            if ( !corner( m_corners.emplace_back() ) ) return fail( "failed to parse face corner, expected v/vt/vn within declared elements" );
+        }
+        if ( m_corners.size() < 3 ) return fail( "face requires at least 3 corners" );
+
+        auto emit = [this, &o]( const std::array<uint32_t, 3>& c )
+        {
+            const auto& v = m_vertex[ c[ 0 ] ];
+            const auto& t = m_uv[ c[ 1 ] ];
+            const auto& n = m_normal[ c[ 2 ] ];
+            const float vtn[ 8 ]{ v[ 0 ], v[ 1 ], v[ 2 ], t[ 0 ], t[ 1 ], n[ 0 ], n[ 1 ], n[ 2 ] };
+            o.data.insert( o.data.end(), std::begin( vtn ), std::end( vtn ) );
+        };
+        for ( std::size_t i = 2; i < m_corners.size(); ++i ) {
+            emit( m_corners[ 0 ] );
+            emit( m_corners[ i - 1 ] );
+            emit( m_corners[ i ] );
+        }
+        return true;
+    }
+
+    bool point()
+    {
+        if ( m_objects->empty() ) return fail( "requesting to add point to null object" );
+        SourceObject& o = m_objects->back();
+        if ( o.vertexAssembly == VertexAssembly::invalid ) o.vertexAssembly = VertexAssembly::v;
+        if ( o.vertexAssembly != VertexAssembly::v ) return fail( "mixing point with non-point element in object" );
+
+        do {
+            int32_t idx = 0;
+            uint32_t v = 0;
+            if ( !number( idx ) || !resolve( idx, m_vertex.size(), v ) ) return fail( "accessing vertex in point out of declared vertices" );
+            o.data.insert( o.data.end(), m_vertex[ v ].begin(), m_vertex[ v ].end() );
+        } while ( !atLineEnd() );
+        return true;
+    }
+
+    bool statement()
+    {
+        const std::string_view cmd = word();
+        if ( cmd.empty() || cmd.front() == '#' ) return true;
+
+        switch ( cmd.size() == 1 ? cmd[ 0 ] : cmd.size() == 2 ? ( cmd[ 0 ] << 8 ) | cmd[ 1 ] : 0 ) {
+        case 'v': {
+            auto& v = m_vertex.emplace_back();
+            if ( !numbers( v ) ) return fail( "failed to parse vertex" );
+            v[ 1 ] *= -1.0f;
+            return true;
+        }
+        case 'vt':
+            if ( !numbers( m_uv.emplace_back() ) ) return fail( "failed to parse uv" );
+            return true;
+        case 'vn':
+            if ( !numbers( m_normal.emplace_back() ) ) return fail( "failed to parse normal" );
+            return true;
+        case 'f': return face();
+        case 'p': return point();
+        case 'o': return object();
+        case 'g': return group();
+        case 'l': return fail( "lines not supported" );
+        default: return true;
+        }
+    }
+};
+
+}
+
+bool read( std::string_view text, std::pmr::vector<SourceObject>& out, ReadContext* ctx )
+{
+    ZoneScoped;
+    Reader reader{
+        .m_ptr = text.data(),
+        .m_end = text.data() + text.size(),
+        .m_objects = &out,
+        .m_ctx = ctx,
+    };
+    // rough guess from typical exports, saves most of reallocations
+    const std::size_t estimate = text.size() / 32;
+    reader.m_vertex.reserve( estimate );
+    reader.m_uv.reserve( estimate );
+    reader.m_normal.reserve( estimate );
+
+    while ( reader.m_ptr != reader.m_end ) {
+        if ( !reader.statement() ) return false;
+        reader.nextLine();
+    }
+    reader.blenderHackMissingPoints();
+    return true;
+}
+
+}
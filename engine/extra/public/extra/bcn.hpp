@@ -0,0 +1,79 @@
+#pragma once
+
+// Block compression encoders and reference decoders.
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace bcn {
+
+enum class Quality : uint8_t {
+    // BC1: endpoints are colors of smallest and largest magnitude
+    // BC7: mode 6 only
+    eFast,
+    // BC1: iterative cluster fit with perceptual error metric
+    // BC7: best of mode 6 and two subset mode 1
+    eHigh,
+};
+
+struct BC1 {
+    uint16_t color0 = 0;
+    uint16_t color1 = 0;
+    uint32_t indices = 0;
+};
+static_assert( sizeof( BC1 ) == 8 );
+
+struct BC4 {
+    uint8_t red0 = 0;
+    uint8_t red1 = 0;
+    uint8_t indices[ 6 ]{};
+};
+static_assert( sizeof( BC4 ) == 8 );
+
+struct BC5 {
+    BC4 red{};
+    BC4 green{};
+};
+static_assert( sizeof( BC5 ) == 16 );
+
+struct BC7 {
+    uint64_t bits[ 2 ]{};
+};
+static_assert( sizeof( BC7 ) == 16 );
+
+// pixels are B8G8R8A8, dimensions must be multiple of 4, alpha is ignored; blocks are returned in row major order
+[[nodiscard]]
+std::pmr::vector<BC1> compressBC1( std::span<const uint8_t> pixels, uint32_t width, uint32_t height, Quality, uint32_t threadCount = 0 );
+
+// decodes into B8G8R8A8
+[[nodiscard]]
+std::pmr::vector<uint8_t> decompressBC1( std::span<const BC1> blocks, uint32_t width, uint32_t height );
+
+// pixels are B8G8R8A8, red and green channels are encoded
+[[nodiscard]]
+std::pmr::vector<BC5> compressBC5( std::span<const uint8_t> pixels, uint32_t width, uint32_t height, uint32_t threadCount = 0 );
+
+// decodes into B8G8R8A8, blue is 0 and alpha is 255
+[[nodiscard]]
+std::pmr::vector<uint8_t> decompressBC5( std::span<const BC5> blocks, uint32_t width, uint32_t height );
+
+// pixels are B8G8R8A8
+[[nodiscard]]
+std::pmr::vector<BC7> compressBC7( std::span<const uint8_t> pixels, uint32_t width, uint32_t height, Quality, uint32_t threadCount = 0 );
+
+// Decodes into B8G8R8A8, fallback for devices without BC7 support.
+// Three subset modes 0 and 2 are not emitted by compressBC7 and decode as opaque magenta.
+[[nodiscard]]
+std::pmr::vector<uint8_t> decompressBC7( std::span<const BC7> blocks, uint32_t width, uint32_t height );
+
+// decodes mip chain of BC7 texture into B8G8R8A8, mips are ordered from largest and must be at least 4x4
+[[nodiscard]]
+std::pmr::vector<uint8_t> decompressBC7( std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t mips, uint32_t layers );
+
+// peak signal to noise ratio of two B8G8R8A8 images, in dB, alpha is included on request
+[[nodiscard]]
+double psnr( std::span<const uint8_t> a, std::span<const uint8_t> b, bool alpha = false );
+
+}
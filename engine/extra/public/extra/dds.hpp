@@ -38,6 +38,10 @@ enum class Format : uint32_t {
     B5G5R5A1_UNORM = 86,
     B8G8R8A8_UNORM = 87,
 
+    BC7_TYPELESS = 97,
+    BC7_UNORM = 98,
+    BC7_UNORM_SRGB = 99,
+
     B4G4R4A4_UNORM = 115,
     // TODO: more formats
 };
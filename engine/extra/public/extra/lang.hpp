@@ -2,8 +2,13 @@
 
 #include <shared/hash.hpp>
 #include <cstdint>
+#include <memory_resource>
+#include <span>
 #include <tuple>
+#include <vector>
 
+// Cooked lockit: Header, uint32_t seed[ buckets ], KeyType[ count ] in slots of minimal perfect hash,
+// then char32_t[ string ] of null terminated values.
 namespace lang {
 struct KeyType {
     Hash::value_type hash = 0;
@@ -25,14 +30,34 @@ static_assert( sizeof( KeyType ) == 12 );
 
 struct Header {
     static constexpr inline uint32_t MAGIC = 'GNAL';
-    static constexpr inline uint32_t VERSION = 2;
+    static constexpr inline uint32_t VERSION = 3;
 
     uint32_t magic = MAGIC;
     uint32_t version = VERSION;
     char id[ 8 ]{};
     uint32_t count = 0;
     uint32_t string = 0;
+    uint32_t buckets = 0;
 };
-static_assert( sizeof( Header ) == 24 );
+static_assert( sizeof( Header ) == 28 );
+
+// average keys sharing one seed, trades table size for time spent searching seeds while cooking
+inline constexpr uint32_t KEYS_PER_BUCKET = 4;
+
+// slot of key with hash h, seed is the one of bucket h % buckets
+constexpr uint32_t slot( Hash::value_type h, uint32_t seed, uint32_t count ) noexcept
+{
+    uint32_t x = h ^ seed;
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x % count;
+}
+
+// Reorders keys into their slots and fills seed of every bucket, false when keys have duplicate hashes.
+[[nodiscard]]
+bool perfectHash( std::span<KeyType> keys, std::pmr::vector<uint32_t>& seeds );
 
 }
@@ -0,0 +1,24 @@
+#pragma once
+
+// LZ77 family block codec, sequence layout follows LZ4 block format:
+// token [literal length 4 bits | match length - 4, 4 bits], optional length bytes, literals, 16 bit match offset
+// https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace lz {
+
+// worst case size of compressed incompressible data
+std::size_t compressBound( std::size_t ) noexcept;
+
+// returns compressed size, 0 when dst is too small
+[[nodiscard]]
+std::size_t compress( std::span<const uint8_t> src, std::span<uint8_t> dst ) noexcept;
+
+// dst must be exactly the size of original data, false on malformed input
+[[nodiscard]]
+bool decompress( std::span<const uint8_t> src, std::span<uint8_t> dst ) noexcept;
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// Mip chain generation for 8 bit textures with 1 or 4 channels.
+// Levels are cascaded in float, each level is filtered from the previous unquantized one,
+// tiles of all layers are processed in parallel.
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace mipgen {
+
+enum class Filter : uint8_t {
+    eBox,
+    eKaiser,
+    eLanczos,
+};
+
+struct Options {
+    Filter filter = Filter::eBox;
+    // color channels are filtered in linear space, alpha is always linear
+    bool srgb = false;
+    // alpha test reference value, when non zero alpha of every mip is scaled to preserve coverage of base level
+    float alphaCoverage = 0.0f;
+    // 0 uses hardware concurrency
+    uint32_t threadCount = 0;
+};
+
+struct Level {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::pmr::vector<uint8_t> pixels{};
+};
+
+// Generates levelCount mips below every layer, returns them layer major without base levels.
+// Layers must have width * height * channels bytes, dimensions divisible by 1 << levelCount.
+// Alpha is the last channel.
+[[nodiscard]]
+std::pmr::vector<Level> generate( std::span<const std::span<const uint8_t>> layers
+    , uint32_t width
+    , uint32_t height
+    , uint32_t channels
+    , uint32_t levelCount
+    , const Options& );
+
+// fraction of pixels with alpha above reference
+[[nodiscard]]
+float alphaCoverage( std::span<const uint8_t> pixels, uint32_t channels, float reference );
+
+}
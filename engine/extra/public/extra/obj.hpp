@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <memory_resource>
 #include <filesystem>
+#include <span>
 #include <vector>
 #include <utility>
 
@@ -12,11 +13,15 @@ enum class VertexAssembly : uint32_t {
     invalid,
     v = 'v',
     vtn = 'ntv',
+    vtnq = 'qntv',
 };
 
+// version 4 adds quantized vtnq chunks, version 3 allows Indices to follow vertices of Chunk,
+// version 2 is non-indexed only
 struct Header {
     static constexpr uint32_t MAGIC = 'CJBO';
-    static constexpr uint32_t VERSION = 2;
+    static constexpr uint32_t VERSION = 4;
+    static constexpr uint32_t VERSION_NON_INDEXED = 2;
     uint32_t magic = MAGIC;
     uint32_t version = VERSION;
     uint32_t chunkCount = 0;
@@ -24,6 +29,7 @@ struct Header {
     Header() noexcept = default;
 };
 
+// for vtnq floatCount is count of 32 bit words of PackedVertex data, preceded by Quantization
 struct Chunk {
     static constexpr uint32_t MAGIC = 'KNHC';
     uint32_t magic = MAGIC;
@@ -34,5 +40,56 @@ struct Chunk {
     Chunk() noexcept = default;
 };
 
-std::pmr::vector<std::pair<Chunk, std::pmr::vector<float>>> parse( std::pmr::vector<uint8_t>&& );
+// decoded = unorm * scale + bias
+struct Quantization {
+    static constexpr uint32_t MAGIC = 'TNAQ';
+    uint32_t magic = MAGIC;
+    float positionScale[ 3 ]{ 1.0f, 1.0f, 1.0f };
+    float positionBias[ 3 ]{};
+    float uvScale[ 2 ]{ 1.0f, 1.0f };
+    float uvBias[ 2 ]{};
+
+    Quantization() noexcept = default;
+};
+
+// 16 bit unorm position (w unused) and uv, 16 bit snorm octahedral normal
+struct PackedVertex {
+    uint16_t position[ 4 ]{};
+    uint16_t uv[ 2 ]{};
+    int16_t normal[ 2 ]{};
+};
+static_assert( sizeof( PackedVertex ) == 16 );
+
+// 16 bit triangle list indices, padded to 4 bytes
+struct Indices {
+    static constexpr uint32_t MAGIC = 'XDNI';
+    uint32_t magic = MAGIC;
+    uint32_t indexCount = 0;
+
+    Indices() noexcept = default;
+
+    static constexpr uint32_t paddedSize( uint32_t indexCount ) noexcept
+    {
+        return ( indexCount * static_cast<uint32_t>( sizeof( uint16_t ) ) + 3u ) & ~3u;
+    }
+};
+
+struct Object {
+    Chunk chunk{};
+    Quantization quantization{};
+    std::pmr::vector<float> vertices{};
+    std::pmr::vector<PackedVertex> packed{};
+    std::pmr::vector<uint16_t> indices{};
+};
+
+std::pmr::vector<Object> parse( std::pmr::vector<uint8_t>&& );
+
+// vtn vertices: 3 floats position, 2 floats uv, 3 floats normal
+static constexpr uint32_t VTN_STRIDE = 8;
+
+[[nodiscard]]
+Quantization quantize( std::span<const float> vtn, std::pmr::vector<PackedVertex>& out );
+
+[[nodiscard]]
+std::pmr::vector<float> dequantize( const Quantization&, std::span<const PackedVertex> );
 } // namespace obj
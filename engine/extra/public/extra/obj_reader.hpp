@@ -0,0 +1,32 @@
+#pragma once
+
+#include <extra/obj.hpp>
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace obj {
+
+// Object of Wavefront OBJ source: faces expanded to vtn triangle list, points to v list.
+// Position y axis is flipped to engine convention.
+struct SourceObject {
+    char name[ 52 ]{};
+    VertexAssembly vertexAssembly = VertexAssembly::invalid;
+    std::pmr::vector<float> data{};
+};
+
+struct ReadContext {
+    std::pmr::string errorMessage{};
+    std::pmr::string errorObject{};
+    uint32_t errorLine = 0;
+};
+
+// Single pass reader, supports v, vt, vn, f, p, o, g; negative indices; polygons are fan triangulated.
+// Other statements are ignored, lines are rejected.
+[[nodiscard]]
+bool read( std::string_view text, std::pmr::vector<SourceObject>& out, ReadContext* ctx = nullptr );
+
+}
@@ -2,6 +2,7 @@
 
 // pak format reference
 // https://quakewiki.org/wiki/.pak
+// extended with format version, optionally compressed entries and name hash index
 
 #include <cstdint>
 
@@ -9,18 +10,37 @@ namespace pak {
 
 struct Header {
     static constexpr inline uint32_t MAGIC = 'KCAP';
+    static constexpr inline uint32_t VERSION = 3;
 
     uint32_t magic = MAGIC;
     uint32_t offset = sizeof( Header );
     uint32_t size = 0;
+    uint32_t version = VERSION;
+    uint32_t indexOffset = 0;
+    uint32_t indexSize = 0;
 };
-static_assert( sizeof( Header ) == 12 );
+static_assert( sizeof( Header ) == 24 );
 
 struct alignas( 64 ) Entry {
-    char name[ 56 ]{};
+    enum class Compression : uint32_t {
+        eNone,
+        eLZ,
+    };
+
+    char name[ 48 ]{};
     uint32_t offset = 0;
+    // bytes stored in archive
     uint32_t size = 0;
+    uint32_t uncompressedSize = 0;
+    Compression compression = Compression::eNone;
 };
 static_assert( sizeof( Entry ) == 64 );
 
+// one per Entry, sorted by hash then entry; hash is shared/hash.hpp Hash of Entry::name
+struct IndexEntry {
+    uint32_t hash = 0;
+    uint32_t entry = 0;
+};
+static_assert( sizeof( IndexEntry ) == 8 );
+
 }
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+
+// 0 resolves to hardware concurrency
+[[nodiscard]]
+inline uint32_t threadCount( uint32_t requested ) noexcept
+{
+    return requested ? requested : std::max( std::thread::hardware_concurrency(), 1u );
+}
+
+// Runs func( job, worker ) for every job in [0, count), jobs are picked in order by up to threadCount workers.
+// Calling thread is worker 0, worker index is below threadCount.
+template <typename TFunc>
+void forEach( std::size_t count, uint32_t threadCount, const TFunc& func )
+{
+    std::atomic<std::size_t> next = 0;
+    auto worker = [&next, count, &func]( uint32_t workerIndex )
+    {
+        for ( std::size_t i = next++; i < count; i = next++ ) {
+            func( i, workerIndex );
+        }
+    };
+    const uint32_t workers = static_cast<uint32_t>( std::clamp<std::size_t>( threadCount, 1, std::max<std::size_t>( count, 1 ) ) );
+    std::pmr::vector<std::thread> threads{};
+    threads.reserve( workers - 1 );
+    for ( uint32_t i = 1; i < workers; ++i ) {
+        threads.emplace_back( worker, i );
+    }
+    worker( 0 );
+    std::ranges::for_each( threads, []( auto& t ) { t.join(); } );
+}
+
+}
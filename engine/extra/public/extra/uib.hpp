@@ -0,0 +1,114 @@
+#pragma once
+
+#include <shared/hash.hpp>
+
+#include <array>
+#include <cstdint>
+
+// Cooked ui screen: Header, then Node[ nodeCount ] in depth-first order, then Property[ propertyCount ]
+// in order of nodes owning them.
+namespace uib {
+
+enum class Widget : uint8_t {
+    eButton,
+    eComboBox,
+    eImage,
+    eLabel,
+    eNineSlice,
+    eProgressbar,
+    eSpinBox,
+    eAnimFrame,
+    eFooter,
+    eFooterButton,
+    count,
+};
+
+inline constexpr std::array<Hash::value_type, static_cast<uint32_t>( Widget::count )> WIDGET_NAMES = {
+    "Button"_hash,
+    "ComboBox"_hash,
+    "Image"_hash,
+    "Label"_hash,
+    "NineSlice"_hash,
+    "Progressbar"_hash,
+    "SpinBox"_hash,
+    "AnimFrame"_hash,
+    "Footer"_hash,
+    "Button"_hash,
+};
+
+enum class Kind : uint8_t {
+    eUnknown,
+    eFloat,
+    eUint,
+    // string value is stored as its hash: lockit keys, sprite paths, data models, anchors...
+    eHash,
+};
+
+constexpr Kind propertyKind( Hash::value_type key ) noexcept
+{
+    switch ( key ) {
+    case "x"_hash:
+    case "y"_hash:
+    case "width"_hash:
+    case "height"_hash:
+    case "spriteSpacing"_hash:
+        return Kind::eFloat;
+    case "count"_hash:
+    case "glow"_hash:
+        return Kind::eUint;
+    case "anchor"_hash:
+    case "color"_hash:
+    case "data"_hash:
+    case "font"_hash:
+    case "goto"_hash:
+    case "input"_hash:
+    case "name"_hash:
+    case "path"_hash:
+    case "scene"_hash:
+    case "style"_hash:
+    case "text"_hash:
+    case "trigger"_hash:
+    case "frame0"_hash: case "frame1"_hash: case "frame2"_hash: case "frame3"_hash:
+    case "frame4"_hash: case "frame5"_hash: case "frame6"_hash: case "frame7"_hash:
+    case "frame8"_hash: case "frame9"_hash: case "frame10"_hash: case "frame11"_hash:
+    case "frame12"_hash: case "frame13"_hash: case "frame14"_hash: case "frame15"_hash:
+        return Kind::eHash;
+    default:
+        return Kind::eUnknown;
+    }
+}
+
+struct Header {
+    static constexpr inline uint32_t MAGIC = 'NRCS';
+    static constexpr inline uint32_t VERSION = 1;
+
+    uint32_t magic = MAGIC;
+    uint32_t version = VERSION;
+    Hash::value_type name = 0;
+    Hash::value_type scene = 0;
+    float width = 1.0f;
+    float height = 1.0f;
+    uint32_t glow = 0;
+    uint32_t rootCount = 0;
+    uint32_t nodeCount = 0;
+    uint32_t propertyCount = 0;
+    // instances of each widget type, lets runtime size storage of whole screen up front
+    std::array<uint16_t, static_cast<uint32_t>( Widget::count )> widgetCount{};
+};
+static_assert( sizeof( Header ) == 60 );
+
+struct Node {
+    Widget type{};
+    uint8_t propertyCount = 0;
+    uint16_t childCount = 0;
+};
+static_assert( sizeof( Node ) == 4 );
+
+struct Property {
+    Hash::value_type key = 0;
+    // float bits, integer or hash, by propertyKind( key )
+    uint32_t value = 0;
+};
+static_assert( sizeof( Property ) == 8 );
+
+}
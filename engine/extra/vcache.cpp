@@ -0,0 +1,234 @@
+#include <extra/vcache.hpp>
+
+#include <profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace vcache {
+
+static constexpr uint32_t INVALID = ~0u;
+static constexpr uint32_t CACHE_SIZE = 32;
+static constexpr float CACHE_DECAY_POWER = 1.5f;
+static constexpr float LAST_TRI_SCORE = 0.75f;
+static constexpr float VALENCE_BOOST_SCALE = 2.0f;
+static constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+static uint32_t hashVertex( const float* vertex, uint32_t stride ) noexcept
+{
+    uint32_t ret = 2166136261u;
+    for ( uint32_t i = 0; i < stride; ++i ) {
+        ret ^= std::bit_cast<uint32_t>( vertex[ i ] );
+        ret *= 16777619u;
+    }
+    return ret ^ ( ret >> 15 );
+}
+
+Welded weld( std::span<const float> vertices, uint32_t stride )
+{
+    ZoneScoped;
+    assert( stride );
+    assert( vertices.size() % stride == 0 );
+    const uint32_t count = static_cast<uint32_t>( vertices.size() / stride );
+
+    // open addressing over welded vertex ids, at most half full
+    const uint32_t tableSize = std::bit_ceil( std::max( count, 1u ) * 2 );
+    std::pmr::vector<uint32_t> table( tableSize, INVALID );
+
+    Welded ret{};
+    ret.indices.resize( count );
+    ret.vertices.reserve( vertices.size() );
+    for ( uint32_t i = 0; i < count; ++i ) {
+        const float* vertex = vertices.data() + i * stride;
+        uint32_t slot = hashVertex( vertex, stride ) & ( tableSize - 1 );
+        for ( ;; slot = ( slot + 1 ) & ( tableSize - 1 ) ) {
+            const uint32_t id = table[ slot ];
+            if ( id == INVALID ) {
+                const uint32_t newId = static_cast<uint32_t>( ret.vertices.size() / stride );
+                table[ slot ] = newId;
+                ret.vertices.insert( ret.vertices.end(), vertex, vertex + stride );
+                ret.indices[ i ] = newId;
+                break;
+            }
+            if ( std::memcmp( ret.vertices.data() + id * stride, vertex, stride * sizeof( float ) ) == 0 ) {
+                ret.indices[ i ] = id;
+                break;
+            }
+        }
+    }
+    return ret;
+}
+
+static float vertexScore( int32_t cachePosition, uint32_t remainingTriangles ) noexcept
+{
+    if ( remainingTriangles == 0 ) return -1.0f;
+
+    float score = 0.0f;
+    if ( cachePosition >= 0 ) {
+        if ( cachePosition < 3 ) {
+            score = LAST_TRI_SCORE;
+        }
+        else {
+            const float scaler = 1.0f / static_cast<float>( CACHE_SIZE - 3 );
+            score = std::pow( 1.0f - static_cast<float>( cachePosition - 3 ) * scaler, CACHE_DECAY_POWER );
+        }
+    }
+    return score + VALENCE_BOOST_SCALE * std::pow( static_cast<float>( remainingTriangles ), -VALENCE_BOOST_POWER );
+}
+
+void optimizeTriangles( std::span<uint32_t> indices, uint32_t vertexCount )
+{
+    ZoneScoped;
+    assert( indices.size() % 3 == 0 );
+    const uint32_t triangleCount = static_cast<uint32_t>( indices.size() / 3 );
+    if ( triangleCount < 2 ) return;
+
+    // per vertex list of triangles not emitted yet
+    std::pmr::vector<uint32_t> remaining( vertexCount );
+    for ( uint32_t idx : indices ) {
+        assert( idx < vertexCount );
+        remaining[ idx ]++;
+    }
+    std::pmr::vector<uint32_t> offsets( vertexCount + 1 );
+    for ( uint32_t i = 0; i < vertexCount; ++i ) {
+        offsets[ i + 1 ] = offsets[ i ] + remaining[ i ];
+    }
+    std::pmr::vector<uint32_t> adjacency( indices.size() );
+    {
+        std::pmr::vector<uint32_t> cursor{ offsets.begin(), offsets.end() - 1 };
+        for ( uint32_t i = 0; i < indices.size(); ++i ) {
+            adjacency[ cursor[ indices[ i ] ]++ ] = i / 3;
+        }
+    }
+
+    std::pmr::vector<int32_t> cachePosition( vertexCount, -1 );
+    std::pmr::vector<float> vertexScores( vertexCount );
+    for ( uint32_t i = 0; i < vertexCount; ++i ) {
+        vertexScores[ i ] = vertexScore( -1, remaining[ i ] );
+    }
+
+    std::pmr::vector<uint8_t> emitted( triangleCount );
+    auto triangleScore = [&indices, &vertexScores]( uint32_t t )
+    {
+        return vertexScores[ indices[ t * 3 ] ] + vertexScores[ indices[ t * 3 + 1 ] ] + vertexScores[ indices[ t * 3 + 2 ] ];
+    };
+
+    std::array<uint32_t, CACHE_SIZE + 3> cache{};
+    std::array<uint32_t, CACHE_SIZE + 3> nextCache{};
+    uint32_t cacheCount = 0;
+
+    std::pmr::vector<uint32_t> output;
+    output.reserve( indices.size() );
+
+    uint32_t best = 0;
+    for ( uint32_t t = 1; t < triangleCount; ++t ) {
+        if ( triangleScore( t ) > triangleScore( best ) ) best = t;
+    }
+    uint32_t cursor = 0;
+    for ( uint32_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount ) {
+        if ( best == INVALID ) {
+            // cache ran dry, continue with next triangle in original order
+            while ( emitted[ cursor ] ) cursor++;
+            best = cursor;
+        }
+        assert( !emitted[ best ] );
+        emitted[ best ] = 1;
+
+        const uint32_t* triangle = indices.data() + best * 3;
+        output.insert( output.end(), triangle, triangle + 3 );
+
+        uint32_t nextCount = 0;
+        for ( uint32_t i = 0; i < 3; ++i ) {
+            const uint32_t v = triangle[ i ];
+            auto begin = adjacency.begin() + offsets[ v ];
+            auto end = begin + remaining[ v ];
+            auto it = std::find( begin, end, best );
+            assert( it != end );
+            std::iter_swap( it, end - 1 );
+            remaining[ v ]--;
+            nextCache[ nextCount++ ] = v;
+        }
+        for ( uint32_t i = 0; i < cacheCount; ++i ) {
+            const uint32_t v = cache[ i ];
+            if ( v == triangle[ 0 ] || v == triangle[ 1 ] || v == triangle[ 2 ] ) continue;
+            nextCache[ nextCount++ ] = v;
+        }
+
+        for ( uint32_t i = 0; i < nextCount; ++i ) {
+            const uint32_t v = nextCache[ i ];
+            cachePosition[ v ] = i < CACHE_SIZE ? static_cast<int32_t>( i ) : -1;
+            vertexScores[ v ] = vertexScore( cachePosition[ v ], remaining[ v ] );
+        }
+
+        best = INVALID;
+        float bestScore = -1.0f;
+        for ( uint32_t i = 0; i < nextCount; ++i ) {
+            const uint32_t v = nextCache[ i ];
+            const uint32_t begin = offsets[ v ];
+            const uint32_t end = begin + remaining[ v ];
+            for ( uint32_t j = begin; j < end; ++j ) {
+                const uint32_t t = adjacency[ j ];
+                const float score = triangleScore( t );
+                if ( score > bestScore ) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+
+        cacheCount = std::min( nextCount, CACHE_SIZE );
+        std::copy_n( nextCache.begin(), cacheCount, cache.begin() );
+    }
+
+    std::ranges::copy( output, indices.begin() );
+}
+
+void optimizeFetch( std::span<uint32_t> indices, std::span<float> vertices, uint32_t stride )
+{
+    ZoneScoped;
+    assert( stride );
+    assert( vertices.size() % stride == 0 );
+    const uint32_t vertexCount = static_cast<uint32_t>( vertices.size() / stride );
+
+    std::pmr::vector<uint32_t> remap( vertexCount, INVALID );
+    uint32_t next = 0;
+    for ( uint32_t& idx : indices ) {
+        assert( idx < vertexCount );
+        if ( remap[ idx ] == INVALID ) {
+            remap[ idx ] = next++;
+        }
+        idx = remap[ idx ];
+    }
+    // unreferenced vertices go last
+    for ( uint32_t& it : remap ) {
+        if ( it == INVALID ) it = next++;
+    }
+
+    std::pmr::vector<float> reordered( vertices.size() );
+    for ( uint32_t i = 0; i < vertexCount; ++i ) {
+        std::copy_n( vertices.data() + i * stride, stride, reordered.data() + remap[ i ] * stride );
+    }
+    std::ranges::copy( reordered, vertices.begin() );
+}
+
+float acmr( std::span<const uint32_t> indices, uint32_t cacheSize )
+{
+    assert( cacheSize );
+    if ( indices.size() < 3 ) return 0.0f;
+
+    // FIFO cache, vertex is resident when inserted within last cacheSize misses
+    const uint32_t vertexCount = *std::ranges::max_element( indices ) + 1;
+    std::pmr::vector<uint32_t> insertedAt( vertexCount, INVALID );
+    uint32_t misses = 0;
+    for ( uint32_t idx : indices ) {
+        if ( insertedAt[ idx ] != INVALID && misses - insertedAt[ idx ] < cacheSize ) continue;
+        insertedAt[ idx ] = misses++;
+    }
+    return static_cast<float>( misses ) / static_cast<float>( indices.size() / 3 );
+}
+
+}
@@ -13,7 +13,7 @@ struct PipelineCreateInfo {
     enum class Topology : uint8_t { eLineStrip, eLineList, eTriangleFan, eTriangleList, eTriangleStrip };
     enum class CullMode : uint8_t { eNone, eFront, eBack };
     enum class FrontFace : uint8_t { eCW, eCCW };
-    enum class InputType : uint8_t { eNone, eF2, eF3, eU, eU2 };
+    enum class InputType : uint8_t { eNone, eF2, eF3, eU, eU2, eUN16x2, eUN16x4, eSN16x2 };
     enum class BlendMode : uint8_t { eNone, eAlpha, eAdditive };
     struct Assembly {
         InputType m_input{};
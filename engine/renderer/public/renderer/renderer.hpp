@@ -50,8 +50,25 @@ struct RenderInfo {
     std::array<Texture, MAX_TEXTURES> m_fragmentTexture{};
 };
 
+struct GpuScopeTiming {
+    std::string_view name{};
+    uint64_t beginNs = 0;
+    uint64_t endNs = 0;
+    float milliseconds = 0.0f;
+};
+
+// Sink of draw and dispatch commands, either the renderer itself or a recording context owned by a worker thread.
+class RecordingContext {
+public:
+    virtual ~RecordingContext() noexcept = default;
+    RecordingContext() noexcept = default;
+
+    virtual void render( const RenderInfo& ) = 0;
+    virtual void dispatch( const DispatchInfo& ) = 0;
+};
+
 class Engine;
-class Renderer {
+class Renderer : public RecordingContext {
 public:
     virtual ~Renderer() noexcept = default;
     Renderer() noexcept = default;
@@ -61,6 +78,8 @@ public:
     enum class Feature : uint32_t {
         eVSyncMailbox,
         eVRSAA,
+        eGpuTimestamps,
+        eBC7,
     };
 
     virtual bool featureAvailable( Feature ) const = 0;
@@ -68,17 +87,44 @@ public:
     virtual void setVSync( VSync ) = 0;
 
     [[nodiscard]] virtual PipelineSlot createPipeline( const PipelineCreateInfo& ) = 0;
+    // slot keeps its value, previous pipeline is destroyed at end of frame; game thread only
+    virtual void replacePipeline( PipelineSlot, const PipelineCreateInfo& ) = 0;
     [[nodiscard]] virtual Buffer createBuffer( std::span<const uint8_t> ) = 0;
     virtual void deleteBuffer( Buffer ) = 0;
 
     [[nodiscard]] virtual Texture createTexture( const TextureCreateInfo&, std::span<const uint8_t> ) = 0;
     virtual void deleteTexture( Texture ) = 0;
+    // Texture slot is kept so copies of the handle sample new content, previous texture is destroyed at end of frame.
+    // Returned handle differs only when channel count changes.
+    [[nodiscard]] virtual Texture replaceTexture( Texture, const TextureCreateInfo&, std::span<const uint8_t> ) = 0;
 
-    virtual void render( const RenderInfo& ) = 0;
-    virtual void dispatch( const DispatchInfo& ) = 0;
+    // render() and dispatch() record directly into current frame, game thread only
+    virtual void render( const RenderInfo& ) override = 0;
+    virtual void dispatch( const DispatchInfo& ) override = 0;
+
+    // Thread-safe, context may be recorded on any thread until endRecording(), valid for current frame only.
+    // Contexts are executed in ascending order of unique order keys, after direct draws. Direct dispatch() executes
+    // ended ones up to the first context still being recorded, the rest wait for a later dispatch() or end of frame,
+    // which waits until every context has ended.
+    [[nodiscard]] virtual RecordingContext* beginRecording( uint32_t order ) = 0;
+    virtual void endRecording( RecordingContext* ) = 0;
 
     virtual void setResolution( uint32_t width, uint32_t height ) = 0;
 
+    // name has to outlive resolved timings, prefer string literals
+    virtual void beginGpuScope( std::string_view ) = 0;
+    virtual void endGpuScope() = 0;
+    // non-blocking, timings are resolved few frames after being recorded; false when nothing new since last call
+    virtual bool gpuTimings( std::pmr::vector<GpuScopeTiming>& ) = 0;
+
+    struct Statistics {
+        uint64_t uniformBytesUploaded = 0;
+        uint64_t uniformBytesCopied = 0;
+        uint32_t uniformBlocks = 0;
+    };
+    // of last submitted frame
+    virtual Statistics statistics() const = 0;
+
     struct CreateInfo{
         SDL_Window* window = nullptr;
         VSync vsync = {};
@@ -101,15 +147,30 @@ protected:
     virtual void present() = 0;
 };
 
+struct GpuScope {
+    Renderer* renderer{};
+
+    GpuScope( Renderer* r, std::string_view name )
+    : renderer{ r }
+    {
+        assert( renderer );
+        renderer->beginGpuScope( name );
+    }
+
+    ~GpuScope()
+    {
+        renderer->endGpuScope();
+    }
+};
 
 template <typename TPushConstant>
 struct InstancedRendering {
     using Instance = typename TPushConstant::Instance;
-    Renderer* renderer{};
+    RecordingContext* renderer{};
     RenderInfo renderInfo{ .m_instanceCount = 0, };
     TPushConstant pushConstant{};
 
-    InstancedRendering( Renderer* r, PipelineSlot p )
+    InstancedRendering( RecordingContext* r, PipelineSlot p )
     : renderer{ r }
     {
         renderInfo.m_pipeline = p;
@@ -15,6 +15,7 @@ enum class TextureFormat : uint8_t {
     eBC3_unorm,
     eBC4_unorm,
     eBC5_unorm,
+    eBC7_unorm,
     eB4G4R4A4_unorm,
 };
 
@@ -12,23 +12,38 @@ CommandPool::~CommandPool() noexcept
     destroy<vkDestroyCommandPool>( m_device, m_pool );
 }
 
-CommandPool::CommandPool( VkDevice device, uint32_t count, uint32_t queueFamily ) noexcept
-: m_device{ device }
+static VkCommandPool createPool( VkDevice device, uint32_t queueFamily )
 {
-    ZoneScoped;
-    assert( device );
-    assert( count > 0 );
-    assert( count <= m_buffers.size() );
-
     const VkCommandPoolCreateInfo poolInfo{
         .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
         .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
         .queueFamilyIndex = queueFamily,
     };
 
+    VkCommandPool pool = VK_NULL_HANDLE;
     [[maybe_unused]]
-    const VkResult poolOK = vkCreateCommandPool( m_device, &poolInfo, nullptr, &m_pool );
+    const VkResult poolOK = vkCreateCommandPool( device, &poolInfo, nullptr, &pool );
     assert( poolOK == VK_SUCCESS );
+    return pool;
+}
+
+CommandPool::CommandPool( VkDevice device, uint32_t queueFamily ) noexcept
+: m_device{ device }
+{
+    ZoneScoped;
+    assert( device );
+    m_pool = createPool( m_device, queueFamily );
+}
+
+CommandPool::CommandPool( VkDevice device, uint32_t count, uint32_t queueFamily ) noexcept
+: m_device{ device }
+{
+    ZoneScoped;
+    assert( device );
+    assert( count > 0 );
+    assert( count <= m_buffers.size() );
+
+    m_pool = createPool( m_device, queueFamily );
 
     const VkCommandBufferAllocateInfo allocInfo{
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
@@ -47,6 +62,8 @@ CommandPool::CommandPool( CommandPool&& rhs ) noexcept
     std::swap( m_device, rhs.m_device );
     std::swap( m_pool, rhs.m_pool );
     std::swap( m_buffers, rhs.m_buffers );
+    std::swap( m_secondary, rhs.m_secondary );
+    std::swap( m_secondaryCurrent, rhs.m_secondaryCurrent );
 }
 
 CommandPool& CommandPool::operator = ( CommandPool&& rhs ) noexcept
@@ -54,6 +71,8 @@ CommandPool& CommandPool::operator = ( CommandPool&& rhs ) noexcept
     std::swap( m_device, rhs.m_device );
     std::swap( m_pool, rhs.m_pool );
     std::swap( m_buffers, rhs.m_buffers );
+    std::swap( m_secondary, rhs.m_secondary );
+    std::swap( m_secondaryCurrent, rhs.m_secondaryCurrent );
     return *this;
 }
 
@@ -63,8 +82,27 @@ VkCommandBuffer CommandPool::operator [] ( uint32_t idx )
     return m_buffers[ idx ];
 }
 
+VkCommandBuffer CommandPool::nextSecondary()
+{
+    if ( m_secondaryCurrent == m_secondary.size() ) [[unlikely]] {
+        const VkCommandBufferAllocateInfo allocInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = m_pool,
+            .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+            .commandBufferCount = 1,
+        };
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        [[maybe_unused]]
+        const VkResult allocOK = vkAllocateCommandBuffers( m_device, &allocInfo, &cmd );
+        assert( allocOK == VK_SUCCESS );
+        m_secondary.push_back( cmd );
+    }
+    return m_secondary[ m_secondaryCurrent++ ];
+}
+
 void CommandPool::reset()
 {
+    m_secondaryCurrent = 0;
     [[maybe_unused]]
     const VkResult result = vkResetCommandPool( m_device, m_pool, VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT );
     assert( result == VK_SUCCESS );
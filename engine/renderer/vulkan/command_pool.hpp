@@ -4,16 +4,22 @@
 
 #include <cstdint>
 #include <array>
+#include <memory_resource>
+#include <vector>
 
 class CommandPool {
     VkDevice m_device = VK_NULL_HANDLE;
     VkCommandPool m_pool = VK_NULL_HANDLE;
     std::array<VkCommandBuffer, 3> m_buffers{};
+    std::pmr::vector<VkCommandBuffer> m_secondary{};
+    uint32_t m_secondaryCurrent = 0;
 
 public:
     ~CommandPool() noexcept;
     CommandPool() noexcept = default;
     CommandPool( VkDevice device, uint32_t count, uint32_t queueFamily ) noexcept;
+    // secondary buffers only, allocated on demand by nextSecondary()
+    CommandPool( VkDevice device, uint32_t queueFamily ) noexcept;
 
     CommandPool( const CommandPool& ) = delete;
     CommandPool& operator = ( const CommandPool& ) = delete;
@@ -22,5 +28,6 @@ public:
     CommandPool& operator = ( CommandPool&& ) noexcept;
 
     VkCommandBuffer operator [] ( uint32_t );
+    VkCommandBuffer nextSecondary();
     void reset();
 };
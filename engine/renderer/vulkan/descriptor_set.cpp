@@ -89,12 +89,31 @@ static VkDescriptorSetLayout createLayout( VkDevice device, const PipelineCreate
     return ret;
 }
 
+static PipelineCreateInfo fromBindingID( uint64_t bindingID )
+{
+    PipelineCreateInfo pci{};
+    pci.m_computeImageCount = static_cast<uint8_t>( bindingID ); bindingID >>= 8;
+    pci.m_computeUniformCount = static_cast<uint8_t>( bindingID ); bindingID >>= 8;
+    pci.m_fragmentImageCount = static_cast<uint8_t>( bindingID ); bindingID >>= 8;
+    pci.m_vertexUniformCount = static_cast<uint8_t>( bindingID );
+    return pci;
+}
+
 DescriptorSet::DescriptorSet( VkDevice device, const PipelineCreateInfo& pci ) noexcept
+: DescriptorSet{ device, pci, !pci.m_computeShaderData.empty() }
+{
+}
+
+DescriptorSet::DescriptorSet( VkDevice device, uint64_t bindingID ) noexcept
+: DescriptorSet{ device, fromBindingID( bindingID ), ( bindingID & 0xFFFFull ) != 0 }
+{
+}
+
+DescriptorSet::DescriptorSet( VkDevice device, const PipelineCreateInfo& pci, bool compute ) noexcept
 : m_device{ device }
 {
     ZoneScoped;
     m_layout = createLayout( m_device, pci );
-    bool compute = !pci.m_computeShaderData.empty();
     m_uniformCount = compute ? pci.m_computeUniformCount : pci.m_vertexUniformCount;
     m_imagesCount = compute ? pci.m_computeImageCount : pci.m_fragmentImageCount;
     if ( m_imagesCount > 0 ) {
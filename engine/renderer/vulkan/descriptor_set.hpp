@@ -20,17 +20,21 @@ class DescriptorSet {
     VkDescriptorType m_imageType{};
 
     void expandCapacityBy( uint32_t );
+    DescriptorSet( VkDevice, const PipelineCreateInfo&, bool compute ) noexcept;
 
 public:
     ~DescriptorSet() noexcept;
     DescriptorSet() noexcept = default;
 
     DescriptorSet( VkDevice, const PipelineCreateInfo& ) noexcept;
+    // layout compatible with every set created from the same binding id
+    DescriptorSet( VkDevice, uint64_t bindingID ) noexcept;
     DescriptorSet( DescriptorSet&& ) noexcept;
 
     DescriptorSet& operator = ( DescriptorSet&& ) noexcept;
 
     VkDescriptorSetLayout layout() const;
+    inline operator bool () const noexcept { return m_layout; }
     VkDescriptorSet next();
     void reset();
 
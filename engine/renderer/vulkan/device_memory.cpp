@@ -29,7 +29,8 @@ DeviceMemory& DeviceMemory::operator = ( DeviceMemory&& rhs ) noexcept
     return *this;
 }
 
-static uint32_t memoryType( VkPhysicalDevice device, uint32_t typeBits, VkMemoryPropertyFlags flags )
+static constexpr uint32_t INVALID_MEMORY_TYPE = ~0u;
+static uint32_t findMemoryType( VkPhysicalDevice device, uint32_t typeBits, VkMemoryPropertyFlags flags )
 {
     VkPhysicalDeviceMemoryProperties memProperties{};
     vkGetPhysicalDeviceMemoryProperties( device, &memProperties );
@@ -43,10 +44,26 @@ static uint32_t memoryType( VkPhysicalDevice device, uint32_t typeBits, VkMemory
         }
         return i;
     }
+    return INVALID_MEMORY_TYPE;
+}
+
+static uint32_t memoryType( VkPhysicalDevice device, uint32_t typeBits, VkMemoryPropertyFlags flags )
+{
+    const uint32_t type = findMemoryType( device, typeBits, flags );
+    if ( type != INVALID_MEMORY_TYPE ) [[likely]] return type;
     assert( !"failed to find requested memory type" );
     return 0;
 }
 
+bool DeviceMemory::hasMemoryType( VkPhysicalDevice physDevice, VkDevice device, VkBuffer buffer, VkMemoryPropertyFlags flags ) noexcept
+{
+    assert( device );
+    assert( buffer );
+    VkMemoryRequirements memRequirements{};
+    vkGetBufferMemoryRequirements( device, buffer, &memRequirements );
+    return findMemoryType( physDevice, memRequirements.memoryTypeBits, flags ) != INVALID_MEMORY_TYPE;
+}
+
 DeviceMemory::DeviceMemory( VkPhysicalDevice physDevice, VkDevice device, VkBuffer buffer, VkMemoryPropertyFlags flags ) noexcept
 : m_device{ device }
 {
@@ -24,4 +24,6 @@ public:
     operator VkDeviceMemory () const noexcept;
 
     uint32_t size() const noexcept;
+
+    static bool hasMemoryType( VkPhysicalDevice, VkDevice, VkBuffer, VkMemoryPropertyFlags ) noexcept;
 };
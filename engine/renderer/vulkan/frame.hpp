@@ -2,16 +2,30 @@
 
 #include "descriptor_set.hpp"
 #include "image.hpp"
+#include "recording_context_vk.hpp"
+#include "timestamp_pool.hpp"
 #include "uniform.hpp"
 
+#include <shared/pmr_pointer.hpp>
+
+#include <array>
+#include <memory_resource>
+#include <vector>
+
 struct Frame
 {
     enum class State : uint32_t {
         eNone,
         eGraphics,
         eCompute,
+        eSecondary, // rendering executes secondary command buffers only
+        eStitched, // rendering ended after executing secondary command buffers
     };
     State m_state = State::eNone;
+    DrawState m_drawState{};
+    bool m_timestampsEnabled = false;
+    uint32_t m_scopeDepthPrepass = TimestampPool::MAX_SCOPES;
+    uint32_t m_scopeColorPass = TimestampPool::MAX_SCOPES;
     VkCommandBuffer m_cmdUniform{};
     VkCommandBuffer m_cmdDepthPrepass{};
     VkCommandBuffer m_cmdColorPass{};
@@ -21,4 +35,7 @@ struct Frame
     Uniform m_uniformBuffer{};
     std::array<DescriptorSet, 32> m_descriptorSets{};
     CommandPool m_commandPool{};
+    TimestampPool m_timestamps{};
+    std::pmr::vector<UniquePointer<RecordingContextVK>> m_recordings{};
+    uint32_t m_recordingsUsed = 0;
 };
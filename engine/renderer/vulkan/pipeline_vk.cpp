@@ -57,6 +57,9 @@ static constexpr auto inputType( PipelineCreateInfo::InputType it )
     case eF3: return VK_FORMAT_R32G32B32_SFLOAT;
     case eU: return VK_FORMAT_R32_UINT;
     case eU2: return VK_FORMAT_R32G32_UINT;
+    case eUN16x2: return VK_FORMAT_R16G16_UNORM;
+    case eUN16x4: return VK_FORMAT_R16G16B16A16_UNORM;
+    case eSN16x2: return VK_FORMAT_R16G16_SNORM;
     }
 }
 
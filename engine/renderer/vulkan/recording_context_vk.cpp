@@ -0,0 +1,147 @@
+#include "recording_context_vk.hpp"
+
+#include "renderer_vk.hpp"
+
+#include <profiler.hpp>
+
+#include <cassert>
+
+RecordingContextVK::RecordingContextVK( RendererVK* renderer, uint32_t queueFamily, std::size_t uniformBlockSize, std::size_t uniformAlign ) noexcept
+: m_renderer{ renderer }
+{
+    ZoneScoped;
+    assert( renderer );
+    m_commandPool = CommandPool{ m_renderer->m_device, queueFamily };
+    m_uniformBuffer = Uniform{ m_renderer->m_physicalDevice, m_renderer->m_device, uniformBlockSize, uniformAlign };
+}
+
+static void beginSecondary( VkCommandBuffer cmd, VkFormat depthFormat, const VkFormat* colorFormat )
+{
+    const VkCommandBufferInheritanceRenderingInfo renderingInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+        .colorAttachmentCount = colorFormat ? 1u : 0u,
+        .pColorAttachmentFormats = colorFormat,
+        .depthAttachmentFormat = depthFormat,
+        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+    };
+    const VkCommandBufferInheritanceInfo inheritanceInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        .pNext = &renderingInfo,
+    };
+    const VkCommandBufferBeginInfo beginInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+        .pInheritanceInfo = &inheritanceInfo,
+    };
+
+    [[maybe_unused]]
+    const VkResult cmdOK = vkBeginCommandBuffer( cmd, &beginInfo );
+    assert( cmdOK == VK_SUCCESS );
+}
+
+void RecordingContextVK::begin( uint32_t order )
+{
+    ZoneScoped;
+    assert( !isRecording() );
+    m_order = order;
+    m_commandPool.reset();
+    m_uniformBuffer.reset();
+    for ( auto& set : m_descriptorSets ) {
+        set.reset();
+    }
+    m_segments.clear();
+    m_drawState = {};
+    m_graphicsSegmentOpen = false;
+    m_executed = false;
+    m_recording.store( true, std::memory_order_release );
+}
+
+void RecordingContextVK::end()
+{
+    ZoneScoped;
+    assert( isRecording() );
+    endGraphicsSegment();
+    m_recording.store( false, std::memory_order_release );
+    m_recording.notify_all();
+}
+
+void RecordingContextVK::beginGraphicsSegment()
+{
+    if ( m_graphicsSegmentOpen ) [[likely]] return;
+
+    const Frame& fr = m_renderer->m_frames[ m_renderer->m_currentFrame ];
+    const VkExtent2D extent = fr.m_renderDepthTarget.extent();
+    const Segment& segment = m_segments.emplace_back( Segment{
+        .m_cmdDepthPrepass = m_commandPool.nextSecondary(),
+        .m_cmdColorPass = m_commandPool.nextSecondary(),
+    } );
+
+    beginSecondary( segment.m_cmdDepthPrepass, m_renderer->m_depthFormat, nullptr );
+    beginSecondary( segment.m_cmdColorPass, m_renderer->m_depthFormat, &m_renderer->m_colorFormat );
+    m_renderer->m_depthPrepass.setDynamicState( segment.m_cmdDepthPrepass, extent );
+    m_renderer->m_mainPass.setDynamicState( segment.m_cmdColorPass, extent );
+    m_drawState = {};
+    m_graphicsSegmentOpen = true;
+}
+
+void RecordingContextVK::endGraphicsSegment()
+{
+    if ( !m_graphicsSegmentOpen ) return;
+    m_graphicsSegmentOpen = false;
+
+    const Segment& segment = m_segments.back();
+    [[maybe_unused]]
+    const VkResult depthOK = vkEndCommandBuffer( segment.m_cmdDepthPrepass );
+    assert( depthOK == VK_SUCCESS );
+    [[maybe_unused]]
+    const VkResult colorOK = vkEndCommandBuffer( segment.m_cmdColorPass );
+    assert( colorOK == VK_SUCCESS );
+}
+
+DescriptorSet& RecordingContextVK::descriptorSet( const PipelineVK& pipeline )
+{
+    const uint32_t id = pipeline.descriptorSetPoolId();
+    assert( id < m_descriptorSets.size() );
+    DescriptorSet& set = m_descriptorSets[ id ];
+    if ( !set ) [[unlikely]] {
+        set = DescriptorSet{ m_renderer->m_device, m_renderer->m_pipelineDescriptorIds[ id ] };
+    }
+    return set;
+}
+
+void RecordingContextVK::render( const RenderInfo& ri )
+{
+    assert( isRecording() );
+    assert( ri.m_pipeline );
+    assert( ri.m_pipeline < m_renderer->m_pipelines.size() );
+
+    beginGraphicsSegment();
+    descriptorSet( m_renderer->m_pipelines[ ri.m_pipeline - 1 ] );
+
+    const Segment& segment = m_segments.back();
+    m_renderer->recordDraw( CommandStream{
+        .m_cmdDepthPrepass = segment.m_cmdDepthPrepass,
+        .m_cmdColorPass = segment.m_cmdColorPass,
+        .m_uniform = &m_uniformBuffer,
+        .m_descriptorSets = m_descriptorSets.data(),
+        .m_state = &m_drawState,
+    }, ri );
+}
+
+void RecordingContextVK::dispatch( const DispatchInfo& dispatchInfo )
+{
+    assert( isRecording() );
+    assert( dispatchInfo.m_pipeline );
+    assert( dispatchInfo.m_pipeline < m_renderer->m_pipelines.size() );
+
+    endGraphicsSegment();
+    PipelineVK& pipeline = m_renderer->m_pipelines[ dispatchInfo.m_pipeline - 1 ];
+    const VkDescriptorSet set = descriptorSet( pipeline ).next();
+    assert( set != VK_NULL_HANDLE );
+
+    m_segments.emplace_back( Segment{
+        .m_computePipeline = &pipeline,
+        .m_uniform = m_uniformBuffer.copy( dispatchInfo.m_uniform.ptr, dispatchInfo.m_uniform.size ),
+        .m_descriptorSet = set,
+    } );
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "command_pool.hpp"
+#include "descriptor_set.hpp"
+#include "uniform.hpp"
+#include "vk.hpp"
+
+#include <renderer/renderer.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+class PipelineVK;
+class RendererVK;
+
+// bound state of command buffer pair, undefined again after vkCmdExecuteCommands
+struct DrawState {
+    PipelineVK* m_lastPipeline = nullptr;
+    float m_lastLineWidth = 0.0f;
+};
+
+// command buffer pair and allocators a draw is recorded with
+struct CommandStream {
+    VkCommandBuffer m_cmdDepthPrepass = VK_NULL_HANDLE;
+    VkCommandBuffer m_cmdColorPass = VK_NULL_HANDLE;
+    Uniform* m_uniform = nullptr;
+    DescriptorSet* m_descriptorSets = nullptr;
+    DrawState* m_state = nullptr;
+};
+
+// Records draws into secondary command buffers with its own uniform and descriptor allocators,
+// so that each worker thread can own one context. Dispatches only reserve their uniform and descriptor set,
+// the dispatch itself is recorded to primary command buffer when the context is executed, because
+// compute passes ping-pong frame render targets.
+class RecordingContextVK : public RecordingContext {
+public:
+    enum : uint32_t {
+        MAX_DESCRIPTOR_SETS = 32,
+    };
+
+    struct Segment {
+        VkCommandBuffer m_cmdDepthPrepass = VK_NULL_HANDLE;
+        VkCommandBuffer m_cmdColorPass = VK_NULL_HANDLE;
+        PipelineVK* m_computePipeline = nullptr;
+        VkDescriptorBufferInfo m_uniform{};
+        VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+    };
+
+private:
+    RendererVK* m_renderer = nullptr;
+    CommandPool m_commandPool{};
+    Uniform m_uniformBuffer{};
+    std::array<DescriptorSet, MAX_DESCRIPTOR_SETS> m_descriptorSets{};
+    std::pmr::vector<Segment> m_segments{};
+    DrawState m_drawState{};
+    uint32_t m_order = 0;
+    bool m_graphicsSegmentOpen = false;
+    bool m_executed = false;
+    std::atomic<bool> m_recording = false;
+
+    DescriptorSet& descriptorSet( const PipelineVK& );
+    void beginGraphicsSegment();
+    void endGraphicsSegment();
+
+public:
+    virtual ~RecordingContextVK() noexcept override = default;
+    RecordingContextVK( RendererVK*, uint32_t queueFamily, std::size_t uniformBlockSize, std::size_t uniformAlign ) noexcept;
+
+    RecordingContextVK( const RecordingContextVK& ) = delete;
+    RecordingContextVK& operator = ( const RecordingContextVK& ) = delete;
+
+    void begin( uint32_t order );
+    void end();
+
+    inline uint32_t order() const noexcept { return m_order; }
+    inline bool isRecording() const noexcept { return m_recording.load( std::memory_order_acquire ); }
+    inline void waitEnded() const noexcept { m_recording.wait( true, std::memory_order_acquire ); }
+    // set once stitched into primary command buffers, render thread only
+    inline bool isExecuted() const noexcept { return m_executed; }
+    inline void setExecuted() noexcept { m_executed = true; }
+    inline std::span<const Segment> segments() const noexcept { return m_segments; }
+    inline Uniform& uniformBuffer() noexcept { return m_uniformBuffer; }
+
+    virtual void render( const RenderInfo& ) override;
+    virtual void dispatch( const DispatchInfo& ) override;
+};
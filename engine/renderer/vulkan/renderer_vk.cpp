@@ -7,6 +7,10 @@
 #include <SDL_vulkan.h>
 #include <profiler.hpp>
 
+#if ENABLE_TRACY_PROFILER
+#include <tracy/TracyC.h>
+#endif
+
 #include <algorithm>
 #include <bit>
 #include <cassert>
@@ -23,6 +27,7 @@ Renderer* Renderer::s_instance = nullptr;
 struct ResourceDeleter {
     void operator () ( TextureVK* t ) { assert( t ); delete t; }
     void operator () ( BufferVK* b ) { assert( b ); delete b; }
+    void operator () ( PipelineVK* p ) { assert( p ); delete p; }
 };
 
 struct TextureExtra {
@@ -56,11 +61,69 @@ struct BufferExtra {
     }
 };
 
+constexpr std::size_t operator ""_KiB( unsigned long long v ) noexcept
+{
+    return v << 10;
+}
+
 constexpr std::size_t operator ""_MiB( unsigned long long v ) noexcept
 {
     return v << 20;
 }
 
+#if ENABLE_TRACY_PROFILER
+static void tracyGpuZones( std::span<const GpuScopeTiming> timings )
+{
+    static const uint8_t context = tracy::GetGpuCtxCounter().fetch_add( 1 );
+    static uint16_t queryId = 0;
+    static bool contextCreated = false;
+    if ( timings.empty() ) return;
+
+    std::array<const GpuScopeTiming*, TimestampPool::MAX_SCOPES> sorted{};
+    auto last = std::ranges::transform( timings, sorted.begin(), []( const auto& t ) { return &t; } ).out;
+    std::sort( sorted.begin(), last, []( auto* lhs, auto* rhs ) { return lhs->beginNs < rhs->beginNs; } );
+
+    if ( !contextCreated ) {
+        contextCreated = true;
+        ___tracy_emit_gpu_new_context_serial( ___tracy_gpu_new_context_data{
+            .gpuTime = static_cast<int64_t>( sorted.front()->beginNs ),
+            .period = 1.0f,
+            .context = context,
+            .flags = 0,
+            .type = static_cast<uint8_t>( tracy::GpuContextType::Vulkan ),
+        } );
+    }
+
+    auto emitEnd = []( const GpuScopeTiming* t )
+    {
+        const uint16_t id = queryId++;
+        ___tracy_emit_gpu_zone_end_serial( ___tracy_gpu_zone_end_data{ .queryId = id, .context = context } );
+        ___tracy_emit_gpu_time_serial( ___tracy_gpu_time_data{ .gpuTime = static_cast<int64_t>( t->endNs ), .queryId = id, .context = context } );
+    };
+
+    // GPU executes command buffers in submission order, so scopes are either disjoint or nested
+    std::array<const GpuScopeTiming*, TimestampPool::MAX_SCOPES> stack{};
+    uint32_t depth = 0;
+    for ( auto it = sorted.begin(); it != last; ++it ) {
+        const GpuScopeTiming* t = *it;
+        while ( depth && stack[ depth - 1 ]->endNs <= t->beginNs ) {
+            emitEnd( stack[ --depth ] );
+        }
+        const uint64_t srcloc = tracy::Profiler::AllocSourceLocation( __LINE__, __FILE__, sizeof( __FILE__ ) - 1
+            , __FUNCTION__, sizeof( __FUNCTION__ ) - 1
+            , t->name.data(), t->name.size()
+        );
+        const uint16_t id = queryId++;
+        ___tracy_emit_gpu_zone_begin_alloc_serial( ___tracy_gpu_zone_begin_data{ .srcloc = srcloc, .queryId = id, .context = context } );
+        ___tracy_emit_gpu_time_serial( ___tracy_gpu_time_data{ .gpuTime = static_cast<int64_t>( t->beginNs ), .queryId = id, .context = context } );
+        stack[ depth++ ] = t;
+    }
+    while ( depth ) {
+        emitEnd( stack[ --depth ] );
+    }
+}
+#endif
+
 static std::pmr::vector<const char*> windowExtensions( SDL_Window* window )
 {
     uint32_t count = 0;
@@ -156,6 +219,7 @@ RendererVK::RendererVK( const Renderer::CreateInfo& createInfo )
 
         m_colorFormat = FormatSupportTest::pick( colorFormatWishlist, m_physicalDevice );
         m_depthFormat = FormatSupportTest::pick( depthFormatWishlist, m_physicalDevice );
+        m_hasBC7 = FormatSupportTest{ m_physicalDevice }( Info{ VK_FORMAT_BC7_UNORM_BLOCK, VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT } );
     }
 
     m_queueManager = QueueManager{ m_physicalDevice, m_surface };
@@ -195,14 +259,20 @@ RendererVK::RendererVK( const Renderer::CreateInfo& createInfo )
     m_transferCmd = m_transferCommandPool[ 0 ];
 
     m_frames.resize( m_swapchain.imageCount() );
+    m_uniformAlignment = physicalProperties.limits.minUniformBufferOffsetAlignment;
 
     for ( auto& it : m_frames ) {
-        it.m_uniformBuffer = Uniform{ m_physicalDevice, m_device, 2_MiB, physicalProperties.limits.minUniformBufferOffsetAlignment };
+        it.m_uniformBuffer = Uniform{ m_physicalDevice, m_device, 2_MiB, m_uniformAlignment };
         it.m_commandPool = CommandPool{ m_device, 3, m_queueManager.graphicsFamily() };
         it.m_cmdUniform = it.m_commandPool[ 0 ];
         it.m_cmdDepthPrepass = it.m_commandPool[ 1 ];
         it.m_cmdColorPass = it.m_commandPool[ 2 ];
     }
+
+    m_hasTimestamps = physicalProperties.limits.timestampComputeAndGraphics;
+    m_timestampPeriod = physicalProperties.limits.timestampPeriod;
+    setFeatureEnabled( Feature::eGpuTimestamps, true );
+
     recreateRenderTargets( m_swapchain.extent() );
 
     {
@@ -237,7 +307,25 @@ PipelineSlot RendererVK::createPipeline( const PipelineCreateInfo& pci )
     ZoneScoped;
 
     const PipelineSlot slot = static_cast<PipelineSlot>( m_pipelineIndexer.next() );
+    m_pipelines[ slot ] = makePipeline( pci );
+    return slot + 1;
+}
+
+void RendererVK::replacePipeline( PipelineSlot slot, const PipelineCreateInfo& pci )
+{
+    ZoneScoped;
+    assert( slot );
+    PipelineVK pipeline = makePipeline( pci );
+    {
+        // recorded command buffers of current frame may still reference previous one
+        Bottleneck bottleneck{ m_resourceDeleteBottleneck };
+        m_resourceDelete.emplace_back( new PipelineVK{ std::move( m_pipelines[ slot - 1 ] ) } );
+    }
+    m_pipelines[ slot - 1 ] = std::move( pipeline );
+}
 
+PipelineVK RendererVK::makePipeline( const PipelineCreateInfo& pci )
+{
     auto findOrAddDescriptorId = []( auto& array, uint64_t bindpoints ) -> std::tuple<uint32_t, bool>
     {
         auto it = std::find( array.begin(), array.end(), bindpoints );
@@ -259,7 +347,7 @@ PipelineSlot RendererVK::createPipeline( const PipelineCreateInfo& pci )
     }
 
     VkDescriptorSetLayout layout = m_frames[ 0 ].m_descriptorSets[ descriptorId ].layout();
-    m_pipelines[ slot ] = PipelineVK{
+    return PipelineVK{
         pci
         , m_device
         , m_depthFormat
@@ -267,7 +355,6 @@ PipelineSlot RendererVK::createPipeline( const PipelineCreateInfo& pci )
         , layout
         , descriptorId
     };
-    return slot + 1;
 }
 
 RendererVK::~RendererVK()
@@ -305,6 +392,10 @@ bool RendererVK::featureAvailable( Feature f ) const
         return Swapchain::supportedVSyncs( m_physicalDevice, m_surface )[ (uint32_t)VSync::eMailbox ];
     case Feature::eVRSAA:
         return m_device.hasFeature( Device::eVRS );
+    case Feature::eGpuTimestamps:
+        return m_hasTimestamps;
+    case Feature::eBC7:
+        return m_hasBC7;
     default:
         return false;
     }
@@ -314,10 +405,18 @@ void RendererVK::setFeatureEnabled( Feature f, bool b )
 {
     switch ( f ) {
     case Feature::eVSyncMailbox: break;
+    case Feature::eBC7: break;
     case Feature::eVRSAA:
         m_mainPass.enableVRS( featureAvailable( f ) && b );
         refreshResolution();
         break;
+    case Feature::eGpuTimestamps:
+        m_gpuTimestamps = featureAvailable( f ) && b;
+        if ( !m_gpuTimestamps ) break;
+        for ( auto& fr : m_frames ) {
+            if ( !fr.m_timestamps ) fr.m_timestamps = TimestampPool{ m_device };
+        }
+        break;
     default:
         assert( !"unhandled enum" );
         break;
@@ -389,6 +488,32 @@ Buffer RendererVK::createBuffer( std::span<const uint8_t> data )
 }
 
 Texture RendererVK::createTexture( const TextureCreateInfo& tci, std::span<const uint8_t> data )
+{
+    ZoneScoped;
+    TextureVK* tex = uploadTexture( tci, data );
+    const uint32_t idx = static_cast<uint32_t>( m_textureIndexer.next() );
+    [[maybe_unused]]
+    TextureVK* oldTex = m_textureSlots[ idx ].exchange( tex );
+    assert( !oldTex );
+    return TextureExtra{ .index = (uint16_t)idx, .channelCount = (uint8_t)tex->channels(), };
+}
+
+Texture RendererVK::replaceTexture( Texture t, const TextureCreateInfo& tci, std::span<const uint8_t> data )
+{
+    ZoneScoped;
+    auto texExtra = std::bit_cast<TextureExtra>( t );
+    assert( texExtra );
+    TextureVK* tex = uploadTexture( tci, data );
+    TextureVK* ptr = m_textureSlots[ texExtra.index ].exchange( tex );
+    assert( ptr );
+    {
+        Bottleneck bottleneck{ m_resourceDeleteBottleneck };
+        m_resourceDelete.emplace_back( ptr );
+    }
+    return TextureExtra{ .index = texExtra.index, .channelCount = (uint8_t)tex->channels(), };
+}
+
+TextureVK* RendererVK::uploadTexture( const TextureCreateInfo& tci, std::span<const uint8_t> data )
 {
     ZoneScoped;
     assert( tci.width > 0 );
@@ -428,13 +553,8 @@ Texture RendererVK::createTexture( const TextureCreateInfo& tci, std::span<const
         vkQueueWaitIdle( queue );
     }
 
-    const uint32_t idx = static_cast<uint32_t>( m_textureIndexer.next() );
-    [[maybe_unused]]
-    TextureVK* oldTex = m_textureSlots[ idx ].exchange( tex );
-    assert( !oldTex );
-
     releaseStagingBuffer( std::move( staging ) );
-    return TextureExtra{ .index = (uint16_t)idx, .channelCount = (uint8_t)tex->channels(), };
+    return tex;
 }
 
 void RendererVK::beginFrame()
@@ -443,7 +563,6 @@ void RendererVK::beginFrame()
     if ( m_pendingVSyncChange ) {
         recreateSwapchain();
     }
-    m_lastLineWidth = 0.0f;
     uint32_t imageIndex = 0;
     static constexpr uint64_t timeout = 8'000'000'000; // 8 seconds
     [[maybe_unused]]
@@ -460,14 +579,162 @@ void RendererVK::beginFrame()
     m_currentFrame = imageIndex;
     Frame& fr = m_frames[ imageIndex ];
     fr.m_state = Frame::State::eNone;
+    fr.m_drawState = {};
     fr.m_uniformBuffer.reset();
     fr.m_commandPool.reset();
     for ( auto& set : fr.m_descriptorSets ) {
         set.reset();
     }
+    {
+        Bottleneck lock{ m_recordingBottleneck };
+        fr.m_recordingsUsed = 0;
+    }
+
+    if ( fr.m_timestamps && fr.m_timestamps.resolve( m_timestampPeriod, m_gpuTimings ) ) {
+        m_gpuTimingsResolved = true;
+#if ENABLE_TRACY_PROFILER
+        tracyGpuZones( m_gpuTimings );
+#endif
+    }
+    fr.m_timestampsEnabled = m_gpuTimestamps;
+    m_gpuScopeDepth = 0;
 
     beginRecording( fr.m_cmdColorPass );
     beginRecording( fr.m_cmdDepthPrepass );
+    fr.m_scopeDepthPrepass = gpuScopeBegin( fr.m_cmdDepthPrepass, "depth prepass" );
+    fr.m_scopeColorPass = gpuScopeBegin( fr.m_cmdColorPass, "color pass" );
+}
+
+uint32_t RendererVK::gpuScopeBegin( VkCommandBuffer cmd, std::string_view name )
+{
+    Frame& fr = m_frames[ m_currentFrame ];
+    if ( !fr.m_timestampsEnabled ) return TimestampPool::MAX_SCOPES;
+    return fr.m_timestamps.begin( cmd, name );
+}
+
+void RendererVK::gpuScopeEnd( VkCommandBuffer cmd, uint32_t scope )
+{
+    Frame& fr = m_frames[ m_currentFrame ];
+    if ( !fr.m_timestampsEnabled ) return;
+    fr.m_timestamps.end( cmd, scope );
+}
+
+void RendererVK::beginGpuScope( std::string_view name )
+{
+    assert( m_gpuScopeDepth < m_gpuScopeStack.size() );
+    if ( m_gpuScopeDepth == m_gpuScopeStack.size() ) [[unlikely]] return;
+    Frame& fr = m_frames[ m_currentFrame ];
+    m_gpuScopeStack[ m_gpuScopeDepth++ ] = gpuScopeBegin( fr.m_cmdColorPass, name );
+}
+
+void RendererVK::endGpuScope()
+{
+    assert( m_gpuScopeDepth > 0 );
+    if ( m_gpuScopeDepth == 0 ) [[unlikely]] return;
+    Frame& fr = m_frames[ m_currentFrame ];
+    gpuScopeEnd( fr.m_cmdColorPass, m_gpuScopeStack[ --m_gpuScopeDepth ] );
+}
+
+RecordingContext* RendererVK::beginRecording( uint32_t order )
+{
+    ZoneScoped;
+    Frame& fr = m_frames[ m_currentFrame ];
+    Bottleneck lock{ m_recordingBottleneck };
+    if ( fr.m_recordingsUsed == fr.m_recordings.size() ) [[unlikely]] {
+        fr.m_recordings.emplace_back( std::pmr::get_default_resource(), this, m_queueManager.graphicsFamily(), 512_KiB, m_uniformAlignment );
+    }
+    RecordingContextVK* ctx = fr.m_recordings[ fr.m_recordingsUsed++ ].get();
+    ctx->begin( order );
+    return ctx;
+}
+
+void RendererVK::endRecording( RecordingContext* rc )
+{
+    assert( rc );
+    static_cast<RecordingContextVK*>( rc )->end();
+}
+
+// Executes ended contexts in order of their keys, up to the first one still being recorded. Contexts from there on
+// stay pending for next dispatch() or end of frame, which waits for them instead.
+void RendererVK::executeRecordings( Frame& fr, bool waitForOpen )
+{
+    ZoneScoped;
+    std::pmr::vector<RecordingContextVK*> pending{};
+    {
+        Bottleneck lock{ m_recordingBottleneck };
+        for ( uint32_t i = 0; i < fr.m_recordingsUsed; ++i ) {
+            RecordingContextVK* ctx = fr.m_recordings[ i ].get();
+            if ( !ctx->isExecuted() ) pending.emplace_back( ctx );
+        }
+    }
+    std::ranges::sort( pending, {}, &RecordingContextVK::order );
+    assert( std::ranges::adjacent_find( pending, {}, &RecordingContextVK::order ) == pending.end() && "recording order keys must be unique" );
+    auto open = std::ranges::find_if( pending, &RecordingContextVK::isRecording );
+    if ( waitForOpen ) {
+        std::ranges::for_each( open, pending.end(), &RecordingContextVK::waitEnded );
+    }
+    else {
+        pending.erase( open, pending.end() );
+    }
+    if ( pending.empty() ) [[likely]] return;
+
+    static constexpr VkRenderingFlags SECONDARY = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+    for ( RecordingContextVK* ctx : pending ) {
+        ctx->setExecuted();
+        for ( const auto& segment : ctx->segments() ) {
+            if ( segment.m_computePipeline ) {
+                recordDispatch( fr, *segment.m_computePipeline, segment.m_uniform, segment.m_descriptorSet );
+                continue;
+            }
+
+            switch ( fr.m_state ) {
+            case Frame::State::eGraphics:
+                m_depthPrepass.end( fr.m_cmdDepthPrepass );
+                m_mainPass.end( fr.m_cmdColorPass );
+                [[fallthrough]];
+            case Frame::State::eCompute:
+            case Frame::State::eStitched:
+                fr.m_renderDepthTarget.transfer( fr.m_cmdDepthPrepass, constants::depthWrite );
+                fr.m_renderTarget.transfer( fr.m_cmdColorPass, constants::fragmentWrite );
+                m_depthPrepass.resume( fr.m_cmdDepthPrepass, fr.m_renderDepthTarget, fr.m_renderTarget, SECONDARY );
+                m_mainPass.resume( fr.m_cmdColorPass, fr.m_renderDepthTarget, fr.m_renderTarget, SECONDARY );
+                break;
+            case Frame::State::eNone:
+                fr.m_renderDepthTarget.transfer( fr.m_cmdDepthPrepass, constants::depthWrite );
+                fr.m_renderTarget.transfer( fr.m_cmdColorPass, constants::fragmentWrite );
+                m_depthPrepass.begin( fr.m_cmdDepthPrepass, fr.m_renderDepthTarget, fr.m_renderTarget, SECONDARY );
+                m_mainPass.begin( fr.m_cmdColorPass, fr.m_renderDepthTarget, fr.m_renderTarget, SECONDARY );
+                break;
+            case Frame::State::eSecondary:
+                break;
+            }
+            fr.m_state = Frame::State::eSecondary;
+            vkCmdExecuteCommands( fr.m_cmdDepthPrepass, 1, &segment.m_cmdDepthPrepass );
+            vkCmdExecuteCommands( fr.m_cmdColorPass, 1, &segment.m_cmdColorPass );
+        }
+    }
+
+    // bound and dynamic state of primary command buffers is undefined after executing secondary ones
+    fr.m_drawState = {};
+    if ( fr.m_state != Frame::State::eSecondary ) return;
+    fr.m_state = Frame::State::eStitched;
+    m_depthPrepass.end( fr.m_cmdDepthPrepass );
+    m_mainPass.end( fr.m_cmdColorPass );
+    const VkExtent2D extent = fr.m_renderDepthTarget.extent();
+    m_depthPrepass.setDynamicState( fr.m_cmdDepthPrepass, extent );
+    m_mainPass.setDynamicState( fr.m_cmdColorPass, extent );
+}
+
+bool RendererVK::gpuTimings( std::pmr::vector<GpuScopeTiming>& timings )
+{
+    if ( !std::exchange( m_gpuTimingsResolved, false ) ) return false;
+    timings = m_gpuTimings;
+    return true;
+}
+
+Renderer::Statistics RendererVK::statistics() const
+{
+    return m_statistics;
 }
 
 void RendererVK::deleteBuffer( Buffer b )
@@ -619,19 +886,23 @@ static bool operator == ( const VkExtent2D& lhs, const VkExtent2D& rhs ) noexcep
 void RendererVK::endFrame()
 {
     ZoneScoped;
-    m_lastPipeline = nullptr;
 
     Frame& fr = m_frames[ m_currentFrame ];
+    assert( m_gpuScopeDepth == 0 );
+    executeRecordings( fr, true );
     switch ( fr.m_state ) {
     case Frame::State::eGraphics:
         m_depthPrepass.end( fr.m_cmdDepthPrepass );
         m_mainPass.end( fr.m_cmdColorPass );
         break;
     case Frame::State::eCompute:
+    case Frame::State::eStitched:
     [[unlikely]] default:
         break;
     }
 
+    gpuScopeEnd( fr.m_cmdDepthPrepass, fr.m_scopeDepthPrepass );
+    gpuScopeEnd( fr.m_cmdColorPass, fr.m_scopeColorPass );
     fr.m_renderDepthTarget.transfer( fr.m_cmdDepthPrepass, constants::depthRead );
     [[maybe_unused]]
     const VkResult cmdEndD = vkEndCommandBuffer( fr.m_cmdDepthPrepass );
@@ -651,6 +922,7 @@ void RendererVK::endFrame()
         .dstSubresource{ .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT, .layerCount = 1 },
         .dstOffsets{ {}, dstOffset },
     };
+    const uint32_t blitScope = gpuScopeBegin( fr.m_cmdColorPass, "blit" );
     vkCmdBlitImage( fr.m_cmdColorPass
         , fr.m_renderTarget.image()
         , constants::copyFrom.m_layout
@@ -660,6 +932,7 @@ void RendererVK::endFrame()
         , &region
         , srcExtent == dstExtent ? VK_FILTER_NEAREST : VK_FILTER_LINEAR
     );
+    gpuScopeEnd( fr.m_cmdColorPass, blitScope );
     transferImage( fr.m_cmdColorPass, m_swapchain.image( m_currentFrame ), constants::copyTo, constants::present );
 
     [[maybe_unused]]
@@ -671,7 +944,22 @@ void RendererVK::endFrame()
 
 
     beginRecording( fr.m_cmdUniform );
+    if ( fr.m_timestampsEnabled ) {
+        fr.m_timestamps.reset( fr.m_cmdUniform );
+    }
+    const uint32_t uniformScope = gpuScopeBegin( fr.m_cmdUniform, "uniform upload" );
     fr.m_uniformBuffer.transfer( fr.m_cmdUniform  );
+    m_statistics.uniformBytesUploaded = fr.m_uniformBuffer.bytesUploaded();
+    m_statistics.uniformBytesCopied = fr.m_uniformBuffer.bytesCopied();
+    m_statistics.uniformBlocks = fr.m_uniformBuffer.blockCount();
+    for ( uint32_t i = 0; i < fr.m_recordingsUsed; ++i ) {
+        Uniform& uniform = fr.m_recordings[ i ]->uniformBuffer();
+        uniform.transfer( fr.m_cmdUniform );
+        m_statistics.uniformBytesUploaded += uniform.bytesUploaded();
+        m_statistics.uniformBytesCopied += uniform.bytesCopied();
+        m_statistics.uniformBlocks += uniform.blockCount();
+    }
+    gpuScopeEnd( fr.m_cmdUniform, uniformScope );
     [[maybe_unused]]
     const VkResult uniformOK = vkEndCommandBuffer( fr.m_cmdUniform );
     assert( uniformOK == VK_SUCCESS );
@@ -756,10 +1044,10 @@ void RendererVK::render( const RenderInfo& ri )
     assert( ri.m_instanceCount > 0 );
 
     Frame& fr = m_frames[ m_currentFrame ];
-    PipelineVK& currentPipeline = m_pipelines[ ri.m_pipeline - 1 ];
 
     switch ( fr.m_state ) {
-    case Frame::State::eCompute: {
+    case Frame::State::eCompute:
+    case Frame::State::eStitched: {
         fr.m_state = Frame::State::eGraphics;
         fr.m_renderDepthTarget.transfer( fr.m_cmdDepthPrepass, constants::depthWrite );
         fr.m_renderTarget.transfer( fr.m_cmdColorPass, constants::fragmentWrite );
@@ -778,9 +1066,29 @@ void RendererVK::render( const RenderInfo& ri )
         break;
     }
 
-    const bool rebindPipeline = m_lastPipeline != &currentPipeline;
+    recordDraw( CommandStream{
+        .m_cmdDepthPrepass = fr.m_cmdDepthPrepass,
+        .m_cmdColorPass = fr.m_cmdColorPass,
+        .m_uniform = &fr.m_uniformBuffer,
+        .m_descriptorSets = fr.m_descriptorSets.data(),
+        .m_state = &fr.m_drawState,
+    }, ri );
+}
+
+void RendererVK::recordDraw( const CommandStream& stream, const RenderInfo& ri )
+{
+    assert( stream.m_cmdDepthPrepass );
+    assert( stream.m_cmdColorPass );
+    assert( stream.m_uniform );
+    assert( stream.m_descriptorSets );
+    assert( stream.m_state );
+
+    PipelineVK& currentPipeline = m_pipelines[ ri.m_pipeline - 1 ];
+    DrawState& state = *stream.m_state;
+
+    const bool rebindPipeline = state.m_lastPipeline != &currentPipeline;
     const bool depthWrite = currentPipeline.depthWrite();
-    const bool updateLineWidth = currentPipeline.useLines() && ri.m_lineWidth != m_lastLineWidth;
+    const bool updateLineWidth = currentPipeline.useLines() && ri.m_lineWidth != state.m_lastLineWidth;
     const bool bindBuffer = ri.m_vertexBuffer;
     uint32_t verticeCount = ri.m_verticeCount;
 
@@ -789,18 +1097,18 @@ void RendererVK::render( const RenderInfo& ri )
         fIndexed = 0b10,
     };
     uint32_t cmd = depthWrite ? fDepth : 0;
-    auto& descriptorPool = fr.m_descriptorSets[ currentPipeline.descriptorSetPoolId() ];
+    auto& descriptorPool = stream.m_descriptorSets[ currentPipeline.descriptorSetPoolId() ];
 
-    m_lastPipeline = &currentPipeline;
+    state.m_lastPipeline = &currentPipeline;
 
-    const VkDescriptorBufferInfo uniformInfo = fr.m_uniformBuffer.copy( ri.m_uniform.ptr, ri.m_uniform.size );
+    const VkDescriptorBufferInfo uniformInfo = stream.m_uniform->copy( ri.m_uniform.ptr, ri.m_uniform.size );
     const VkDescriptorSet descriptorSet = descriptorPool.next();
     assert( descriptorSet != VK_NULL_HANDLE );
 
 
     if ( rebindPipeline ) {
-        if ( depthWrite ) vkCmdBindPipeline( fr.m_cmdDepthPrepass, VK_PIPELINE_BIND_POINT_GRAPHICS, currentPipeline.depthPrepass() );
-        vkCmdBindPipeline( fr.m_cmdColorPass, VK_PIPELINE_BIND_POINT_GRAPHICS, currentPipeline );
+        if ( depthWrite ) vkCmdBindPipeline( stream.m_cmdDepthPrepass, VK_PIPELINE_BIND_POINT_GRAPHICS, currentPipeline.depthPrepass() );
+        vkCmdBindPipeline( stream.m_cmdColorPass, VK_PIPELINE_BIND_POINT_GRAPHICS, currentPipeline );
     }
 
 
@@ -820,13 +1128,13 @@ void RendererVK::render( const RenderInfo& ri )
     std::ranges::transform( ri.m_fragmentTexture, imageInfo.begin(), find );
     currentPipeline.updateDescriptorSet( descriptorSet, uniformInfo, imageInfo );
 
-    if ( depthWrite ) vkCmdBindDescriptorSets( fr.m_cmdDepthPrepass, VK_PIPELINE_BIND_POINT_GRAPHICS, currentPipeline.layout(), 0, 1, &descriptorSet, 0, nullptr );
-    vkCmdBindDescriptorSets( fr.m_cmdColorPass, VK_PIPELINE_BIND_POINT_GRAPHICS, currentPipeline.layout(), 0, 1, &descriptorSet, 0, nullptr );
+    if ( depthWrite ) vkCmdBindDescriptorSets( stream.m_cmdDepthPrepass, VK_PIPELINE_BIND_POINT_GRAPHICS, currentPipeline.layout(), 0, 1, &descriptorSet, 0, nullptr );
+    vkCmdBindDescriptorSets( stream.m_cmdColorPass, VK_PIPELINE_BIND_POINT_GRAPHICS, currentPipeline.layout(), 0, 1, &descriptorSet, 0, nullptr );
 
     if ( currentPipeline.useLines() && ( updateLineWidth || rebindPipeline ) ) [[unlikely]] {
-        m_lastLineWidth = ri.m_lineWidth;
-        if ( depthWrite ) vkCmdSetLineWidth( fr.m_cmdDepthPrepass, ri.m_lineWidth );
-        vkCmdSetLineWidth( fr.m_cmdColorPass, ri.m_lineWidth );
+        state.m_lastLineWidth = ri.m_lineWidth;
+        if ( depthWrite ) vkCmdSetLineWidth( stream.m_cmdDepthPrepass, ri.m_lineWidth );
+        vkCmdSetLineWidth( stream.m_cmdColorPass, ri.m_lineWidth );
     }
 
     auto getBuffer = [this]( Buffer buf )
@@ -841,13 +1149,13 @@ void RendererVK::render( const RenderInfo& ri )
     };
     if ( bindBuffer ) {
         auto [ buffers, offsets, vCount ] = getBuffer( ri.m_vertexBuffer );
-        if ( depthWrite ) vkCmdBindVertexBuffers( fr.m_cmdDepthPrepass, 0, 1, buffers.data(), offsets.data() );
-        vkCmdBindVertexBuffers( fr.m_cmdColorPass, 0, 1, buffers.data(), offsets.data() );
+        if ( depthWrite ) vkCmdBindVertexBuffers( stream.m_cmdDepthPrepass, 0, 1, buffers.data(), offsets.data() );
+        vkCmdBindVertexBuffers( stream.m_cmdColorPass, 0, 1, buffers.data(), offsets.data() );
         verticeCount = vCount / currentPipeline.vertexStride();
         if ( ri.m_indexBuffer ) {
             auto [ ibuffers, ioffsets, ivCount ] = getBuffer( ri.m_indexBuffer );
-            if ( depthWrite ) vkCmdBindIndexBuffer( fr.m_cmdDepthPrepass, ibuffers.front(), ioffsets.front(), VK_INDEX_TYPE_UINT16 );
-            vkCmdBindIndexBuffer( fr.m_cmdColorPass, ibuffers.front(), ioffsets.front(), VK_INDEX_TYPE_UINT16 );
+            if ( depthWrite ) vkCmdBindIndexBuffer( stream.m_cmdDepthPrepass, ibuffers.front(), ioffsets.front(), VK_INDEX_TYPE_UINT16 );
+            vkCmdBindIndexBuffer( stream.m_cmdColorPass, ibuffers.front(), ioffsets.front(), VK_INDEX_TYPE_UINT16 );
             verticeCount = ivCount / sizeof( uint16_t );
             cmd |= fIndexed;
         }
@@ -855,10 +1163,10 @@ void RendererVK::render( const RenderInfo& ri )
 
     assert( verticeCount );
     switch ( cmd ) {
-    case fDepth: vkCmdDraw( fr.m_cmdDepthPrepass, verticeCount, ri.m_instanceCount, 0, 0 ); [[fallthrough]];
-    case 0:      vkCmdDraw( fr.m_cmdColorPass, verticeCount, ri.m_instanceCount, 0, 0 ); break;
-    case fDepth | fIndexed: vkCmdDrawIndexed( fr.m_cmdDepthPrepass, verticeCount, ri.m_instanceCount, 0, 0, 0 ); [[fallthrough]];
-    case fIndexed:          vkCmdDrawIndexed( fr.m_cmdColorPass, verticeCount, ri.m_instanceCount, 0, 0, 0 ); break;
+    case fDepth: vkCmdDraw( stream.m_cmdDepthPrepass, verticeCount, ri.m_instanceCount, 0, 0 ); [[fallthrough]];
+    case 0:      vkCmdDraw( stream.m_cmdColorPass, verticeCount, ri.m_instanceCount, 0, 0 ); break;
+    case fDepth | fIndexed: vkCmdDrawIndexed( stream.m_cmdDepthPrepass, verticeCount, ri.m_instanceCount, 0, 0, 0 ); [[fallthrough]];
+    case fIndexed:          vkCmdDrawIndexed( stream.m_cmdColorPass, verticeCount, ri.m_instanceCount, 0, 0, 0 ); break;
     }
 }
 
@@ -868,14 +1176,27 @@ void RendererVK::dispatch( const DispatchInfo& dispatchInfo )
     assert( dispatchInfo.m_pipeline < m_pipelines.size() );
 
     Frame& fr = m_frames[ m_currentFrame ];
+    executeRecordings( fr, false );
+
     PipelineVK& currentPipeline = m_pipelines[ dispatchInfo.m_pipeline - 1 ];
+    auto& descriptorPool = fr.m_descriptorSets[ currentPipeline.descriptorSetPoolId() ];
+    const VkDescriptorBufferInfo uniformInfo = fr.m_uniformBuffer.copy( dispatchInfo.m_uniform.ptr, dispatchInfo.m_uniform.size );
+    const VkDescriptorSet descriptorSet = descriptorPool.next();
+    assert( descriptorSet != VK_NULL_HANDLE );
+    recordDispatch( fr, currentPipeline, uniformInfo, descriptorSet );
+}
 
+void RendererVK::recordDispatch( Frame& fr, PipelineVK& currentPipeline, const VkDescriptorBufferInfo& uniformInfo, VkDescriptorSet descriptorSet )
+{
     switch ( fr.m_state ) {
     case Frame::State::eGraphics:
-        fr.m_state = Frame::State::eCompute;
+    case Frame::State::eSecondary:
         m_depthPrepass.end( fr.m_cmdDepthPrepass );
         m_mainPass.end( fr.m_cmdColorPass );
         [[fallthrough]];
+    case Frame::State::eStitched:
+        fr.m_state = Frame::State::eCompute;
+        [[fallthrough]];
     case Frame::State::eNone:
         fr.m_renderTarget.transfer( fr.m_cmdColorPass, constants::computeReadWrite );
         fr.m_renderTargetTmp.transfer( fr.m_cmdColorPass, constants::computeReadWrite );
@@ -884,11 +1205,6 @@ void RendererVK::dispatch( const DispatchInfo& dispatchInfo )
         break;
     }
 
-    auto& descriptorPool = fr.m_descriptorSets[ currentPipeline.descriptorSetPoolId() ];
-    const VkDescriptorBufferInfo uniformInfo = fr.m_uniformBuffer.copy( dispatchInfo.m_uniform.ptr, dispatchInfo.m_uniform.size );
-    const VkDescriptorSet descriptorSet = descriptorPool.next();
-    assert( descriptorSet != VK_NULL_HANDLE );
-
     std::array<VkDescriptorImageInfo, 2> imageInfo{
         fr.m_renderTarget.imageInfo(),
         fr.m_renderTargetTmp.imageInfo(),
@@ -899,7 +1215,9 @@ void RendererVK::dispatch( const DispatchInfo& dispatchInfo )
     vkCmdBindPipeline( fr.m_cmdColorPass, VK_PIPELINE_BIND_POINT_COMPUTE, currentPipeline );
 
     const VkExtent2D extent = fr.m_renderTarget.extent();
+    const uint32_t dispatchScope = gpuScopeBegin( fr.m_cmdColorPass, "compute dispatch" );
     vkCmdDispatch( fr.m_cmdColorPass, extent.width / 4, extent.height / 4, 1 );
+    gpuScopeEnd( fr.m_cmdColorPass, dispatchScope );
 
     std::swap( fr.m_renderTarget, fr.m_renderTargetTmp );
 }
@@ -8,9 +8,11 @@
 #include "instance.hpp"
 #include "pipeline_vk.hpp"
 #include "queue_manager.hpp"
+#include "recording_context_vk.hpp"
 #include "renderpass.hpp"
 #include "swapchain.hpp"
 #include "texture_vk.hpp"
+#include "timestamp_pool.hpp"
 #include "uniform.hpp"
 #include "vk.hpp"
 
@@ -50,7 +52,6 @@ public:
     VkSemaphore m_semaphoreAvailableImage = VK_NULL_HANDLE;
     VkSemaphore m_semaphoreRender = VK_NULL_HANDLE;
 
-    float m_lastLineWidth = 0.0f;
     uint32_t m_currentFrame = 0;
     uint32_t currentFrame();
 
@@ -61,7 +62,6 @@ public:
     Indexer<MAX_PIPELINES> m_pipelineIndexer{};
     std::array<uint64_t, MAX_PIPELINES> m_pipelineDescriptorIds{};
     std::array<PipelineVK, MAX_PIPELINES> m_pipelines{};
-    PipelineVK* m_lastPipeline = nullptr;
 
     Texture m_defaultTextureId{};
     const TextureVK* m_defaultTexture = nullptr;
@@ -72,7 +72,7 @@ public:
     std::array<std::atomic<BufferVK*>, MAX_BUFFERS> m_bufferSlots{};
 
     std::mutex m_resourceDeleteBottleneck{};
-    using ResourceDelete = std::variant<TextureVK*, BufferVK*>;
+    using ResourceDelete = std::variant<TextureVK*, BufferVK*, PipelineVK*>;
     std::pmr::vector<ResourceDelete> m_resourceDelete{};
 
     std::mutex m_stagingBuffersCacheBottleneck{};
@@ -85,13 +85,37 @@ public:
     std::atomic<uint64_t> m_pendingResolutionChange = {};
     std::optional<VSync> m_pendingVSyncChange{};
 
+    bool m_hasTimestamps = false;
+    bool m_hasBC7 = false;
+    bool m_gpuTimestamps = false;
+    bool m_gpuTimingsResolved = false;
+    float m_timestampPeriod = 0.0f;
+    uint32_t m_gpuScopeDepth = 0;
+    std::array<uint32_t, TimestampPool::MAX_SCOPES> m_gpuScopeStack{};
+    std::pmr::vector<GpuScopeTiming> m_gpuTimings{};
+
+    Statistics m_statistics{};
+
+    std::size_t m_uniformAlignment = 0;
+    std::mutex m_recordingBottleneck{};
+
     void recreateSwapchain();
     void recreateRenderTargets( VkExtent2D );
     void refreshResolution();
 
+    PipelineVK makePipeline( const PipelineCreateInfo& );
+    TextureVK* uploadTexture( const TextureCreateInfo&, std::span<const uint8_t> );
+
     BufferVK getStagingBuffer( uint32_t );
     void releaseStagingBuffer( BufferVK&& );
 
+    uint32_t gpuScopeBegin( VkCommandBuffer, std::string_view );
+    void gpuScopeEnd( VkCommandBuffer, uint32_t );
+
+    void recordDraw( const CommandStream&, const RenderInfo& );
+    void recordDispatch( Frame&, PipelineVK&, const VkDescriptorBufferInfo&, VkDescriptorSet );
+    void executeRecordings( Frame&, bool waitForOpen );
+
 public:
     virtual ~RendererVK() override;
     RendererVK( const Renderer::CreateInfo& );
@@ -100,14 +124,22 @@ public:
     virtual void setVSync( VSync ) override;
 
     virtual PipelineSlot createPipeline( const PipelineCreateInfo& ) override;
+    virtual void replacePipeline( PipelineSlot, const PipelineCreateInfo& ) override;
     virtual Buffer createBuffer( std::span<const uint8_t> ) override;
     virtual Texture createTexture( const TextureCreateInfo&, std::span<const uint8_t> ) override;
     virtual void beginFrame() override;
     virtual void endFrame() override;
     virtual void deleteBuffer( Buffer ) override;
     virtual void deleteTexture( Texture ) override;
+    virtual Texture replaceTexture( Texture, const TextureCreateInfo&, std::span<const uint8_t> ) override;
     virtual void present() override;
     virtual void render( const RenderInfo& ) override;
     virtual void dispatch( const DispatchInfo& ) override;
+    virtual RecordingContext* beginRecording( uint32_t order ) override;
+    virtual void endRecording( RecordingContext* ) override;
     virtual void setResolution( uint32_t width, uint32_t height ) override;
+    virtual void beginGpuScope( std::string_view ) override;
+    virtual void endGpuScope() override;
+    virtual bool gpuTimings( std::pmr::vector<GpuScopeTiming>& ) override;
+    virtual Statistics statistics() const override;
 };
@@ -14,15 +14,9 @@ RenderPass::RenderPass( const Device& d, Purpose purpose ) noexcept
 {
 }
 
-void RenderPass::begin( VkCommandBuffer cmd, const Image& depth, const Image& color ) noexcept
+void RenderPass::setDynamicState( VkCommandBuffer cmd, VkExtent2D extent ) const noexcept
 {
     assert( cmd );
-    static constexpr std::array clearColor{
-        VkClearValue{ .color = { .float32{ 0.0f, 0.0f, 0.0f, 0.0f } } },
-        VkClearValue{ .depthStencil = { 1.0f, 0u } }
-    };
-
-    const VkExtent2D extent = depth.extent();
     const VkRect2D rect{ {}, extent };
     const VkViewport viewport{
         .x = 0,
@@ -43,6 +37,18 @@ void RenderPass::begin( VkCommandBuffer cmd, const Image& depth, const Image& co
         assert( vkCmdSetFragmentShadingRateKHR );
         vkCmdSetFragmentShadingRateKHR( cmd, &vrs, combiner );
     }
+}
+
+void RenderPass::begin( VkCommandBuffer cmd, const Image& depth, const Image& color, VkRenderingFlags flags ) noexcept
+{
+    assert( cmd );
+    static constexpr std::array clearColor{
+        VkClearValue{ .color = { .float32{ 0.0f, 0.0f, 0.0f, 0.0f } } },
+        VkClearValue{ .depthStencil = { 1.0f, 0u } }
+    };
+
+    const VkRect2D rect{ {}, depth.extent() };
+    setDynamicState( cmd, rect.extent );
     const VkRenderingAttachmentInfoKHR colorAttachment{
         .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
         .imageView = color.view(),
@@ -62,6 +68,7 @@ void RenderPass::begin( VkCommandBuffer cmd, const Image& depth, const Image& co
     };
     const VkRenderingInfo renderInfo{
         .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+        .flags = flags,
         .renderArea = rect,
         .layerCount = 1u,
         .colorAttachmentCount = m_depthOnly ? 0u : 1u,
@@ -72,7 +79,7 @@ void RenderPass::begin( VkCommandBuffer cmd, const Image& depth, const Image& co
     vkCmdBeginRenderingKHR( cmd, &renderInfo );
 }
 
-void RenderPass::resume( VkCommandBuffer cmd, const Image& depth, const Image& color ) noexcept
+void RenderPass::resume( VkCommandBuffer cmd, const Image& depth, const Image& color, VkRenderingFlags flags ) noexcept
 {
     assert( cmd );
     const VkRenderingAttachmentInfoKHR colorAttachment{
@@ -93,7 +100,7 @@ void RenderPass::resume( VkCommandBuffer cmd, const Image& depth, const Image& c
     };
     const VkRenderingInfo renderInfo{
         .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
-        .flags = VK_RENDERING_RESUMING_BIT,
+        .flags = VK_RENDERING_RESUMING_BIT | flags,
         .renderArea = VkRect2D{ {}, depth.extent() },
         .layerCount = 1u,
         .colorAttachmentCount = m_depthOnly ? 0u : 1u,
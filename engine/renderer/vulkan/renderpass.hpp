@@ -23,9 +23,12 @@ public:
     RenderPass( RenderPass&& ) noexcept = default;
     RenderPass& operator = ( RenderPass&& ) noexcept = default;
 
-    void begin( VkCommandBuffer, const Image& depth, const Image& color ) noexcept;
-    void resume( VkCommandBuffer, const Image& depth, const Image& color ) noexcept;
+    void begin( VkCommandBuffer, const Image& depth, const Image& color, VkRenderingFlags = 0 ) noexcept;
+    void resume( VkCommandBuffer, const Image& depth, const Image& color, VkRenderingFlags = 0 ) noexcept;
     void end( VkCommandBuffer ) noexcept;
 
+    // viewport, scissor and shading rate; not inherited by secondary command buffers
+    void setDynamicState( VkCommandBuffer, VkExtent2D ) const noexcept;
+
     inline void enableVRS( bool b ) noexcept { m_vrs = b; }
 };
@@ -20,6 +20,7 @@ static auto format( const TextureCreateInfo& tci )
     case TextureFormat::eBC3_unorm: return VK_FORMAT_BC3_UNORM_BLOCK;
     case TextureFormat::eBC4_unorm: return VK_FORMAT_BC4_UNORM_BLOCK;
     case TextureFormat::eBC5_unorm: return VK_FORMAT_BC5_UNORM_BLOCK;
+    case TextureFormat::eBC7_unorm: return VK_FORMAT_BC7_UNORM_BLOCK;
     case TextureFormat::eB4G4R4A4_unorm: return VK_FORMAT_A4R4G4B4_UNORM_PACK16;
     default:
         assert( !"unsuported format" );
@@ -50,6 +51,7 @@ static uint32_t formatToChannels( VkFormat f )
     case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
     case VK_FORMAT_BC2_UNORM_BLOCK:
     case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
         return 4;
     case VK_FORMAT_BC5_UNORM_BLOCK:
         return 2;
@@ -0,0 +1,115 @@
+#include "timestamp_pool.hpp"
+
+#include "utils_vk.hpp"
+
+#include <profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <utility>
+
+TimestampPool::~TimestampPool() noexcept
+{
+    destroy<vkDestroyQueryPool>( m_device, m_pool );
+}
+
+TimestampPool::TimestampPool( VkDevice device ) noexcept
+: m_device{ device }
+{
+    ZoneScoped;
+    assert( device );
+    const VkQueryPoolCreateInfo createInfo{
+        .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        .queryType = VK_QUERY_TYPE_TIMESTAMP,
+        .queryCount = MAX_QUERIES,
+    };
+    [[maybe_unused]]
+    const VkResult poolOK = vkCreateQueryPool( m_device, &createInfo, nullptr, &m_pool );
+    assert( poolOK == VK_SUCCESS );
+}
+
+TimestampPool::TimestampPool( TimestampPool&& rhs ) noexcept
+{
+    std::swap( m_device, rhs.m_device );
+    std::swap( m_pool, rhs.m_pool );
+    std::swap( m_queryCount, rhs.m_queryCount );
+    std::swap( m_scopeCount, rhs.m_scopeCount );
+    std::swap( m_scopes, rhs.m_scopes );
+}
+
+TimestampPool& TimestampPool::operator = ( TimestampPool&& rhs ) noexcept
+{
+    std::swap( m_device, rhs.m_device );
+    std::swap( m_pool, rhs.m_pool );
+    std::swap( m_queryCount, rhs.m_queryCount );
+    std::swap( m_scopeCount, rhs.m_scopeCount );
+    std::swap( m_scopes, rhs.m_scopes );
+    return *this;
+}
+
+void TimestampPool::reset( VkCommandBuffer cmd ) noexcept
+{
+    assert( m_pool );
+    vkCmdResetQueryPool( cmd, m_pool, 0, MAX_QUERIES );
+}
+
+uint32_t TimestampPool::begin( VkCommandBuffer cmd, std::string_view name ) noexcept
+{
+    assert( m_pool );
+    if ( m_scopeCount == MAX_SCOPES ) [[unlikely]] return MAX_SCOPES;
+
+    const uint32_t scope = m_scopeCount++;
+    m_scopes[ scope ] = Scope{ .name = name, .begin = m_queryCount++ };
+    vkCmdWriteTimestamp( cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_pool, m_scopes[ scope ].begin );
+    return scope;
+}
+
+void TimestampPool::end( VkCommandBuffer cmd, uint32_t scope ) noexcept
+{
+    assert( m_pool );
+    if ( scope >= m_scopeCount ) [[unlikely]] return;
+    assert( m_scopes[ scope ].end == 0 );
+    assert( m_queryCount < MAX_QUERIES );
+    m_scopes[ scope ].end = m_queryCount++;
+    vkCmdWriteTimestamp( cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_pool, m_scopes[ scope ].end );
+}
+
+bool TimestampPool::resolve( float timestampPeriod, std::pmr::vector<GpuScopeTiming>& timings ) noexcept
+{
+    ZoneScoped;
+    const uint32_t queryCount = std::exchange( m_queryCount, 0 );
+    const uint32_t scopeCount = std::exchange( m_scopeCount, 0 );
+    if ( queryCount == 0 ) return false;
+
+    std::array<uint64_t, MAX_QUERIES> ticks{};
+    const VkResult result = vkGetQueryPoolResults( m_device
+        , m_pool
+        , 0
+        , queryCount
+        , sizeof( uint64_t ) * queryCount
+        , ticks.data()
+        , sizeof( uint64_t )
+        , VK_QUERY_RESULT_64_BIT
+    );
+    if ( result != VK_SUCCESS ) return false;
+
+    const double period = static_cast<double>( timestampPeriod );
+    auto nanoseconds = [period]( uint64_t t ) { return static_cast<uint64_t>( static_cast<double>( t ) * period ); };
+
+    timings.clear();
+    for ( uint32_t i = 0; i < scopeCount; ++i ) {
+        const Scope& scope = m_scopes[ i ];
+        if ( scope.end == 0 ) continue;
+        const uint64_t begin = nanoseconds( ticks[ scope.begin ] );
+        const uint64_t end = nanoseconds( ticks[ scope.end ] );
+        timings.emplace_back( GpuScopeTiming{
+            .name = scope.name,
+            .beginNs = begin,
+            .endNs = std::max( begin, end ),
+            .milliseconds = static_cast<float>( std::max( begin, end ) - begin ) / 1'000'000.0f,
+        } );
+    }
+    m_scopes = {};
+    return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "vk.hpp"
+
+#include <renderer/renderer.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+class TimestampPool {
+public:
+    enum : uint32_t {
+        MAX_SCOPES = 32,
+        MAX_QUERIES = MAX_SCOPES * 2,
+    };
+
+    struct Scope {
+        std::string_view name{};
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+
+private:
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkQueryPool m_pool = VK_NULL_HANDLE;
+    uint32_t m_queryCount = 0;
+    uint32_t m_scopeCount = 0;
+    std::array<Scope, MAX_SCOPES> m_scopes{};
+
+public:
+    ~TimestampPool() noexcept;
+    TimestampPool() noexcept = default;
+    TimestampPool( VkDevice ) noexcept;
+
+    TimestampPool( const TimestampPool& ) = delete;
+    TimestampPool& operator = ( const TimestampPool& ) = delete;
+    TimestampPool( TimestampPool&& ) noexcept;
+    TimestampPool& operator = ( TimestampPool&& ) noexcept;
+
+    inline operator bool () const noexcept { return m_pool; }
+
+    // returns MAX_SCOPES when out of queries, end() ignores such scope
+    [[nodiscard]]
+    uint32_t begin( VkCommandBuffer, std::string_view name ) noexcept;
+    void end( VkCommandBuffer, uint32_t scope ) noexcept;
+
+    // must be recorded before any begin()/end() in submission order
+    void reset( VkCommandBuffer ) noexcept;
+
+    // non-blocking, returns false when results of previous submission are not available yet;
+    // clears recorded scopes either way
+    [[nodiscard]]
+    bool resolve( float timestampPeriod, std::pmr::vector<GpuScopeTiming>& ) noexcept;
+};
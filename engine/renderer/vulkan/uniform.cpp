@@ -4,46 +4,46 @@
 
 #include <profiler.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <utility>
 #include <bit>
 
+static constexpr VkMemoryPropertyFlags HOST_MEMORY = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+static constexpr VkMemoryPropertyFlags DIRECT_MEMORY = HOST_MEMORY | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
 Uniform::~Uniform() noexcept
 {
-    if ( m_device && m_memoryStaging ) {
-        vkUnmapMemory( m_device, m_memoryStaging );
+    for ( auto& it : m_blocks ) {
+        destroyBlock( it );
     }
-    destroy<vkDestroyBuffer>( m_device, m_buffer );
-    destroy<vkDestroyBuffer>( m_device, m_staging );
 }
 
 Uniform::Uniform( Uniform&& rhs ) noexcept
 {
+    std::swap( m_physicalDevice, rhs.m_physicalDevice );
     std::swap( m_device, rhs.m_device );
-    std::swap( m_memoryStaging, rhs.m_memoryStaging );
-    std::swap( m_memoryDeviceLocal, rhs.m_memoryDeviceLocal );
-    std::swap( m_staging, rhs.m_staging );
-    std::swap( m_buffer, rhs.m_buffer );
-    std::swap( m_mapped, rhs.m_mapped );
-    std::swap( m_currentOffset, rhs.m_currentOffset );
+    std::swap( m_blocks, rhs.m_blocks );
+    std::swap( m_currentBlock, rhs.m_currentBlock );
     std::swap( m_minAlign, rhs.m_minAlign );
-    std::swap( m_size, rhs.m_size );
+    std::swap( m_blockSize, rhs.m_blockSize );
+    std::swap( m_bytesUploaded, rhs.m_bytesUploaded );
+    std::swap( m_bytesCopied, rhs.m_bytesCopied );
+    std::swap( m_direct, rhs.m_direct );
 }
 
 Uniform& Uniform::operator = ( Uniform&& rhs ) noexcept
 {
+    std::swap( m_physicalDevice, rhs.m_physicalDevice );
     std::swap( m_device, rhs.m_device );
-    std::swap( m_memoryStaging, rhs.m_memoryStaging );
-    std::swap( m_memoryDeviceLocal, rhs.m_memoryDeviceLocal );
-    std::swap( m_staging, rhs.m_staging );
-    std::swap( m_buffer, rhs.m_buffer );
-    std::swap( m_mapped, rhs.m_mapped );
-    std::swap( m_currentOffset, rhs.m_currentOffset );
+    std::swap( m_blocks, rhs.m_blocks );
+    std::swap( m_currentBlock, rhs.m_currentBlock );
     std::swap( m_minAlign, rhs.m_minAlign );
-    std::swap( m_size, rhs.m_size );
-
+    std::swap( m_blockSize, rhs.m_blockSize );
+    std::swap( m_bytesUploaded, rhs.m_bytesUploaded );
+    std::swap( m_bytesCopied, rhs.m_bytesCopied );
+    std::swap( m_direct, rhs.m_direct );
     return *this;
 }
 
@@ -62,28 +62,57 @@ static VkBuffer createBuffer( VkDevice device, std::size_t size, VkBufferUsageFl
     return buffer;
 }
 
-Uniform::Uniform( VkPhysicalDevice physDevice, VkDevice device, std::size_t size, std::size_t minAlign ) noexcept
-: m_device{ device }
+Uniform::Uniform( VkPhysicalDevice physDevice, VkDevice device, std::size_t blockSize, std::size_t minAlign ) noexcept
+: m_physicalDevice{ physDevice }
+, m_device{ device }
 , m_minAlign{ minAlign }
-, m_size{ size }
+, m_blockSize{ blockSize }
 {
     ZoneScoped;
-    m_staging = createBuffer( device, m_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT );
-    m_buffer = createBuffer( device, m_size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT );
+    VkBuffer probe = createBuffer( device, m_blockSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT );
+    m_direct = DeviceMemory::hasMemoryType( physDevice, device, probe, DIRECT_MEMORY );
+    destroy<vkDestroyBuffer>( device, probe );
 
-    m_memoryStaging = DeviceMemory{ physDevice, device, m_staging, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
-    m_memoryDeviceLocal = DeviceMemory{ physDevice, device, m_buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT };
+    m_blocks.emplace_back( createBlock( m_blockSize ) );
+    reset();
+}
 
-    [[maybe_unused]] const VkResult sOK = vkBindBufferMemory( device, m_staging, m_memoryStaging, 0 );
-    [[maybe_unused]] const VkResult lOK = vkBindBufferMemory( device, m_buffer, m_memoryDeviceLocal, 0 );
+Uniform::Block Uniform::createBlock( std::size_t size ) noexcept
+{
+    ZoneScoped;
+    Block block{ .m_size = size };
+    if ( m_direct ) {
+        block.m_buffer = createBuffer( m_device, size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT );
+        block.m_memory = DeviceMemory{ m_physicalDevice, m_device, block.m_buffer, DIRECT_MEMORY };
+    }
+    else {
+        block.m_buffer = createBuffer( m_device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT );
+        block.m_deviceLocal = createBuffer( m_device, size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT );
+        block.m_memory = DeviceMemory{ m_physicalDevice, m_device, block.m_buffer, HOST_MEMORY };
+        block.m_memoryDeviceLocal = DeviceMemory{ m_physicalDevice, m_device, block.m_deviceLocal, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT };
+        [[maybe_unused]] const VkResult lOK = vkBindBufferMemory( m_device, block.m_deviceLocal, block.m_memoryDeviceLocal, 0 );
+        assert( lOK == VK_SUCCESS );
+    }
+    [[maybe_unused]] const VkResult sOK = vkBindBufferMemory( m_device, block.m_buffer, block.m_memory, 0 );
     assert( sOK == VK_SUCCESS );
-    assert( lOK == VK_SUCCESS );
 
-    assert( m_size <= m_memoryStaging.size() );
+    assert( size <= block.m_memory.size() );
+    void* mapped = nullptr;
     [[maybe_unused]]
-    const VkResult mapOK = vkMapMemory( m_device, m_memoryStaging, 0, m_size, {}, &m_mapped );
+    const VkResult mapOK = vkMapMemory( m_device, block.m_memory, 0, size, {}, &mapped );
     assert( mapOK == VK_SUCCESS );
-    reset();
+    block.m_mapped = reinterpret_cast<std::byte*>( mapped );
+    return block;
+}
+
+void Uniform::destroyBlock( Block& block ) noexcept
+{
+    if ( m_device && block.m_mapped ) {
+        vkUnmapMemory( m_device, block.m_memory );
+    }
+    destroy<vkDestroyBuffer>( m_device, block.m_deviceLocal );
+    destroy<vkDestroyBuffer>( m_device, block.m_buffer );
+    block = {};
 }
 
 static std::uintptr_t align( std::uintptr_t p, std::size_t a )
@@ -95,14 +124,22 @@ static std::uintptr_t align( std::uintptr_t p, std::size_t a )
 
 VkDescriptorBufferInfo Uniform::copy( const void* data, std::size_t size ) noexcept
 {
-    const std::uintptr_t offset = align( m_currentOffset, m_minAlign );
-    m_currentOffset = offset + size;
-    assert( m_currentOffset <= m_size );
-    auto* ptr = reinterpret_cast<std::byte*>( m_mapped ) + offset;
-    std::memcpy( ptr, data, size );
+    assert( !m_blocks.empty() );
+    std::uintptr_t offset = align( m_blocks[ m_currentBlock ].m_used, m_minAlign );
+    while ( offset + size > m_blocks[ m_currentBlock ].m_size ) [[unlikely]] {
+        if ( ++m_currentBlock == m_blocks.size() ) {
+            m_blocks.emplace_back( createBlock( std::max( m_blockSize, size ) ) );
+        }
+        offset = 0;
+    }
+
+    Block& block = m_blocks[ m_currentBlock ];
+    block.m_used = offset + size;
+    m_bytesUploaded += size;
+    std::memcpy( block.m_mapped + offset, data, size );
 
     return {
-        .buffer = m_buffer,
+        .buffer = m_direct ? block.m_buffer : block.m_deviceLocal,
         .offset = offset,
         .range = size,
     };
@@ -110,16 +147,42 @@ VkDescriptorBufferInfo Uniform::copy( const void* data, std::size_t size ) noexc
 
 void Uniform::reset()
 {
-    m_currentOffset = 0;
+    m_currentBlock = 0;
+    m_bytesUploaded = 0;
+    m_bytesCopied = 0;
+    for ( auto& it : m_blocks ) {
+        it.m_used = 0;
+    }
 }
 
 void Uniform::transfer( VkCommandBuffer cmd )
 {
-    if ( m_currentOffset == 0 ) {
+    if ( m_direct ) {
         return;
     }
-    const VkBufferCopy copyRegion{
-        .size = m_currentOffset,
+    for ( const auto& it : m_blocks ) {
+        if ( it.m_used == 0 ) continue;
+        const VkBufferCopy copyRegion{
+            .size = it.m_used,
+        };
+        vkCmdCopyBuffer( cmd, it.m_buffer, it.m_deviceLocal, 1, &copyRegion );
+        m_bytesCopied += it.m_used;
+    }
+    if ( m_bytesCopied == 0 ) {
+        return;
+    }
+
+    static constexpr VkMemoryBarrier barrier{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT,
     };
-    vkCmdCopyBuffer( cmd, m_staging, m_buffer, 1, &copyRegion );
+    vkCmdPipelineBarrier( cmd
+        , VK_PIPELINE_STAGE_TRANSFER_BIT
+        , VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+        , 0
+        , 1, &barrier
+        , 0, nullptr
+        , 0, nullptr
+    );
 }
@@ -5,22 +5,40 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory_resource>
+#include <vector>
 
+// Linear per-frame allocator of persistently mapped blocks, chains another block when current one runs out.
+// When host visible device local memory is available (ReBAR, unified memory) uniforms are written in place,
+// otherwise only the used range of each block is copied to device local mirror.
 class Uniform {
-    DeviceMemory m_memoryStaging{};
-    DeviceMemory m_memoryDeviceLocal{};
+    struct Block {
+        DeviceMemory m_memory{};
+        DeviceMemory m_memoryDeviceLocal{};
+        VkBuffer m_buffer = VK_NULL_HANDLE;
+        VkBuffer m_deviceLocal = VK_NULL_HANDLE;
+        std::byte* m_mapped = nullptr;
+        std::size_t m_size = 0;
+        std::size_t m_used = 0;
+    };
+
+    VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
     VkDevice m_device = VK_NULL_HANDLE;
-    VkBuffer m_staging = VK_NULL_HANDLE;
-    VkBuffer m_buffer = VK_NULL_HANDLE;
-    void* m_mapped = nullptr;
-    std::uintptr_t m_currentOffset = 0;
+    std::pmr::vector<Block> m_blocks{};
+    std::size_t m_currentBlock = 0;
     std::size_t m_minAlign = 0;
-    std::size_t m_size = 0;
+    std::size_t m_blockSize = 0;
+    std::size_t m_bytesUploaded = 0;
+    std::size_t m_bytesCopied = 0;
+    bool m_direct = false;
+
+    Block createBlock( std::size_t size ) noexcept;
+    void destroyBlock( Block& ) noexcept;
 
 public:
     ~Uniform() noexcept;
     Uniform() noexcept = default;
-    Uniform( VkPhysicalDevice, VkDevice, std::size_t size, std::size_t minAlign ) noexcept;
+    Uniform( VkPhysicalDevice, VkDevice, std::size_t blockSize, std::size_t minAlign ) noexcept;
 
     Uniform( Uniform&& ) noexcept;
     Uniform& operator = ( Uniform&& ) noexcept;
@@ -31,4 +49,9 @@ public:
     VkDescriptorBufferInfo copy( const void*, std::size_t ) noexcept;
     void reset();
     void transfer( VkCommandBuffer cmd );
+
+    inline std::size_t bytesUploaded() const noexcept { return m_bytesUploaded; }
+    inline std::size_t bytesCopied() const noexcept { return m_bytesCopied; }
+    inline uint32_t blockCount() const noexcept { return static_cast<uint32_t>( m_blocks.size() ); }
+    inline bool isDirect() const noexcept { return m_direct; }
 };
@@ -99,7 +99,7 @@ struct Hash {
     }
 };
 
-constexpr Hash::value_type operator ""_hash( const char* str, std::size_t len ) noexcept
+consteval Hash::value_type operator ""_hash( const char* str, std::size_t len ) noexcept
 {
     return Hash::calc( str, len );
 }
@@ -22,6 +22,11 @@ public:
         return m_map.insert( p );
     }
 
+    auto insertOrAssign( std::pair<std::string_view, T>&& p )
+    {
+        return m_map.insert_or_assign( Hash{}( p.first ), p.second );
+    }
+
     T operator [] ( std::string_view sv ) const
     {
         return find( Hash{}( sv ) );
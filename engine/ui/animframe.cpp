@@ -59,7 +59,10 @@ void AnimFrame::update( const UpdateContext& uctx )
         m_spinner = math::mod( m_spinner + uctx.deltaTime * 2.0f, 1.0f );
     }
     auto f = static_cast<float>( m_count ) * m_spinner;
-    m_index = std::min<uint32_t>( static_cast<uint32_t>( f ), m_count - 1 );
+    const uint32_t index = std::min<uint32_t>( static_cast<uint32_t>( f ), m_count - 1 );
+    if ( index == m_index ) { return; }
+    m_index = index;
+    invalidate();
 }
 
 }
@@ -0,0 +1,149 @@
+#include <ui/arena.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace ui {
+
+static constexpr std::size_t ALIGN = alignof( std::max_align_t );
+
+static thread_local std::pmr::memory_resource* s_current = nullptr;
+
+class Arena::Resource final : public std::pmr::memory_resource {
+    // counts what monotonic buffer asks from heap once initial block runs out
+    class Upstream final : public std::pmr::memory_resource {
+        std::pmr::memory_resource* m_heap = nullptr;
+        Statistics* m_statistics = nullptr;
+
+    public:
+        Upstream( std::pmr::memory_resource* heap, Statistics* statistics ) noexcept
+        : m_heap{ heap }
+        , m_statistics{ statistics }
+        {}
+
+        std::pmr::memory_resource* heap() const noexcept
+        {
+            return m_heap;
+        }
+
+    private:
+        virtual void* do_allocate( std::size_t bytes, std::size_t align ) override
+        {
+            m_statistics->heapAllocations++;
+            m_statistics->heapBytes += bytes;
+            return m_heap->allocate( bytes, align );
+        }
+
+        virtual void do_deallocate( void* ptr, std::size_t bytes, std::size_t align ) override
+        {
+            m_heap->deallocate( ptr, bytes, align );
+        }
+
+        virtual bool do_is_equal( const std::pmr::memory_resource& rhs ) const noexcept override
+        {
+            return this == &rhs;
+        }
+    };
+
+    Statistics m_statistics{};
+    Upstream m_upstream;
+    std::pmr::monotonic_buffer_resource m_monotonic;
+
+public:
+    Resource( std::pmr::memory_resource* heap, void* buffer, std::size_t capacity ) noexcept
+    : m_upstream{ heap, &m_statistics }
+    , m_monotonic{ buffer, capacity, &m_upstream }
+    {}
+
+    std::pmr::memory_resource* heap() const noexcept
+    {
+        return m_upstream.heap();
+    }
+
+    Statistics& statistics() noexcept
+    {
+        return m_statistics;
+    }
+
+private:
+    virtual void* do_allocate( std::size_t bytes, std::size_t align ) override
+    {
+        m_statistics.allocations++;
+        m_statistics.bytes += bytes;
+        return m_monotonic.allocate( bytes, align );
+    }
+
+    virtual void do_deallocate( void*, std::size_t, std::size_t ) override
+    {
+    }
+
+    virtual bool do_is_equal( const std::pmr::memory_resource& rhs ) const noexcept override
+    {
+        return this == &rhs;
+    }
+};
+
+Arena::Arena( std::size_t capacity ) noexcept
+{
+    // resource lives at front of the block it manages
+    constexpr std::size_t header = ( sizeof( Resource ) + ALIGN - 1 ) & ~( ALIGN - 1 );
+    m_bytes = header + capacity;
+    std::pmr::memory_resource* heap = std::pmr::get_default_resource();
+    std::byte* block = static_cast<std::byte*>( heap->allocate( m_bytes, ALIGN ) );
+    assert( block );
+    m_resource = std::construct_at( reinterpret_cast<Resource*>( block ), heap, block + header, capacity );
+    Statistics& statistics = m_resource->statistics();
+    statistics.heapAllocations++;
+    statistics.heapBytes += m_bytes;
+}
+
+Arena::~Arena() noexcept
+{
+    if ( !m_resource ) return;
+    assert( s_current != m_resource );
+    std::pmr::memory_resource* heap = m_resource->heap();
+    std::destroy_at( m_resource );
+    heap->deallocate( m_resource, m_bytes, ALIGN );
+}
+
+Arena::Arena( Arena&& rhs ) noexcept
+{
+    std::swap( m_resource, rhs.m_resource );
+    std::swap( m_bytes, rhs.m_bytes );
+}
+
+Arena& Arena::operator = ( Arena&& rhs ) noexcept
+{
+    std::swap( m_resource, rhs.m_resource );
+    std::swap( m_bytes, rhs.m_bytes );
+    return *this;
+}
+
+std::pmr::memory_resource* Arena::resource() const noexcept
+{
+    return m_resource ? static_cast<std::pmr::memory_resource*>( m_resource ) : std::pmr::get_default_resource();
+}
+
+Arena::Statistics Arena::statistics() const noexcept
+{
+    return m_resource ? m_resource->statistics() : Statistics{};
+}
+
+std::pmr::memory_resource* Arena::current() noexcept
+{
+    return s_current ? s_current : std::pmr::get_default_resource();
+}
+
+Arena::Scope::Scope( const Arena& arena ) noexcept
+: m_previous{ std::exchange( s_current, arena.resource() ) }
+{
+}
+
+Arena::Scope::~Scope() noexcept
+{
+    s_current = m_previous;
+}
+
+}
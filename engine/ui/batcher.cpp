@@ -0,0 +1,154 @@
+#include <ui/batcher.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace ui {
+
+static constexpr uint32_t INVALID_SLOT = ~0u;
+
+Batcher::Batcher( const Pipelines& pipelines ) noexcept
+: m_pipelines{ pipelines }
+{
+    m_renderInfo.m_pipeline = m_pipelines.batch;
+    m_renderInfo.m_verticeCount = Batch::VERTICES;
+    m_renderInfo.m_instanceCount = 0;
+}
+
+bool Batcher::transform( const math::mat4& model, const math::mat4& view, const math::mat4& projection, math::vec4& scaleOffset )
+{
+    const math::mat4 m = view * model;
+    const bool scaleTranslate = m[ 0 ][ 1 ] == 0.0f && m[ 0 ][ 2 ] == 0.0f && m[ 0 ][ 3 ] == 0.0f
+        && m[ 1 ][ 0 ] == 0.0f && m[ 1 ][ 2 ] == 0.0f && m[ 1 ][ 3 ] == 0.0f
+        && m[ 3 ][ 2 ] == 0.0f && m[ 3 ][ 3 ] == 1.0f;
+    if ( !scaleTranslate ) return false;
+
+    if ( m_renderInfo.m_instanceCount != 0 && m_batch.m_projection != projection ) flush();
+    m_batch.m_projection = projection;
+    scaleOffset = math::vec4{ m[ 0 ][ 0 ], m[ 1 ][ 1 ], m[ 3 ][ 0 ], m[ 3 ][ 1 ] };
+    return true;
+}
+
+uint32_t Batcher::atlasSlot( Texture texture )
+{
+    auto begin = m_renderInfo.m_fragmentTexture.begin();
+    auto end = begin + m_textureCount;
+    auto it = std::find( begin, end, texture );
+    if ( it != end ) return static_cast<uint32_t>( it - begin );
+    if ( m_textureCount == RenderInfo::MAX_TEXTURES ) return INVALID_SLOT;
+    m_renderInfo.m_fragmentTexture[ m_textureCount ] = texture;
+    return m_textureCount++;
+}
+
+template <typename TPushConstant>
+void Batcher::append( const RenderInfo& ri, const TPushConstant& pushConstant )
+{
+    math::vec4 scaleOffset{};
+    if ( !transform( pushConstant.m_model, pushConstant.m_view, pushConstant.m_projection, scaleOffset ) ) {
+        flush();
+        m_target->render( ri );
+        m_submitted++;
+        return;
+    }
+
+    // atlas index of incoming draw to slot in current batch, forgotten whenever batch is flushed
+    std::array<uint32_t, RenderInfo::MAX_TEXTURES> remap{};
+    remap.fill( INVALID_SLOT );
+    for ( uint32_t i = 0; i < ri.m_instanceCount; ++i ) {
+        const auto& src = pushConstant.m_instances[ i ];
+        assert( src.m_whichAtlas < RenderInfo::MAX_TEXTURES );
+        if ( m_renderInfo.m_instanceCount == Batch::INSTANCES ) {
+            flush();
+            remap.fill( INVALID_SLOT );
+        }
+        uint32_t& slot = remap[ src.m_whichAtlas ];
+        if ( slot == INVALID_SLOT ) {
+            slot = atlasSlot( ri.m_fragmentTexture[ src.m_whichAtlas ] );
+        }
+        if ( slot == INVALID_SLOT ) {
+            flush();
+            remap.fill( INVALID_SLOT );
+            slot = atlasSlot( ri.m_fragmentTexture[ src.m_whichAtlas ] );
+        }
+
+        math::vec4 color{};
+        if constexpr ( std::is_same_v<TPushConstant, PushConstant<Pipeline::eSpriteSequence>> ) color = pushConstant.m_color;
+        else color = src.m_color;
+
+        // assigned member-wise so padding of storage stays zeroed, uploads are deterministic
+        Instance& dst = m_batch.m_instances[ m_renderInfo.m_instanceCount++ ];
+        dst.m_color = color;
+        dst.m_xywh = math::vec4{
+            src.m_xywh.x * scaleOffset.x + scaleOffset.z,
+            src.m_xywh.y * scaleOffset.y + scaleOffset.w,
+            src.m_xywh.z * scaleOffset.x,
+            src.m_xywh.w * scaleOffset.y,
+        };
+        dst.m_uvwh = src.m_uvwh;
+        dst.m_whichAtlas = slot;
+        dst.m_sampleRGBA = src.m_sampleRGBA;
+    }
+}
+
+void Batcher::render( const RenderInfo& ri )
+{
+    assert( m_target );
+    if ( ri.m_pipeline == m_pipelines.spriteSequence ) {
+        using PushConstant = PushConstant<Pipeline::eSpriteSequence>;
+        assert( ri.m_uniform.size == sizeof( PushConstant ) );
+        append( ri, *reinterpret_cast<const PushConstant*>( ri.m_uniform.ptr ) );
+        return;
+    }
+    if ( ri.m_pipeline == m_pipelines.spriteSequenceColors ) {
+        using PushConstant = PushConstant<Pipeline::eSpriteSequenceColors>;
+        assert( ri.m_uniform.size == sizeof( PushConstant ) );
+        append( ri, *reinterpret_cast<const PushConstant*>( ri.m_uniform.ptr ) );
+        return;
+    }
+    flush();
+    m_target->render( ri );
+    m_submitted++;
+}
+
+void Batcher::dispatch( const DispatchInfo& di )
+{
+    assert( m_target );
+    flush();
+    m_target->dispatch( di );
+}
+
+void Batcher::begin( RecordingContext* target )
+{
+    assert( target );
+    assert( m_renderInfo.m_instanceCount == 0 );
+    m_target = target;
+    m_submitted = 0;
+}
+
+void Batcher::end()
+{
+    flush();
+    m_target = nullptr;
+}
+
+void Batcher::flush()
+{
+    if ( m_renderInfo.m_instanceCount == 0 ) return;
+    // shader does not read past instance count, tail of the batch is not uploaded
+    m_renderInfo.m_uniform.ptr = &m_batch;
+    m_renderInfo.m_uniform.size = offsetof( Batch, m_instances ) + m_renderInfo.m_instanceCount * sizeof( Instance );
+    m_target->render( m_renderInfo );
+    m_submitted++;
+    m_renderInfo.m_instanceCount = 0;
+    m_textureCount = 0;
+}
+
+uint32_t Batcher::submitted() const
+{
+    return m_submitted;
+}
+
+}
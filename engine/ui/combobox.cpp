@@ -150,7 +150,7 @@ void ComboBoxList::render( const RenderContext& rctx ) const
 
     for ( decltype( count ) i = 0; i < count; ++i ) {
         Label l{ ci };
-        l.setText( m_model->data( i + m_index.offset() ).visit( GetString{} ) );
+        l.setText( m_model->data( i + m_index.offset() ).visit( GetStringView{} ) );
         l.onRender( rctx );
         ci.position.y += m_lineHeight;
     }
@@ -183,8 +183,9 @@ EventProcessing ComboBoxList::onMouseEvent( const MouseEvent& event )
 
     pos.y += m_topPadding;
     auto idx = pointToIndex( p, pos, s.x, m_lineHeight, visibleCount() );
-    if ( idx ) {
+    if ( idx && idx - 1 != m_index.currentVisible() ) {
         m_index.selectVisible( idx - 1 );
+        invalidate();
     }
 
     switch ( event.type ) {
@@ -214,10 +215,12 @@ EventProcessing ComboBoxList::onAction( ui::Action action )
 
     case ui::Action::eMenuDown:
         m_index.increase();
+        invalidate();
         return EventProcessing::eContinue;
 
     case ui::Action::eMenuUp:
         m_index.decrease();
+        invalidate();
         return EventProcessing::eContinue;
 
     default:
@@ -99,6 +99,7 @@ void Decorator::setSprite( const Sprite& sprite )
     };
     m_textures.resize( 1 );
     m_textures[ 0 ] = sprite.texture;
+    invalidate();
 }
 
 void Decorator::setNineSlice( const std::array<Hash::value_type, 9>& hashes )
@@ -119,6 +120,7 @@ void Decorator::setNineSlice( const std::array<Hash::value_type, 9>& hashes )
         sprite.m_whichAtlas = (uint32_t)std::distance( m_textures.begin(), std::ranges::find( m_textures, sprites[ i ].texture ) );
         sprite.m_sampleRGBA = textureIs4Channel( m_textures[ sprite.m_whichAtlas ] );
     }
+    invalidate();
 }
 
 void Decorator::render( const RenderContext& rctx ) const
@@ -0,0 +1,75 @@
+#include <ui/draw_cache.hpp>
+
+#include <cassert>
+#include <cstring>
+
+namespace ui {
+
+DrawCache::DrawCache( std::pmr::memory_resource* resource ) noexcept
+: m_commands{ resource }
+, m_uniforms{ resource }
+{
+}
+
+uint32_t DrawCache::storeUniform( const void* ptr, size_t size )
+{
+    const uint32_t offset = static_cast<uint32_t>( m_uniforms.size() );
+    if ( !size ) return offset;
+    assert( ptr );
+    m_uniforms.resize( offset + ( size + sizeof( math::vec4 ) - 1 ) / sizeof( math::vec4 ) );
+    std::memcpy( m_uniforms.data() + offset, ptr, size );
+    return offset;
+}
+
+void DrawCache::render( const RenderInfo& ri )
+{
+    Command& cmd = m_commands.emplace_back( Command{ .renderInfo = ri } );
+    cmd.uniformOffset = storeUniform( ri.m_uniform.ptr, ri.m_uniform.size );
+}
+
+void DrawCache::dispatch( const DispatchInfo& di )
+{
+    Command& cmd = m_commands.emplace_back( Command{ .dispatchInfo = di, .isDispatch = true } );
+    cmd.uniformOffset = storeUniform( di.m_uniform.ptr, di.m_uniform.size );
+}
+
+void DrawCache::reset( const math::mat4& model, const math::mat4& view, const math::mat4& projection )
+{
+    m_commands.clear();
+    m_uniforms.clear();
+    m_model = model;
+    m_view = view;
+    m_projection = projection;
+}
+
+bool DrawCache::matches( const math::mat4& model, const math::mat4& view, const math::mat4& projection ) const
+{
+    return m_model == model
+        && m_view == view
+        && m_projection == projection;
+}
+
+void DrawCache::replay( RecordingContext* rc ) const
+{
+    assert( rc );
+    // uniform storage is stable until next reset, fix up pointers at replay
+    for ( const Command& cmd : m_commands ) {
+        const void* uniform = m_uniforms.data() + cmd.uniformOffset;
+        if ( cmd.isDispatch ) {
+            DispatchInfo di = cmd.dispatchInfo;
+            di.m_uniform.ptr = di.m_uniform.size ? uniform : nullptr;
+            rc->dispatch( di );
+            continue;
+        }
+        RenderInfo ri = cmd.renderInfo;
+        ri.m_uniform.ptr = ri.m_uniform.size ? uniform : nullptr;
+        rc->render( ri );
+    }
+}
+
+uint32_t DrawCache::size() const
+{
+    return static_cast<uint32_t>( m_commands.size() );
+}
+
+}
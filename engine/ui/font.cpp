@@ -9,6 +9,7 @@
 #include <profiler.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <numeric>
 #include <memory_resource>
@@ -33,9 +34,9 @@ static std::tuple<math::vec4, math::vec4> composeSprite( const fnta::Glyph& glyp
 }
 
 
-static std::pmr::u32string textUnmap( std::u32string_view s )
+static std::pmr::u32string textUnmap( std::u32string_view s, std::pmr::memory_resource* resource )
 {
-    std::pmr::u32string ret;
+    std::pmr::u32string ret{ std::pmr::polymorphic_allocator<>{ resource } };
     auto isAction = []( char32_t c ) { return c >= (char32_t)ui::Action::Enum::base && c < (char32_t)ui::Action::Enum::end; };
     auto it = std::ranges::find_if( s, isAction );
     if ( it == s.end() ) [[likely]] return ret;
@@ -114,6 +115,11 @@ Font::Font( const CreateInfo& ci )
     m_lineHeight = header.lineHeight;
     m_name = header.nameHash;
     m_glyphMap = GlyphMap{ charSpan, glyphSpan };
+    assert( header.count < ( 1u << GlyphTable::GLYPH_BITS ) );
+    for ( uint32_t i = 0; i < header.count; ++i ) {
+        m_glyphTable.insert( charSpan[ i ], GlyphTable::makeRef( 0, i ) );
+    }
+    m_glyphTable.finish();
     m_texture = g_uiProperty.findTexture( header.textureHash );
     assert( m_texture );
 }
@@ -126,6 +132,8 @@ Font::Font( Font&& rhs )
     std::swap( m_scale, rhs.m_scale );
     std::swap( m_texture, rhs.m_texture );
     std::swap( m_glyphMap, rhs.m_glyphMap );
+    std::swap( m_glyphTable, rhs.m_glyphTable );
+    std::swap( m_fontMap, rhs.m_fontMap );
     std::swap( m_name, rhs.m_name );
 }
 
@@ -137,6 +145,8 @@ Font& Font::operator = ( Font&& rhs )
     std::swap( m_scale, rhs.m_scale );
     std::swap( m_texture, rhs.m_texture );
     std::swap( m_glyphMap, rhs.m_glyphMap );
+    std::swap( m_glyphTable, rhs.m_glyphTable );
+    std::swap( m_fontMap, rhs.m_fontMap );
     std::swap( m_name, rhs.m_name );
     return *this;
 }
@@ -153,18 +163,30 @@ Texture Font::texture() const
 }
 
 Font::RenderText Font::composeText( std::u32string_view text, const math::vec2& geometry ) const
+{
+    RenderText ret{};
+    composeText( ret, text, geometry );
+    return ret;
+}
+
+void Font::composeText( RenderText& ret, std::u32string_view text, const math::vec2& geometry ) const
 {
     ZoneScoped;
-    std::pmr::u32string textRemapped = textUnmap( text );
+    // text with action glyphs is remapped on stack, heap is reached only by unusually long one
+    std::array<std::byte, 512> buffer;
+    std::pmr::monotonic_buffer_resource stack{ buffer.data(), buffer.size() };
+    std::pmr::u32string textRemapped = textUnmap( text, &stack );
     if ( !textRemapped.empty() ) text = textRemapped;
 
-    RenderText ret{
-        .pushData{
-            .m_pipeline = g_uiProperty.findMaterial( "spriteSequence"_hash ),
-            .m_verticeCount = ui::PushConstant<ui::Pipeline::eSpriteSequence>::VERTICES,
-        },
+    ret.pushData = RenderInfo{
+        .m_pipeline = g_uiProperty.findMaterial( "spriteSequence"_hash ),
+        .m_verticeCount = ui::PushConstant<ui::Pipeline::eSpriteSequence>::VERTICES,
     };
-    if ( text.empty() ) [[unlikely]] return ret;
+    ret.data.clear();
+    ret.extent = {};
+    if ( text.empty() ) [[unlikely]] return;
+    // at most one quad per character, growing one by one would leave every smaller copy behind in screen arena
+    ret.data.reserve( text.size() );
 
     math::vec2 cursor{};
     uint32_t lastBreakPosition = 0;
@@ -269,7 +291,6 @@ Font::RenderText Font::composeText( std::u32string_view text, const math::vec2&
     ret.extent.x = std::max( ret.extent.x, cursor.x );
     ret.extent.y = cursor.y;
     ret.pushData.m_instanceCount = (uint32_t)ret.data.size();
-    return ret;
 }
 
 Texture Font::appendRenderText( math::vec2& cursor, RenderInstance& sprite, char32_t chr ) const
@@ -289,9 +310,13 @@ Texture Font::appendRenderText( math::vec2& cursor, RenderInstance& sprite, char
 
 std::tuple<Font::Glyph, Texture, math::vec2, uint32_t> Font::getGlyph( char32_t ch ) const
 {
-    const Glyph* g = m_glyphMap.find( ch );
-    if ( g ) [[likely]] return std::make_tuple( *g, m_texture, extent(), m_lineHeight );
-    return g_uiProperty.fontMap().getGlyph( m_name, ch );
+    const GlyphTable::Ref ref = m_glyphTable.find( ch );
+    assert( ref );
+    if ( !ref ) [[unlikely]] return {};
+    const uint32_t fontIndex = GlyphTable::font( ref );
+    assert( !fontIndex || m_fontMap );
+    const Font* font = fontIndex ? &m_fontMap->m_fonts[ fontIndex - 1 ] : this;
+    return std::make_tuple( font->m_glyphMap.m_values[ GlyphTable::glyph( ref ) ], font->m_texture, font->extent(), font->m_lineHeight );
 }
 
 math::vec2 Font::extent() const
@@ -301,7 +326,8 @@ math::vec2 Font::extent() const
 
 bool Font::hasCodepoint( char32_t cp ) const
 {
-    return std::ranges::binary_search( m_glyphMap.m_keys, cp );
+    const GlyphTable::Ref ref = m_glyphTable.find( cp );
+    return ref && GlyphTable::font( ref ) == 0;
 }
 
 Sprite Font::find( Hash::value_type h ) const
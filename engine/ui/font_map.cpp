@@ -1,9 +1,10 @@
 #include <ui/font_map.hpp>
 
-#include <shared/max_score_element.hpp>
+#include <profiler.hpp>
 
 #include <algorithm>
 #include <cassert>
+#include <numeric>
 
 namespace ui {
 
@@ -12,27 +13,43 @@ void FontMap::addFont( std::span<const uint8_t> data )
     m_fonts.emplace_back( Font::CreateInfo{
         .fontAtlas = data,
     } );
+    assert( m_fonts.size() < GlyphTable::MAX_FONTS );
+    bakeGlyphTables();
 }
 
-const Font* FontMap::findFont( Hash::value_type hash ) const
+void FontMap::bakeGlyphTables()
 {
-    auto it = std::ranges::find_if( m_fonts, [hash]( const Font& f ) { return f.m_name == hash; } );
-    assert( it != m_fonts.end() );
-    return &*it;
+    ZoneScoped;
+    // code point missing in font is taken from font with the tallest line that has it
+    std::pmr::vector<uint32_t> fallbackOrder( m_fonts.size() );
+    std::iota( fallbackOrder.begin(), fallbackOrder.end(), 0u );
+    std::ranges::stable_sort( fallbackOrder, std::ranges::greater{}, [this]( uint32_t i ) { return m_fonts[ i ].m_lineHeight; } );
+
+    for ( uint32_t i = 0; i < m_fonts.size(); ++i ) {
+        Font& font = m_fonts[ i ];
+        font.m_fontMap = this;
+        font.m_glyphTable.clear();
+        auto insertGlyphs = [&font]( const Font& from, uint32_t fontIndex )
+        {
+            const auto& keys = from.m_glyphMap.m_keys;
+            for ( uint32_t g = 0; g < keys.size(); ++g ) {
+                font.m_glyphTable.insert( keys[ g ], GlyphTable::makeRef( fontIndex, g ) );
+            }
+        };
+        insertGlyphs( font, 0 );
+        for ( uint32_t f : fallbackOrder ) {
+            if ( f == i ) continue;
+            insertGlyphs( m_fonts[ f ], f + 1 );
+        }
+        font.m_glyphTable.finish();
+    }
 }
 
-std::tuple<Font::Glyph, Texture, math::vec2, uint32_t> FontMap::getGlyph( Hash::value_type name, char32_t codepoint ) const
+const Font* FontMap::findFont( Hash::value_type hash ) const
 {
-    auto it = maxScoreElement( m_fonts, [name, codepoint]( const auto& f ) -> size_t
-    {
-        if ( !f.hasCodepoint( codepoint ) ) return 0;
-        return ( f.m_name == name ) * 10'000'000u + f.m_lineHeight;
-    } );
+    auto it = std::ranges::find_if( m_fonts, [hash]( const Font& f ) { return f.m_name == hash; } );
     assert( it != m_fonts.end() );
-    auto g = it->m_glyphMap.find( codepoint );
-    assert( g );
-    if ( g ) [[likely]] return std::make_tuple( *g, it->m_texture, it->extent(), it->m_lineHeight );
-    return {};
+    return &*it;
 }
 
 }
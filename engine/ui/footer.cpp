@@ -29,7 +29,13 @@ Footer::Footer( const Footer::CreateInfo& ci ) noexcept
 
 void Footer::refreshText()
 {
+    size_t length = 0;
+    for ( auto&& action : m_actions ) {
+        if ( action.textId == 0 ) continue;
+        length += SPACING + g_uiProperty.localize( action.textId ).size();
+    }
     m_text.clear();
+    m_text.reserve( length );
     for ( auto&& action : m_actions ) {
         if ( action.textId == 0 ) continue;
         m_text.push_back( (char32_t)action.action );
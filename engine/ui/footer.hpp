@@ -16,6 +16,9 @@ namespace ui {
 class Footer : public Widget
 {
 public:
+    // characters around text of every button: action glyph, space before text and four after it
+    static constexpr uint32_t SPACING = 6;
+
     struct Entry {
         enum class Type : uint32_t {
             unknown,
@@ -51,7 +54,7 @@ private:
     };
     static constexpr uint32_t MAX_ENTRIES = 4;
     std::array<ActionInfo, MAX_ENTRIES> m_actions{};
-    std::pmr::u32string m_text{};
+    std::pmr::u32string m_text{ std::pmr::polymorphic_allocator<>{ Arena::current() } };
 
     void refreshText();
 };
@@ -0,0 +1,48 @@
+#include <ui/glyph_table.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace ui {
+
+void GlyphTable::clear()
+{
+    m_pageIndex = {};
+    m_pages.clear();
+    m_sparse.clear();
+}
+
+void GlyphTable::insert( char32_t cp, Ref ref )
+{
+    assert( ref );
+    if ( cp >= BMP_END ) {
+        m_sparse.emplace_back( cp, ref );
+        return;
+    }
+    if ( m_pages.empty() ) m_pages.emplace_back();
+    uint16_t& page = m_pageIndex[ cp >> 8 ];
+    if ( page == 0 ) {
+        page = static_cast<uint16_t>( m_pages.size() );
+        m_pages.emplace_back();
+    }
+    Ref& r = m_pages[ page ][ cp & 0xFFu ];
+    if ( r == 0 ) r = ref;
+}
+
+void GlyphTable::finish()
+{
+    auto byKey = []( const auto& lhs, const auto& rhs ) { return lhs.first < rhs.first; };
+    auto sameKey = []( const auto& lhs, const auto& rhs ) { return lhs.first == rhs.first; };
+    std::stable_sort( m_sparse.begin(), m_sparse.end(), byKey );
+    m_sparse.erase( std::unique( m_sparse.begin(), m_sparse.end(), sameKey ), m_sparse.end() );
+    m_sparse.shrink_to_fit();
+}
+
+GlyphTable::Ref GlyphTable::findSparse( char32_t cp ) const
+{
+    auto it = std::ranges::lower_bound( m_sparse, cp, {}, &std::pair<char32_t, Ref>::first );
+    if ( it == m_sparse.end() || it->first != cp ) return 0;
+    return it->second;
+}
+
+}
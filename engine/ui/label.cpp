@@ -20,7 +20,7 @@ Label::Label( const Label::CreateInfo& ci )
     assert( m_font );
     if ( m_dataModel ) {
         m_revision = m_dataModel->revision();
-        setText( m_dataModel->data( m_dataModel->current() ).visit( GetString{} ) );
+        setText( m_dataModel->data( m_dataModel->current() ).visit( GetStringView{} ) );
     }
     else if ( m_locText ) {
         setText( g_uiProperty.localize( m_locText ) );
@@ -54,8 +54,9 @@ void Label::refreshInput()
 {
     Widget::refreshInput();
     if ( m_hasActions ) {
-        m_renderText = m_font->composeText( m_text, m_labelExtent );
+        m_font->composeText( m_renderText, m_text, m_labelExtent );
         m_size = m_renderText.extent;
+        invalidate();
     }
 }
 
@@ -64,7 +65,7 @@ void Label::lockitChanged()
     Widget::lockitChanged();
     if ( m_dataModel ) {
         m_revision = m_dataModel->revision();
-        setText( m_dataModel->data( m_dataModel->current() ).visit( GetString{} ) );
+        setText( m_dataModel->data( m_dataModel->current() ).visit( GetStringView{} ) );
     }
     else if ( m_locText ) {
         setText( g_uiProperty.localize( m_locText ) );
@@ -73,19 +74,26 @@ void Label::lockitChanged()
 
 void Label::setText( std::u32string_view str )
 {
-    setText( std::pmr::u32string{ str.begin(), str.end() } );
+    m_text.assign( str );
+    refreshText();
 }
 
 void Label::setText( std::pmr::u32string&& str )
 {
     m_text = std::move( str );
+    refreshText();
+}
+
+void Label::refreshText()
+{
     auto isAction = []( char32_t c )
     {
         return c >= (char32_t)Action::base && c < (char32_t)Action::end;
     };
     m_hasActions = std::ranges::find_if( m_text, isAction ) != m_text.end();
-    m_renderText = m_font->composeText( m_text, m_labelExtent );
+    m_font->composeText( m_renderText, m_text, m_labelExtent );
     m_size = m_renderText.extent;
+    invalidate();
 }
 
 void Label::update( const UpdateContext& )
@@ -94,7 +102,7 @@ void Label::update( const UpdateContext& )
     const auto rev = m_dataModel->revision();
     if ( rev == m_revision ) { return; }
     m_revision = rev;
-    setText( m_dataModel->data( m_dataModel->current() ).visit( GetString{} ) );
+    setText( m_dataModel->data( m_dataModel->current() ).visit( GetStringView{} ) );
 }
 
 DataModel* Label::dataModel() const
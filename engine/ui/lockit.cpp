@@ -14,6 +14,11 @@ Lockit::Lockit( std::span<const uint8_t> data )
     assert( header.magic == header.MAGIC );
     assert( header.version == header.VERSION );
 
+    assert( header.count == 0 || header.buckets != 0 );
+    assert( data.size() >= header.buckets * sizeof( uint32_t ) );
+    m_seeds = { reinterpret_cast<const uint32_t*>( data.data() ), header.buckets };
+    data = data.subspan( header.buckets * sizeof( uint32_t ) );
+
     assert( data.size() >= header.count * sizeof( lang::KeyType ) );
     m_keys = { reinterpret_cast<const lang::KeyType*>( data.data() ), header.count };
     data = data.subspan( header.count * sizeof( lang::KeyType ) );
@@ -33,13 +38,18 @@ std::u32string_view Lockit::find( std::string_view sv ) const
 
 std::u32string_view Lockit::find( Hash::value_type h ) const
 {
-    auto it = std::lower_bound( m_keys.begin(), m_keys.end(), lang::KeyType{ h, 0, 0 } );
-    if ( it == m_keys.end() || it->hash != h ) {
+    if ( m_keys.empty() ) [[unlikely]] {
+        assert( !"missing lockit key" );
+        return U"<missing lockit key>";
+    }
+    const uint32_t seed = m_seeds[ h % m_seeds.size() ];
+    const lang::KeyType& key = m_keys[ lang::slot( h, seed, static_cast<uint32_t>( m_keys.size() ) ) ];
+    if ( key.hash != h ) {
         assert( !"missing lockit key" );
         return U"<missing lockit key>";
     }
-    assert( m_data.size() >= ( (size_t)it->offset + it->size ) );
-    return std::u32string_view{ m_data.data() + it->offset, it->size };
+    assert( m_data.size() >= ( (size_t)key.offset + key.size ) );
+    return std::u32string_view{ m_data.data() + key.offset, key.size };
 }
 
 }
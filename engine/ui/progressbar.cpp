@@ -51,7 +51,10 @@ void Progressbar::update( const UpdateContext& )
     const auto rev = m_dataModel->revision();
     if ( rev == m_revision ) { return; }
     m_revision = rev;
-    m_value = m_dataModel->data( m_dataModel->current() ).visit( GetFloat{} );
+    const float value = m_dataModel->data( m_dataModel->current() ).visit( GetFloat{} );
+    if ( value == m_value ) { return; }
+    m_value = value;
+    invalidate();
 }
 
 }
@@ -1,6 +1,8 @@
 #include <ui/property.hpp>
 #include <ui/font.hpp>
 
+#include <algorithm>
+
 namespace ui {
 
 Sprite Property::sprite( Hash::value_type hash ) const
@@ -33,7 +35,7 @@ void Property::playSound( Hash::value_type hh )
 {
     auto sound = m_sounds->find( hh );
     assert( sound );
-    m_audio->play( sound, Audio::Channel::eUI );
+    m_audio->play( sound, Audio::Channel::eUI, Audio::Priority::eHigh );
 }
 
 void Property::changeScreen( Hash::value_type hash, math::vec2 viewport )
@@ -59,6 +61,27 @@ uint32_t Property::changeLockit( std::array<char, 8> id )
     return m_currentLang;
 }
 
+void Property::setResources( const Resources& r )
+{
+    m_textures = r.textures;
+    m_materials = r.materials;
+    m_sounds = r.sounds;
+    m_audio = r.audio;
+    m_remapper = r.remapper;
+}
+
+const Lockit* Property::loadLANG( std::span<const uint8_t> data )
+{
+    Lockit lockit{ data };
+    auto it = std::ranges::find( m_lockit, lockit.id(), &Lockit::id );
+    if ( it != m_lockit.end() ) {
+        *it = std::move( lockit );
+        std::ranges::for_each( m_screens, []( auto& s ) { s.lockitChanged(); } );
+        return nullptr;
+    }
+    return &m_lockit.emplace_back( std::move( lockit ) );
+}
+
 void Property::loadFNTA( std::span<const uint8_t> data )
 {
     m_fontMap.addFont( data );
@@ -75,7 +98,15 @@ void Property::loadATLAS( std::span<const uint8_t> data )
 
 void Property::loadUI( std::span<const uint8_t> data )
 {
-    m_screens.emplace_back( data );
+    const Screen& screen = m_screens.emplace_back( data );
+    // reloaded screen replaces previous one of same name
+    auto it = std::ranges::find( m_screens, screen.name(), &Screen::name );
+    if ( &*it == &screen ) return;
+    if ( m_currentScreen == &*it ) {
+        m_currentScreen = &m_screens.back();
+        m_currentScreen->show( m_viewport );
+    }
+    m_screens.erase( it );
 }
 
 }
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace ui {
+
+// Single block of memory backing widgets of one screen together with their strings and containers. Deallocation
+// is no-op, whole block is released at once together with arena. Grows from default resource when initial size
+// turns out too small.
+class Arena {
+public:
+    struct Statistics {
+        // served by arena
+        uint32_t allocations = 0;
+        std::size_t bytes = 0;
+        // requested by arena from default resource, initial block included
+        uint32_t heapAllocations = 0;
+        std::size_t heapBytes = 0;
+    };
+
+    // Makes arena current on this thread, widgets constructed meanwhile allocate from it.
+    class Scope {
+        std::pmr::memory_resource* m_previous = nullptr;
+
+    public:
+        ~Scope() noexcept;
+        explicit Scope( const Arena& ) noexcept;
+        Scope( const Scope& ) = delete;
+        Scope& operator = ( const Scope& ) = delete;
+    };
+
+private:
+    class Resource;
+    Resource* m_resource = nullptr;
+    std::size_t m_bytes = 0;
+
+public:
+    ~Arena() noexcept;
+    Arena() noexcept = default;
+    explicit Arena( std::size_t capacity ) noexcept;
+    Arena( const Arena& ) = delete;
+    Arena( Arena&& ) noexcept;
+    Arena& operator = ( const Arena& ) = delete;
+    Arena& operator = ( Arena&& ) noexcept;
+
+    // default resource when arena is empty
+    std::pmr::memory_resource* resource() const noexcept;
+    Statistics statistics() const noexcept;
+
+    // resource of innermost Scope on this thread, default resource outside of any
+    static std::pmr::memory_resource* current() noexcept;
+};
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <math.hpp>
+#include <renderer/renderer.hpp>
+#include <ui/pipeline.hpp>
+
+#include <cstdint>
+
+namespace ui {
+
+// Merges sprite and glyph quads of whole screen into as few draws as possible. Quads are moved into screen space
+// and keep their painter's order, atlas is selected per instance so texture changes do not need sorting.
+// Batch is flushed only when it is full, runs out of atlas slots, projection changes or before any other draw or dispatch.
+// Owned by screen for its whole lifetime, batch storage is too large to be set up every frame.
+class Batcher final : public RecordingContext {
+public:
+    struct Pipelines {
+        PipelineSlot batch{};
+        PipelineSlot spriteSequence{};
+        PipelineSlot spriteSequenceColors{};
+    };
+
+private:
+    using Batch = PushConstant<Pipeline::eSpriteBatch>;
+    using Instance = Batch::Instance;
+
+    RecordingContext* m_target = nullptr;
+    Pipelines m_pipelines{};
+    RenderInfo m_renderInfo{};
+    uint32_t m_textureCount = 0;
+    uint32_t m_submitted = 0;
+    Batch m_batch{};
+
+    // model and view folded into instance geometry, false when they rotate or skew
+    bool transform( const math::mat4& model, const math::mat4& view, const math::mat4& projection, math::vec4& scaleOffset );
+    uint32_t atlasSlot( Texture );
+    template <typename TPushConstant>
+    void append( const RenderInfo&, const TPushConstant& );
+
+public:
+    virtual ~Batcher() noexcept override = default;
+    Batcher() noexcept = default;
+    Batcher( const Pipelines& ) noexcept;
+
+    virtual void render( const RenderInfo& ) override;
+    virtual void dispatch( const DispatchInfo& ) override;
+
+    // following draws are batched for given target until end()
+    void begin( RecordingContext* );
+    void flush();
+    void end();
+    // draws forwarded to target since begin()
+    uint32_t submitted() const;
+};
+
+}
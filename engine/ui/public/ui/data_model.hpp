@@ -19,12 +19,19 @@ struct GetT {
     inline T operator () ( const T& t ) const { return t; }
     inline T operator () ( const auto& ) const { return {}; }
 };
+
+// view into string held by variant, valid as long as the variant is
+struct GetStringView {
+    inline std::u32string_view operator () ( const std::pmr::u32string& t ) const { return t; }
+    inline std::u32string_view operator () ( const auto& ) const { return {}; }
+};
 }
 
 using Variant = std::variant<std::monostate, std::pmr::u32string, Sprite, float>;
 using GetString = detail::GetT<std::pmr::u32string>;
 using GetFloat = detail::GetT<float>;
 using GetSprite = detail::GetT<Sprite>;
+using GetStringView = detail::GetStringView;
 
 class DataModel {
 public:
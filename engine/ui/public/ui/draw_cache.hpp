@@ -0,0 +1,50 @@
+#pragma once
+
+#include <math.hpp>
+#include <renderer/renderer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace ui {
+
+// Records draws and dispatches of single widget together with copy of their uniforms, so they can be
+// replayed in later frames without regenerating sprite instances or glyph quads.
+class DrawCache final : public RecordingContext {
+    struct Command {
+        RenderInfo renderInfo{};
+        DispatchInfo dispatchInfo{};
+        uint32_t uniformOffset = 0;
+        bool isDispatch = false;
+    };
+
+    std::pmr::vector<Command> m_commands{};
+    std::pmr::vector<math::vec4> m_uniforms{};
+    math::mat4 m_model{ 1.0f };
+    math::mat4 m_view{ 1.0f };
+    math::mat4 m_projection{ 1.0f };
+
+    uint32_t storeUniform( const void*, size_t );
+
+public:
+    virtual ~DrawCache() noexcept override = default;
+    DrawCache() noexcept = default;
+    explicit DrawCache( std::pmr::memory_resource* ) noexcept;
+    DrawCache( const DrawCache& ) = delete;
+    DrawCache( DrawCache&& ) noexcept = default;
+    DrawCache& operator = ( const DrawCache& ) = delete;
+    DrawCache& operator = ( DrawCache&& ) noexcept = default;
+
+    virtual void render( const RenderInfo& ) override;
+    virtual void dispatch( const DispatchInfo& ) override;
+
+    // drops recorded commands, following ones are recorded with given transforms
+    void reset( const math::mat4& model, const math::mat4& view, const math::mat4& projection );
+    bool matches( const math::mat4& model, const math::mat4& view, const math::mat4& projection ) const;
+    void replay( RecordingContext* ) const;
+    uint32_t size() const;
+};
+
+}
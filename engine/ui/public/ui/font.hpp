@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ui/glyph_table.hpp>
 #include <ui/pipeline.hpp>
 #include <ui/sprite.hpp>
 
@@ -34,6 +35,9 @@ class Font {
     using Glyph = fnta::Glyph;
     using GlyphMap = FixedMapView<const char32_t, const Glyph>;
     GlyphMap m_glyphMap{};
+    // own glyphs first, then fallback fonts of FontMap the font was added to
+    GlyphTable m_glyphTable{};
+    const FontMap* m_fontMap = nullptr;
 
     std::tuple<Glyph, Texture, math::vec2, uint32_t> getGlyph( char32_t ) const;
 
@@ -66,6 +70,8 @@ public:
         math::vec2 extent;
     };
     RenderText composeText( std::u32string_view, const math::vec2& geometry = math::vec2{ 320.0f, 100.0f } ) const;
+    // reuses storage of given render text
+    void composeText( RenderText&, std::u32string_view, const math::vec2& geometry ) const;
 
     Texture appendRenderText( math::vec2&, RenderInstance&, char32_t ) const;
 };
@@ -11,12 +11,15 @@
 namespace ui {
 
 class FontMap {
+    friend Font;
     std::pmr::vector<Font> m_fonts;
 
+    // resolves fallback glyphs of every font into its glyph table
+    void bakeGlyphTables();
+
 public:
     void addFont( std::span<const uint8_t> );
     const Font* findFont( Hash::value_type ) const;
-    std::tuple<Font::Glyph, Texture, math::vec2, uint32_t> getGlyph( Hash::value_type name, char32_t ) const;
 };
 
 }
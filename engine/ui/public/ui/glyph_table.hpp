@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace ui {
+
+// Glyph references by code point, direct-indexed through 256 code point pages for Basic Multilingual Plane,
+// sorted sparse table for the rest. Reference packs index of font that provides glyph together with glyph index
+// in that font, 0 means no font has the code point.
+class GlyphTable {
+public:
+    using Ref = uint32_t;
+    static constexpr uint32_t GLYPH_BITS = 24;
+    static constexpr uint32_t MAX_FONTS = 1u << ( 32 - GLYPH_BITS );
+
+    static constexpr Ref makeRef( uint32_t font, uint32_t glyph ) { return ( font << GLYPH_BITS ) | ( glyph + 1 ); }
+    static constexpr uint32_t font( Ref r ) { return r >> GLYPH_BITS; }
+    static constexpr uint32_t glyph( Ref r ) { return ( r & ( ( 1u << GLYPH_BITS ) - 1 ) ) - 1; }
+
+private:
+    static constexpr char32_t BMP_END = 0x10000;
+    using Page = std::array<Ref, 256>;
+
+    // page 0 stays empty, every page of code points without glyphs points at it
+    std::array<uint16_t, BMP_END / 256> m_pageIndex{};
+    std::pmr::vector<Page> m_pages{};
+    std::pmr::vector<std::pair<char32_t, Ref>> m_sparse{};
+
+public:
+    void clear();
+    // first insert of code point wins, call finish() once all are inserted
+    void insert( char32_t, Ref );
+    void finish();
+
+    inline Ref find( char32_t cp ) const
+    {
+        if ( cp < BMP_END ) [[likely]] {
+            if ( m_pages.empty() ) [[unlikely]] return 0;
+            return m_pages[ m_pageIndex[ cp >> 8 ] ][ cp & 0xFFu ];
+        }
+        return findSparse( cp );
+    }
+
+private:
+    Ref findSparse( char32_t ) const;
+};
+
+}
@@ -28,13 +28,15 @@ public:
 private:
     DataModel* m_dataModel = nullptr;
     const Font* m_font = nullptr;
-    std::pmr::u32string m_text{};
+    std::pmr::u32string m_text{ std::pmr::polymorphic_allocator<>{ Arena::current() } };
     math::vec4 m_color = math::vec4{ 1.0f, 1.0f, 1.0f, 1.0f };
     math::vec2 m_labelExtent{};
     Hash::value_type m_locText{};
     DataModel::size_type m_revision = 0xFFFF;
     bool m_hasActions : 1 = false;
-    Font::RenderText m_renderText{};
+    Font::RenderText m_renderText{ .data = std::pmr::vector<Font::RenderInstance>{ std::pmr::polymorphic_allocator<>{ Arena::current() } } };
+
+    void refreshText();
 
 public:
     Label() = default;
@@ -11,8 +11,10 @@
 
 namespace ui {
 
+// Views into cooked .lang, keys are found in constant time through minimal perfect hash built by cooker.
 class Lockit {
 
+    std::span<const uint32_t> m_seeds{};
     std::span<const lang::KeyType> m_keys{};
     std::span<const char32_t> m_data{};
     std::array<char, 8> m_id{};
@@ -10,6 +10,7 @@ namespace ui {
 enum class Pipeline : uint32_t {
     eSpriteSequence,
     eSpriteSequenceColors,
+    eSpriteBatch,
     eGlow,
     eBlur,
 };
@@ -60,6 +61,17 @@ struct PushConstant<Pipeline::eSpriteSequenceColors> {
     };
 };
 
+// whole screen worth of quads already in screen space, sized to fit guaranteed minimum of maxUniformBufferRange
+template <>
+struct PushConstant<Pipeline::eSpriteBatch> {
+    static constexpr uint32_t INSTANCES = 255;
+    static constexpr uint32_t VERTICES = 4;
+    using Instance = PushConstant<Pipeline::eSpriteSequenceColors>::Instance;
+    math::mat4 m_projection{};
+    alignas( 16 ) std::array<Instance, INSTANCES> m_instances{};
+};
+static_assert( sizeof( PushConstant<Pipeline::eSpriteBatch> ) <= 16384 );
+
 template <>
 struct PushConstant<Pipeline::eGlow> {
     static constexpr uint32_t VERTICES = 4;
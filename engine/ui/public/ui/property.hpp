@@ -51,6 +51,14 @@ class Property {
 
 
 public:
+    struct Resources {
+        const ResourceMap<Texture>* textures = nullptr;
+        const ResourceMap<PipelineSlot>* materials = nullptr;
+        const ResourceMap<Audio::Slot>* sounds = nullptr;
+        Audio* audio = nullptr;
+        input::Remapper* remapper = nullptr;
+    };
+
     struct PendingComboBox{
         math::vec2 position{};
         math::vec2 size{};
@@ -131,9 +139,12 @@ public:
     void changeScreen( Hash::value_type, math::vec2 );
     void changeScreen( Hash::value_type );
     uint32_t changeLockit( std::array<char, 8> );
+    void setResources( const Resources& );
 
     void loadATLAS( std::span<const uint8_t> );
     void loadFNTA( std::span<const uint8_t> );
+    // data has to outlive lockit; returns newly added language, nullptr when it replaced one already loaded
+    const Lockit* loadLANG( std::span<const uint8_t> );
     void loadUI( std::span<const uint8_t> );
 };
 
@@ -3,6 +3,8 @@
 #include <math.hpp>
 #include <shared/pmr_pointer.hpp>
 #include <shared/hash.hpp>
+#include <ui/arena.hpp>
+#include <ui/batcher.hpp>
 #include <ui/input.hpp>
 #include <ui/tab_order.hpp>
 #include <ui/message_box.hpp>
@@ -12,13 +14,22 @@
 #include <memory_resource>
 #include <span>
 
+namespace uib {
+struct Header;
+}
+
 namespace ui {
 
 struct RenderContext;
 struct UpdateContext;
 class Widget;
 
-class Screen final : public Widget {
+// Base of Screen so that arena is constructed before and released after the widget tree living in it.
+struct ScreenArena {
+    Arena m_arena{};
+};
+
+class Screen final : private ScreenArena, public Widget {
     TabOrder<> m_tabOrder{};
     math::vec2 m_extent{ 1, 1 };
     math::vec2 m_resize{ 1, 1 };
@@ -31,6 +42,8 @@ class Screen final : public Widget {
     UniquePointer<Widget> m_glow{};
     UniquePointer<Widget> m_modalWidget{};
     UniquePointer<Widget> m_footer{};
+    mutable RenderStatistics m_statistics{};
+    mutable Batcher m_batcher{};
 
     enum class RepeatDirection : uint32_t {
         none,
@@ -47,6 +60,8 @@ class Screen final : public Widget {
     Widget* findWidgetByTabOrder( uint16_t );
 
     void updateInputRepeat( float );
+    void loadText( std::span<const uint8_t>, uint16_t& tabOrderCount );
+    void loadCooked( const uib::Header&, std::span<const uint8_t>, uint16_t& tabOrderCount );
 
     std::pmr::memory_resource* allocator();
 
@@ -58,7 +73,8 @@ public:
     Screen( Screen&& ) noexcept = default;
     Screen( std::span<const uint8_t> ) noexcept;
 
-    Screen& operator = ( Screen&& ) noexcept = default;
+    // containers of widget tree keep pointing at arena they were created with
+    Screen& operator = ( Screen&& ) = delete;
     Screen& operator = ( const Screen& ) = delete;
 
     virtual EventProcessing onAction( ui::Action ) override;
@@ -69,8 +85,11 @@ public:
 
     void resize( math::vec2 );
     void show( math::vec2 size );
-    void render( Renderer*, math::vec2 viewport ) const;
+    void render( RecordingContext*, math::vec2 viewport ) const;
     virtual void render( const RenderContext& ) const override;
+    // of last render()
+    inline RenderStatistics statistics() const { return m_statistics; }
+    inline Arena::Statistics arenaStatistics() const { return m_arena.statistics(); }
 
     inline Hash::value_type name() const { return m_name; }
     inline Hash::value_type scene() const { return m_scene; }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <ui/anchor.hpp>
+#include <ui/arena.hpp>
+#include <ui/draw_cache.hpp>
 #include <ui/input.hpp>
 
 #include <math.hpp>
@@ -10,14 +12,24 @@
 #include <list>
 #include <memory_resource>
 
-class Renderer;
-
 namespace ui {
 
 class Screen;
 
+struct RenderStatistics {
+    // widgets which regenerated their draws
+    uint32_t rebuilt = 0;
+    // widgets which replayed draws recorded in earlier frame
+    uint32_t replayed = 0;
+    // issued by widgets
+    uint32_t draws = 0;
+    // reaching renderer after batching
+    uint32_t submitted = 0;
+};
+
 struct RenderContext {
-    Renderer* renderer = nullptr;
+    RecordingContext* renderer = nullptr;
+    RenderStatistics* statistics = nullptr;
     math::mat4 model{ 1.0f };
     math::mat4 view{ 1.0f };
     math::mat4 projection{ 1.0f };
@@ -46,7 +58,7 @@ public:
     template <typename T>
     inline T* emplace_child( const typename T::CreateInfo& ci )
     {
-        auto alloc = std::pmr::get_default_resource();
+        auto alloc = m_children.get_allocator().resource();
         auto& w = m_children.emplace_back( UniquePointer<T>{ alloc, ci } );
         return reinterpret_cast<T*>( w.get() );
     }
@@ -60,7 +72,7 @@ public:
     void onRender( RenderContext ) const;
 
 protected:
-    std::pmr::list<UniquePointer<Widget>> m_children{};
+    std::pmr::list<UniquePointer<Widget>> m_children{ std::pmr::polymorphic_allocator<>{ Arena::current() } };
     math::vec2 m_position{};
     math::vec2 m_size{};
     Anchor m_anchor = Anchor::fTop | Anchor::fLeft;
@@ -68,6 +80,13 @@ protected:
     bool m_enabled : 1 = true;
     bool m_focused : 1 = false;
 
+private:
+    mutable bool m_dirty : 1 = true;
+    mutable DrawCache m_drawCache{ Arena::current() };
+
+protected:
+    // draws are regenerated on next render, call whenever state read by render() changes
+    void invalidate();
     bool testRect( math::vec2 ) const;
 
     static bool testRect( math::vec2 p, math::vec2 pos, math::vec2 size );
@@ -81,6 +100,12 @@ public:
     Widget& operator = ( const Widget& ) = delete;
     Widget& operator = ( Widget&& ) = default;
 
+    // own containers allocate from given resource instead of current arena
+    inline explicit Widget( std::pmr::memory_resource* resource ) noexcept
+    : m_children{ std::pmr::polymorphic_allocator<>{ resource } }
+    , m_drawCache{ resource }
+    {}
+
     inline Widget( Anchor a ) noexcept
     : m_anchor{ a }
     {}
@@ -14,24 +14,26 @@
 #include <ui/property.hpp>
 
 #include <config/config.hpp>
+#include <extra/uib.hpp>
 
 #include <profiler.hpp>
 
+#include <bit>
+#include <cstring>
 #include <optional>
 #include <string_view>
 
 namespace ui {
 
-template <typename T> void setX( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->position.x = e.toFloat(); };
-template <typename T> void setY( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->position.y = e.toFloat(); };
-template <typename T> void setW( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->size.x = e.toFloat(); };
-template <typename T> void setH( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->size.y = e.toFloat(); };
-template <typename T> void setAnchor( void* ci, const cfg::Entry& e )
+template <typename T> void setX( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->position.x = std::bit_cast<float>( v ); };
+template <typename T> void setY( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->position.y = std::bit_cast<float>( v ); };
+template <typename T> void setW( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->size.x = std::bit_cast<float>( v ); };
+template <typename T> void setH( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->size.y = std::bit_cast<float>( v ); };
+template <typename T> void setAnchor( void* ci, uint32_t v )
 {
-    auto convert = []( const auto& e )
+    auto convert = []( Hash::value_type h )
     {
-        Hash hash{};
-        switch ( hash( e.toString() ) ) {
+        switch ( h ) {
         default: assert( !"unknown anchor value" ); [[fallthrough]];
         case "topLeft"_hash: return Anchor::fTop | Anchor::fLeft;
         case "midLeft"_hash: return Anchor::fMiddle | Anchor::fLeft;
@@ -46,22 +48,66 @@ template <typename T> void setAnchor( void* ci, const cfg::Entry& e )
         case "botRight"_hash: return Anchor::fBottom | Anchor::fRight;
         }
     };
-    reinterpret_cast<typename T::CreateInfo*>( ci )->anchor = convert( e );
+    reinterpret_cast<typename T::CreateInfo*>( ci )->anchor = convert( v );
+};
+template <typename T> void setCount( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->count = v; };
+template <typename T> void setData( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->data = v; };
+template <typename T> void setText( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->text = v; };
+template <typename T> void setFont( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->font = v; };
+template <typename T> void setPath( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->path = v; };
+template <typename T> void setStyle( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->style = v; };
+template <typename T> void setSpriteSpacing( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->spriteSpacing = std::bit_cast<float>( v ); };
+template <typename T> void setColor( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->color = v; };
+template <typename T> void setTrigger( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->trigger = v; };
+template <typename T> void setGoto( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->screenChange = v; };
+template <typename T, size_t Tidx> void setFrame( void* ci, uint32_t v ) { reinterpret_cast<typename T::CreateInfo*>( ci )->frames[ Tidx ] = v; };
+
+// value of text property as stored in cooked screen
+static uint32_t propertyValue( const cfg::Entry& entry, uib::Kind kind )
+{
+    switch ( kind ) {
+    case uib::Kind::eFloat: return std::bit_cast<uint32_t>( entry.toFloat() );
+    case uib::Kind::eUint: return entry.toInt<uint32_t>();
+    case uib::Kind::eHash: return Hash{}( entry.toString() );
+    default: return 0;
+    }
+}
+
+// walks nodes and properties of cooked screen in the order they were written
+class CookedReader {
+    std::span<const uib::Node> m_nodes{};
+    std::span<const uib::Property> m_properties{};
+
+public:
+    CookedReader( std::span<const uib::Node> nodes, std::span<const uib::Property> properties ) noexcept
+    : m_nodes{ nodes }
+    , m_properties{ properties }
+    {}
+
+    const uib::Node& peek() const
+    {
+        assert( !m_nodes.empty() );
+        return m_nodes.front();
+    }
+
+    std::span<const uib::Property> next()
+    {
+        const uib::Node& node = peek();
+        assert( node.propertyCount <= m_properties.size() );
+        std::span<const uib::Property> ret = m_properties.first( node.propertyCount );
+        m_properties = m_properties.subspan( node.propertyCount );
+        m_nodes = m_nodes.subspan( 1 );
+        return ret;
+    }
 };
-template <typename T> void setCount( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->count = e.toInt<uint32_t>(); };
-template <typename T> void setData( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->data = Hash{}( e.toString() ); };
-template <typename T> void setText( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->text = Hash{}( e.toString() ); };
-template <typename T> void setFont( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->font = Hash{}( e.toString() ); };
-template <typename T> void setPath( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->path = Hash{}( e.toString() ); };
-template <typename T> void setStyle( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->style = Hash{}( e.toString() ); };
-template <typename T> void setSpriteSpacing( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->spriteSpacing = e.toFloat(); };
-template <typename T> void setColor( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->color = Hash{}( e.toString() ); };
-template <typename T> void setTrigger( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->trigger = Hash{}( e.toString() ); };
-template <typename T> void setGoto( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->screenChange = Hash{}( e.toString() ); };
-template <typename T, size_t Tidx> void setFrame( void* ci, const cfg::Entry& e ) { reinterpret_cast<typename T::CreateInfo*>( ci )->frames[ Tidx ] = Hash{}( e.toString() ); };
-
-using F = std::tuple<Hash::value_type, void(*)( void*, const cfg::Entry& )>;
-using W = std::tuple<Hash::value_type, UniquePointer<Widget>(*)( std::pmr::memory_resource*, const cfg::Entry&, std::span<const F>, uint16_t& ),std::span<const F>>;
+
+using F = std::tuple<Hash::value_type, void(*)( void*, uint32_t )>;
+using W = std::tuple<Hash::value_type
+    , UniquePointer<Widget>(*)( std::pmr::memory_resource*, const cfg::Entry&, std::span<const F>, uint16_t& )
+    , UniquePointer<Widget>(*)( std::pmr::memory_resource*, CookedReader&, std::span<const F>, uint16_t& )
+    , std::span<const F>
+    , size_t
+>;
 
 
 inline constexpr std::array PROGRESSBAR_FIELDS = {
@@ -164,19 +210,46 @@ inline constexpr std::array ANIMFRAME_FIELDS = {
 };
 
 
+// upper bound of arena bytes taken by single T, including alignment
+template <typename T>
+inline constexpr size_t STORAGE = sizeof( T ) + alignof( T ) - 1;
+// T owned by its parent through node of children list
+template <typename T>
+inline constexpr size_t CHILD = STORAGE<T> + sizeof( UniquePointer<Widget> ) + 2 * sizeof( void* );
+// glyphs of lockit string of usual length, longer strings make arena grow
+inline constexpr size_t TEXT_GLYPHS = 32;
+// label keeps copy of its text and quad of every glyph
+inline constexpr size_t LABEL = CHILD<Label> + TEXT_GLYPHS * ( sizeof( char32_t ) + sizeof( Font::RenderInstance ) );
+// footer has background and single label composed of all buttons
+inline constexpr size_t FOOTER = CHILD<Footer> + CHILD<Decorator> + CHILD<Label>;
+// action glyph and spacing around lockit string, text is kept by both footer and its label
+inline constexpr size_t FOOTER_BUTTON = sizeof( Footer::Entry )
+    + ( TEXT_GLYPHS + Footer::SPACING ) * ( 2 * sizeof( char32_t ) + sizeof( Font::RenderInstance ) );
+
 template <typename T>
 static UniquePointer<Widget> makeWidget( std::pmr::memory_resource*, const cfg::Entry&, std::span<const F>, uint16_t& );
+template <typename T>
+static UniquePointer<Widget> makeCookedWidget( std::pmr::memory_resource*, CookedReader&, std::span<const F>, uint16_t& );
 
+// indexed by uib::Widget, last column is arena bytes of widget together with its internal labels
 inline constexpr std::array WIDGETS = {
-    W{ "Button"_hash, &makeWidget<Button>, BUTTON_FIELDS },
-    W{ "ComboBox"_hash, &makeWidget<ComboBox>, COMBOBOX_FIELDS },
-    W{ "Image"_hash, &makeWidget<Image>, IMAGE_FIELDS },
-    W{ "Label"_hash, &makeWidget<Label>, LABEL_FIELDS },
-    W{ "NineSlice"_hash, &makeWidget<Decorator>, DECORATOR_FIELDS },
-    W{ "Progressbar"_hash, &makeWidget<Progressbar>, PROGRESSBAR_FIELDS },
-    W{ "SpinBox"_hash, &makeWidget<SpinBox>, SPINBOX_FIELDS },
-    W{ "AnimFrame"_hash, &makeWidget<AnimFrame>, ANIMFRAME_FIELDS },
+    W{ "Button"_hash, &makeWidget<Button>, &makeCookedWidget<Button>, BUTTON_FIELDS, CHILD<Button> + LABEL },
+    W{ "ComboBox"_hash, &makeWidget<ComboBox>, &makeCookedWidget<ComboBox>, COMBOBOX_FIELDS, CHILD<ComboBox> + LABEL * 2 },
+    W{ "Image"_hash, &makeWidget<Image>, &makeCookedWidget<Image>, IMAGE_FIELDS, CHILD<Image> },
+    W{ "Label"_hash, &makeWidget<Label>, &makeCookedWidget<Label>, LABEL_FIELDS, LABEL },
+    W{ "NineSlice"_hash, &makeWidget<Decorator>, &makeCookedWidget<Decorator>, DECORATOR_FIELDS, CHILD<Decorator> },
+    W{ "Progressbar"_hash, &makeWidget<Progressbar>, &makeCookedWidget<Progressbar>, PROGRESSBAR_FIELDS, CHILD<Progressbar> },
+    W{ "SpinBox"_hash, &makeWidget<SpinBox>, &makeCookedWidget<SpinBox>, SPINBOX_FIELDS, CHILD<SpinBox> + LABEL * 2 },
+    W{ "AnimFrame"_hash, &makeWidget<AnimFrame>, &makeCookedWidget<AnimFrame>, ANIMFRAME_FIELDS, CHILD<AnimFrame> },
 };
+static_assert( []()
+{
+    if ( WIDGETS.size() != static_cast<size_t>( uib::Widget::eFooter ) ) return false;
+    for ( size_t i = 0; i < WIDGETS.size(); ++i ) {
+        if ( std::get<0>( WIDGETS[ i ] ) != uib::WIDGET_NAMES[ i ] ) return false;
+    }
+    return true;
+}(), "WIDGETS order has to match uib::Widget" );
 
 template <typename T>
 UniquePointer<Widget> makeWidget( std::pmr::memory_resource* allocator, const cfg::Entry& entry, std::span<const F> fields, uint16_t& tabOrder )
@@ -193,7 +266,7 @@ UniquePointer<Widget> makeWidget( std::pmr::memory_resource* allocator, const cf
         bool propertyHandled = false;
         for ( auto&& [ hh, set ] : fields ) {
             if ( hh != h ) continue;
-            set( &ci, property );
+            set( &ci, propertyValue( property, uib::propertyKind( h ) ) );
             propertyHandled = true;
             break;
         }
@@ -205,7 +278,7 @@ UniquePointer<Widget> makeWidget( std::pmr::memory_resource* allocator, const cf
     UniquePointer<T> ret{ allocator, ci };
     for ( auto&& property : unknownField ) {
         const auto h = hash( property->name() );
-        for ( auto&& [ hh, makeWgt, ff ] : WIDGETS ) {
+        for ( auto&& [ hh, makeWgt, makeCooked, ff, storage ] : WIDGETS ) {
             if ( h != hh ) continue;
             ret.get()->emplace_child( makeWgt( allocator, *property, ff, tabOrder ) );
             break;
@@ -214,19 +287,63 @@ UniquePointer<Widget> makeWidget( std::pmr::memory_resource* allocator, const cf
     return ret;
 }
 
+static UniquePointer<Widget> makeCooked( std::pmr::memory_resource* allocator, CookedReader& reader, uint16_t& tabOrder )
+{
+    const auto type = static_cast<uint32_t>( reader.peek().type );
+    assert( type < WIDGETS.size() );
+    auto&& [ hh, makeWgt, makeCookedWgt, fields, storage ] = WIDGETS[ type ];
+    return makeCookedWgt( allocator, reader, fields, tabOrder );
+}
+
+template <typename T>
+UniquePointer<Widget> makeCookedWidget( std::pmr::memory_resource* allocator, CookedReader& reader, std::span<const F> fields, uint16_t& tabOrder )
+{
+    typename T::CreateInfo ci{};
+    if constexpr ( TabOrdering<T>::value ) {
+        ci.tabOrder = tabOrder++;
+    }
+
+    const uint32_t childCount = reader.peek().childCount;
+    for ( auto&& [ key, value ] : reader.next() ) {
+        for ( auto&& [ hh, set ] : fields ) {
+            if ( hh != key ) continue;
+            set( &ci, value );
+            break;
+        }
+    }
+
+    UniquePointer<T> ret{ allocator, ci };
+    for ( uint32_t i = 0; i < childCount; ++i ) {
+        ret.get()->emplace_child( makeCooked( allocator, reader, tabOrder ) );
+    }
+    return ret;
+}
+
+static Action::Enum footerAction( Hash::value_type h )
+{
+    switch ( h ) {
+    case "eMenuApply"_hash: return Action::eMenuApply;
+    case "eMenuCancel"_hash: return Action::eMenuCancel;
+    default:
+        assert( !"unknown input action" );
+        return {};
+    }
+}
+
+static bool setFooterEntry( Footer::Entry& button, Hash::value_type key, uint32_t value )
+{
+    switch ( key ) {
+    case "text"_hash: button.textId = value; return true;
+    case "input"_hash: button.action = footerAction( value ); return true;
+    case "trigger"_hash: button.triggerId = value; return true;
+    case "goto"_hash: button.screenChange = value; return true;
+    default: return false;
+    }
+}
+
 static UniquePointer<Widget> makeFooter( std::pmr::memory_resource* alloc, const cfg::Entry& entry, math::vec2 position, math::vec2 size  )
 {
     ZoneScoped;
-    auto makeInput = []( Hash::value_type h ) -> Action::Enum
-    {
-        switch ( h ) {
-        case "eMenuApply"_hash: return Action::eMenuApply;
-        case "eMenuCancel"_hash: return Action::eMenuCancel;
-        default:
-            assert( !"unknown input action" );
-            return {};
-        }
-    };
     Hash hash{};
     std::pmr::vector<Footer::Entry> entries;
     Footer::CreateInfo ci{
@@ -238,15 +355,9 @@ static UniquePointer<Widget> makeFooter( std::pmr::memory_resource* alloc, const
         case "Button"_hash: {
             auto& button = entries.emplace_back();
             for ( auto&& props : property ) {
-                switch ( hash( props.name() ) ) {
-                case "text"_hash: button.textId = hash( props.toString() ); continue;
-                case "input"_hash: button.action = makeInput( hash( props.toString() ) ); continue;
-                case "trigger"_hash: button.triggerId = hash( props.toString() ); continue;
-                case "goto"_hash: button.screenChange = hash( props.toString() ); continue;
-                default:
-                    assert( !"Footer.Button unhandled property" );
-                    continue;
-                }
+                const auto h = hash( props.name() );
+                if ( setFooterEntry( button, h, propertyValue( props, uib::propertyKind( h ) ) ) ) continue;
+                assert( !"Footer.Button unhandled property" );
             }
         }}
     }
@@ -254,12 +365,125 @@ static UniquePointer<Widget> makeFooter( std::pmr::memory_resource* alloc, const
     return UniquePointer<Footer>{ alloc, ci };
 }
 
+static UniquePointer<Widget> makeFooter( std::pmr::memory_resource* alloc, CookedReader& reader, math::vec2 position, math::vec2 size  )
+{
+    ZoneScoped;
+    const uint32_t childCount = reader.peek().childCount;
+    reader.next();
+    std::pmr::vector<Footer::Entry> entries( childCount, alloc );
+    for ( auto& button : entries ) {
+        assert( reader.peek().type == uib::Widget::eFooterButton );
+        for ( auto&& [ key, value ] : reader.next() ) {
+            [[maybe_unused]] const bool handled = setFooterEntry( button, key, value );
+            assert( handled );
+        }
+    }
+    Footer::CreateInfo ci{
+        .position = position,
+        .size = size,
+        .entries = entries,
+    };
+    return UniquePointer<Footer>{ alloc, ci };
+}
+
+static bool isCooked( std::span<const uint8_t> fileContent )
+{
+    uint32_t magic = 0;
+    if ( fileContent.size() >= sizeof( magic ) ) {
+        std::memcpy( &magic, fileContent.data(), sizeof( magic ) );
+    }
+    return magic == uib::Header::MAGIC;
+}
+
+static bool readHeader( std::span<const uint8_t> fileContent, uib::Header& header )
+{
+    if ( fileContent.size() < sizeof( header ) ) {
+        assert( !"buffer size too small for cooked screen" );
+        return false;
+    }
+    std::memcpy( &header, fileContent.data(), sizeof( header ) );
+    if ( header.version != header.VERSION ) {
+        assert( !"cooked screen has incorrect version" );
+        return false;
+    }
+    const size_t expectedSize = sizeof( header ) + sizeof( uib::Node ) * header.nodeCount + sizeof( uib::Property ) * header.propertyCount;
+    if ( fileContent.size() < expectedSize ) {
+        assert( !"not enough data in cooked screen" );
+        return false;
+    }
+    return true;
+}
+
+// text screens are for development only, they are parsed once more to count widgets the way cooker does
+static uib::Header countWidgets( std::span<const uint8_t> fileContent )
+{
+    uib::Header header{};
+    Hash hash{};
+    const auto entry = cfg::Entry::fromData( fileContent );
+    for ( const auto& property : entry ) {
+        const auto h = hash( property.name() );
+        switch ( h ) {
+        case "glow"_hash: header.glow = property.toInt<bool>(); continue;
+        case "Footer"_hash:
+            header.widgetCount[ static_cast<uint32_t>( uib::Widget::eFooter ) ]++;
+            for ( const auto& button : property ) {
+                if ( hash( button.name() ) == "Button"_hash ) header.widgetCount[ static_cast<uint32_t>( uib::Widget::eFooterButton ) ]++;
+            }
+            continue;
+        default:
+            break;
+        }
+        for ( size_t i = 0; i < WIDGETS.size(); ++i ) {
+            if ( std::get<0>( WIDGETS[ i ] ) == h ) header.widgetCount[ i ]++;
+        }
+    }
+    return header;
+}
+
+static size_t arenaCapacity( std::span<const uint8_t> fileContent )
+{
+    uib::Header header{};
+    if ( !isCooked( fileContent ) ) header = countWidgets( fileContent );
+    else if ( !readHeader( fileContent, header ) ) return 0;
+
+    size_t storage = header.glow ? STORAGE<Glow> : 0;
+    storage += header.widgetCount[ static_cast<uint32_t>( uib::Widget::eFooter ) ] * FOOTER;
+    storage += header.widgetCount[ static_cast<uint32_t>( uib::Widget::eFooterButton ) ] * FOOTER_BUTTON;
+    for ( size_t i = 0; i < WIDGETS.size(); ++i ) {
+        storage += header.widgetCount[ i ] * std::get<4>( WIDGETS[ i ] );
+    }
+    return storage;
+}
+
 Screen::Screen( std::span<const uint8_t> fileContent ) noexcept
+: ScreenArena{ Arena{ arenaCapacity( fileContent ) } }
+, Widget{ m_arena.resource() }
+, m_batcher{ Batcher::Pipelines{
+    .batch = g_uiProperty.findMaterial( "spriteBatch"_hash ),
+    .spriteSequence = g_uiProperty.findMaterial( "spriteSequence"_hash ),
+    .spriteSequenceColors = g_uiProperty.findMaterial( "spriteSequenceColors"_hash ),
+} }
 {
     ZoneScoped;
-    std::pmr::memory_resource* alloc = allocator();
+    const Arena::Scope scope{ m_arena };
     uint16_t tabOrderCount = 0;
+    uib::Header header{};
+    if ( !isCooked( fileContent ) ) {
+        loadText( fileContent, tabOrderCount );
+    }
+    else if ( readHeader( fileContent, header ) ) {
+        loadCooked( header, fileContent, tabOrderCount );
+    }
+    if ( tabOrderCount != 0 ) {
+        m_tabOrder = TabOrder<>{ 0, 0, tabOrderCount };
+        changeFocus( Widget::INVALID_TAB, 0 );
+    }
+}
 
+void Screen::loadText( std::span<const uint8_t> fileContent, uint16_t& tabOrderCount )
+{
+    ZoneScoped;
+    std::pmr::memory_resource* alloc = m_arena.resource();
     auto entry = cfg::Entry::fromData( fileContent );
     Hash hash{};
     for ( const auto& property : entry ) {
@@ -277,14 +501,34 @@ Screen::Screen( std::span<const uint8_t> fileContent ) noexcept
         default:
             break;
         }
-        for ( auto&& [ hh, makeWgt, fields ] : WIDGETS ) {
+        for ( auto&& [ hh, makeWgt, makeCooked, fields, storage ] : WIDGETS ) {
             if ( h != hh ) continue;
             m_children.emplace_back( makeWgt( alloc, property, fields, tabOrderCount ) );
         }
     }
-    if ( tabOrderCount != 0 ) {
-        m_tabOrder = TabOrder<>{ 0, 0, tabOrderCount };
-        changeFocus( Widget::INVALID_TAB, 0 );
+}
+
+void Screen::loadCooked( const uib::Header& header, std::span<const uint8_t> fileContent, uint16_t& tabOrderCount )
+{
+    ZoneScoped;
+    std::pmr::memory_resource* alloc = m_arena.resource();
+    m_name = header.name;
+    m_scene = header.scene;
+    m_extent = math::vec2{ header.width, header.height };
+    if ( header.glow ) m_glow = UniquePointer<Glow>{ alloc };
+
+    const uib::Node* nodes = reinterpret_cast<const uib::Node*>( fileContent.data() + sizeof( header ) );
+    const uib::Property* properties = reinterpret_cast<const uib::Property*>( nodes + header.nodeCount );
+    CookedReader reader{ { nodes, header.nodeCount }, { properties, header.propertyCount } };
+    for ( uint32_t i = 0; i < header.rootCount; ++i ) {
+        if ( reader.peek().type == uib::Widget::eFooter ) {
+            m_footer = makeFooter( alloc, reader
+                , math::vec2{ 48.0f, m_extent.y - 48.0f * 2.0f }
+                , math::vec2{ m_extent.x - 48.0f * 2.0f, 48.0f }
+            );
+            continue;
+        }
+        m_children.emplace_back( makeCooked( alloc, reader, tabOrderCount ) );
     }
 }
 
@@ -293,11 +537,14 @@ void Screen::render( const RenderContext& ) const
     assert( !"stupid c++/clang cannot delete virtual function if samely named function with different parameters exists" );
 }
 
-void Screen::render( Renderer* renderer, math::vec2 viewport ) const
+void Screen::render( RecordingContext* renderer, math::vec2 viewport ) const
 {
     ZoneScoped;
+    m_statistics = {};
+    m_batcher.begin( renderer );
     ui::RenderContext rctx{
-        .renderer = renderer,
+        .renderer = &m_batcher,
+        .statistics = &m_statistics,
         .projection = math::ortho( 0.0f, viewport.x, 0.0f, viewport.y, -1.0f, 1.0f ),
         .colorMain{ 0.118f, 0.565f, 1.0f, 1.0f },
         .colorFocus{ 0.69f, 0.769f, 1.0f, 1.0f },
@@ -324,6 +571,8 @@ void Screen::render( Renderer* renderer, math::vec2 viewport ) const
 
     if ( m_footer ) m_footer->onRender( rctx );
     if ( m_modalWidget ) m_modalWidget->onRender( rctx );
+    m_batcher.end();
+    m_statistics.submitted = m_batcher.submitted();
 }
 
 void Screen::updateInputRepeat( float dt )
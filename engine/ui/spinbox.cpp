@@ -91,6 +91,7 @@ EventProcessing SpinBox::onMouseEvent( const MouseEvent& event )
     const math::vec2 s = size();
     setFocused( testRect( p, pos, s ) );
     if ( !isFocused() ) {
+        if ( m_focusL || m_focusR ) invalidate();
         m_focusL = false;
         m_focusR = false;
         return EventProcessing::eContinue;
@@ -101,6 +102,7 @@ EventProcessing SpinBox::onMouseEvent( const MouseEvent& event )
     const bool right = testRect( p, m_arrowRight.geometry() + math::vec4{ pos.x, pos.y, 0.0f, 0.0f } );
     switch ( event.type ) {
     case MouseEvent::eMove:
+        if ( m_focusL != left || m_focusR != right ) invalidate();
         m_focusL = left;
         m_focusR = right;
         break;
@@ -144,6 +146,8 @@ EventProcessing SpinBox::onAction( ui::Action action )
 
 void SpinBox::update( const UpdateContext& uctx )
 {
+    // arrows slide back into place after being pressed
+    if ( m_animL < 1.0f || m_animR < 1.0f ) invalidate();
     m_animL = std::min( m_animL + uctx.deltaTime * 7.0f, 1.0f );
     m_animR = std::min( m_animR + uctx.deltaTime * 7.0f, 1.0f );
 }
@@ -21,7 +21,21 @@ void Widget::onRender( RenderContext rctx ) const
 {
     const math::vec2 pos = position() + offsetByAnchor();
     rctx.model = math::translate( rctx.model, math::vec3{ pos.x, pos.y, 0.0f } );
-    render( rctx );
+    if ( m_dirty || !m_drawCache.matches( rctx.model, rctx.view, rctx.projection ) ) {
+        m_drawCache.reset( rctx.model, rctx.view, rctx.projection );
+        RenderContext record = rctx;
+        record.renderer = &m_drawCache;
+        // widgets composed inside render() belong to this one
+        record.statistics = nullptr;
+        render( record );
+        m_dirty = false;
+        if ( rctx.statistics ) rctx.statistics->rebuilt++;
+    }
+    else if ( rctx.statistics ) {
+        rctx.statistics->replayed++;
+    }
+    if ( rctx.statistics ) rctx.statistics->draws += m_drawCache.size();
+    m_drawCache.replay( rctx.renderer );
     for ( auto&& it : m_children ) it->onRender( rctx );
 }
 
@@ -48,7 +62,9 @@ void Widget::setPosition( math::vec2 v )
 
 void Widget::setSize( math::vec2 v )
 {
+    if ( m_size == v ) return;
     m_size = v;
+    invalidate();
 }
 
 math::vec2 Widget::position() const
@@ -96,7 +112,9 @@ bool Widget::isEnabled() const
 
 void Widget::setEnabled( bool b )
 {
+    if ( m_enabled == b ) return;
     m_enabled = b;
+    invalidate();
 }
 
 bool Widget::isFocused() const
@@ -106,7 +124,14 @@ bool Widget::isFocused() const
 
 void Widget::setFocused( bool b )
 {
+    if ( m_focused == b ) return;
     m_focused = b;
+    invalidate();
+}
+
+void Widget::invalidate()
+{
+    m_dirty = true;
 }
 
 bool Widget::testRect( math::vec2 p, math::vec2 pos, math::vec2 size )
@@ -1,27 +1,43 @@
+struct Dequantize {
+    vec4 positionScale;
+    vec4 positionBias;
+    vec4 uvScaleBias;
+};
+
 layout( binding = 0 ) uniform ubo {
     mat4 modelMatrix;
     mat4 viewMatrix;
     mat4 projectionMatrix;
+    Dequantize dequantize;
 };
 
-layout( location = 0 ) in vec3 vertVert;
+layout( location = 0 ) in vec4 vertVert;
 layout( location = 1 ) in vec2 vertUV;
-layout( location = 2 ) in vec3 vertNormal;
+layout( location = 2 ) in vec2 vertNormal;
 
 layout( location = 0 ) out vec2 fragUV;
 layout( location = 1 ) out vec3 fragNormal;
 layout( location = 2 ) out vec3 fragVert;
 layout( location = 3 ) out flat mat3 fragNormalMatrix;
 
+vec3 octDecode( vec2 e )
+{
+    vec3 n = vec3( e.xy, 1.0 - abs( e.x ) - abs( e.y ) );
+    float t = max( -n.z, 0.0 );
+    n.xy += mix( vec2( t ), vec2( -t ), greaterThanEqual( n.xy, vec2( 0.0 ) ) );
+    return normalize( n );
+}
+
 void main()
 {
+    vec3 position = vertVert.xyz * dequantize.positionScale.xyz + dequantize.positionBias.xyz;
     gl_Position = projectionMatrix
         * viewMatrix
         * modelMatrix
-        * vec4( vertVert.xyz, 1.0 );
+        * vec4( position, 1.0 );
 
-    fragUV = vertUV;
-    fragNormal = vertNormal;
-    fragVert = ( modelMatrix * vec4( vertVert.xyz, 1.0 ) ).xyz;
+    fragUV = vertUV * dequantize.uvScaleBias.xy + dequantize.uvScaleBias.zw;
+    fragNormal = octDecode( vertNormal );
+    fragVert = ( modelMatrix * vec4( position, 1.0 ) ).xyz;
     fragNormalMatrix = mat3( transpose( inverse( modelMatrix ) ) );
 }
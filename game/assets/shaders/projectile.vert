@@ -5,15 +5,22 @@ struct Projectile {
     vec4 positionScale;
 };
 
+struct Dequantize {
+    vec4 positionScale;
+    vec4 positionBias;
+    vec4 uvScaleBias;
+};
+
 layout( binding = 0 ) uniform ubo {
     mat4 modelMatrix;
     mat4 viewMatrix;
     mat4 projectionMatrix;
+    Dequantize dequantize;
     Projectile projectiles[ INSTANCES ];
 };
 
 
-layout( location = 0 ) in vec3 vertVert;
+layout( location = 0 ) in vec4 vertVert;
 layout( location = 1 ) in vec2 vertUV;
 
 layout( location = 0 ) out vec2 fragUV;
@@ -26,11 +33,11 @@ vec3 quat2rotate( vec3 pos, vec4 quat )
 void main()
 {
     Projectile projectile = projectiles[ gl_InstanceIndex ];
-    vec3 pos = vertVert * projectile.positionScale.w;
+    vec3 pos = ( vertVert.xyz * dequantize.positionScale.xyz + dequantize.positionBias.xyz ) * projectile.positionScale.w;
     pos += 2.0 * cross( projectile.quat.xyz, cross( projectile.quat.xyz, pos ) + projectile.quat.w * pos );
     gl_Position = projectionMatrix
         * viewMatrix
         * modelMatrix
         * vec4( projectile.positionScale.xyz + pos, 1.0 );
-    fragUV = vertUV;
+    fragUV = vertUV * dequantize.uvScaleBias.xy + dequantize.uvScaleBias.zw;
 }
@@ -5,14 +5,21 @@ struct ColorScheme {
     vec4 outter2;
 };
 
+struct Dequantize {
+    vec4 positionScale;
+    vec4 positionBias;
+    vec4 uvScaleBias;
+};
+
 layout( binding = 0 ) uniform ubo {
     mat4 modelMatrix;
     mat4 viewMatrix;
     mat4 projectionMatrix;
+    Dequantize dequantize;
     ColorScheme colorScheme;
 };
 
-layout( location = 0 ) in vec3 vertVert;
+layout( location = 0 ) in vec4 vertVert;
 layout( location = 1 ) in vec2 vertUV;
 
 layout( location = 0 ) out vec2 fragUV;
@@ -23,9 +30,9 @@ void main()
     gl_Position = projectionMatrix
         * viewMatrix
         * modelMatrix
-        * vec4( vertVert.xyz, 1.0 );
+        * vec4( vertVert.xyz * dequantize.positionScale.xyz + dequantize.positionBias.xyz, 1.0 );
 
-    fragUV = vertUV;
+    fragUV = vertUV * dequantize.uvScaleBias.xy + dequantize.uvScaleBias.zw;
     fragColor = colorScheme;
 
 }
@@ -3,6 +3,7 @@
 #include "game_pipeline.hpp"
 #include "utils.hpp"
 
+#include <engine/texture_streamer.hpp>
 #include <renderer/renderer.hpp>
 
 #include <algorithm>
@@ -44,10 +45,12 @@ void Bullet::renderAll( const RenderContext& rctx, std::span<Bullet> span, Textu
     instancedTail.pushConstant.m_cameraDirection = rctx.cameraDirection;
     instancedTail.pushConstant.m_cameraUp = rctx.cameraUp;
     instancedTail.renderInfo.m_fragmentTexture[ 0 ] = tail;
+    // projectiles fly past the camera, keep their textures fully resident while any is in flight
+    if ( rctx.textureStreamer ) rctx.textureStreamer->request( tail, rctx.viewport.y );
 
 
     const math::mat4 mvp = rctx.projection * rctx.view * rctx.model;
-    Buffer lastMesh{};
+    MeshBuffer lastMesh{};
     Texture lastTexture{};
 
     for ( auto&& bullet : span ) {
@@ -57,12 +60,16 @@ void Bullet::renderAll( const RenderContext& rctx, std::span<Bullet> span, Textu
         assert( bullet.m_texture );
         if ( ( lastMesh != bullet.m_mesh ) || ( lastTexture != bullet.m_texture ) ) {
             instanced.renderInfo.m_fragmentTexture[ 0 ] = lastTexture;
-            instanced.renderInfo.m_vertexBuffer = lastMesh;
+            instanced.renderInfo.m_vertexBuffer = lastMesh.vertices;
+            instanced.renderInfo.m_indexBuffer = lastMesh.indices;
             instanced.flush();
             lastMesh = bullet.m_mesh;
             lastTexture = bullet.m_texture;
+            if ( rctx.textureStreamer ) rctx.textureStreamer->request( lastTexture, rctx.viewport.y );
             instanced.renderInfo.m_fragmentTexture[ 0 ] = lastTexture;
-            instanced.renderInfo.m_vertexBuffer = lastMesh;
+            instanced.renderInfo.m_vertexBuffer = lastMesh.vertices;
+            instanced.renderInfo.m_indexBuffer = lastMesh.indices;
+            instanced.pushConstant.m_dequantize = lastMesh.dequantize;
         }
         instanced.append( PushConstant<Pipeline::eProjectile>::Instance{ bullet.m_quat, math::vec4{ bullet.m_position, meter } } );
         if ( bullet.m_type == Type::eTorpedo )
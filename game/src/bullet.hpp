@@ -1,5 +1,6 @@
 #pragma once
 
+#include "mesh.hpp"
 #include "saobject.hpp"
 #include "units.hpp"
 #include "explosion.hpp"
@@ -8,7 +9,6 @@
 #include <audio/audio.hpp>
 #include <math.hpp>
 #include <renderer/texture.hpp>
-#include <renderer/buffer.hpp>
 #include <shared/hash.hpp>
 #include <shared/pmr_pointer.hpp>
 
@@ -35,7 +35,7 @@ public:
     math::quat m_quat{};
     math::vec3 m_prevPosition{};
     Signal m_target{};
-    Buffer m_mesh{};
+    MeshBuffer m_mesh{};
     Texture m_texture{};
     float m_speed = 0.0f;
     float m_travelDistance = 0.0f;
@@ -55,7 +55,7 @@ public:
 
 struct WeaponCreateInfo {
     Signal target{};
-    Buffer mesh{};
+    MeshBuffer mesh{};
     Texture texture{};
     float delay = 0.0f;
     float speed = 0.0f;
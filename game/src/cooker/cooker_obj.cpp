@@ -1,241 +1,123 @@
 #include <cooker/common.hpp>
 
 #include <extra/obj.hpp>
+#include <extra/obj_reader.hpp>
+#include <extra/vcache.hpp>
 #include <extra/args.hpp>
-#include <ccmd/ccmd.hpp>
 
 #include <array>
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 #include <memory_resource>
 #include <cassert>
-
-struct Vec2 { float data[ 2 ]{}; };
-struct Vec3 { float data[ 3 ]{}; };
-
-struct Face {
-    uint32_t vert[ 3 ]{};
-    uint32_t uv[ 3 ]{};
-    uint32_t norm[ 3 ]{};
-    Face() = default;
-};
-
-struct Point {
-    uint32_t v{};
-    Point() = default;
-};
-
-struct Object {
-    char name[ 52 ]{};
-    Object() = default;
-};
-
-struct FullObject : public Object {
-    std::pmr::vector<float> data{};
-    obj::VertexAssembly dataType = obj::VertexAssembly::invalid;
-    FullObject()
-    {
-        data.reserve( 0xFFFu );
-    }
+#include <cmath>
+
+struct FullObject : public obj::SourceObject {
+    std::pmr::vector<obj::PackedVertex> packed{};
+    std::pmr::vector<uint16_t> indices{};
+    obj::Quantization quantization{};
+    FullObject() = default;
+    FullObject( obj::SourceObject&& so ) noexcept : obj::SourceObject{ std::move( so ) } {}
 };
 
 std::ofstream& operator << ( std::ofstream& o, const FullObject& fo )
 {
     cooker::write( o, obj::Chunk::MAGIC );
     cooker::write( o, fo.name );
-    cooker::write( o, fo.dataType );
-    cooker::write( o, (uint32_t)fo.data.size() );
-    cooker::write( o, fo.data );
-    return o;
-}
-
-struct Compiler {
-
-    std::pmr::vector<Vec3> m_vertex{};
-    std::pmr::vector<Vec2> m_uv{};
-    std::pmr::vector<Vec3> m_normal{};
-    std::pmr::vector<FullObject> m_objects{};
-
-    // Blender hack:
-    uint32_t m_verticeIndexForChunk = 0;
-
-    Compiler()
-    {
-        m_vertex.reserve( 0xFFFu );
-        m_uv.reserve( 0xFFFu );
-        m_normal.reserve( 0xFFFu );
-        m_objects.reserve( 0xFu );
-    }
-
-    void readObj( std::string_view path )
-    {
-        const std::array commands = {
-            ccmd::Command{ "v", &Compiler::vertex, this },
-            ccmd::Command{ "o", &Compiler::object, this },
-            ccmd::Command{ "vt", &Compiler::uv, this },
-            ccmd::Command{ "vn", &Compiler::normal, this },
-            ccmd::Command{ "f", &Compiler::face, this },
-            ccmd::Command{ "p", &Compiler::point, this },
-            ccmd::Command{ "l", &Compiler::line, this },
-            ccmd::Command{ []( ccmd::Vm*, void* ){ return 0u; }, nullptr },
-        };
-
-        auto data = cooker::readText( path );
-        auto bytecode = ccmd::compile( data );
-        if ( bytecode.empty() ) cooker::error( "failed to compile", path );
-        auto ec = ccmd::run( commands, bytecode );
-        if ( ec != ccmd::eSuccess ) cooker::error( "failed to parse", path );
-        blenderHackMissingPoints();
+    cooker::write( o, fo.vertexAssembly );
+    if ( fo.vertexAssembly == obj::VertexAssembly::vtnq ) {
+        cooker::write( o, (uint32_t)( fo.packed.size() * sizeof( obj::PackedVertex ) / sizeof( float ) ) );
+        cooker::write( o, fo.quantization );
+        cooker::write( o, fo.packed );
     }
-
-    void blenderHackMissingPoints()
-    {
-        auto idx = std::exchange( m_verticeIndexForChunk, (uint32_t)m_vertex.size() );
-        if ( m_objects.empty() ) return;
-        if ( !m_objects.back().data.empty() ) return;
-        if ( idx == m_vertex.size() ) return;
-        assert( idx < m_vertex.size() );
-        for ( auto it = m_vertex.begin() + idx; it != m_vertex.end(); ++it ) {
-            std::ranges::copy( it->data, std::back_inserter( m_objects.back().data ) );
-        }
-    }
-
-    static uint32_t object( ccmd::Vm* vm, void* ctx )
-    {
-        assert( vm ); assert( ctx );
-        auto instance = reinterpret_cast<Compiler*>( ctx );
-        instance->blenderHackMissingPoints();
-        auto& o = instance->m_objects.emplace_back();
-        std::pmr::string name;
-        if ( !ccmd::argv( vm, 0, name ) ) cooker::error( "cannot get object name" );
-        if ( name.size() >= std::size( o.name ) ) cooker::error( "object name too long", name );
-        auto it = std::copy( name.begin(), name.end(), std::begin( o.name ) );
-        std::fill( it, std::end( o.name ), '\0' );
-        return 0;
+    else {
+        cooker::write( o, (uint32_t)fo.data.size() );
+        cooker::write( o, fo.data );
     }
+    if ( fo.indices.empty() ) return o;
+
+    obj::Indices indices{};
+    indices.indexCount = static_cast<uint32_t>( fo.indices.size() );
+    cooker::write( o, indices );
+    cooker::write( o, fo.indices );
+    const std::array<uint8_t, 4> padding{};
+    const uint32_t paddingSize = obj::Indices::paddedSize( indices.indexCount ) - indices.indexCount * (uint32_t)sizeof( uint16_t );
+    cooker::write( o, std::span<const uint8_t>{ padding.data(), paddingSize } );
+    return o;
+}
 
-    static uint32_t vertex( ccmd::Vm* vm, void* ctx )
-    {
-        assert( vm ); assert( ctx );
-        auto instance = reinterpret_cast<Compiler*>( ctx );
-        auto& v = instance->m_vertex.emplace_back();
-        ccmd::argv( vm, 0, v.data[ 0 ] );
-        ccmd::argv( vm, 1, v.data[ 1 ] );
-        ccmd::argv( vm, 2, v.data[ 2 ] );
-        v.data[ 1 ] *= -1.0f;
-        return 0;
+// welds vertices of triangle list, orders triangles for post-transform cache and vertices for fetch locality
+static void makeIndexed( FullObject& fo )
+{
+    if ( fo.vertexAssembly != obj::VertexAssembly::vtn ) return;
+    vcache::Welded welded = vcache::weld( fo.data, obj::VTN_STRIDE );
+    const uint32_t vertexCount = static_cast<uint32_t>( welded.vertices.size() / obj::VTN_STRIDE );
+    if ( vertexCount > 0xFFFFu ) {
+        cooker::warning( "too many vertices for 16 bit indices, keeping non-indexed object", fo.name );
+        return;
     }
+    vcache::optimizeTriangles( welded.indices, vertexCount );
+    vcache::optimizeFetch( welded.indices, welded.vertices, obj::VTN_STRIDE );
 
-    static uint32_t uv( ccmd::Vm* vm, void* ctx )
-    {
-        assert( vm ); assert( ctx );
-        auto instance = reinterpret_cast<Compiler*>( ctx );
-        auto& u = instance->m_uv.emplace_back();
-        ccmd::argv( vm, 0, u.data[ 0 ] );
-        ccmd::argv( vm, 1, u.data[ 1 ] );
-        return 0;
-    }
+    fo.data = std::move( welded.vertices );
+    fo.indices.resize( welded.indices.size() );
+    std::ranges::transform( welded.indices, fo.indices.begin(), []( uint32_t i ) { return static_cast<uint16_t>( i ); } );
+}
 
-    static uint32_t normal( ccmd::Vm* vm, void* ctx )
-    {
-        assert( vm ); assert( ctx );
-        auto instance = reinterpret_cast<Compiler*>( ctx );
-        auto& n = instance->m_normal.emplace_back();
-        ccmd::argv( vm, 0, n.data[ 0 ] );
-        ccmd::argv( vm, 1, n.data[ 1 ] );
-        ccmd::argv( vm, 2, n.data[ 2 ] );
-        return 0;
-    }
+struct ErrorBounds {
+    float position = 0.001f;
+    float uv = 1.0f / 4096.0f;
+    float normalDegrees = 0.1f;
+};
 
-    static uint32_t line( [[maybe_unused]] ccmd::Vm* vm, void* ctx )
-    {
-        assert( vm ); assert( ctx );
-        auto instance = reinterpret_cast<Compiler*>( ctx );
-        if ( instance->m_objects.empty() ) cooker::error( "lines not supported", "" );
-        cooker::error( "lines not supported in object", instance->m_objects.back().name );
-        return 1;
+// replaces float vertices with 16 bit quantized ones, fails when decoded vertices exceed error bounds
+static void makeQuantized( FullObject& fo, const ErrorBounds& bounds )
+{
+    if ( fo.vertexAssembly != obj::VertexAssembly::vtn ) return;
+    fo.quantization = obj::quantize( fo.data, fo.packed );
+    const std::pmr::vector<float> decoded = obj::dequantize( fo.quantization, fo.packed );
+    assert( decoded.size() == fo.data.size() );
+
+    float positionError = 0.0f;
+    float uvError = 0.0f;
+    float normalCos = 1.0f;
+    for ( size_t i = 0; i < decoded.size(); i += obj::VTN_STRIDE ) {
+        const float* src = fo.data.data() + i;
+        const float* dst = decoded.data() + i;
+        for ( uint32_t j = 0; j < 3; ++j ) positionError = std::max( positionError, std::abs( src[ j ] - dst[ j ] ) );
+        for ( uint32_t j = 3; j < 5; ++j ) uvError = std::max( uvError, std::abs( src[ j ] - dst[ j ] ) );
+        const float srcLength = std::sqrt( src[ 5 ] * src[ 5 ] + src[ 6 ] * src[ 6 ] + src[ 7 ] * src[ 7 ] );
+        if ( srcLength == 0.0f ) continue;
+        const float cos = ( src[ 5 ] * dst[ 5 ] + src[ 6 ] * dst[ 6 ] + src[ 7 ] * dst[ 7 ] ) / srcLength;
+        normalCos = std::min( normalCos, cos );
     }
+    const float normalDegrees = std::acos( std::clamp( normalCos, -1.0f, 1.0f ) ) * 57.2957795f;
 
-    static uint32_t face( ccmd::Vm* vm, void* ctx )
-    {
-        assert( vm ); assert( ctx );
-        auto instance = reinterpret_cast<Compiler*>( ctx );
-
-        if ( instance->m_objects.empty() ) cooker::error( "requesting to add face to null object" );
-        auto& o = instance->m_objects.back();
-        if ( o.dataType == obj::VertexAssembly::invalid ) { o.dataType = obj::VertexAssembly::vtn; };
-        if ( o.dataType != obj::VertexAssembly::vtn ) cooker::error( "mixing face with non-face element in object", o.name );
-
-        auto doVert = [size=instance->m_vertex.size(), &o]( auto& u )
-        {
-            if ( u == 0 ) cooker::error( "vertex cannot have index 0 in object", o.name );
-            if ( u > size ) cooker::error( "accessing vertex in face out of declared vertices in object", o.name );
-            u--;
-        };
-        auto doUV = [size=instance->m_uv.size(), &o]( auto& u )
-        {
-            if ( u == 0 ) cooker::error( "uv cannot have index 0 in object", o.name );
-            if ( u > size ) cooker::error( "accessing uv in face out of declared ivs in object", o.name );
-            u--;
-        };
-        auto doNormal = [size=instance->m_normal.size(), &o]( auto& u )
-        {
-            if ( u == 0 ) cooker::error( "normal cannot have index 0 in object", o.name );
-            if ( u > size ) cooker::error( "accessing normal in face out of declared normals in object", o.name );
-            u--;
-        };
-        auto parse = [&o]( auto& s, uint32_t& a, uint32_t& b, uint32_t& c )
-        {
-            if ( std::sscanf( s.c_str(), "%u/%u/%u", &a, &b, &c ) != 3 )
-                cooker::error( "failed to parse face in object", o.name );
-        };
-        Face f{};
-        std::pmr::string arg;
-        ccmd::argv( vm, 0, arg ); parse( arg, f.vert[ 0 ], f.uv[ 0 ], f.norm[ 0 ] );
-        ccmd::argv( vm, 1, arg ); parse( arg, f.vert[ 1 ], f.uv[ 1 ], f.norm[ 1 ] );
-        ccmd::argv( vm, 2, arg ); parse( arg, f.vert[ 2 ], f.uv[ 2 ], f.norm[ 2 ] );
-
-        std::ranges::for_each( f.vert, doVert );
-        std::ranges::for_each( f.uv, doUV );
-        std::ranges::for_each( f.norm, doNormal );
+    if ( positionError > bounds.position ) cooker::error( "quantized position error out of bounds in object", fo.name );
+    if ( uvError > bounds.uv ) cooker::error( "quantized uv error out of bounds in object", fo.name );
+    if ( normalDegrees > bounds.normalDegrees ) cooker::error( "quantized normal error out of bounds in object", fo.name );
 
-        for ( uint32_t i = 0; i < 3; ++i ) {
-            o.data.emplace_back( instance->m_vertex[ f.vert[ i ] ].data[ 0 ] );
-            o.data.emplace_back( instance->m_vertex[ f.vert[ i ] ].data[ 1 ] );
-            o.data.emplace_back( instance->m_vertex[ f.vert[ i ] ].data[ 2 ] );
-            o.data.emplace_back( instance->m_uv[ f.uv[ i ] ].data[ 0 ] );
-            o.data.emplace_back( instance->m_uv[ f.uv[ i ] ].data[ 1 ] );
-            o.data.emplace_back( instance->m_normal[ f.norm[ i ] ].data[ 0 ] );
-            o.data.emplace_back( instance->m_normal[ f.norm[ i ] ].data[ 1 ] );
-            o.data.emplace_back( instance->m_normal[ f.norm[ i ] ].data[ 2 ] );
-        }
-        return 0;
-    }
-
-    static uint32_t point( ccmd::Vm* vm, void* ctx )
-    {
-        assert( vm ); assert( ctx );
-        auto instance = reinterpret_cast<Compiler*>( ctx );
+    fo.vertexAssembly = obj::VertexAssembly::vtnq;
+    fo.data.clear();
+}
 
-        if ( instance->m_objects.empty() ) cooker::error( "requesting to add point to null object" );
-        auto& o = instance->m_objects.back();
-        if ( o.dataType == obj::VertexAssembly::invalid ) { o.dataType = obj::VertexAssembly::v; };
-        if ( o.dataType != obj::VertexAssembly::v ) cooker::error( "mixing point with non-point element in object", o.name );
-        uint32_t v = 0;
-        ccmd::argv( vm, 0, v );
-        if ( v == 0 ) cooker::error( "point cannot have index 0 in object", o.name );
-        if ( v > instance->m_vertex.size() ) cooker::error( "accessing vertex in point out of declared vertexes in object", o.name );
-        o.data.emplace_back( instance->m_vertex[ v - 1 ].data[ 0 ] );
-        o.data.emplace_back( instance->m_vertex[ v - 1 ].data[ 1 ] );
-        o.data.emplace_back( instance->m_vertex[ v - 1 ].data[ 2 ] );
-        return 0;
+static std::pmr::vector<FullObject> readObj( std::string_view path )
+{
+    const cooker::MappedFile file{ path };
+    std::pmr::vector<obj::SourceObject> objects{};
+    obj::ReadContext ctx{};
+    if ( !obj::read( file.text(), objects, &ctx ) ) {
+        std::cout << cooker::FAIL << path << ":" << ctx.errorLine << " " << ctx.errorMessage << " " << ctx.errorObject << std::endl;
+        std::exit( 1 );
     }
-
-};
+    return { std::make_move_iterator( objects.begin() ), std::make_move_iterator( objects.end() ) };
+}
 
 int main( int argc, const char** argv )
 {
@@ -246,6 +128,11 @@ int main( int argc, const char** argv )
             "\t--obj \"<file/path.obj>\" \u2012 specifies source object\n"
             "\t--dst \"<file/path.objc>\" \u2012 specifies output object\n"
             "\nOptional arguments:\n"
+            "\t--indexed \u2012 welds vertices and emits cache optimized index buffer\n"
+            "\t--quantize \u2012 emits 16 bit positions and uvs, octahedral normals\n"
+            "\t--max-position-error <float> \u2012 quantization error bound of positions, default 0.001\n"
+            "\t--max-uv-error <float> \u2012 quantization error bound of uvs, default 1/4096\n"
+            "\t--max-normal-error <degrees> \u2012 quantization error bound of normals, default 0.1\n"
             "\t-h --help \u2012 prints this message\n"
             ;
     }
@@ -255,14 +142,26 @@ int main( int argc, const char** argv )
     args.read( "--obj", argObj ) || cooker::error( "--obj <file/path.obj> \u2012 argument not specified" );
     args.read( "--dst", argDst ) || cooker::error( "--dst <file/path.objc> \u2012 argument not specified" );
 
-    Compiler compiler{};
-    compiler.readObj( argObj );
+    const bool indexed = args.read( "--indexed" );
+    const bool quantized = args.read( "--quantize" );
+    ErrorBounds bounds{};
+    args.read( "--max-position-error", bounds.position );
+    args.read( "--max-uv-error", bounds.uv );
+    args.read( "--max-normal-error", bounds.normalDegrees );
+
+    std::pmr::vector<FullObject> objects = readObj( argObj );
+    if ( indexed ) {
+        std::ranges::for_each( objects, &makeIndexed );
+    }
+    if ( quantized ) {
+        std::ranges::for_each( objects, [&bounds]( auto& fo ) { makeQuantized( fo, bounds ); } );
+    }
 
     obj::Header header{};
-    header.chunkCount = static_cast<uint32_t>( compiler.m_objects.size() );
+    header.chunkCount = static_cast<uint32_t>( objects.size() );
 
     auto ofs = cooker::openWrite( argDst );
     cooker::write( ofs, header );
-    std::ranges::for_each( compiler.m_objects, [&ofs]( const auto& f ) { ofs << f; } );
+    std::ranges::for_each( objects, [&ofs]( const auto& f ) { ofs << f; } );
     return 0;
 }
@@ -30,13 +30,15 @@ math::quat Enemy::quat() const
     return math::quatLookAt( m_direction, { 0.0f, 1.0f, 0.0f } );
 }
 
-void Enemy::shoot( std::pmr::vector<Bullet>& vec )
+Audio::Slot Enemy::shoot( std::pmr::vector<Bullet>& vec )
 {
-    if ( !m_weapon.ready() ) return;
-    if ( !AutoAim{}.matches( position(), direction(), m_target.position ) ) return;
-    auto& b = vec.emplace_back( m_weapon.fire(), position(), direction() );
+    if ( !m_weapon.ready() ) return {};
+    if ( !AutoAim{}.matches( position(), direction(), m_target.position ) ) return {};
+    const WeaponCreateInfo wci = m_weapon.fire();
+    auto& b = vec.emplace_back( wci, position(), direction() );
     b.m_collideId = COLLIDE_ID;
     b.m_quat = quat();
+    return wci.sound;
 }
 
 Signal Enemy::signal() const
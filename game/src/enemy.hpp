@@ -29,7 +29,8 @@ public:
     Enemy() = default;
     Enemy( const CreateInfo& );
 
-    void shoot( std::pmr::vector<Bullet>& );
+    // returns sound of fired weapon, 0 when not firing
+    Audio::Slot shoot( std::pmr::vector<Bullet>& );
     Signal signal() const;
 
     static void renderAll( const RenderContext&, std::span<const Enemy> );
@@ -3,6 +3,7 @@
 #include "colors.hpp"
 #include "game_pipeline.hpp"
 
+#include <engine/texture_streamer.hpp>
 #include <renderer/renderer.hpp>
 
 #include <algorithm>
@@ -19,6 +20,7 @@ void Explosion::renderAll( const RenderContext& rctx, const std::pmr::vector<Exp
     instanced.pushConstant.m_cameraPosition = rctx.cameraPosition;
     instanced.pushConstant.m_cameraUp = rctx.cameraUp;
     instanced.renderInfo.m_fragmentTexture[ 0 ] = explosions.front().m_texture; // TODO sort + split by texture
+    if ( rctx.textureStreamer ) rctx.textureStreamer->request( explosions.front().m_texture, rctx.viewport.y );
 
 
     auto makeParticle = []( const Explosion& expl ) -> Instanced::Instance
@@ -70,11 +70,17 @@ Game::Game( int argc, char** argv )
 : Engine{ Engine::CreateInfo{ .gameName = "starace", .versionMajor = 1, .versionMinor = 1, .argc = argc, .argv = argv } }
 {
     ZoneScoped;
-    g_uiProperty.m_textures = &m_textures;
-    g_uiProperty.m_remapper = &m_remapper;
-    g_uiProperty.m_materials = &m_materials;
-    g_uiProperty.m_sounds = &m_sounds;
-    g_uiProperty.m_audio = m_audio;
+    for ( int i = 1; i + 1 < argc; ++i ) {
+        if ( std::string_view{ argv[ i ] } == "--loose" ) m_looseDirectory = argv[ ++i ];
+        else if ( std::string_view{ argv[ i ] } == "--texture-budget" ) m_textureStreamer->setBudget( std::strtoull( argv[ ++i ], nullptr, 10 ) << 20 );
+    }
+    g_uiProperty.setResources( ui::Property::Resources{
+        .textures = &m_textures,
+        .materials = &m_materials,
+        .sounds = &m_sounds,
+        .audio = m_audio,
+        .remapper = &m_remapper,
+    } );
     loadSettings();
     m_io->setCallback( ".spv", []( Asset&& ) {} ); // HACK for loading dependant file in .mat
     m_io->setCallback( ".mat", this, &Game::loadMAT );
@@ -128,6 +134,9 @@ void Game::onInit()
     setupUI();
 
     m_io->mount( "data.pak" );
+    if ( !m_looseDirectory.empty() ) {
+        m_io->mountLoose( m_looseDirectory, 1 );
+    }
     g_pipelines[ Pipeline::eMesh ] = m_materials[ "mesh"_hash ];
     g_pipelines[ Pipeline::eProjectile ] = m_materials[ "projectile"_hash ];
     g_pipelines[ Pipeline::eThruster2 ] = m_materials[ "thruster2"_hash ];
@@ -150,6 +159,7 @@ void Game::onInit()
         .background = g_uiProperty.sprite( "background"_hash ),
         .pipeline = m_materials[ "background"_hash ],
         .spaceDustPipeline = m_materials[ "space_dust"_hash ],
+        .textureStreamer = m_textureStreamer,
     } };
     m_menuScene.setModel( &m_jetsContainer[ 0 ].model );
     onResize( viewportWidth(), viewportHeight() );
@@ -335,13 +345,16 @@ void Game::onRender( Renderer* renderer )
     if ( !screen ) [[unlikely]] return;
 
     const auto [ width, height, aspect ] = viewport();
+    const math::vec2 viewportSize{ width, height };
+    // recorded on render thread straight into frame, renderer is the recording context
     switch ( screen->scene() ) {
     case "gameplay"_hash:
     case "pause"_hash:
-        m_gameScene.render( renderer, math::vec2{ width, height } );
+        m_gameScene.render( renderer, viewportSize );
         break;
     case "menu"_hash:
-        m_menuScene.render( renderer, math::vec2{ width, height } );
+        m_textureStreamer->request( m_mapsContainer[ m_currentMission ].preview, static_cast<float>( height ) );
+        m_menuScene.render( renderer, viewportSize );
         break;
     case 0: break;
     default:
@@ -349,7 +362,7 @@ void Game::onRender( Renderer* renderer )
         break;
     }
 
-    screen->render( renderer, math::vec2( width, height ) );
+    screen->render( renderer, viewportSize );
     if ( screen->scene() == 0 ) [[unlikely]] return;
 
     switch ( m_gameSettings.antialias ) {
@@ -376,6 +389,7 @@ void Game::onUpdate( float deltaTime )
     }
 
     UpdateContext uctx{ .deltaTime = deltaTime, };
+    updateMusic( screen->scene() );
 
     switch ( screen->scene() ) {
     case "gameplay"_hash:
@@ -395,6 +409,22 @@ void Game::onUpdate( float deltaTime )
     screen->update( uictx );
 }
 
+void Game::updateMusic( Hash::value_type scene )
+{
+    const auto music = scene == "menu"_hash ? m_music[ "music/menu.wav"_hash ] : std::span<const uint8_t>{};
+    // reloaded music was stopped by engine, it starts over with new data
+    if ( scene == m_musicScene && music.data() == m_menuMusicData.data() ) [[likely]] return;
+    m_musicScene = scene;
+    m_menuMusicData = music;
+    if ( m_menuMusic ) {
+        m_audio->stop( m_menuMusic );
+        m_menuMusic = 0;
+    }
+    if ( !music.empty() ) {
+        m_menuMusic = m_audio->stream( music, Audio::Channel::eMusic, true );
+    }
+}
+
 void Game::updateGame( UpdateContext& updateContext )
 {
     ZoneScoped;
@@ -429,6 +459,7 @@ void Game::createLevel()
     const auto& w2 = m_weapons[ m_weapon2 ];
     m_gameScene = GameScene{ GameScene::CreateInfo{
         .audio = m_audio,
+        .textureStreamer = m_textureStreamer,
         .skybox = m_mapsContainer[ m_currentMission ].texture,
         .textures = &m_textures,
         .enemyModel = &m_enemyModel,
@@ -485,7 +516,7 @@ void Game::loadMAP( Asset&& asset )
     using std::string_view_literals::operator""sv;
     ZoneScoped;
     cfg::Entry entry = cfg::Entry::fromData( asset.data );
-    MapCreateInfo& ci = m_mapsContainer.emplace_back();
+    MapCreateInfo ci{};
     ci.texture[ MapCreateInfo::eTop ] = m_textures[ entry[ "top"sv ].toString() ];
     ci.texture[ MapCreateInfo::eBottom ] = m_textures[ entry[ "bottom"sv ].toString() ];
     ci.texture[ MapCreateInfo::eLeft ] = m_textures[ entry[ "left"sv ].toString() ];
@@ -495,6 +526,10 @@ void Game::loadMAP( Asset&& asset )
     ci.name = entry[ "name"sv ].toString32();
     ci.preview = m_textures[ entry[ "preview"sv ].toString() ];
     ci.enemies = entry[ "enemies"sv ].toInt<uint32_t>();
+    // reloaded map replaces previous one of same name
+    auto it = std::ranges::find( m_mapsContainer, ci.name, &MapCreateInfo::name );
+    if ( it != m_mapsContainer.end() ) *it = std::move( ci );
+    else m_mapsContainer.emplace_back( std::move( ci ) );
 }
 
 void Game::loadJET( Asset&& asset )
@@ -502,11 +537,14 @@ void Game::loadJET( Asset&& asset )
     using std::string_view_literals::operator""sv;
     ZoneScoped;
     cfg::Entry entry = cfg::Entry::fromData( asset.data );
-    auto& jet = m_jetsContainer.emplace_back();
+    JetInfo jet{};
     auto&& texture = m_textures[ entry[ "texture"sv ].toString() ];
     auto&& mesh = m_meshes[ entry[ "model"sv ].toString() ];
     jet.model = Model{ mesh, texture };
     jet.name = entry[ "name"sv ].toString32();
+    auto it = std::ranges::find( m_jetsContainer, jet.name, &JetInfo::name );
+    if ( it != m_jetsContainer.end() ) *it = std::move( jet );
+    else m_jetsContainer.emplace_back( std::move( jet ) );
 }
 
 void Game::loadWPN( Asset&& asset )
@@ -550,17 +588,23 @@ void Game::loadWPN( Asset&& asset )
             continue;
         }
     }
-    if ( isHidden ) m_enemyWeapon = weap;
+    if ( isHidden ) {
+        m_enemyWeapon = weap;
+        return;
+    }
+    auto it = std::ranges::find( m_weapons, weap.displayName, &WeaponCreateInfo::displayName );
+    if ( it != m_weapons.end() ) *it = weap;
     else m_weapons.emplace_back( weap );
 }
 
 void Game::loadLANG( Asset&& asset )
 {
     ZoneScoped;
-    auto& ll = g_uiProperty.m_lockit.emplace_back( asset.data );
+    const ui::Lockit* ll = g_uiProperty.loadLANG( asset.data );
+    if ( !ll ) return;
     m_optionsGame.m_languageUI.addOption( OptionsGame::LanguageInfo{
-        .id = ll.id(),
-        .display = std::pmr::u32string{ ll.find( "lockit"_hash ) },
+        .id = ll->id(),
+        .display = std::pmr::u32string{ ll->find( "lockit"_hash ) },
     } );
 }
 
@@ -23,6 +23,7 @@
 #include <map>
 #include <vector>
 #include <memory_resource>
+#include <span>
 
 class Game : public Engine {
 public:
@@ -31,6 +32,8 @@ public:
 
 private:
     input::Remapper m_remapper{};
+    // development mount of loose cooked files over data.pak, set by --loose <directory>
+    std::filesystem::path m_looseDirectory{};
 
     uint32_t m_currentMission = 0;
     uint32_t m_currentJet = 0;
@@ -61,6 +64,11 @@ private:
     OptionsAudio m_optionsAudio{};
     OptionsGame m_optionsGame{};
     GameplayUIData m_gameplayUIData{};
+    // streamed while menu scene is shown
+    Audio::Stream m_menuMusic{};
+    Hash::value_type m_musicScene = 0;
+    // data m_menuMusic plays, differs once reload has replaced it
+    std::span<const uint8_t> m_menuMusicData{};
 
     ui::Var<std::pmr::u32string> m_uiMissionResult{ U"BUG ME" };
     ui::Var<std::pmr::u32string> m_uiMissionScore{ U"BUG ME" };
@@ -88,6 +96,7 @@ private:
     void setupUI();
 
     void updateGame( UpdateContext& );
+    void updateMusic( Hash::value_type scene );
 
     void onAction( input::Action );
     virtual void onActuator( input::Actuator ) override;
@@ -22,6 +22,13 @@ enum class Pipeline : PipelineSlot {
 template <Pipeline P>
 struct PushConstant;
 
+// maps quantized mesh vertices back to model space, identity for float meshes
+struct Dequantize {
+    math::vec4 m_positionScale{ 1.0f, 1.0f, 1.0f, 0.0f };
+    math::vec4 m_positionBias{};
+    math::vec4 m_uvScaleBias{ 1.0f, 1.0f, 0.0f, 0.0f };
+};
+
 template <>
 struct PushConstant<Pipeline::eBackground> {
     math::mat4 m_model{};
@@ -50,6 +57,7 @@ struct PushConstant<Pipeline::eMesh> {
     math::mat4 m_model{};
     math::mat4 m_view{};
     math::mat4 m_projection{};
+    Dequantize m_dequantize{};
 };
 
 template <>
@@ -57,6 +65,7 @@ struct PushConstant<Pipeline::eThruster2> {
     math::mat4 m_model{};
     math::mat4 m_view{};
     math::mat4 m_projection{};
+    Dequantize m_dequantize{};
     math::vec4 m_colorInner1{};
     math::vec4 m_colorInner2{};
     math::vec4 m_colorOutter1{};
@@ -125,6 +134,7 @@ struct PushConstant<Pipeline::eProjectile> {
     math::mat4 m_model{};
     math::mat4 m_view{};
     math::mat4 m_projection{};
+    Dequantize m_dequantize{};
     std::array<Instance, INSTANCES> m_instances{};
 };
 
@@ -13,6 +13,7 @@ GameScene::GameScene( const CreateInfo& ci ) noexcept
 , m_plasma{ ci.textures->find( "textures/plasma.dds"_hash ) }
 , m_tail{ ci.textures->find( "textures/tail.dds"_hash ) }
 , m_audio{ ci.audio }
+, m_textureStreamer{ ci.textureStreamer }
 {
     ZoneScoped;
     m_explosions.reserve( 3000 );
@@ -38,11 +39,12 @@ GameScene::GameScene( const CreateInfo& ci ) noexcept
     } );
 }
 
-void GameScene::render( Renderer* renderer, math::vec2 viewport )
+void GameScene::render( RecordingContext* renderer, math::vec2 viewport )
 {
     ZoneScoped;
     RenderContext rctx{
         .renderer = renderer,
+        .textureStreamer = m_textureStreamer,
         .projection = math::ortho( 0.0f, viewport.x, 0.0f, viewport.y, -100.0f, 100.0f ),
         .viewport = viewport,
     };
@@ -60,6 +62,16 @@ void GameScene::render( Renderer* renderer, math::vec2 viewport )
     m_targeting.render( rr );
 }
 
+static Audio::Emitter makeEmitter( const math::vec3& position, const math::vec3& velocity )
+{
+    return Audio::Emitter{
+        .position = position,
+        .velocity = velocity,
+        .minDistance = 60.0_m,
+        .maxDistance = 1500.0_m,
+    };
+}
+
 static void forEachQuadratic( auto& container1, auto& container2, auto&& fn )
 {
     ZoneScoped;
@@ -82,6 +94,15 @@ void GameScene::update( UpdateContext uctx )
     math::vec3 jetPos = m_player.position();
     math::vec3 jetVel = m_player.velocity();
 
+    const auto [ cameraPos, cameraUp, cameraTgt ] = getCamera();
+    m_audio->setListener( Audio::Listener{
+        .position = cameraPos,
+        .velocity = jetVel,
+        .forward = math::normalize( cameraTgt - cameraPos ),
+        .up = cameraUp,
+        .speedOfSound = 1235_kmph,
+    } );
+
     std::ranges::for_each( m_enemies, [s=m_player.signal()]( Enemy& e ) { e.setTarget( s ); } );
     Enemy::updateAll( uctx, m_enemies );
     Explosion::updateAll( uctx, m_explosions );
@@ -132,14 +153,18 @@ void GameScene::update( UpdateContext uctx )
         return true;
     };
     std::erase_if( m_enemies, extraExplosions );
-    std::ranges::for_each( m_enemies, [this]( Enemy& e ) { e.shoot( m_bullets ); } );
+    for ( Enemy& e : m_enemies ) {
+        // distant enemy fire is culled before it takes a mixer voice
+        const Audio::Slot sound = e.shoot( m_bullets );
+        if ( sound ) m_audio->play( sound, Audio::Channel::eSFX, makeEmitter( e.position(), e.velocity() ), Audio::Priority::eLow );
+    }
 
     m_targeting.setSignals( std::move( sgs ) );
     m_targeting.setTarget( m_player.target(), m_player.targetingState() );
     m_targeting.update( uctx );
 
     auto soundsToPlay = m_player.shoot( m_bullets );
-    for ( auto&& s : soundsToPlay ) { if ( s ) m_audio->play( s, Audio::Channel::eSFX ); }
+    for ( auto&& s : soundsToPlay ) { if ( s ) m_audio->play( s, Audio::Channel::eSFX, makeEmitter( jetPos, jetVel ) ); }
 
     m_spacedust.setCenter( jetPos );
     m_spacedust.setVelocity( -jetVel );
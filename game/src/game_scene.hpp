@@ -12,6 +12,7 @@
 #include "targeting.hpp"
 
 #include <audio/audio.hpp>
+#include <engine/texture_streamer.hpp>
 #include <shared/resource_map.hpp>
 #include <renderer/texture.hpp>
 
@@ -32,6 +33,7 @@ class GameScene {
     Texture m_plasma{};
     Texture m_tail{};
     Audio* m_audio{};
+    TextureStreamer* m_textureStreamer{};
     AutoLerp<float> m_look{ 0.0f, 1.0f, 3.0f };
     uint32_t m_score = 0;
 
@@ -40,6 +42,7 @@ class GameScene {
 public:
     struct CreateInfo {
         Audio* audio{};
+        TextureStreamer* textureStreamer{};
         std::array<Texture, 6> skybox{};
         const ResourceMap<Texture>* textures = nullptr;
         Model* enemyModel{};
@@ -53,7 +56,7 @@ public:
     GameScene() noexcept = default;
     GameScene( const CreateInfo& ) noexcept;
 
-    void render( Renderer*, math::vec2 viewport );
+    void render( RecordingContext*, math::vec2 viewport );
     void update( UpdateContext );
     void onAction( input::Action );
 
@@ -10,6 +10,7 @@
 MenuScene::MenuScene( const CreateInfo& ci )
 : m_background{ ci.background }
 , m_pipeline{ ci.pipeline }
+, m_textureStreamer{ ci.textureStreamer }
 {
     m_spaceDust.setPipeline( ci.spaceDustPipeline );
     m_spaceDust.setVelocity( math::vec3{ 0.0f, 0.0f, 26.0_m } );
@@ -17,7 +18,7 @@ MenuScene::MenuScene( const CreateInfo& ci )
     m_spaceDust.setLineWidth( 2.0f );
 }
 
-void MenuScene::render( Renderer* renderer, math::vec2 viewport )
+void MenuScene::render( RecordingContext* renderer, math::vec2 viewport )
 {
     ZoneScoped;
 
@@ -41,6 +42,7 @@ void MenuScene::render( Renderer* renderer, math::vec2 viewport )
     const math::vec3 cameraPos = math::normalize( math::vec3{ -4, -3, -3 } ) * 24.0_m;
     RenderContext rctx{
         .renderer = renderer,
+        .textureStreamer = m_textureStreamer,
         .view = math::lookAt( cameraPos, math::vec3{}, math::vec3{ 0, 1, 0 } ),
         .projection = math::perspective( 55.0_deg, viewport.x / viewport.y, 0.001f, 2000.0f ),
         .viewport = viewport,
@@ -5,12 +5,14 @@
 #include "render_context.hpp"
 #include "space_dust.hpp"
 
+#include <engine/texture_streamer.hpp>
 #include <ui/sprite.hpp>
 
 class MenuScene {
     ui::Sprite m_background{};
     Model* m_model{};
     PipelineSlot m_pipeline{};
+    TextureStreamer* m_textureStreamer{};
     SpaceDust m_spaceDust{};
 
 public:
@@ -18,12 +20,13 @@ public:
         ui::Sprite background{};
         PipelineSlot pipeline{};
         PipelineSlot spaceDustPipeline{};
+        TextureStreamer* textureStreamer{};
     };
     MenuScene() = default;
     MenuScene( const CreateInfo& );
 
     inline void setModel( Model* m ) { m_model = m; }
     void update( const UpdateContext& );
-    void render( Renderer* renderer, math::vec2 viewport );
+    void render( RecordingContext* renderer, math::vec2 viewport );
 
 };
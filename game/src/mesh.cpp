@@ -7,6 +7,15 @@
 
 #include <cstring>
 
+static Dequantize dequantize( const obj::Quantization& q ) noexcept
+{
+    return Dequantize{
+        .m_positionScale = math::vec4{ q.positionScale[ 0 ], q.positionScale[ 1 ], q.positionScale[ 2 ], 0.0f },
+        .m_positionBias = math::vec4{ q.positionBias[ 0 ], q.positionBias[ 1 ], q.positionBias[ 2 ], 0.0f },
+        .m_uvScaleBias = math::vec4{ q.uvScale[ 0 ], q.uvScale[ 1 ], q.uvBias[ 0 ], q.uvBias[ 1 ] },
+    };
+}
+
 Mesh::Mesh( std::span<const uint8_t> data, Renderer* renderer ) noexcept
 : m_renderer{ renderer }
 {
@@ -22,7 +31,7 @@ Mesh::Mesh( std::span<const uint8_t> data, Renderer* renderer ) noexcept
     std::advance( ptr, sizeof( header ) );
 
     assert( header.magic == obj::Header::MAGIC );
-    assert( header.version == obj::Header::VERSION );
+    assert( header.version >= obj::Header::VERSION_NON_INDEXED && header.version <= obj::Header::VERSION );
 
     auto readVec3 = []( auto& vec, auto& ptr )
     {
@@ -59,25 +68,67 @@ Mesh::Mesh( std::span<const uint8_t> data, Renderer* renderer ) noexcept
             continue;
         }
 
-        const uint8_t* floats = reinterpret_cast<const uint8_t*>( ptr );
-        const uint32_t bytesToLoad = chunk.floatCount * sizeof( float );
-        std::span<const uint8_t> span{ floats, bytesToLoad };
-        std::advance( ptr, bytesToLoad );
-        Buffer buffer = renderer->createBuffer( span );
+        MeshBuffer buffer{};
+        switch ( chunk.vertexAssembly ) {
+        case obj::VertexAssembly::vtnq: {
+            obj::Quantization quantization{};
+            assert( ptr + sizeof( quantization ) <= end );
+            std::memcpy( &quantization, ptr, sizeof( quantization ) );
+            std::advance( ptr, sizeof( quantization ) );
+            assert( quantization.magic == obj::Quantization::MAGIC );
+            const uint32_t bytesToLoad = chunk.floatCount * sizeof( float );
+            assert( ptr + bytesToLoad <= end );
+            buffer.vertices = renderer->createBuffer( std::span<const uint8_t>{ ptr, bytesToLoad } );
+            buffer.dequantize = dequantize( quantization );
+            std::advance( ptr, bytesToLoad );
+        } break;
+
+        case obj::VertexAssembly::vtn: {
+            // float meshes are quantized on load, pipelines consume only quantized vertices
+            std::pmr::vector<float> floats( chunk.floatCount );
+            assert( ptr + floats.size() * sizeof( float ) <= end );
+            std::memcpy( floats.data(), ptr, floats.size() * sizeof( float ) );
+            std::advance( ptr, floats.size() * sizeof( float ) );
+            std::pmr::vector<obj::PackedVertex> packed{};
+            const obj::Quantization quantization = obj::quantize( floats, packed );
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>( packed.data() );
+            buffer.vertices = renderer->createBuffer( std::span<const uint8_t>{ bytes, packed.size() * sizeof( obj::PackedVertex ) } );
+            buffer.dequantize = dequantize( quantization );
+        } break;
+
+        default: {
+            const uint32_t bytesToLoad = chunk.floatCount * sizeof( float );
+            assert( ptr + bytesToLoad <= end );
+            buffer.vertices = renderer->createBuffer( std::span<const uint8_t>{ ptr, bytesToLoad } );
+            std::advance( ptr, bytesToLoad );
+        } break;
+        }
+
+        obj::Indices indices{};
+        if ( header.version != obj::Header::VERSION_NON_INDEXED && ptr + sizeof( indices ) <= end ) {
+            std::memcpy( &indices, ptr, sizeof( indices ) );
+        }
+        if ( indices.magic == obj::Indices::MAGIC && indices.indexCount ) {
+            std::advance( ptr, sizeof( indices ) );
+            assert( ptr + obj::Indices::paddedSize( indices.indexCount ) <= end );
+            buffer.indices = renderer->createBuffer( std::span<const uint8_t>{ ptr, indices.indexCount * sizeof( uint16_t ) } );
+            std::advance( ptr, obj::Indices::paddedSize( indices.indexCount ) );
+        }
         m_map.emplace( std::make_pair( std::pmr::string{ chunk.name }, buffer ) );
     }
 }
 
-Buffer Mesh::operator [] ( std::string_view v ) const noexcept
+MeshBuffer Mesh::operator [] ( std::string_view v ) const noexcept
 {
     auto it = m_map.find( std::pmr::string{ v.begin(), v.end() } );
-    return it != m_map.end() ? it->second : Buffer{};
+    return it != m_map.end() ? it->second : MeshBuffer{};
 }
 
 Mesh::~Mesh() noexcept
 {
     if ( !m_renderer ) return;
     for ( const auto& it : m_map ) {
-        m_renderer->deleteBuffer( it.second );
+        m_renderer->deleteBuffer( it.second.vertices );
+        if ( it.second.indices ) m_renderer->deleteBuffer( it.second.indices );
     }
 }
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "game_pipeline.hpp"
+
 #include <math.hpp>
 #include <renderer/buffer.hpp>
 #include <shared/stack_vector.hpp>
 
 #include <array>
+#include <compare>
 #include <cstdint>
 #include <memory_resource>
 #include <string>
@@ -19,10 +22,21 @@ struct Hardpoints {
     StackVector<math::vec3, 1> secondary{};
 };
 
+// index buffer is optional, meshes cooked without --indexed are plain triangle lists
+struct MeshBuffer {
+    Buffer vertices{};
+    Buffer indices{};
+    Dequantize dequantize{};
+
+    inline explicit operator bool () const noexcept { return vertices; }
+    inline bool operator == ( const MeshBuffer& rhs ) const noexcept { return vertices == rhs.vertices; }
+    inline auto operator <=> ( const MeshBuffer& rhs ) const noexcept { return vertices <=> rhs.vertices; }
+};
+
 class Mesh {
     Renderer* m_renderer = nullptr;
     // TODO revisit with complying map __cpp_lib_generic_unordered_lookup, or drop key altogether
-    std::pmr::unordered_map<std::pmr::string, Buffer> m_map{};
+    std::pmr::unordered_map<std::pmr::string, MeshBuffer> m_map{};
 public:
     Hardpoints hardpoints{};
     StackVector<math::vec3, 2> thrusterAfterglow{};
@@ -36,7 +50,7 @@ public:
     Mesh( Mesh&& ) noexcept = default;
     Mesh& operator = ( Mesh&& ) noexcept = default;
 
-    Buffer operator [] ( std::string_view ) const noexcept;
+    MeshBuffer operator [] ( std::string_view ) const noexcept;
     inline auto begin() const { return m_map.begin(); }
     inline auto end() const { return m_map.end(); }
 };
@@ -4,6 +4,7 @@
 #include "game_pipeline.hpp"
 #include "units.hpp"
 
+#include <engine/texture_streamer.hpp>
 #include <renderer/renderer.hpp>
 
 #include <profiler.hpp>
@@ -38,10 +39,20 @@ void Model::render( const RenderContext& rctx ) const
         .m_uniform = pushConstant,
     };
     ri.m_fragmentTexture[ 0 ] = m_texture;
-    auto renderMesh = [&ri, &rctx]( Buffer b )
+    if ( rctx.textureStreamer ) {
+        // projected diameter of unit sphere around model origin
+        const math::vec4 center = rctx.projection * rctx.view * rctx.model * math::vec4{ 0.0f, 0.0f, 0.0f, 1.0f };
+        const float extent = center.w > 0.0f
+            ? 2.0f * static_cast<float>( meter ) * rctx.projection[ 1 ][ 1 ] * 0.5f * rctx.viewport.y / center.w
+            : 0.0f;
+        rctx.textureStreamer->request( m_texture, extent );
+    }
+    auto renderMesh = [&ri, &rctx, &pushConstant]( const MeshBuffer& b )
     {
         if ( !b ) return;
-        ri.m_vertexBuffer = b;
+        pushConstant.m_dequantize = b.dequantize;
+        ri.m_vertexBuffer = b.vertices;
+        ri.m_indexBuffer = b.indices;
         rctx.renderer->render( ri );
     };
     renderMesh( m_tail );
@@ -54,13 +65,15 @@ void Model::render( const RenderContext& rctx ) const
             .m_model = math::scale( rctx.model, math::vec3{ meter, meter, meter } ),
             .m_view = rctx.view,
             .m_projection = rctx.projection,
+            .m_dequantize = m_thruster.dequantize,
             .m_colorInner1 = colorscheme::ion[ 1 ],
             .m_colorInner2 = colorscheme::ion[ 0 ],
             .m_colorOutter1 = colorscheme::ion[ 3 ],
             .m_colorOutter2 = colorscheme::ion[ 2 ],
         };
         ri.m_pipeline = g_pipelines[ Pipeline::eThruster2 ];
-        ri.m_vertexBuffer = m_thruster;
+        ri.m_vertexBuffer = m_thruster.vertices;
+        ri.m_indexBuffer = m_thruster.indices;
         ri.m_uniform = p;
         rctx.renderer->render( ri );
     }
@@ -70,6 +83,7 @@ void Model::render( const RenderContext& rctx ) const
     ri.m_verticeCount = PushConstant<Pipeline::eAfterglow>::VERTICES;
     ri.m_instanceCount = PushConstant<Pipeline::eAfterglow>::INSTANCES;
     ri.m_vertexBuffer = {};
+    ri.m_indexBuffer = {};
 
     static const std::array zSizeCutoff{
         math::vec4{ 0.01_m, 3.0_m, 0.1f, 0.0f },
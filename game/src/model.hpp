@@ -21,11 +21,11 @@ private:
     StackVector<math::vec3, 2> m_thrusterAfterglow{};
 
 public:
-    Buffer m_hull{};
-    Buffer m_thruster{};
-    Buffer m_wings{};
-    Buffer m_tail{};
-    Buffer m_intake{};
+    MeshBuffer m_hull{};
+    MeshBuffer m_thruster{};
+    MeshBuffer m_wings{};
+    MeshBuffer m_tail{};
+    MeshBuffer m_intake{};
     ~Model() = default;
     Model() = default;
     Model( const Mesh&, Texture ) noexcept;
@@ -2,9 +2,11 @@
 
 #include <math.hpp>
 
-class Renderer;
+class RecordingContext;
+class TextureStreamer;
 struct RenderContext {
-    Renderer* renderer = nullptr;
+    RecordingContext* renderer = nullptr;
+    TextureStreamer* textureStreamer = nullptr;
     math::mat4 model = math::mat4( 1.0f );
     math::mat4 view = math::mat4( 1.0f );
     math::mat4 projection = math::mat4( 1.0f );
@@ -3,8 +3,11 @@
 #include "game_pipeline.hpp"
 #include "map_create_info.hpp"
 
+#include <engine/texture_streamer.hpp>
 #include <renderer/renderer.hpp>
 
+#include <algorithm>
+
 void Skybox::render( const RenderContext& rctx ) const
 {
     const PushConstant<Pipeline::eSkybox> pushConstant{
@@ -26,5 +29,9 @@ void Skybox::render( const RenderContext& rctx ) const
     ri.m_fragmentTexture[ 3 ] = m_texture[ Wall::eRight ];
     ri.m_fragmentTexture[ 4 ] = m_texture[ Wall::eTop ];
     ri.m_fragmentTexture[ 5 ] = m_texture[ Wall::eBottom ];
+    if ( rctx.textureStreamer ) {
+        const float extent = std::max( rctx.viewport.x, rctx.viewport.y );
+        for ( Texture t : m_texture ) rctx.textureStreamer->request( t, extent );
+    }
     rctx.renderer->render( ri );
 }
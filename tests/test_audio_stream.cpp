@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <audio/mixer.hpp>
+#include <audio/stream.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numbers>
+#include <thread>
+#include <vector>
+
+// mono PCM16 sine
+static std::vector<uint8_t> makeWav( uint32_t rate, uint32_t frames, float frequency )
+{
+    std::vector<uint8_t> ret;
+    auto put = [&ret]( auto v ) {
+        const size_t at = ret.size();
+        ret.resize( at + sizeof( v ) );
+        std::memcpy( ret.data() + at, &v, sizeof( v ) );
+    };
+    put( 'FFIR' );
+    put( static_cast<uint32_t>( 36 + frames * 2 ) );
+    put( 'EVAW' );
+    put( ' tmf' );
+    put( 16u );
+    put( uint16_t{ 1 } );
+    put( uint16_t{ 1 } );
+    put( rate );
+    put( rate * 2 );
+    put( uint16_t{ 2 } );
+    put( uint16_t{ 16 } );
+    put( 'atad' );
+    put( frames * 2 );
+    for ( uint32_t i = 0; i < frames; ++i ) {
+        const float t = static_cast<float>( i ) / static_cast<float>( rate );
+        put( static_cast<int16_t>( std::lround( 16000.0f * std::sin( 2.0f * std::numbers::pi_v<float> * frequency * t ) ) ) );
+    }
+    return ret;
+}
+
+TEST( AudioStream, resamples_to_device_format )
+{
+    static constexpr uint32_t RATE = 22050;
+    static constexpr float FREQUENCY = 440.0f;
+    const auto wav = makeWav( RATE, RATE * 2, FREQUENCY );
+    AudioStream stream{};
+    ASSERT_TRUE( stream.claim() );
+    ASSERT_FALSE( stream.open( std::span<const uint8_t>{ wav }.first( 40 ), { 48000, 2 }, false ) );
+    ASSERT_TRUE( stream.open( wav, { 48000, 2 }, false ) );
+
+    std::vector<int16_t> out;
+    std::vector<int16_t> chunk( 1000 );
+    while ( !stream.finished() ) {
+        stream.decode();
+        out.insert( out.end(), chunk.begin(), chunk.begin() + stream.read( chunk ) );
+    }
+    // 2 s at 48 kHz stereo
+    EXPECT_NEAR( static_cast<double>( out.size() ), 48000.0 * 2 * 2, 4.0 );
+    double maxError = 0.0;
+    // frames after last source frame hold its value
+    for ( size_t i = 0; i + 8 < out.size(); i += 2 ) {
+        ASSERT_EQ( out[ i ], out[ i + 1 ] );
+        const double t = static_cast<double>( i / 2 ) / 48000.0;
+        const double expected = 16000.0 * std::sin( 2.0 * std::numbers::pi * FREQUENCY * t );
+        maxError = std::max( maxError, std::abs( out[ i ] - expected ) );
+    }
+    EXPECT_LT( maxError, 16000.0 * 0.01 );
+    stream.release();
+    EXPECT_TRUE( stream.claim() );
+}
+
+TEST( AudioStream, streams_through_mixer )
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint32_t RATE = 44100;
+    static constexpr uint32_t CALLBACK = 512 * 2;
+    // 60 s of music, played briefly in real time then stopped
+    const auto wav = makeWav( RATE, RATE * 60, 220.0f );
+
+    StreamDecoder decoder{};
+    Mixer mixer{};
+    AudioStream* stream = decoder.open( wav, { 48000, 2 }, true );
+    ASSERT_TRUE( stream );
+    mixer.play( stream, 0, 0xFF );
+
+    const std::vector<float> gain{ 1.0f };
+    std::vector<int16_t> out( CALLBACK );
+    const auto callbackPeriod = std::chrono::microseconds( 1'000'000 * 512 / 48000 );
+    auto next = Clock::now();
+    for ( uint32_t i = 0; i < 40; ++i ) {
+        mixer.mix( out, gain );
+        next += callbackPeriod;
+        std::this_thread::sleep_until( next );
+    }
+    mixer.mix( std::span<int16_t>{ out }.first( 0 ), gain );
+    auto stats = mixer.statistics();
+    EXPECT_EQ( stats.voices, 1u );
+    EXPECT_EQ( stats.underrun, 0u );
+
+    const uint16_t generation = stream->generation();
+    stream->stop();
+    mixer.mix( out, gain );
+    mixer.mix( std::span<int16_t>{ out }.first( 0 ), gain );
+    EXPECT_EQ( mixer.statistics().voices, 0u );
+    // released by mixer, can be reused, handles of previous playback are told apart by generation
+    EXPECT_EQ( decoder.open( wav, { 48000, 2 }, false ), stream );
+    EXPECT_NE( stream->generation(), generation );
+
+    EXPECT_LT( sizeof( AudioStream ), 512u * 1024u );
+}
+
+TEST( AudioStream, stop_by_source_ends_reads_of_it )
+{
+    static constexpr uint32_t RATE = 44100;
+    StreamDecoder decoder{};
+    auto previous = std::make_unique<std::vector<uint8_t>>( makeWav( RATE, RATE * 10, 220.0f ) );
+    const auto wav = makeWav( RATE, RATE, 440.0f );
+    AudioStream* looped = decoder.open( *previous, { 48000, 2 }, true );
+    AudioStream* other = decoder.open( wav, { 48000, 2 }, true );
+    ASSERT_TRUE( looped );
+    ASSERT_TRUE( other );
+
+    // decode thread keeps refilling while data is replaced, as on hot reload
+    std::vector<int16_t> out( 4096 );
+    for ( uint32_t i = 0; i < 8; ++i ) {
+        looped->read( out );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    decoder.stop( *previous );
+    previous.reset();
+    std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+
+    EXPECT_TRUE( looped->finished() );
+    EXPECT_FALSE( other->finished() );
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <extra/bcn.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// B8G8R8A8 diagonal gradient between two saturated colors, worst case for banding
+static std::vector<uint8_t> gradient( uint32_t size )
+{
+    std::vector<uint8_t> ret( size * size * 4 );
+    for ( uint32_t y = 0; y < size; ++y ) {
+        for ( uint32_t x = 0; x < size; ++x ) {
+            const float t = static_cast<float>( x + y ) / static_cast<float>( size * 2 - 2 );
+            uint8_t* px = ret.data() + ( y * size + x ) * 4;
+            px[ 0 ] = static_cast<uint8_t>( std::lround( 40.0f + t * 180.0f ) );
+            px[ 1 ] = static_cast<uint8_t>( std::lround( 200.0f - t * 120.0f ) );
+            px[ 2 ] = static_cast<uint8_t>( std::lround( 90.0f + t * 60.0f ) );
+            px[ 3 ] = 0xFF;
+        }
+    }
+    return ret;
+}
+
+TEST( BlockCompression, solidColor )
+{
+    std::vector<uint8_t> image( 8 * 4 * 4 );
+    for ( size_t i = 0; i < image.size(); i += 4 ) {
+        // representable in 565: 8 bit expansions of 0x10, 0x20, 0x08
+        image[ i ] = 0x42;
+        image[ i + 1 ] = 0x82;
+        image[ i + 2 ] = 0x84;
+        image[ i + 3 ] = 0xFF;
+    }
+    for ( auto quality : { bcn::Quality::eFast, bcn::Quality::eHigh } ) {
+        const auto blocks = bcn::compressBC1( image, 8, 4, quality );
+        ASSERT_EQ( blocks.size(), 2u );
+        const auto decoded = bcn::decompressBC1( blocks, 8, 4 );
+        EXPECT_EQ( decoded, ( std::pmr::vector<uint8_t>{ image.begin(), image.end() } ) );
+    }
+}
+
+TEST( BlockCompression, threadsAreDeterministic )
+{
+    std::vector<uint8_t> image( 64 * 64 * 4 );
+    std::mt19937 gen{ 5 };
+    std::ranges::generate( image, [&gen]() { return static_cast<uint8_t>( gen() ); } );
+    const auto single = bcn::compressBC1( image, 64, 64, bcn::Quality::eHigh, 1 );
+    const auto multi = bcn::compressBC1( image, 64, 64, bcn::Quality::eHigh, 4 );
+    ASSERT_EQ( single.size(), multi.size() );
+    for ( size_t i = 0; i < single.size(); ++i ) {
+        EXPECT_EQ( single[ i ].color0, multi[ i ].color0 );
+        EXPECT_EQ( single[ i ].color1, multi[ i ].color1 );
+        EXPECT_EQ( single[ i ].indices, multi[ i ].indices );
+    }
+}
+
+TEST( BlockCompression, gradientQuality )
+{
+    static constexpr uint32_t SIZE = 256;
+    const std::vector<uint8_t> image = gradient( SIZE );
+
+    const auto fast = bcn::compressBC1( image, SIZE, SIZE, bcn::Quality::eFast );
+    const auto high = bcn::compressBC1( image, SIZE, SIZE, bcn::Quality::eHigh );
+
+    const double psnrFast = bcn::psnr( image, bcn::decompressBC1( fast, SIZE, SIZE ) );
+    const double psnrHigh = bcn::psnr( image, bcn::decompressBC1( high, SIZE, SIZE ) );
+    EXPECT_GT( psnrHigh, psnrFast + 3.0 );
+    EXPECT_GT( psnrHigh, 40.0 );
+}
+
+TEST( BlockCompression, bc7RoundTrip )
+{
+    static constexpr uint32_t SIZE = 256;
+    const std::vector<uint8_t> opaque = gradient( SIZE );
+    const std::vector<uint8_t> image = []()
+    {
+        // soft edged alpha blobs over the gradient
+        std::vector<uint8_t> ret = gradient( SIZE );
+        for ( uint32_t y = 0; y < SIZE; ++y ) {
+            for ( uint32_t x = 0; x < SIZE; ++x ) {
+                const float a = 0.5f + 0.5f * std::sin( static_cast<float>( x ) * 0.07f ) * std::cos( static_cast<float>( y ) * 0.05f );
+                ret[ ( y * SIZE + x ) * 4 + 3 ] = static_cast<uint8_t>( std::lround( a * 255.0f ) );
+            }
+        }
+        return ret;
+    }();
+
+    for ( const auto* source : { &opaque, &image } ) {
+        const auto fast = bcn::compressBC7( *source, SIZE, SIZE, bcn::Quality::eFast );
+        const auto high = bcn::compressBC7( *source, SIZE, SIZE, bcn::Quality::eHigh );
+        ASSERT_EQ( fast.size(), SIZE * SIZE / 16 );
+
+        const double psnrFast = bcn::psnr( *source, bcn::decompressBC7( fast, SIZE, SIZE ), true );
+        const double psnrHigh = bcn::psnr( *source, bcn::decompressBC7( high, SIZE, SIZE ), true );
+        EXPECT_GT( psnrFast, 45.0 );
+        EXPECT_GE( psnrHigh, psnrFast );
+    }
+
+    const auto bc1 = bcn::compressBC1( opaque, SIZE, SIZE, bcn::Quality::eHigh );
+    const auto bc7 = bcn::compressBC7( opaque, SIZE, SIZE, bcn::Quality::eFast );
+    EXPECT_GT( bcn::psnr( opaque, bcn::decompressBC7( bc7, SIZE, SIZE ) ), bcn::psnr( opaque, bcn::decompressBC1( bc1, SIZE, SIZE ) ) );
+}
+
+TEST( BlockCompression, bc7Noise )
+{
+    std::vector<uint8_t> image( 64 * 64 * 4 );
+    std::mt19937 gen{ 7 };
+    std::ranges::generate( image, [&gen]() { return static_cast<uint8_t>( gen() ); } );
+    const auto single = bcn::compressBC7( image, 64, 64, bcn::Quality::eHigh, 1 );
+    const auto multi = bcn::compressBC7( image, 64, 64, bcn::Quality::eHigh, 4 );
+    ASSERT_EQ( single.size(), multi.size() );
+    for ( size_t i = 0; i < single.size(); ++i ) {
+        EXPECT_EQ( single[ i ].bits[ 0 ], multi[ i ].bits[ 0 ] );
+        EXPECT_EQ( single[ i ].bits[ 1 ], multi[ i ].bits[ 1 ] );
+    }
+    // uncorrelated noise, endpoints still have to land on block extremes
+    EXPECT_GT( bcn::psnr( image, bcn::decompressBC7( single, 64, 64 ), true ), 10.0 );
+
+    // mip chain decode matches per level decode
+    std::pmr::vector<uint8_t> chain( single.size() * sizeof( bcn::BC7 ) );
+    std::memcpy( chain.data(), single.data(), chain.size() );
+    const auto mip0 = bcn::decompressBC7( std::span<const uint8_t>{ chain }, 64, 64, 1, 1 );
+    EXPECT_EQ( mip0, bcn::decompressBC7( single, 64, 64 ) );
+}
+
+TEST( BlockCompression, bc5RoundTrip )
+{
+    static constexpr uint32_t SIZE = 64;
+    const std::vector<uint8_t> image = gradient( SIZE );
+    const auto blocks = bcn::compressBC5( image, SIZE, SIZE );
+    ASSERT_EQ( blocks.size(), SIZE * SIZE / 16 );
+    const auto decoded = bcn::decompressBC5( blocks, SIZE, SIZE );
+    double mse = 0.0;
+    for ( size_t i = 0; i < image.size(); i += 4 ) {
+        EXPECT_EQ( decoded[ i ], 0x00 );
+        EXPECT_EQ( decoded[ i + 3 ], 0xFF );
+        for ( size_t c = 1; c < 3; ++c ) {
+            const double d = static_cast<double>( image[ i + c ] ) - static_cast<double>( decoded[ i + c ] );
+            mse += d * d;
+        }
+    }
+    mse /= static_cast<double>( SIZE * SIZE * 2 );
+    EXPECT_LT( mse, 1.0 );
+}
@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+
+#include <engine/filesystem.hpp>
+#include <extra/pak.hpp>
+#include <shared/hash.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Files = std::vector<std::pair<std::string, std::string>>;
+
+static std::filesystem::path writePak( std::string_view fileName, const Files& files )
+{
+    auto path = std::filesystem::temp_directory_path() / fileName;
+    std::ofstream ofs( path, std::ios::binary );
+    EXPECT_TRUE( ofs.is_open() );
+
+    pak::Header header{};
+    ofs.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+
+    std::vector<pak::Entry> entries( files.size() );
+    std::vector<pak::IndexEntry> index( files.size() );
+    for ( uint32_t i = 0; i < files.size(); ++i ) {
+        const auto& [ name, content ] = files[ i ];
+        auto& entry = entries[ i ];
+        std::ranges::copy( name, std::begin( entry.name ) );
+        entry.offset = static_cast<uint32_t>( ofs.tellp() );
+        entry.size = entry.uncompressedSize = static_cast<uint32_t>( content.size() );
+        ofs.write( content.data(), static_cast<std::streamsize>( content.size() ) );
+        index[ i ] = pak::IndexEntry{ .hash = Hash{}( name ), .entry = i };
+    }
+    std::ranges::sort( index, []( const auto& lhs, const auto& rhs )
+    {
+        return lhs.hash != rhs.hash ? lhs.hash < rhs.hash : lhs.entry < rhs.entry;
+    } );
+
+    header.offset = static_cast<uint32_t>( ofs.tellp() );
+    header.size = static_cast<uint32_t>( entries.size() * sizeof( pak::Entry ) );
+    ofs.write( reinterpret_cast<const char*>( entries.data() ), header.size );
+    header.indexOffset = static_cast<uint32_t>( ofs.tellp() );
+    header.indexSize = static_cast<uint32_t>( index.size() * sizeof( pak::IndexEntry ) );
+    ofs.write( reinterpret_cast<const char*>( index.data() ), header.indexSize );
+    ofs.seekp( 0 );
+    ofs.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    return path;
+}
+
+static Files generateFiles( uint32_t count, std::string_view prefix )
+{
+    Files ret;
+    ret.reserve( count );
+    for ( uint32_t i = 0; i < count; ++i ) {
+        ret.emplace_back( "dir/file_" + std::to_string( i ) + ".bin", std::string( prefix ) + std::to_string( i ) );
+    }
+    return ret;
+}
+
+static std::string_view view( std::span<const uint8_t> data )
+{
+    return { reinterpret_cast<const char*>( data.data() ), data.size() };
+}
+
+TEST( Filesystem, lookup_all_entries )
+{
+    const Files files = generateFiles( 12'000, "a" );
+    const auto path = writePak( "test_filesystem_lookup.pak", files );
+    Filesystem fs{};
+    fs.mount( path );
+    for ( const auto& [ name, content ] : files ) {
+        EXPECT_EQ( view( fs.viewWait( name ) ), content );
+    }
+    std::filesystem::remove( path );
+}
+
+TEST( Filesystem, newer_mount_shadows_older )
+{
+    const Files older{ { "a/shared.txt", "old" }, { "a/old.txt", "only old" } };
+    const Files newer{ { "a/shared.txt", "new" }, { "a/new.txt", "only new" } };
+    const auto olderPath = writePak( "test_filesystem_older.pak", older );
+    const auto newerPath = writePak( "test_filesystem_newer.pak", newer );
+    Filesystem fs{};
+    fs.mount( olderPath );
+    EXPECT_EQ( view( fs.viewWait( "a/shared.txt" ) ), "old" );
+    fs.mount( newerPath );
+    EXPECT_EQ( view( fs.viewWait( "a/shared.txt" ) ), "new" );
+    EXPECT_EQ( view( fs.viewWait( "a/old.txt" ) ), "only old" );
+    EXPECT_EQ( view( fs.viewWait( "a/new.txt" ) ), "only new" );
+    std::filesystem::remove( olderPath );
+    std::filesystem::remove( newerPath );
+}
+
+TEST( Filesystem, priority_shadows_regardless_of_order )
+{
+    const Files base{ { "a/shared.txt", "base" }, { "a/base.txt", "only base" } };
+    const Files patch{ { "a/shared.txt", "patch" }, { "a/patch.txt", "only patch" } };
+    const auto basePath = writePak( "test_filesystem_base.pak", base );
+    const auto patchPath = writePak( "test_filesystem_patch.pak", patch );
+    {
+        Filesystem fs{};
+        fs.mount( patchPath, 1 );
+        fs.mount( basePath );
+        EXPECT_EQ( view( fs.viewWait( "a/shared.txt" ) ), "patch" );
+        EXPECT_EQ( view( fs.viewWait( "a/base.txt" ) ), "only base" );
+        EXPECT_EQ( view( fs.viewWait( "a/patch.txt" ) ), "only patch" );
+    }
+    {
+        Filesystem fs{};
+        fs.mount( basePath );
+        fs.mount( patchPath, 1 );
+        EXPECT_EQ( view( fs.viewWait( "a/shared.txt" ) ), "patch" );
+        // same priority, later mount wins
+        fs.mount( basePath, 1 );
+        EXPECT_EQ( view( fs.viewWait( "a/shared.txt" ) ), "base" );
+        EXPECT_EQ( view( fs.viewWait( "a/patch.txt" ) ), "only patch" );
+    }
+    std::filesystem::remove( basePath );
+    std::filesystem::remove( patchPath );
+}
+
+TEST( Filesystem, callbacks_of_replaced_and_shadowed_entries )
+{
+    const Files base{ { "a/shared.txt", "base" }, { "a/base.txt", "only base" }, { "a/skip.bin", "no callback" } };
+    const Files patch{ { "a/shared.txt", "patch" } };
+    const auto basePath = writePak( "test_filesystem_cb_base.pak", base );
+    const auto patchPath = writePak( "test_filesystem_cb_patch.pak", patch );
+
+    std::vector<std::pair<std::string, std::string>> calls;
+    auto record = [&calls]( Asset&& a ) { calls.emplace_back( a.path, view( a.data ) ); };
+    {
+        Filesystem fs{};
+        fs.setCallback( ".txt", record );
+        fs.mount( basePath );
+        fs.mount( patchPath, 1 );
+        const decltype( calls ) expected{ { "a/base.txt", "only base" }, { "a/shared.txt", "base" }, { "a/shared.txt", "patch" } };
+        EXPECT_EQ( calls, expected );
+    }
+    calls.clear();
+    {
+        // shadowed entry of lower priority mount is neither loaded nor reported
+        Filesystem fs{};
+        fs.setCallback( ".txt", record );
+        fs.mount( patchPath, 1 );
+        fs.mount( basePath );
+        const decltype( calls ) expected{ { "a/shared.txt", "patch" }, { "a/base.txt", "only base" } };
+        EXPECT_EQ( calls, expected );
+    }
+    std::filesystem::remove( basePath );
+    std::filesystem::remove( patchPath );
+}
+
+TEST( Filesystem, loose_mount_reloads_changed_files )
+{
+    using Clock = std::chrono::steady_clock;
+    const auto root = std::filesystem::temp_directory_path() / "test_filesystem_loose";
+    std::filesystem::remove_all( root );
+    std::filesystem::create_directories( root / "a" );
+    auto write = [&root]( std::string_view name, std::string_view content )
+    {
+        std::ofstream ofs( root / name, std::ios::binary );
+        ofs.write( content.data(), static_cast<std::streamsize>( content.size() ) );
+    };
+    write( "a/one.txt", "one" );
+    write( "a/skip.bin", "no callback" );
+    const auto pakPath = writePak( "test_filesystem_loose.pak", { { "a/one.txt", "packed" }, { "a/packed.txt", "packed" } } );
+
+    std::vector<std::pair<std::string, std::string>> calls;
+    Filesystem fs{};
+    fs.setCallback( ".txt", [&calls]( Asset&& a ) { calls.emplace_back( a.path, view( a.data ) ); } );
+    fs.mount( pakPath );
+    fs.mountLoose( root, 1 );
+    EXPECT_EQ( view( fs.viewWait( "a/one.txt" ) ), "one" );
+    EXPECT_EQ( view( fs.viewWait( "a/skip.bin" ) ), "no callback" );
+    EXPECT_EQ( view( fs.viewWait( "a/packed.txt" ) ), "packed" );
+    EXPECT_EQ( fs.processReloads(), 0u );
+
+#if defined( __linux__ )
+    calls.clear();
+    auto waitForReloads = [&fs]( uint32_t count )
+    {
+        const auto deadline = Clock::now() + std::chrono::seconds( 5 );
+        uint32_t reloaded = 0;
+        while ( reloaded < count && Clock::now() < deadline ) {
+            reloaded += fs.processReloads();
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+        return reloaded;
+    };
+    write( "a/one.txt", "two" );
+    EXPECT_EQ( waitForReloads( 1 ), 1u );
+    EXPECT_EQ( view( fs.viewWait( "a/one.txt" ) ), "two" );
+    const decltype( calls ) expected{ { "a/one.txt", "two" } };
+    EXPECT_EQ( calls, expected );
+
+    // files of new directories are served too
+    std::filesystem::create_directories( root / "b" );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    write( "b/new.txt", "new" );
+    EXPECT_EQ( waitForReloads( 1 ), 1u );
+    EXPECT_EQ( view( fs.viewWait( "b/new.txt" ) ), "new" );
+
+    // superseded reloads and retired snapshots are released while lookups keep running, saving does not grow memory
+    const Filesystem::Statistics before = fs.statistics();
+    std::atomic<bool> quit = false;
+    std::thread reader{ [&fs, &quit]()
+    {
+        while ( !quit.load() ) {
+            [[maybe_unused]]
+            const auto data = fs.viewWait( "a/packed.txt" );
+        }
+    } };
+    for ( char c = '0'; c <= '9'; ++c ) {
+        write( "a/one.txt", std::string( 4, c ) );
+        EXPECT_EQ( waitForReloads( 1 ), 1u );
+    }
+    quit.store( true );
+    reader.join();
+    // retired data is reclaimed by first reload without lookups in flight
+    write( "a/one.txt", "last" );
+    EXPECT_EQ( waitForReloads( 1 ), 1u );
+    EXPECT_EQ( view( fs.viewWait( "a/one.txt" ) ), "last" );
+    const Filesystem::Statistics after = fs.statistics();
+    EXPECT_EQ( after.mounts, before.mounts );
+    EXPECT_EQ( after.snapshots, 1u );
+#endif
+    std::filesystem::remove_all( root );
+    std::filesystem::remove( pakPath );
+}
+
+TEST( Filesystem, DISABLED_benchmark_concurrent_lookup )
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint32_t ENTRIES = 16'384;
+    static constexpr uint32_t LOOKUPS_PER_THREAD = 1'000'000;
+
+    const Files files = generateFiles( ENTRIES, "b" );
+    const auto path = writePak( "test_filesystem_benchmark.pak", files );
+    Filesystem fs{};
+    fs.mount( path );
+
+    const uint32_t maxThreads = std::max( 1u, std::min( 8u, std::thread::hardware_concurrency() ) );
+    for ( uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2 ) {
+        std::atomic<uint64_t> misses = 0;
+        auto reader = [&fs, &files, &misses]( uint32_t seed )
+        {
+            uint64_t localMisses = 0;
+            for ( uint32_t i = 0; i < LOOKUPS_PER_THREAD; ++i ) {
+                const auto& [ name, content ] = files[ ( i * 7919u + seed ) % ENTRIES ];
+                localMisses += fs.viewWait( name ).size() != content.size();
+            }
+            misses += localMisses;
+        };
+
+        const auto t0 = Clock::now();
+        std::vector<std::thread> threads;
+        for ( uint32_t i = 0; i < threadCount; ++i ) {
+            threads.emplace_back( reader, i );
+        }
+        std::ranges::for_each( threads, []( auto& t ) { t.join(); } );
+        const auto t1 = Clock::now();
+
+        EXPECT_EQ( misses, 0 );
+        const double seconds = std::chrono::duration<double>( t1 - t0 ).count();
+        const double lookups = static_cast<double>( LOOKUPS_PER_THREAD ) * threadCount;
+        RecordProperty( "threads_" + std::to_string( threadCount ) + "_mlookups_s", std::to_string( lookups / std::max( seconds, 1e-9 ) / 1'000'000.0 ) );
+    }
+    std::filesystem::remove( path );
+}
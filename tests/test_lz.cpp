@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <extra/lz.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static std::vector<uint8_t> roundTrip( std::span<const uint8_t> src )
+{
+    std::vector<uint8_t> compressed( lz::compressBound( src.size() ) );
+    const std::size_t size = lz::compress( src, compressed );
+    EXPECT_NE( size, 0 );
+    compressed.resize( size );
+
+    std::vector<uint8_t> ret( src.size() );
+    EXPECT_TRUE( lz::decompress( compressed, ret ) );
+    return ret;
+}
+
+static std::vector<uint8_t> randomBytes( std::size_t size, uint32_t seed )
+{
+    std::mt19937 gen{ seed };
+    std::uniform_int_distribution<uint32_t> dist{ 0, 255 };
+    std::vector<uint8_t> ret( size );
+    for ( auto& it : ret ) it = static_cast<uint8_t>( dist( gen ) );
+    return ret;
+}
+
+// resembles cooked assets: runs of repeated structs mixed with noise
+static std::vector<uint8_t> assetLikeBytes( std::size_t size, uint32_t seed )
+{
+    std::mt19937 gen{ seed };
+    std::uniform_int_distribution<uint32_t> dist{ 0, 255 };
+    std::vector<uint8_t> ret;
+    ret.reserve( size );
+    while ( ret.size() < size ) {
+        const std::size_t run = 16 + dist( gen );
+        if ( dist( gen ) < 96 ) {
+            for ( std::size_t i = 0; i < run; ++i ) ret.push_back( static_cast<uint8_t>( dist( gen ) ) );
+        }
+        else {
+            const uint8_t pattern[ 4 ]{ static_cast<uint8_t>( dist( gen ) ), 0, 0x80, 0x3F };
+            for ( std::size_t i = 0; i < run; ++i ) ret.push_back( pattern[ i % 4 ] );
+        }
+    }
+    ret.resize( size );
+    return ret;
+}
+
+TEST( LZ, empty )
+{
+    std::vector<uint8_t> src{};
+    EXPECT_EQ( roundTrip( src ), src );
+}
+
+TEST( LZ, short_input )
+{
+    for ( std::size_t size = 1; size < 32; ++size ) {
+        const auto src = randomBytes( size, static_cast<uint32_t>( size ) );
+        EXPECT_EQ( roundTrip( src ), src );
+    }
+}
+
+TEST( LZ, text )
+{
+    static constexpr std::string_view text = "the quick brown fox jumps over the lazy dog, the quick brown fox jumps over the lazy dog again";
+    const std::span<const uint8_t> src{ reinterpret_cast<const uint8_t*>( text.data() ), text.size() };
+    const auto ret = roundTrip( src );
+    EXPECT_TRUE( std::equal( src.begin(), src.end(), ret.begin(), ret.end() ) );
+}
+
+TEST( LZ, overlapping_run )
+{
+    std::vector<uint8_t> src( 100'000, 0xAB );
+    src[ 5000 ] = 0;
+    EXPECT_EQ( roundTrip( src ), src );
+
+    std::vector<uint8_t> dst( lz::compressBound( src.size() ) );
+    EXPECT_LT( lz::compress( src, dst ), src.size() / 100 );
+}
+
+TEST( LZ, long_literals_and_matches )
+{
+    auto src = randomBytes( 70'000, 7 );
+    src.insert( src.end(), src.begin(), src.begin() + 3000 );
+    src.resize( src.size() + 2000, 0 );
+    EXPECT_EQ( roundTrip( src ), src );
+}
+
+TEST( LZ, incompressible_does_not_fit )
+{
+    const auto src = randomBytes( 4096, 1 );
+    std::vector<uint8_t> dst( src.size() - src.size() / 8 );
+    EXPECT_EQ( lz::compress( src, dst ), 0 );
+
+    dst.resize( lz::compressBound( src.size() ) );
+    EXPECT_NE( lz::compress( src, dst ), 0 );
+}
+
+TEST( LZ, malformed_input )
+{
+    const auto src = assetLikeBytes( 10'000, 3 );
+    std::vector<uint8_t> compressed( lz::compressBound( src.size() ) );
+    compressed.resize( lz::compress( src, compressed ) );
+    ASSERT_FALSE( compressed.empty() );
+
+    std::vector<uint8_t> dst( src.size() );
+    EXPECT_FALSE( lz::decompress( std::span{ compressed }.first( compressed.size() / 2 ), dst ) );
+
+    std::vector<uint8_t> small( src.size() - 1 );
+    EXPECT_FALSE( lz::decompress( compressed, small ) );
+
+    std::vector<uint8_t> large( src.size() + 1 );
+    EXPECT_FALSE( lz::decompress( compressed, large ) );
+
+    // offset pointing before beginning of output
+    const uint8_t badOffset[]{ 0x10, 'a', 0xFF, 0xFF, 0x00 };
+    std::vector<uint8_t> out( 16 );
+    EXPECT_FALSE( lz::decompress( badOffset, out ) );
+}
+
+TEST( LZ, DISABLED_benchmark )
+{
+    using Clock = std::chrono::steady_clock;
+    const auto src = assetLikeBytes( 16 << 20, 42 );
+    std::vector<uint8_t> compressed( lz::compressBound( src.size() ) );
+
+    const auto c0 = Clock::now();
+    compressed.resize( lz::compress( src, compressed ) );
+    const auto c1 = Clock::now();
+    ASSERT_FALSE( compressed.empty() );
+
+    std::vector<uint8_t> dst( src.size() );
+    static constexpr int ROUNDS = 8;
+    const auto d0 = Clock::now();
+    for ( int i = 0; i < ROUNDS; ++i ) {
+        ASSERT_TRUE( lz::decompress( compressed, dst ) );
+    }
+    const auto d1 = Clock::now();
+    EXPECT_EQ( dst, src );
+
+    auto mibPerSecond = []( std::size_t bytes, auto duration )
+    {
+        const double seconds = std::chrono::duration<double>( duration ).count();
+        return static_cast<double>( bytes ) / ( 1024.0 * 1024.0 ) / std::max( seconds, 1e-9 );
+    };
+    const double ratio = static_cast<double>( src.size() ) / static_cast<double>( compressed.size() );
+    RecordProperty( "ratio", std::to_string( ratio ) );
+    RecordProperty( "compress_mib_s", std::to_string( mibPerSecond( src.size(), c1 - c0 ) ) );
+    RecordProperty( "decompress_mib_s", std::to_string( mibPerSecond( src.size() * ROUNDS, d1 - d0 ) ) );
+    EXPECT_GT( ratio, 1.0 );
+}
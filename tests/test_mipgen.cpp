@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <extra/mipgen.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+static constexpr uint32_t SIZE = 512;
+static constexpr uint32_t LEVELS = 6;
+
+static double toSrgb( double l )
+{
+    return l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow( l, 1.0 / 2.4 ) - 0.055;
+}
+
+static uint8_t quantize( double v )
+{
+    return static_cast<uint8_t>( std::lround( std::clamp( v, 0.0, 1.0 ) * 255.0 ) );
+}
+
+// high contrast pattern in linear space: zone plate, hard edged stripes and smooth gradient
+static std::vector<double> linearPattern()
+{
+    std::vector<double> ret( SIZE * SIZE );
+    for ( uint32_t y = 0; y < SIZE; ++y ) {
+        for ( uint32_t x = 0; x < SIZE; ++x ) {
+            const double u = ( x + 0.5 ) / SIZE - 0.5;
+            const double v = ( y + 0.5 ) / SIZE - 0.5;
+            double value = 0.5 + 0.5 * std::cos( 400.0 * ( u * u + v * v ) );
+            if ( x < SIZE / 4 ) value = ( ( x / 3 ) & 1 ) ? 1.0 : 0.0;
+            if ( y >= SIZE * 3 / 4 ) value = static_cast<double>( x ) / SIZE;
+            ret[ y * SIZE + x ] = value;
+        }
+    }
+    return ret;
+}
+
+static std::vector<uint8_t> encode( const std::vector<double>& linear )
+{
+    std::vector<uint8_t> ret( linear.size() * 4 );
+    for ( std::size_t i = 0; i < linear.size(); ++i ) {
+        const uint8_t c = quantize( toSrgb( linear[ i ] ) );
+        ret[ i * 4 ] = c;
+        ret[ i * 4 + 1 ] = c;
+        ret[ i * 4 + 2 ] = c;
+        ret[ i * 4 + 3 ] = 0xFF;
+    }
+    return ret;
+}
+
+// exact pixel footprint average in linear space
+static std::vector<uint8_t> reference( const std::vector<double>& linear, uint32_t level )
+{
+    const uint32_t scale = 1u << level;
+    const uint32_t size = SIZE >> level;
+    std::vector<uint8_t> ret( size * size * 4 );
+    for ( uint32_t y = 0; y < size; ++y ) {
+        for ( uint32_t x = 0; x < size; ++x ) {
+            double sum = 0.0;
+            for ( uint32_t sy = 0; sy < scale; ++sy ) {
+                for ( uint32_t sx = 0; sx < scale; ++sx ) {
+                    sum += linear[ ( y * scale + sy ) * SIZE + x * scale + sx ];
+                }
+            }
+            const uint8_t c = quantize( toSrgb( sum / ( scale * scale ) ) );
+            std::fill_n( ret.begin() + ( y * size + x ) * 4, 3, c );
+            ret[ ( y * size + x ) * 4 + 3 ] = 0xFF;
+        }
+    }
+    return ret;
+}
+
+static double psnr( std::span<const uint8_t> a, std::span<const uint8_t> b )
+{
+    double mse = 0.0;
+    for ( std::size_t i = 0; i < a.size(); ++i ) {
+        const double d = static_cast<double>( a[ i ] ) - static_cast<double>( b[ i ] );
+        mse += d * d;
+    }
+    mse /= static_cast<double>( a.size() );
+    return mse == 0.0 ? 99.0 : 10.0 * std::log10( 255.0 * 255.0 / mse );
+}
+
+TEST( MipGen, constant )
+{
+    std::vector<uint8_t> image( 64 * 64 * 4 );
+    for ( std::size_t i = 0; i < image.size(); i += 4 ) {
+        image[ i ] = 10;
+        image[ i + 1 ] = 128;
+        image[ i + 2 ] = 250;
+        image[ i + 3 ] = 77;
+    }
+    const std::array<std::span<const uint8_t>, 1> layers{ image };
+    for ( auto filter : { mipgen::Filter::eBox, mipgen::Filter::eKaiser, mipgen::Filter::eLanczos } ) {
+        for ( bool srgb : { false, true } ) {
+            const auto levels = mipgen::generate( layers, 64, 64, 4, 4, { .filter = filter, .srgb = srgb } );
+            ASSERT_EQ( levels.size(), 4u );
+            for ( uint32_t i = 0; i < levels.size(); ++i ) {
+                EXPECT_EQ( levels[ i ].width, 32u >> i );
+                EXPECT_EQ( levels[ i ].height, 32u >> i );
+                ASSERT_EQ( levels[ i ].pixels.size(), levels[ i ].width * levels[ i ].height * 4 );
+                EXPECT_TRUE( std::equal( levels[ i ].pixels.begin(), levels[ i ].pixels.end(), image.begin() ) );
+            }
+        }
+    }
+}
+
+TEST( MipGen, layersAndThreads )
+{
+    std::vector<uint8_t> a( 32 * 16 );
+    std::vector<uint8_t> b( 32 * 16 );
+    std::mt19937 gen{ 3 };
+    std::ranges::generate( a, [&gen]() { return static_cast<uint8_t>( gen() ); } );
+    std::ranges::fill( b, 200 );
+    const std::array<std::span<const uint8_t>, 2> layers{ a, b };
+    const mipgen::Options single{ .filter = mipgen::Filter::eLanczos, .srgb = true, .threadCount = 1 };
+    mipgen::Options multi = single;
+    multi.threadCount = 4;
+    const auto levels = mipgen::generate( layers, 32, 16, 1, 2, single );
+    const auto levelsMulti = mipgen::generate( layers, 32, 16, 1, 2, multi );
+    ASSERT_EQ( levels.size(), 4u );
+    ASSERT_EQ( levelsMulti.size(), 4u );
+    for ( uint32_t i = 0; i < levels.size(); ++i ) {
+        EXPECT_EQ( levels[ i ].pixels, levelsMulti[ i ].pixels );
+    }
+    EXPECT_EQ( levels[ 1 ].width, 8u );
+    EXPECT_EQ( levels[ 1 ].height, 4u );
+    EXPECT_TRUE( std::ranges::all_of( levels[ 2 ].pixels, []( uint8_t c ) { return c == 200; } ) );
+    EXPECT_TRUE( std::ranges::all_of( levels[ 3 ].pixels, []( uint8_t c ) { return c == 200; } ) );
+}
+
+TEST( MipGen, alphaCoverage )
+{
+    // foliage like cutout: thin soft edged alpha features over transparent background
+    std::vector<uint8_t> image( SIZE * SIZE * 4, 0xFF );
+    for ( uint32_t y = 0; y < SIZE; ++y ) {
+        for ( uint32_t x = 0; x < SIZE; ++x ) {
+            const double a = std::sin( x * 0.9 ) * std::sin( y * 0.7 + std::sin( x * 0.05 ) * 4.0 );
+            image[ ( y * SIZE + x ) * 4 + 3 ] = quantize( ( a - 0.5 ) * 4.0 );
+        }
+    }
+    const std::array<std::span<const uint8_t>, 1> layers{ image };
+    static constexpr float REFERENCE = 0.5f;
+    const float base = mipgen::alphaCoverage( image, 4, REFERENCE );
+
+    const auto plain = mipgen::generate( layers, SIZE, SIZE, 4, LEVELS, {} );
+    const auto preserved = mipgen::generate( layers, SIZE, SIZE, 4, LEVELS, { .alphaCoverage = REFERENCE } );
+    for ( uint32_t i = 0; i < LEVELS; ++i ) {
+        const float covPlain = mipgen::alphaCoverage( plain[ i ].pixels, 4, REFERENCE );
+        const float covPreserved = mipgen::alphaCoverage( preserved[ i ].pixels, 4, REFERENCE );
+        EXPECT_NEAR( covPreserved, base, 0.02f ) << "level " << i + 1;
+        if ( i > 1 ) {
+            EXPECT_LT( covPlain, base * 0.5f ) << "level " << i + 1;
+        }
+    }
+}
+
+struct FilterCase {
+    const char* name;
+    mipgen::Options options;
+};
+
+static constexpr std::array FILTER_CASES{
+    FilterCase{ "box_gamma", { .filter = mipgen::Filter::eBox } },
+    FilterCase{ "box_srgb", { .filter = mipgen::Filter::eBox, .srgb = true } },
+    FilterCase{ "kaiser_srgb", { .filter = mipgen::Filter::eKaiser, .srgb = true } },
+    FilterCase{ "lanczos_srgb", { .filter = mipgen::Filter::eLanczos, .srgb = true } },
+};
+
+TEST( MipGen, filterQuality )
+{
+    const std::vector<double> linear = linearPattern();
+    const std::vector<uint8_t> image = encode( linear );
+    const std::array<std::span<const uint8_t>, 1> layers{ image };
+
+    std::array<double, FILTER_CASES.size()> meanPsnr{};
+    for ( size_t c = 0; c < FILTER_CASES.size(); ++c ) {
+        const auto levels = mipgen::generate( layers, SIZE, SIZE, 4, LEVELS, FILTER_CASES[ c ].options );
+        ASSERT_EQ( levels.size(), LEVELS );
+        for ( uint32_t i = 0; i < LEVELS; ++i ) meanPsnr[ c ] += psnr( levels[ i ].pixels, reference( linear, i + 1 ) ) / LEVELS;
+    }
+    EXPECT_GT( meanPsnr[ 1 ], meanPsnr[ 0 ] + 3.0 );
+    EXPECT_GT( meanPsnr[ 2 ], meanPsnr[ 0 ] );
+    EXPECT_GT( meanPsnr[ 3 ], meanPsnr[ 0 ] );
+}
+
+TEST( MipGen, DISABLED_benchmark )
+{
+    using Clock = std::chrono::steady_clock;
+    const std::vector<uint8_t> image = encode( linearPattern() );
+
+    static constexpr uint32_t LAYERS = 6;
+    const std::array<std::span<const uint8_t>, LAYERS> layers{ image, image, image, image, image, image };
+
+    for ( const FilterCase& c : FILTER_CASES ) {
+        const auto t0 = Clock::now();
+        const auto levels = mipgen::generate( layers, SIZE, SIZE, 4, LEVELS, c.options );
+        const auto t1 = Clock::now();
+        ASSERT_EQ( levels.size(), LAYERS * LEVELS );
+
+        const double seconds = std::max( std::chrono::duration<double>( t1 - t0 ).count(), 1e-9 );
+        const double mpix = static_cast<double>( SIZE ) * SIZE * LAYERS / 1e6;
+        RecordProperty( std::string{ c.name } + "_mpix_s", std::to_string( mpix / seconds ) );
+    }
+}
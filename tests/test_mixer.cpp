@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <audio/mixer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::vector<int16_t> noise( uint32_t count, int16_t amplitude, uint32_t seed )
+{
+    std::mt19937 gen{ seed };
+    std::uniform_int_distribution<int> dist{ -amplitude, amplitude };
+    std::vector<int16_t> ret( count );
+    std::ranges::generate( ret, [&]() { return static_cast<int16_t>( dist( gen ) ); } );
+    return ret;
+}
+
+TEST( Mixer, matches_reference )
+{
+    // gains and samples exactly representable, summation order does not matter
+    const std::vector<float> gains{ 1.0f, 0.5f, 0.25f };
+    std::vector<std::vector<int16_t>> sources;
+    for ( uint32_t i = 0; i < 7; ++i ) {
+        sources.emplace_back( noise( 1000 + i * 777, 12000, i ) );
+    }
+
+    Mixer mixer{};
+    for ( uint32_t i = 0; i < sources.size(); ++i ) {
+        mixer.play( sources[ i ], static_cast<uint8_t>( i % gains.size() ), 0 );
+    }
+
+    std::vector<int16_t> out( 7000 );
+    std::vector<float> expected( out.size() );
+    for ( uint32_t i = 0; i < sources.size(); ++i ) {
+        for ( uint32_t j = 0; j < sources[ i ].size(); ++j ) {
+            expected[ j ] += static_cast<float>( sources[ i ][ j ] ) * gains[ i % gains.size() ];
+        }
+    }
+    // odd callback sizes exercise scalar tails
+    for ( size_t begin = 0, size = 1; begin < out.size(); begin += size, size = size * 3 + 1 ) {
+        mixer.mix( std::span<int16_t>{ out }.subspan( begin, std::min( size, out.size() - begin ) ), gains );
+    }
+
+    uint64_t clipped = 0;
+    for ( size_t i = 0; i < out.size(); ++i ) {
+        clipped += expected[ i ] > 32767.0f || expected[ i ] < -32768.0f;
+        ASSERT_EQ( out[ i ], static_cast<int16_t>( std::nearbyint( std::clamp( expected[ i ], -32768.0f, 32767.0f ) ) ) ) << i;
+    }
+    mixer.mix( std::span<int16_t>{ out }.first( 1 ), gains );
+    const auto stats = mixer.statistics();
+    EXPECT_GT( clipped, 0u );
+    EXPECT_EQ( stats.clipped, clipped );
+    EXPECT_EQ( stats.started, sources.size() );
+    EXPECT_EQ( stats.voices, 0u );
+}
+
+TEST( Mixer, voice_stealing )
+{
+    const std::vector<float> gains{ 1.0f };
+    const std::vector<int16_t> loud( 4096, 1000 );
+    const std::vector<int16_t> quiet( 4096, 1 );
+    const std::vector<int16_t> silent( 4096, 0 );
+    std::vector<int16_t> out( 16 );
+
+    Mixer mixer{};
+    mixer.play( loud, 0, 1 );
+    for ( uint32_t i = 1; i < Mixer::MAX_VOICES; ++i ) {
+        mixer.play( quiet, 0, 1 );
+    }
+    mixer.mix( out, gains );
+    EXPECT_EQ( out[ 0 ], 1000 + Mixer::MAX_VOICES - 1 );
+
+    // lower priority does not fit
+    mixer.play( silent, 0, 0 );
+    mixer.mix( out, gains );
+    EXPECT_EQ( out[ 0 ], 1000 + Mixer::MAX_VOICES - 1 );
+
+    // same priority replaces oldest
+    mixer.play( silent, 0, 1 );
+    mixer.mix( out, gains );
+    EXPECT_EQ( out[ 0 ], Mixer::MAX_VOICES - 1 );
+
+    // higher priority replaces lowest priority first
+    mixer.play( loud, 0, 2 );
+    mixer.play( silent, 0, 1 );
+    mixer.mix( out, gains );
+    EXPECT_EQ( out[ 0 ], 1000 + Mixer::MAX_VOICES - 3 );
+
+    mixer.mix( std::span<int16_t>{ out }.first( 0 ), gains );
+    const auto stats = mixer.statistics();
+    EXPECT_EQ( stats.voices, Mixer::MAX_VOICES );
+    EXPECT_EQ( stats.started, Mixer::MAX_VOICES + 3 );
+    EXPECT_EQ( stats.stolen, 3u );
+    EXPECT_EQ( stats.dropped, 1u );
+}
+
+TEST( Mixer, placement )
+{
+    const std::vector<float> gains{ 1.0f };
+    // stereo frames, left 1000, right -1000
+    std::vector<int16_t> stereo( 200 );
+    for ( size_t i = 0; i < stereo.size(); i += 2 ) {
+        stereo[ i ] = 1000;
+        stereo[ i + 1 ] = -1000;
+    }
+    std::vector<int16_t> out( 400 );
+
+    Mixer mixer{};
+    mixer.play( stereo, 0, 0, nullptr, Mixer::Placement{ .left = 0.5f, .right = 0.25f } );
+    mixer.mix( out, gains );
+    for ( size_t i = 0; i < out.size(); i += 2 ) {
+        ASSERT_EQ( out[ i ], i < stereo.size() ? 500 : 0 ) << i;
+        ASSERT_EQ( out[ i + 1 ], i < stereo.size() ? -250 : 0 ) << i;
+    }
+
+    // twice the pitch finishes in half the frames
+    mixer.play( stereo, 0, 0, nullptr, Mixer::Placement{ .pitch = 2.0f } );
+    mixer.mix( out, gains );
+    for ( size_t i = 0; i < out.size(); i += 2 ) {
+        ASSERT_EQ( out[ i ], i < stereo.size() / 2 ? 1000 : 0 ) << i;
+    }
+
+    // half the pitch interpolates between source frames
+    std::vector<int16_t> ramp( 100 );
+    for ( size_t i = 0; i < ramp.size(); ++i ) {
+        ramp[ i ] = static_cast<int16_t>( i * 10 );
+    }
+    mixer.setChannels( 1 );
+    mixer.play( ramp, 0, 0, nullptr, Mixer::Placement{ .pitch = 0.5f } );
+    mixer.mix( out, gains );
+    for ( size_t i = 0; i + 2 < ramp.size() * 2; ++i ) {
+        ASSERT_EQ( out[ i ], static_cast<int16_t>( i * 5 ) ) << i;
+    }
+    EXPECT_EQ( out[ ramp.size() * 2 ], 0 );
+    mixer.mix( std::span<int16_t>{ out }.first( 0 ), gains );
+    EXPECT_EQ( mixer.statistics().voices, 0u );
+}
+
+// per voice saturating add into output, how voices were mixed before
+static void mixReference( std::span<int16_t> out, std::span<const int16_t> in, float gain )
+{
+    for ( size_t i = 0; i < out.size(); ++i ) {
+        const int32_t s = out[ i ] + static_cast<int32_t>( static_cast<float>( in[ i ] ) * gain );
+        out[ i ] = static_cast<int16_t>( std::clamp( s, -32768, 32767 ) );
+    }
+}
+
+TEST( Mixer, DISABLED_benchmark )
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint32_t RATE = 48000;
+    static constexpr uint32_t CHANNELS = 2;
+    static constexpr uint32_t CALLBACK = 512 * CHANNELS;
+    static constexpr uint32_t SECONDS = 10;
+    const std::vector<float> gains{ 0.8f };
+
+    std::vector<std::vector<int16_t>> sources;
+    for ( uint32_t i = 0; i < 64; ++i ) {
+        sources.emplace_back( noise( RATE * CHANNELS * SECONDS, 8000, i ) );
+    }
+    std::vector<int16_t> out( CALLBACK );
+
+    for ( uint32_t voices : { 8u, 32u, 64u } ) {
+        Mixer mixer{};
+        for ( uint32_t i = 0; i < voices; ++i ) {
+            mixer.play( sources[ i ], 0, 0 );
+        }
+        const auto t0 = Clock::now();
+        for ( uint32_t i = 0; i < RATE * CHANNELS * SECONDS; i += CALLBACK ) {
+            mixer.mix( out, gains );
+        }
+        const auto t1 = Clock::now();
+
+        const uint32_t mixed = std::min( voices, Mixer::MAX_VOICES );
+        for ( uint32_t i = 0; i < RATE * CHANNELS * SECONDS; i += CALLBACK ) {
+            std::ranges::fill( out, 0 );
+            for ( uint32_t v = 0; v < mixed; ++v ) {
+                mixReference( out, std::span<const int16_t>{ sources[ v ] }.subspan( i, CALLBACK ), gains[ 0 ] );
+            }
+        }
+        const auto t2 = Clock::now();
+
+        const auto stats = mixer.statistics();
+        EXPECT_EQ( stats.started, mixed );
+        EXPECT_EQ( stats.dropped, voices - mixed );
+        const double ms = std::chrono::duration<double, std::milli>( t1 - t0 ).count();
+        const double msReference = std::chrono::duration<double, std::milli>( t2 - t1 ).count();
+        const std::string prefix = "voices_" + std::to_string( voices );
+        RecordProperty( prefix + "_realtime", std::to_string( SECONDS * 1000.0 / ms ) );
+        RecordProperty( prefix + "_ms", std::to_string( ms ) );
+        RecordProperty( prefix + "_saturating_ms", std::to_string( msReference ) );
+    }
+}
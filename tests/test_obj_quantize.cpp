@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <extra/obj.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// minimal reader of source OBJ, expands faces to vtn triangle list the same way cooker_obj does
+static std::pmr::vector<float> readObj( const std::filesystem::path& path )
+{
+    std::vector<std::array<float, 3>> v;
+    std::vector<std::array<float, 2>> vt;
+    std::vector<std::array<float, 3>> vn;
+    std::pmr::vector<float> ret;
+
+    std::ifstream ifs( path );
+    std::string line;
+    while ( std::getline( ifs, line ) ) {
+        std::istringstream ss{ line };
+        std::string cmd;
+        ss >> cmd;
+        if ( cmd == "v" ) {
+            auto& it = v.emplace_back();
+            ss >> it[ 0 ] >> it[ 1 ] >> it[ 2 ];
+        }
+        else if ( cmd == "vt" ) {
+            auto& it = vt.emplace_back();
+            ss >> it[ 0 ] >> it[ 1 ];
+        }
+        else if ( cmd == "vn" ) {
+            auto& it = vn.emplace_back();
+            ss >> it[ 0 ] >> it[ 1 ] >> it[ 2 ];
+        }
+        else if ( cmd == "f" ) {
+            std::string corner;
+            while ( ss >> corner ) {
+                uint32_t a = 0, b = 0, c = 0;
+                EXPECT_EQ( std::sscanf( corner.c_str(), "%u/%u/%u", &a, &b, &c ), 3 );
+                ret.insert( ret.end(), v[ a - 1 ].begin(), v[ a - 1 ].end() );
+                ret.insert( ret.end(), vt[ b - 1 ].begin(), vt[ b - 1 ].end() );
+                ret.insert( ret.end(), vn[ c - 1 ].begin(), vn[ c - 1 ].end() );
+            }
+        }
+    }
+    return ret;
+}
+
+TEST( ObjQuantize, errorBounds )
+{
+    const std::filesystem::path models{ MODELS_DIR };
+    uint32_t modelCount = 0;
+    for ( const auto& entry : std::filesystem::directory_iterator{ models } ) {
+        if ( entry.path().extension() != ".obj" ) continue;
+        modelCount++;
+
+        const std::pmr::vector<float> source = readObj( entry.path() );
+        ASSERT_FALSE( source.empty() );
+        ASSERT_EQ( source.size() % obj::VTN_STRIDE, 0 );
+
+        std::pmr::vector<obj::PackedVertex> packed;
+        const obj::Quantization q = obj::quantize( source, packed );
+        const std::pmr::vector<float> decoded = obj::dequantize( q, packed );
+        ASSERT_EQ( decoded.size(), source.size() );
+
+        // half of 16 bit unorm step of each axis, plus float rounding
+        float positionBound[ 3 ]{};
+        float uvBound[ 2 ]{};
+        for ( uint32_t j = 0; j < 3; ++j ) positionBound[ j ] = q.positionScale[ j ] / 65535.0f * 0.5f + 1e-5f;
+        for ( uint32_t j = 0; j < 2; ++j ) uvBound[ j ] = q.uvScale[ j ] / 65535.0f * 0.5f + 1e-6f;
+
+        double normalCos = 1.0;
+        for ( std::size_t i = 0; i < source.size(); i += obj::VTN_STRIDE ) {
+            const float* src = source.data() + i;
+            const float* dst = decoded.data() + i;
+            for ( uint32_t j = 0; j < 3; ++j ) {
+                ASSERT_LE( std::abs( src[ j ] - dst[ j ] ), positionBound[ j ] ) << entry.path();
+            }
+            for ( uint32_t j = 0; j < 2; ++j ) {
+                ASSERT_LE( std::abs( src[ j + 3 ] - dst[ j + 3 ] ), uvBound[ j ] ) << entry.path();
+            }
+            const double length = std::sqrt( double( src[ 5 ] ) * src[ 5 ] + double( src[ 6 ] ) * src[ 6 ] + double( src[ 7 ] ) * src[ 7 ] );
+            const double cos = ( double( src[ 5 ] ) * dst[ 5 ] + double( src[ 6 ] ) * dst[ 6 ] + double( src[ 7 ] ) * dst[ 7 ] ) / length;
+            normalCos = std::min( normalCos, cos );
+        }
+        // octahedral 16 bit step is below 0.01 degree, decoded normals are normalized in float
+        const double normalDegrees = std::acos( std::min( normalCos, 1.0 ) ) * 57.29577951308232;
+        EXPECT_LT( normalDegrees, 0.05 ) << entry.path();
+    }
+    EXPECT_GT( modelCount, 0u );
+}
+
+TEST( ObjQuantize, octahedralNormals )
+{
+    std::pmr::vector<float> vtn;
+    for ( int32_t z = -8; z <= 8; ++z ) {
+        for ( int32_t y = -8; y <= 8; ++y ) {
+            for ( int32_t x = -8; x <= 8; ++x ) {
+                if ( x == 0 && y == 0 && z == 0 ) continue;
+                const float n[ 3 ]{ static_cast<float>( x ), static_cast<float>( y ), static_cast<float>( z ) };
+                const float len = std::sqrt( n[ 0 ] * n[ 0 ] + n[ 1 ] * n[ 1 ] + n[ 2 ] * n[ 2 ] );
+                vtn.insert( vtn.end(), { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, n[ 0 ] / len, n[ 1 ] / len, n[ 2 ] / len } );
+            }
+        }
+    }
+    std::pmr::vector<obj::PackedVertex> packed;
+    const obj::Quantization q = obj::quantize( vtn, packed );
+    const std::pmr::vector<float> decoded = obj::dequantize( q, packed );
+    for ( std::size_t i = 0; i < vtn.size(); i += obj::VTN_STRIDE ) {
+        const float cos = vtn[ i + 5 ] * decoded[ i + 5 ] + vtn[ i + 6 ] * decoded[ i + 6 ] + vtn[ i + 7 ] * decoded[ i + 7 ];
+        ASSERT_GT( cos, 0.99999f ) << i / obj::VTN_STRIDE;
+    }
+}
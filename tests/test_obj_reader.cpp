@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <extra/obj_reader.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static std::pmr::vector<obj::SourceObject> readOk( std::string_view text )
+{
+    std::pmr::vector<obj::SourceObject> ret;
+    obj::ReadContext ctx{};
+    EXPECT_TRUE( obj::read( text, ret, &ctx ) ) << ctx.errorLine << " " << ctx.errorMessage;
+    return ret;
+}
+
+static constexpr std::string_view QUAD =
+    "# comment\n"
+    "mtllib quad.mtl\n"
+    "o quad\n"
+    "v 0 0 0\n"
+    "v 1 0 0\n"
+    "v 1 1 0\n"
+    "v 0 1 0\n"
+    "vt 0 0\n"
+    "vt 1 0\n"
+    "vt 1 1\n"
+    "vt 0 1\n"
+    "vn 0 0 1\n"
+    "usemtl none\n"
+    "s off\n"
+    "f 1/1/1 2/2/1 3/3/1 4/4/1\n";
+
+TEST( ObjReader, fanTriangulation )
+{
+    const auto objects = readOk( QUAD );
+    ASSERT_EQ( objects.size(), 1u );
+    EXPECT_EQ( std::string_view{ objects[ 0 ].name }, "quad" );
+    EXPECT_EQ( objects[ 0 ].vertexAssembly, obj::VertexAssembly::vtn );
+    ASSERT_EQ( objects[ 0 ].data.size(), 6u * 8u );
+
+    // corners 0 1 2, 0 2 3, y flipped
+    const float expectedX[ 6 ]{ 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f };
+    const float expectedY[ 6 ]{ -0.0f, -0.0f, -1.0f, -0.0f, -1.0f, -1.0f };
+    for ( uint32_t i = 0; i < 6; ++i ) {
+        EXPECT_EQ( objects[ 0 ].data[ i * 8 ], expectedX[ i ] );
+        EXPECT_EQ( objects[ 0 ].data[ i * 8 + 1 ], expectedY[ i ] );
+        EXPECT_TRUE( std::signbit( objects[ 0 ].data[ i * 8 + 1 ] ) );
+        EXPECT_EQ( objects[ 0 ].data[ i * 8 + 7 ], 1.0f );
+    }
+}
+
+TEST( ObjReader, negativeIndices )
+{
+    std::string text{ QUAD };
+    text.replace( text.find( "f 1/1/1 2/2/1 3/3/1 4/4/1" ), 25, "f -4/-4/-1 -3/-3/-1 -2/-2/-1 -1/-1/-1" );
+    const auto relative = readOk( text );
+    const auto absolute = readOk( QUAD );
+    ASSERT_EQ( relative.size(), 1u );
+    EXPECT_EQ( relative[ 0 ].data, absolute[ 0 ].data );
+}
+
+TEST( ObjReader, groupsPointsAndLooseVertices )
+{
+    const auto objects = readOk(
+        "g first\r\n"
+        "v 1 2 3\r\n"
+        "v 4 5 6\r\n"
+        "o points\n"
+        "p 1\n"
+        "p -1\n"
+        "o hardpoints\n"
+        "v 7 8 9\n"
+    );
+    ASSERT_EQ( objects.size(), 3u );
+    EXPECT_EQ( std::string_view{ objects[ 0 ].name }, "first" );
+    EXPECT_EQ( objects[ 0 ].vertexAssembly, obj::VertexAssembly::invalid );
+    EXPECT_EQ( objects[ 0 ].data, ( std::pmr::vector<float>{ 1.0f, -2.0f, 3.0f, 4.0f, -5.0f, 6.0f } ) );
+    EXPECT_EQ( objects[ 1 ].vertexAssembly, obj::VertexAssembly::v );
+    EXPECT_EQ( objects[ 1 ].data, ( std::pmr::vector<float>{ 1.0f, -2.0f, 3.0f, 4.0f, -5.0f, 6.0f } ) );
+    EXPECT_EQ( objects[ 2 ].data, ( std::pmr::vector<float>{ 7.0f, -8.0f, 9.0f } ) );
+}
+
+TEST( ObjReader, groupsWithinObject )
+{
+    // exporters name groups after object and material, faces stay in the object
+    std::string text{ QUAD };
+    text.insert( text.find( "usemtl none" ), "g quad_none\n" );
+    const auto grouped = readOk( text );
+    const auto plain = readOk( QUAD );
+    ASSERT_EQ( grouped.size(), 1u );
+    EXPECT_EQ( std::string_view{ grouped[ 0 ].name }, "quad" );
+    EXPECT_EQ( grouped[ 0 ].vertexAssembly, obj::VertexAssembly::vtn );
+    EXPECT_EQ( grouped[ 0 ].data, plain[ 0 ].data );
+
+    text.insert( text.find( "s off" ), "g\n" );
+    const auto bare = readOk( text );
+    ASSERT_EQ( bare.size(), 1u );
+    EXPECT_EQ( bare[ 0 ].data, plain[ 0 ].data );
+
+    // bare group before any object opens an unnamed one
+    const auto unnamed = readOk( "v 0 0 0\ng\nv 1 2 3\n" );
+    ASSERT_EQ( unnamed.size(), 1u );
+    EXPECT_EQ( std::string_view{ unnamed[ 0 ].name }, "" );
+    EXPECT_EQ( unnamed[ 0 ].data, ( std::pmr::vector<float>{ 1.0f, -2.0f, 3.0f } ) );
+}
+
+TEST( ObjReader, errors )
+{
+    auto fails = []( std::string_view text, uint32_t line )
+    {
+        std::pmr::vector<obj::SourceObject> objects;
+        obj::ReadContext ctx{};
+        EXPECT_FALSE( obj::read( text, objects, &ctx ) ) << text;
+        EXPECT_EQ( ctx.errorLine, line ) << text;
+        EXPECT_FALSE( ctx.errorMessage.empty() ) << text;
+    };
+    fails( "v 0 0 0\nf 1/1/1 1/1/1 1/1/1\n", 2 );
+    fails( "o a\nv 0 0 0\nvt 0 0\nvn 0 0 1\nf 1/1/1 1/1/1 2/1/1\n", 5 );
+    fails( "o a\nv 0 0 0\nvt 0 0\nvn 0 0 1\nf 0/1/1 1/1/1 1/1/1\n", 5 );
+    fails( "o a\nv 0 0 0\nvt 0 0\nvn 0 0 1\nf 1//1 1//1 1//1\n", 5 );
+    fails( "o a\nv 0 0 0\nvt 0 0\nvn 0 0 1\nf 1/1/1 1/1/1\n", 5 );
+    fails( "o a\nv 0 0 0\nl 1 1\n", 3 );
+    fails( "o a\nv 0 0 x\n", 2 );
+    fails( "o a\nv 0 0 0\nvt 0 0\nvn 0 0 1\np 1\nf 1/1/1 1/1/1 1/1/1\n", 6 );
+}
+
+// grid of quads, 2 triangles each
+static std::string syntheticObj( uint32_t size )
+{
+    std::string ret;
+    ret.reserve( static_cast<std::size_t>( size + 1 ) * ( size + 1 ) * 96 + static_cast<std::size_t>( size ) * size * 64 );
+    ret += "o grid\n";
+    char line[ 128 ]{};
+    for ( uint32_t y = 0; y <= size; ++y ) {
+        for ( uint32_t x = 0; x <= size; ++x ) {
+            const float fx = static_cast<float>( x ) / static_cast<float>( size );
+            const float fy = static_cast<float>( y ) / static_cast<float>( size );
+            ret.append( line, static_cast<std::size_t>( std::snprintf( line, sizeof( line ), "v %f %f %f\n", fx * 100.0f, fy * 100.0f, fx * fy ) ) );
+            ret.append( line, static_cast<std::size_t>( std::snprintf( line, sizeof( line ), "vt %f %f\n", fx, fy ) ) );
+            ret.append( line, static_cast<std::size_t>( std::snprintf( line, sizeof( line ), "vn %.4f %.4f %.4f\n", 0.0f, 0.0f, 1.0f ) ) );
+        }
+    }
+    for ( uint32_t y = 0; y < size; ++y ) {
+        for ( uint32_t x = 0; x < size; ++x ) {
+            const uint32_t a = y * ( size + 1 ) + x + 1;
+            const uint32_t b = a + 1;
+            const uint32_t c = b + size + 1;
+            const uint32_t d = a + size + 1;
+            ret.append( line, static_cast<std::size_t>( std::snprintf( line, sizeof( line ), "f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c, d, d, d ) ) );
+        }
+    }
+    return ret;
+}
+
+TEST( ObjReader, DISABLED_benchmark )
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint32_t SIZE = 708;
+    const std::string text = syntheticObj( SIZE );
+
+    std::pmr::vector<obj::SourceObject> objects;
+    const auto t0 = Clock::now();
+    ASSERT_TRUE( obj::read( text, objects ) );
+    const auto t1 = Clock::now();
+
+    ASSERT_EQ( objects.size(), 1u );
+    const std::size_t triangles = objects[ 0 ].data.size() / 24;
+    EXPECT_EQ( triangles, static_cast<std::size_t>( SIZE ) * SIZE * 2 );
+
+    const double seconds = std::max( std::chrono::duration<double>( t1 - t0 ).count(), 1e-9 );
+    RecordProperty( "parse_mib_s", std::to_string( static_cast<double>( text.size() ) / ( 1024.0 * 1024.0 ) / seconds ) );
+}
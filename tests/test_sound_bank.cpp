@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <audio/mixer.hpp>
+#include <audio/sound_bank.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static std::pmr::vector<uint8_t> makeSound( uint32_t samples, int16_t value )
+{
+    std::pmr::vector<uint8_t> ret( samples * sizeof( int16_t ) );
+    for ( uint32_t i = 0; i < samples; ++i ) {
+        std::memcpy( ret.data() + i * sizeof( int16_t ), &value, sizeof( value ) );
+    }
+    return ret;
+}
+
+TEST( SoundBank, grows_with_stable_handles )
+{
+    static constexpr uint32_t COUNT = 5000;
+    SoundBank bank{};
+    std::vector<SoundBank::Handle> handles;
+    for ( uint32_t i = 0; i < COUNT; ++i ) {
+        handles.emplace_back( bank.add( makeSound( 16 + i % 7, static_cast<int16_t>( i ) ), static_cast<uint8_t>( i % 2 ) ) );
+        ASSERT_TRUE( handles.back() );
+    }
+    auto stats = bank.statistics();
+    EXPECT_GE( stats.capacity, COUNT );
+    EXPECT_EQ( stats.sounds[ 0 ] + stats.sounds[ 1 ], COUNT );
+    uint64_t bytes[ 2 ]{};
+    for ( uint32_t i = 0; i < COUNT; ++i ) {
+        bytes[ i % 2 ] += ( 16 + i % 7 ) * sizeof( int16_t );
+    }
+    EXPECT_EQ( stats.bytes[ 0 ], bytes[ 0 ] );
+    EXPECT_EQ( stats.bytes[ 1 ], bytes[ 1 ] );
+
+    // handles stay valid while bank grows
+    for ( uint32_t i = 0; i < COUNT; ++i ) {
+        const SoundBank::Sound sound = bank.acquire( handles[ i ] );
+        ASSERT_TRUE( sound.voices );
+        ASSERT_EQ( sound.samples.size(), 16 + i % 7 );
+        ASSERT_EQ( sound.samples.front(), static_cast<int16_t>( i ) );
+        sound.voices->fetch_sub( 1 );
+    }
+
+    bank.retain( handles[ 0 ] );
+    for ( SoundBank::Handle h : handles ) {
+        bank.release( h );
+    }
+    stats = bank.statistics();
+    EXPECT_EQ( stats.sounds[ 0 ], 1u );
+    EXPECT_EQ( stats.sounds[ 1 ], 0u );
+    EXPECT_EQ( stats.bytes[ 0 ], 16u * sizeof( int16_t ) );
+    EXPECT_EQ( stats.bytes[ 1 ], 0u );
+    EXPECT_EQ( stats.retired, 0u );
+
+    // freed slots are reused without growing, old handles never alias new sounds
+    const uint32_t capacity = stats.capacity;
+    for ( uint32_t i = 1; i < COUNT; ++i ) {
+        const SoundBank::Handle h = bank.add( makeSound( 4, -1 ), 0 );
+        ASSERT_NE( h, handles[ i ] );
+    }
+    EXPECT_EQ( bank.statistics().capacity, capacity );
+    for ( uint32_t i = 1; i < COUNT; ++i ) {
+        ASSERT_FALSE( bank.acquire( handles[ i ] ).voices );
+    }
+    EXPECT_TRUE( bank.acquire( handles[ 0 ] ).voices );
+}
+
+TEST( SoundBank, reclaims_after_voices_finish )
+{
+    SoundBank bank{};
+    Mixer mixer{};
+    const std::vector<float> gain{ 1.0f };
+    const SoundBank::Handle h = bank.add( makeSound( 3000, 1000 ), 0 );
+
+    for ( uint32_t i = 0; i < 2; ++i ) {
+        const SoundBank::Sound sound = bank.acquire( h );
+        mixer.play( sound.samples, 0, 0, sound.voices );
+    }
+    std::vector<int16_t> out( 1000 );
+    mixer.mix( out, gain );
+    EXPECT_EQ( out.back(), 2000 );
+
+    // unloaded while playing, samples stay alive
+    bank.release( h );
+    EXPECT_FALSE( bank.acquire( h ).voices );
+    EXPECT_EQ( bank.collect(), 0u );
+    EXPECT_EQ( bank.statistics().retired, 1u );
+    EXPECT_EQ( bank.statistics().bytes[ 0 ], 3000u * sizeof( int16_t ) );
+    mixer.mix( out, gain );
+    EXPECT_EQ( out.back(), 2000 );
+
+    mixer.mix( out, gain );
+    mixer.mix( out, gain );
+    EXPECT_EQ( out.back(), 0 );
+    EXPECT_EQ( bank.collect(), 1u );
+    EXPECT_EQ( bank.statistics().retired, 0u );
+    EXPECT_EQ( bank.statistics().bytes[ 0 ], 0u );
+}
+
+TEST( SoundBank, stress_load_play_unload )
+{
+    static constexpr uint32_t ROUNDS = 20;
+    static constexpr uint32_t SOUNDS = 500;
+    SoundBank bank{};
+    Mixer mixer{};
+
+    std::atomic<bool> quit = false;
+    std::thread audioThread{ [&]()
+    {
+        const std::vector<float> gain{ 1.0f };
+        std::vector<int16_t> out( 512 * 2 );
+        while ( !quit.load() ) {
+            mixer.mix( out, gain );
+        }
+    } };
+
+    std::vector<SoundBank::Handle> handles;
+    uint32_t peakCapacity = 0;
+    for ( uint32_t round = 0; round < ROUNDS; ++round ) {
+        for ( uint32_t i = 0; i < SOUNDS; ++i ) {
+            handles.emplace_back( bank.add( makeSound( 256 + i, 100 ), static_cast<uint8_t>( i % SoundBank::MAX_CHANNELS ) ) );
+        }
+        for ( uint32_t i = 0; i < SOUNDS; i += 3 ) {
+            const SoundBank::Sound sound = bank.acquire( handles[ i ] );
+            mixer.play( sound.samples, 0, 0, sound.voices );
+        }
+        // unload everything, including sounds which are still playing
+        for ( SoundBank::Handle h : handles ) {
+            bank.release( h );
+        }
+        handles.clear();
+        peakCapacity = std::max( peakCapacity, bank.statistics().capacity );
+    }
+    // drain remaining voices
+    while ( mixer.statistics().voices || bank.statistics().retired ) {
+        std::this_thread::yield();
+        bank.collect();
+    }
+    quit.store( true );
+    audioThread.join();
+
+    const auto stats = bank.statistics();
+    for ( uint32_t c = 0; c < SoundBank::MAX_CHANNELS; ++c ) {
+        EXPECT_EQ( stats.bytes[ c ], 0u ) << c;
+        EXPECT_EQ( stats.sounds[ c ], 0u ) << c;
+    }
+    // retired sounds do not keep their slots once reclaimed
+    EXPECT_LT( peakCapacity, SOUNDS * 2 );
+}
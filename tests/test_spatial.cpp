@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <audio/spatial.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+TEST( Spatial, attenuation_curves )
+{
+    Spatial::Emitter e{
+        .minDistance = 10.0f,
+        .maxDistance = 110.0f,
+    };
+    for ( Spatial::Curve curve : { Spatial::Curve::eInverse, Spatial::Curve::eLinear, Spatial::Curve::eExponential } ) {
+        e.curve = curve;
+        EXPECT_EQ( Spatial::attenuation( e, 0.0f ), 1.0f );
+        EXPECT_EQ( Spatial::attenuation( e, 10.0f ), 1.0f );
+        EXPECT_EQ( Spatial::attenuation( e, 110.0f ), 0.0f );
+        EXPECT_EQ( Spatial::attenuation( e, 500.0f ), 0.0f );
+        float prev = 1.0f;
+        for ( float d = 11.0f; d < 110.0f; d += 1.0f ) {
+            const float g = Spatial::attenuation( e, d );
+            ASSERT_LT( g, prev ) << d;
+            ASSERT_GT( g, 0.0f ) << d;
+            prev = g;
+        }
+    }
+    e.curve = Spatial::Curve::eInverse;
+    EXPECT_FLOAT_EQ( Spatial::attenuation( e, 20.0f ), 0.5f );
+    e.curve = Spatial::Curve::eLinear;
+    EXPECT_FLOAT_EQ( Spatial::attenuation( e, 60.0f ), 0.5f );
+    e.curve = Spatial::Curve::eExponential;
+    e.rolloff = 2.0f;
+    EXPECT_FLOAT_EQ( Spatial::attenuation( e, 20.0f ), 0.25f );
+}
+
+TEST( Spatial, pan )
+{
+    // looking down -z, right is +x
+    const Spatial::Listener listener{ .position{ 1.0f, 2.0f, 3.0f } };
+    Spatial::Emitter e{
+        .minDistance = 1.0f,
+        .maxDistance = 100.0f,
+    };
+
+    e.position = listener.position + math::vec3{ 0.0f, 0.0f, -2.0f };
+    Spatial s = Spatial::compute( listener, e );
+    EXPECT_FLOAT_EQ( s.left, 0.5f );
+    EXPECT_FLOAT_EQ( s.right, 0.5f );
+    EXPECT_FLOAT_EQ( s.pitch, 1.0f );
+
+    e.position = listener.position + math::vec3{ 2.0f, 0.0f, 0.0f };
+    s = Spatial::compute( listener, e );
+    EXPECT_NEAR( s.left, 0.0f, 1e-6f );
+    EXPECT_FLOAT_EQ( s.right, 0.5f );
+
+    e.position = listener.position + math::vec3{ -2.0f, 0.0f, 0.0f };
+    s = Spatial::compute( listener, e );
+    EXPECT_FLOAT_EQ( s.left, 0.5f );
+    EXPECT_NEAR( s.right, 0.0f, 1e-6f );
+
+    // front right, nearer side stays at full gain
+    e.position = listener.position + math::vec3{ 2.0f, 0.0f, -2.0f };
+    s = Spatial::compute( listener, e );
+    EXPECT_GT( s.left, 0.0f );
+    EXPECT_LT( s.left, s.right );
+
+    // inside minDistance pan collapses towards center
+    e.position = listener.position + math::vec3{ 0.25f, 0.0f, 0.0f };
+    s = Spatial::compute( listener, e );
+    EXPECT_FLOAT_EQ( s.right, 1.0f );
+    EXPECT_GT( s.left, 0.7f );
+    e.position = listener.position;
+    s = Spatial::compute( listener, e );
+    EXPECT_EQ( s.left, 1.0f );
+    EXPECT_EQ( s.right, 1.0f );
+
+    // listener rolled upside down swaps sides
+    const Spatial::Listener flipped{ .position = listener.position, .up{ 0.0f, -1.0f, 0.0f } };
+    e.position = listener.position + math::vec3{ 2.0f, 0.0f, 0.0f };
+    s = Spatial::compute( flipped, e );
+    EXPECT_FLOAT_EQ( s.left, 0.5f );
+    EXPECT_NEAR( s.right, 0.0f, 1e-6f );
+}
+
+TEST( Spatial, doppler )
+{
+    static constexpr float C = 340.0f;
+    const Spatial::Listener listener{ .speedOfSound = C };
+    Spatial::Emitter e{
+        .position{ 0.0f, 0.0f, -50.0f },
+        .minDistance = 1.0f,
+        .maxDistance = 1000.0f,
+    };
+
+    e.velocity = math::vec3{ 0.0f, 0.0f, 34.0f };
+    EXPECT_FLOAT_EQ( Spatial::compute( listener, e ).pitch, C / ( C - 34.0f ) );
+    e.velocity = math::vec3{ 0.0f, 0.0f, -34.0f };
+    EXPECT_FLOAT_EQ( Spatial::compute( listener, e ).pitch, C / ( C + 34.0f ) );
+    // perpendicular motion does not shift pitch
+    e.velocity = math::vec3{ 100.0f, 0.0f, 0.0f };
+    EXPECT_FLOAT_EQ( Spatial::compute( listener, e ).pitch, 1.0f );
+
+    // listener and source flying in formation
+    Spatial::Listener moving = listener;
+    moving.velocity = math::vec3{ 0.0f, 0.0f, -100.0f };
+    e.velocity = moving.velocity;
+    EXPECT_FLOAT_EQ( Spatial::compute( moving, e ).pitch, 1.0f );
+
+    // supersonic is clamped
+    e.velocity = math::vec3{ 0.0f, 0.0f, 10.0f * C };
+    const float pitch = Spatial::compute( listener, e ).pitch;
+    EXPECT_GE( pitch, Spatial::MIN_PITCH );
+    EXPECT_LE( pitch, Spatial::MAX_PITCH );
+    EXPECT_TRUE( std::isfinite( pitch ) );
+
+    moving.speedOfSound = 0.0f;
+    EXPECT_EQ( Spatial::compute( moving, e ).pitch, 1.0f );
+}
+
+TEST( Spatial, culls_distant_battle )
+{
+    static constexpr uint32_t COUNT = 10000;
+    static constexpr float RADIUS = 3000.0f;
+    const Spatial::Listener listener{};
+    std::mt19937 gen{ 42 };
+    std::uniform_real_distribution<float> dist{ -RADIUS, RADIUS };
+
+    uint32_t audible = 0;
+    uint32_t inRange = 0;
+    for ( uint32_t i = 0; i < COUNT; ++i ) {
+        const Spatial::Emitter e{
+            .position{ dist( gen ), dist( gen ), dist( gen ) },
+            .minDistance = 30.0f,
+            .maxDistance = 1500.0f,
+        };
+        inRange += math::length( e.position ) < e.maxDistance;
+        const Spatial s = Spatial::compute( listener, e );
+        if ( !s.audible() ) {
+            ASSERT_LT( std::max( s.left, s.right ), Spatial::CULL_GAIN );
+            continue;
+        }
+        audible++;
+    }
+    EXPECT_EQ( audible, inRange );
+    EXPECT_LT( audible, COUNT / 4 );
+}
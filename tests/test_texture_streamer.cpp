@@ -0,0 +1,282 @@
+#include <gtest/gtest.h>
+
+#include <engine/filesystem.hpp>
+#include <engine/texture_streamer.hpp>
+#include <renderer/renderer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Records texture uploads instead of talking to a device.
+class TextureRecorder : public Renderer {
+public:
+    struct Upload {
+        TextureCreateInfo tci{};
+        std::vector<uint8_t> data{};
+    };
+    std::map<Texture, Upload> m_textures{};
+    Texture m_next = 1;
+
+    virtual bool featureAvailable( Feature ) const override { return false; }
+    virtual void setFeatureEnabled( Feature, bool ) override {}
+    virtual void setVSync( VSync ) override {}
+    virtual PipelineSlot createPipeline( const PipelineCreateInfo& ) override { return 0; }
+    virtual void replacePipeline( PipelineSlot, const PipelineCreateInfo& ) override {}
+    virtual Buffer createBuffer( std::span<const uint8_t> ) override { return {}; }
+    virtual void deleteBuffer( Buffer ) override {}
+    virtual Texture createTexture( const TextureCreateInfo& tci, std::span<const uint8_t> data ) override
+    {
+        return replaceTexture( m_next++, tci, data );
+    }
+    virtual void deleteTexture( Texture t ) override { m_textures.erase( t ); }
+    virtual Texture replaceTexture( Texture t, const TextureCreateInfo& tci, std::span<const uint8_t> data ) override
+    {
+        m_textures[ t ] = Upload{ tci, { data.begin(), data.end() } };
+        return t;
+    }
+    virtual void render( const RenderInfo& ) override {}
+    virtual void dispatch( const DispatchInfo& ) override {}
+    virtual RecordingContext* beginRecording( uint32_t ) override { return this; }
+    virtual void endRecording( RecordingContext* ) override {}
+    virtual void setResolution( uint32_t, uint32_t ) override {}
+    virtual void beginGpuScope( std::string_view ) override {}
+    virtual void endGpuScope() override {}
+    virtual bool gpuTimings( std::pmr::vector<GpuScopeTiming>& ) override { return false; }
+    virtual Statistics statistics() const override { return {}; }
+    virtual void beginFrame() override {}
+    virtual void endFrame() override {}
+    virtual void present() override {}
+};
+
+// BC1 sized mip chain, every byte holds its mip level
+static std::vector<uint8_t> mipChain( TextureCreateInfo& tci, uint32_t size )
+{
+    tci = TextureCreateInfo{
+        .width = size,
+        .height = size,
+        .mip0ByteCount = size * size / 2,
+        .format = TextureFormat::eBC1_unorm,
+    };
+    std::vector<uint8_t> ret;
+    uint32_t level = 0;
+    for ( uint32_t s = size; s >= 4; s /= 2, level++ ) {
+        ret.insert( ret.end(), s * s / 2, static_cast<uint8_t>( level ) );
+    }
+    tci.mips = level;
+    return ret;
+}
+
+static void frame( TextureStreamer& streamer )
+{
+    streamer.update();
+    streamer.flush();
+}
+
+TEST( TextureStreamer, mip_for_extent )
+{
+    TextureCreateInfo tci{};
+    const auto data = mipChain( tci, 1024 );
+    EXPECT_EQ( tci.mips, 9u );
+    EXPECT_EQ( TextureStreamer::mipForExtent( tci, 2048.0f ), 0u );
+    EXPECT_EQ( TextureStreamer::mipForExtent( tci, 1024.0f ), 0u );
+    EXPECT_EQ( TextureStreamer::mipForExtent( tci, 1000.0f ), 0u );
+    EXPECT_EQ( TextureStreamer::mipForExtent( tci, 512.0f ), 1u );
+    EXPECT_EQ( TextureStreamer::mipForExtent( tci, 100.0f ), 3u );
+    EXPECT_EQ( TextureStreamer::mipForExtent( tci, 0.0f ), 8u );
+    EXPECT_EQ( TextureStreamer::chainBytes( tci, 0 ), data.size() );
+}
+
+TEST( TextureStreamer, registers_tail_and_streams_on_request )
+{
+    TextureRecorder renderer{};
+    TextureStreamer streamer{ &renderer, 64ull << 20 };
+    TextureCreateInfo tci{};
+    const auto data = mipChain( tci, 1024 );
+
+    const Texture tex = streamer.add( tci, data );
+    ASSERT_EQ( renderer.m_textures.size(), 1u );
+    // 64x64 and smaller
+    EXPECT_EQ( renderer.m_textures[ tex ].tci.width, TextureStreamer::TAIL_EXTENT );
+    EXPECT_EQ( renderer.m_textures[ tex ].data.front(), 4 );
+    EXPECT_EQ( streamer.statistics().residentBytes, TextureStreamer::chainBytes( tci, 4 ) );
+
+    streamer.request( tex, 256.0f );
+    frame( streamer );
+    frame( streamer );
+    EXPECT_EQ( renderer.m_textures[ tex ].tci.width, 256u );
+    EXPECT_EQ( renderer.m_textures[ tex ].tci.mips, 7u );
+    EXPECT_EQ( renderer.m_textures[ tex ].data.front(), 2 );
+    EXPECT_EQ( renderer.m_textures[ tex ].data.size(), TextureStreamer::chainBytes( tci, 2 ) );
+
+    streamer.request( tex, 1024.0f );
+    frame( streamer );
+    frame( streamer );
+    const auto stats = streamer.statistics();
+    EXPECT_EQ( renderer.m_textures[ tex ].data, data );
+    EXPECT_EQ( stats.fullyResident, 1u );
+    EXPECT_EQ( stats.streamedIn, 2u );
+    EXPECT_EQ( stats.residentBytes, data.size() );
+    EXPECT_EQ( stats.pendingUploads, 0u );
+}
+
+TEST( TextureStreamer, budget_evicts_least_recently_used )
+{
+    static constexpr uint32_t COUNT = 8;
+    TextureRecorder renderer{};
+    TextureCreateInfo tci{};
+    const auto data = mipChain( tci, 512 );
+    const uint64_t full = TextureStreamer::chainBytes( tci, 0 );
+    const uint64_t tail = TextureStreamer::chainBytes( tci, 3 );
+    // tails of all and two full chains
+    TextureStreamer streamer{ &renderer, tail * COUNT + ( full - tail ) * 2 };
+
+    std::vector<Texture> textures;
+    for ( uint32_t i = 0; i < COUNT; ++i ) {
+        textures.emplace_back( streamer.add( tci, data ) );
+    }
+    // each texture gets its turn on screen for few frames
+    for ( uint32_t i = 0; i < COUNT; ++i ) {
+        for ( uint32_t f = 0; f < 3; ++f ) {
+            streamer.request( textures[ i ], 512.0f );
+            frame( streamer );
+        }
+        const auto stats = streamer.statistics();
+        EXPECT_LE( stats.committedBytes, stats.budgetBytes );
+        EXPECT_LE( stats.residentBytes, stats.budgetBytes );
+        EXPECT_EQ( renderer.m_textures[ textures[ i ] ].tci.width, 512u );
+    }
+    // most recently used ones survive
+    EXPECT_EQ( renderer.m_textures[ textures[ COUNT - 1 ] ].tci.width, 512u );
+    EXPECT_EQ( renderer.m_textures[ textures[ COUNT - 2 ] ].tci.width, 512u );
+    EXPECT_EQ( renderer.m_textures[ textures[ 0 ] ].tci.width, TextureStreamer::TAIL_EXTENT );
+
+    const auto stats = streamer.statistics();
+    EXPECT_EQ( stats.fullyResident, 2u );
+    EXPECT_EQ( stats.streamedIn, COUNT );
+    EXPECT_GT( stats.evicted, 0u );
+
+    // requests not fitting within budget are served with coarser mips
+    streamer.setBudget( tail * COUNT + ( full - tail ) / 2 );
+    for ( uint32_t f = 0; f < 3; ++f ) {
+        streamer.request( textures[ 0 ], 512.0f );
+        frame( streamer );
+    }
+    EXPECT_EQ( renderer.m_textures[ textures[ 0 ] ].tci.width, 256u );
+    EXPECT_EQ( streamer.statistics().fullyResident, 0u );
+    EXPECT_GT( streamer.statistics().overBudget, 0u );
+}
+
+TEST( TextureStreamer, reload_keeps_handle )
+{
+    TextureRecorder renderer{};
+    TextureStreamer streamer{ &renderer, 64ull << 20 };
+    TextureCreateInfo tci{};
+    const auto data = mipChain( tci, 256 );
+    const Texture tex = streamer.add( tci, data );
+    streamer.request( tex, 256.0f );
+    frame( streamer );
+    frame( streamer );
+    EXPECT_EQ( streamer.statistics().fullyResident, 1u );
+
+    TextureCreateInfo tci2{};
+    const auto data2 = mipChain( tci2, 128 );
+    EXPECT_EQ( streamer.add( tci2, data2, tex ), tex );
+    EXPECT_EQ( renderer.m_textures[ tex ].tci.width, TextureStreamer::TAIL_EXTENT );
+    EXPECT_EQ( streamer.statistics().textures, 1u );
+    EXPECT_EQ( streamer.statistics().residentBytes, TextureStreamer::chainBytes( tci2, 1 ) );
+}
+
+TEST( TextureStreamer, reload_finishes_reads_of_previous_data )
+{
+    static constexpr uint32_t COUNT = 8;
+    TextureRecorder renderer{};
+    TextureStreamer streamer{ &renderer, 256ull << 20 };
+    TextureCreateInfo tci{};
+    std::vector<std::unique_ptr<std::vector<uint8_t>>> previous;
+    std::vector<Texture> textures;
+    for ( uint32_t i = 0; i < COUNT; ++i ) {
+        previous.emplace_back( std::make_unique<std::vector<uint8_t>>( mipChain( tci, 2048 ) ) );
+        textures.emplace_back( streamer.add( tci, *previous.back() ) );
+    }
+    auto data = mipChain( tci, 2048 );
+    std::ranges::for_each( data, []( uint8_t& b ) { b += 16; } );
+
+    // reads of full chains are queued behind each other, last one is reloaded before it completes
+    std::ranges::for_each( textures, [&streamer]( Texture t ) { streamer.request( t, 2048.0f ); } );
+    streamer.update();
+    const Texture tex = textures.back();
+    EXPECT_EQ( streamer.add( tci, data, tex ), tex );
+    previous.back().reset();
+
+    // other chains are uploaded over few frames within upload limit
+    for ( uint32_t f = 0; f < 4; ++f ) {
+        streamer.request( tex, 2048.0f );
+        frame( streamer );
+    }
+    EXPECT_EQ( renderer.m_textures[ tex ].data, data );
+    EXPECT_EQ( renderer.m_textures[ textures.front() ].data, *previous.front() );
+}
+
+TEST( TextureStreamer, filesystem_reloads_twice_with_read_in_flight )
+{
+#if defined( __linux__ )
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint32_t COUNT = 8;
+    const auto root = std::filesystem::temp_directory_path() / "test_texture_streamer_reload";
+    std::filesystem::remove_all( root );
+    std::filesystem::create_directories( root / "textures" );
+    TextureCreateInfo tci{};
+    auto data = mipChain( tci, 2048 );
+    auto write = [&root, &data]( uint8_t version )
+    {
+        std::ranges::for_each( data, [version]( uint8_t& b ) { b = static_cast<uint8_t>( ( b & 15 ) + version * 16 ); } );
+        std::ofstream ofs( root / "textures/tex.bin", std::ios::binary );
+        ofs.write( reinterpret_cast<const char*>( data.data() ), static_cast<std::streamsize>( data.size() ) );
+    };
+    write( 0 );
+
+    TextureRecorder renderer{};
+    TextureStreamer streamer{ &renderer, 256ull << 20 };
+    Filesystem fs{};
+    fs.mountLoose( root );
+    const Texture tex = streamer.add( tci, fs.viewWait( "textures/tex.bin" ) );
+    fs.setCallback( ".bin", [&streamer, &tci, tex]( Asset&& a ) { EXPECT_EQ( streamer.add( tci, a.data, tex ), tex ); } );
+    // reads of these are queued ahead of the reloaded one
+    const std::vector<uint8_t> other = mipChain( tci, 2048 );
+    std::vector<Texture> textures;
+    for ( uint32_t i = 1; i < COUNT; ++i ) {
+        textures.emplace_back( streamer.add( tci, other ) );
+    }
+    textures.emplace_back( tex );
+
+    // second reload releases data of first one, which the streamer is reading meanwhile
+    for ( uint8_t version = 1; version <= 2; ++version ) {
+        write( version );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+        std::ranges::for_each( textures, [&streamer]( Texture t ) { streamer.request( t, 2048.0f ); } );
+        streamer.update();
+        const auto deadline = Clock::now() + std::chrono::seconds( 5 );
+        uint32_t reloaded = 0;
+        while ( !reloaded && Clock::now() < deadline ) {
+            reloaded = fs.processReloads();
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+        ASSERT_EQ( reloaded, 1u );
+    }
+    EXPECT_EQ( fs.statistics().snapshots, 1u );
+
+    for ( uint32_t f = 0; f < 4; ++f ) {
+        streamer.request( tex, 2048.0f );
+        frame( streamer );
+    }
+    EXPECT_EQ( renderer.m_textures[ tex ].data, data );
+    std::filesystem::remove_all( root );
+#endif
+}
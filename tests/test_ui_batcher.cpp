@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <ui/batcher.hpp>
+#include <ui/pipeline.hpp>
+
+#include <renderer/renderer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+static constexpr PipelineSlot BATCH = 1;
+static constexpr PipelineSlot SPRITE = 2;
+static constexpr PipelineSlot SPRITE_COLORS = 3;
+static constexpr PipelineSlot GLOW = 4;
+static constexpr PipelineSlot BLUR = 5;
+
+// Every quad as it would end up in clip space, so batched and direct draws can be compared.
+struct Quad {
+    PipelineSlot pipeline{};
+    math::vec4 corners{};
+    math::vec4 uvwh{};
+    math::vec4 color{};
+    Texture texture{};
+    uint32_t sampleRGBA = 0;
+};
+
+class ExpandingContext : public RecordingContext {
+public:
+    std::vector<Quad> m_quads{};
+    uint32_t m_draws = 0;
+    uint32_t m_dispatches = 0;
+
+    template <typename TInstance>
+    void expand( const RenderInfo& ri, const math::mat4& mvp, const TInstance& instance, math::vec4 color )
+    {
+        const math::vec4 a = mvp * math::vec4{ instance.m_xywh.x, instance.m_xywh.y, 0.0f, 1.0f };
+        const math::vec4 b = mvp * math::vec4{ instance.m_xywh.x + instance.m_xywh.z, instance.m_xywh.y + instance.m_xywh.w, 0.0f, 1.0f };
+        m_quads.emplace_back( Quad{
+            .pipeline = SPRITE,
+            .corners{ a.x, a.y, b.x, b.y },
+            .uvwh = instance.m_uvwh,
+            .color = color,
+            .texture = ri.m_fragmentTexture[ instance.m_whichAtlas ],
+            .sampleRGBA = instance.m_sampleRGBA,
+        } );
+    }
+
+    virtual void render( const RenderInfo& ri ) override
+    {
+        m_draws++;
+        switch ( ri.m_pipeline ) {
+        case SPRITE: {
+            const auto& pc = *reinterpret_cast<const ui::PushConstant<ui::Pipeline::eSpriteSequence>*>( ri.m_uniform.ptr );
+            const math::mat4 mvp = pc.m_projection * pc.m_view * pc.m_model;
+            for ( uint32_t i = 0; i < ri.m_instanceCount; ++i ) expand( ri, mvp, pc.m_instances[ i ], pc.m_color );
+        } break;
+        case SPRITE_COLORS: {
+            const auto& pc = *reinterpret_cast<const ui::PushConstant<ui::Pipeline::eSpriteSequenceColors>*>( ri.m_uniform.ptr );
+            const math::mat4 mvp = pc.m_projection * pc.m_view * pc.m_model;
+            for ( uint32_t i = 0; i < ri.m_instanceCount; ++i ) expand( ri, mvp, pc.m_instances[ i ], pc.m_instances[ i ].m_color );
+        } break;
+        case BATCH: {
+            using Batch = ui::PushConstant<ui::Pipeline::eSpriteBatch>;
+            EXPECT_LE( ri.m_instanceCount, Batch::INSTANCES );
+            EXPECT_EQ( ri.m_uniform.size, offsetof( Batch, m_instances ) + ri.m_instanceCount * sizeof( Batch::Instance ) );
+            const auto& pc = *reinterpret_cast<const Batch*>( ri.m_uniform.ptr );
+            for ( uint32_t i = 0; i < ri.m_instanceCount; ++i ) expand( ri, pc.m_projection, pc.m_instances[ i ], pc.m_instances[ i ].m_color );
+        } break;
+        default:
+            m_quads.emplace_back( Quad{ .pipeline = ri.m_pipeline } );
+            break;
+        }
+    }
+
+    virtual void dispatch( const DispatchInfo& di ) override
+    {
+        m_dispatches++;
+        m_quads.emplace_back( Quad{ .pipeline = di.m_pipeline } );
+    }
+};
+
+// Widgets of a menu: labels, spin box arrows, glow, blur of message box and a rotated sprite, over more atlases
+// and more quads than fit in single batch.
+static void drawMenu( RecordingContext* rc )
+{
+    const math::mat4 projection = math::ortho( 0.0f, 1280.0f, 0.0f, 720.0f, -1.0f, 1.0f );
+    const math::mat4 view = math::translate( math::mat4{ 1.0f }, math::vec3{ 7.0f, 3.0f, 0.0f } );
+
+    RenderInfo glow{ .m_pipeline = GLOW, .m_verticeCount = 4 };
+    rc->render( glow );
+
+    for ( uint32_t w = 0; w < 24; ++w ) {
+        const math::mat4 model = math::translate( math::mat4{ 1.0f }, math::vec3{ 10.0f * w, 20.0f * w, 0.0f } );
+        if ( w % 3 ) {
+            ui::PushConstant<ui::Pipeline::eSpriteSequence> pc{
+                .m_model = model,
+                .m_view = view,
+                .m_projection = projection,
+                .m_color{ 0.1f * w, 1.0f, 0.5f, 1.0f },
+            };
+            RenderInfo ri{ .m_pipeline = SPRITE, .m_verticeCount = 4, .m_instanceCount = pc.INSTANCES };
+            ri.m_fragmentTexture[ 0 ] = 100 + w % 12;
+            for ( uint32_t i = 0; i < pc.INSTANCES; ++i ) {
+                pc.m_instances[ i ] = { .m_xywh{ 8.0f * i, 0.0f, 8.0f, 16.0f }, .m_uvwh{ 0.01f * i, 0.0f, 0.01f, 0.02f } };
+            }
+            ri.m_uniform = pc;
+            rc->render( ri );
+            continue;
+        }
+        ui::PushConstant<ui::Pipeline::eSpriteSequenceColors> pc{
+            .m_model = model,
+            .m_view = view,
+            .m_projection = projection,
+        };
+        RenderInfo ri{ .m_pipeline = SPRITE_COLORS, .m_verticeCount = 4, .m_instanceCount = 40 };
+        ri.m_fragmentTexture[ 0 ] = 100;
+        ri.m_fragmentTexture[ 1 ] = 200 + w;
+        for ( uint32_t i = 0; i < ri.m_instanceCount; ++i ) {
+            pc.m_instances[ i ] = {
+                .m_color{ 1.0f, 0.0f, 0.01f * i, 1.0f },
+                .m_xywh{ 4.0f * i, 2.0f * i, 32.0f, 32.0f },
+                .m_uvwh{ 0.5f, 0.5f, 0.25f, 0.25f },
+                .m_whichAtlas = i & 1,
+                .m_sampleRGBA = 1,
+            };
+        }
+        ri.m_uniform = pc;
+        rc->render( ri );
+    }
+
+    ui::PushConstant<ui::Pipeline::eSpriteSequence> rotated{
+        .m_model = math::mat4{ 1.0f },
+        .m_view = view,
+        .m_projection = projection,
+    };
+    rotated.m_model[ 0 ] = math::vec4{ 0.0f, 1.0f, 0.0f, 0.0f };
+    rotated.m_model[ 1 ] = math::vec4{ -1.0f, 0.0f, 0.0f, 0.0f };
+    rotated.m_instances[ 0 ] = { .m_xywh{ 1.0f, 2.0f, 3.0f, 4.0f } };
+    RenderInfo ri{ .m_pipeline = SPRITE, .m_verticeCount = 4, .m_instanceCount = 1 };
+    ri.m_uniform = rotated;
+    rc->render( ri );
+
+    DispatchInfo blur{ .m_pipeline = BLUR };
+    rc->dispatch( blur );
+    rc->render( glow );
+}
+
+TEST( UiBatcher, preserves_painters_order )
+{
+    ExpandingContext direct{};
+    drawMenu( &direct );
+
+    ExpandingContext batched{};
+    ui::Batcher batcher{ ui::Batcher::Pipelines{ .batch = BATCH, .spriteSequence = SPRITE, .spriteSequenceColors = SPRITE_COLORS } };
+    batcher.begin( &batched );
+    drawMenu( &batcher );
+    batcher.end();
+
+    ASSERT_EQ( direct.m_quads.size(), batched.m_quads.size() );
+    for ( size_t i = 0; i < direct.m_quads.size(); ++i ) {
+        const Quad& a = direct.m_quads[ i ];
+        const Quad& b = batched.m_quads[ i ];
+        ASSERT_EQ( a.pipeline, b.pipeline ) << i;
+        ASSERT_EQ( a.texture, b.texture ) << i;
+        ASSERT_EQ( a.sampleRGBA, b.sampleRGBA ) << i;
+        ASSERT_EQ( a.uvwh, b.uvwh ) << i;
+        ASSERT_EQ( a.color, b.color ) << i;
+        for ( int c = 0; c < 4; ++c ) {
+            ASSERT_NEAR( a.corners[ c ], b.corners[ c ], 1e-5f ) << i;
+        }
+    }
+    EXPECT_EQ( direct.m_dispatches, batched.m_dispatches );
+    EXPECT_EQ( batcher.submitted(), batched.m_draws );
+    EXPECT_LT( batched.m_draws, direct.m_draws );
+}
+
+TEST( UiBatcher, flushes_on_full_batch_and_atlas_table )
+{
+    using Batch = ui::PushConstant<ui::Pipeline::eSpriteBatch>;
+    const math::mat4 projection = math::ortho( 0.0f, 1280.0f, 0.0f, 720.0f, -1.0f, 1.0f );
+    ExpandingContext ctx{};
+    ui::Batcher batcher{ ui::Batcher::Pipelines{ .batch = BATCH, .spriteSequence = SPRITE, .spriteSequenceColors = SPRITE_COLORS } };
+    batcher.begin( &ctx );
+
+    ui::PushConstant<ui::Pipeline::eSpriteSequence> pc{
+        .m_model = math::mat4{ 1.0f },
+        .m_view = math::mat4{ 1.0f },
+        .m_projection = projection,
+    };
+    RenderInfo ri{ .m_pipeline = SPRITE, .m_verticeCount = 4, .m_instanceCount = pc.INSTANCES };
+    ri.m_uniform = pc;
+    // single atlas, exactly one full batch
+    for ( uint32_t i = 0; i < Batch::INSTANCES / pc.INSTANCES; ++i ) batcher.render( ri );
+    ri.m_instanceCount = Batch::INSTANCES % pc.INSTANCES;
+    batcher.render( ri );
+    EXPECT_EQ( ctx.m_draws, 0u );
+    ri.m_instanceCount = 1;
+    batcher.render( ri );
+    EXPECT_EQ( ctx.m_draws, 1u );
+    batcher.flush();
+    EXPECT_EQ( ctx.m_draws, 2u );
+
+    // tenth distinct atlas does not fit texture table
+    for ( Texture t = 1; t <= RenderInfo::MAX_TEXTURES + 1; ++t ) {
+        ri.m_fragmentTexture[ 0 ] = t;
+        batcher.render( ri );
+    }
+    EXPECT_EQ( ctx.m_draws, 3u );
+    batcher.flush();
+    EXPECT_EQ( ctx.m_draws, 4u );
+
+    // different projection starts new batch
+    batcher.render( ri );
+    pc.m_projection = math::ortho( 0.0f, 1920.0f, 0.0f, 720.0f, -1.0f, 1.0f );
+    ri.m_uniform = pc;
+    batcher.render( ri );
+    batcher.end();
+    EXPECT_EQ( ctx.m_draws, 6u );
+    EXPECT_EQ( batcher.submitted(), 6u );
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <ui/lockit.hpp>
+
+#include <extra/lang.hpp>
+#include <shared/hash.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+struct Table {
+    std::pmr::vector<lang::KeyType> keys{};
+    std::pmr::u32string strings{};
+    std::pmr::vector<std::string> names{};
+};
+
+static Table makeTable( uint32_t count )
+{
+    Table ret{};
+    for ( uint32_t i = 0; i < count; ++i ) {
+        const std::string name = "key_" + std::to_string( i );
+        const std::string value = "value of " + name;
+        ret.keys.emplace_back( Hash{}( name ), static_cast<uint32_t>( ret.strings.size() ), static_cast<uint32_t>( value.size() ) );
+        ret.strings.append( value.begin(), value.end() );
+        ret.strings.push_back( 0 );
+        ret.names.emplace_back( name );
+    }
+    return ret;
+}
+
+static std::pmr::vector<uint8_t> cook( Table table )
+{
+    std::pmr::vector<uint32_t> seeds{};
+    EXPECT_TRUE( lang::perfectHash( table.keys, seeds ) );
+    const lang::Header header{
+        .id = "en",
+        .count = static_cast<uint32_t>( table.keys.size() ),
+        .string = static_cast<uint32_t>( table.strings.size() ),
+        .buckets = static_cast<uint32_t>( seeds.size() ),
+    };
+    std::pmr::vector<uint8_t> ret( sizeof( header ) + seeds.size() * sizeof( uint32_t ) + table.keys.size() * sizeof( lang::KeyType ) + table.strings.size() * sizeof( char32_t ) );
+    uint8_t* ptr = ret.data();
+    std::memcpy( ptr, &header, sizeof( header ) );
+    ptr += sizeof( header );
+    std::memcpy( ptr, seeds.data(), seeds.size() * sizeof( uint32_t ) );
+    ptr += seeds.size() * sizeof( uint32_t );
+    std::memcpy( ptr, table.keys.data(), table.keys.size() * sizeof( lang::KeyType ) );
+    ptr += table.keys.size() * sizeof( lang::KeyType );
+    std::memcpy( ptr, table.strings.data(), table.strings.size() * sizeof( char32_t ) );
+    return ret;
+}
+
+TEST( UiLockit, finds_every_key )
+{
+    for ( uint32_t count : { 1u, 2u, 49u, 1000u } ) {
+        const Table table = makeTable( count );
+        const std::pmr::vector<uint8_t> data = cook( table );
+        const ui::Lockit lockit{ data };
+        for ( uint32_t i = 0; i < count; ++i ) {
+            const std::string expected = "value of " + table.names[ i ];
+            const std::u32string_view value = lockit.find( Hash{}( table.names[ i ] ) );
+            ASSERT_EQ( value.size(), expected.size() ) << table.names[ i ];
+            EXPECT_TRUE( std::ranges::equal( value, expected ) ) << table.names[ i ];
+            EXPECT_EQ( value, lockit.find( table.names[ i ] ) );
+        }
+    }
+    EXPECT_EQ( ui::Lockit{ cook( makeTable( 3 ) ) }.find( "key_1"_hash ), U"value of key_1" );
+}
+
+TEST( UiLockit, perfect_hash_rejects_duplicates )
+{
+    std::pmr::vector<lang::KeyType> keys{};
+    keys.emplace_back( "a"_hash, 0, 0 );
+    keys.emplace_back( "b"_hash, 0, 0 );
+    keys.emplace_back( "a"_hash, 0, 0 );
+    std::pmr::vector<uint32_t> seeds{};
+    EXPECT_FALSE( lang::perfectHash( keys, seeds ) );
+
+    std::pmr::vector<lang::KeyType> empty{};
+    EXPECT_TRUE( lang::perfectHash( empty, seeds ) );
+    EXPECT_TRUE( seeds.empty() );
+}
+
+TEST( UiLockit, DISABLED_lookup_benchmark )
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint32_t LOOKUPS = 2'000'000;
+
+    for ( uint32_t count : { 49u, 1000u, 20000u } ) {
+        const Table table = makeTable( count );
+        const std::pmr::vector<uint8_t> data = cook( table );
+        const ui::Lockit lockit{ data };
+
+        // previous layout: keys sorted by hash, binary searched
+        std::pmr::vector<lang::KeyType> sorted = table.keys;
+        std::sort( sorted.begin(), sorted.end() );
+        auto lowerBound = [&sorted, &table]( Hash::value_type h ) -> std::u32string_view
+        {
+            auto it = std::lower_bound( sorted.begin(), sorted.end(), lang::KeyType{ h, 0, 0 } );
+            if ( it == sorted.end() || it->hash != h ) return {};
+            return std::u32string_view{ table.strings.data() + it->offset, it->size };
+        };
+
+        std::pmr::vector<Hash::value_type> queries( LOOKUPS );
+        std::mt19937 gen{ count };
+        std::uniform_int_distribution<uint32_t> dist{ 0, count - 1 };
+        for ( auto& q : queries ) q = table.keys[ dist( gen ) ].hash;
+
+        auto measure = [&queries]( auto&& find, size_t& sum )
+        {
+            sum = 0;
+            const auto begin = Clock::now();
+            for ( Hash::value_type h : queries ) sum += find( h ).size();
+            return std::chrono::duration<double, std::nano>( Clock::now() - begin ).count() / LOOKUPS;
+        };
+        size_t sumSorted = 0;
+        size_t sumHashed = 0;
+        const double sortedTime = measure( lowerBound, sumSorted );
+        const double hashedTime = measure( [&lockit]( Hash::value_type h ) { return lockit.find( h ); }, sumHashed );
+        EXPECT_EQ( sumSorted, sumHashed );
+        const std::string prefix = "keys_" + std::to_string( count );
+        RecordProperty( prefix + "_lower_bound_ns", std::to_string( sortedTime ) );
+        RecordProperty( prefix + "_perfect_hash_ns", std::to_string( hashedTime ) );
+    }
+}
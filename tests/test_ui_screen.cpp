@@ -0,0 +1,639 @@
+#include <gtest/gtest.h>
+
+#include <ui/data_model.hpp>
+#include <ui/font.hpp>
+#include <ui/pipeline.hpp>
+#include <ui/property.hpp>
+#include <ui/screen.hpp>
+
+#include <config/config.hpp>
+#include <extra/fnta.hpp>
+#include <extra/lang.hpp>
+#include <input/remapper.hpp>
+#include <renderer/renderer.hpp>
+#include <shared/hash.hpp>
+#include <shared/resource_map.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <set>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+// Counts draws and hashes everything renderer would consume, so cached frames can be compared with rebuilt ones.
+class CountingContext : public RecordingContext {
+public:
+    uint32_t m_draws = 0;
+    uint32_t m_dispatches = 0;
+    uint32_t m_instances = 0;
+    uint64_t m_checksum = 14695981039346656037ull;
+    bool m_hashEnabled = true;
+
+    void hash( const void* ptr, size_t size )
+    {
+        if ( !m_hashEnabled ) return;
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>( ptr );
+        for ( size_t i = 0; i < size; ++i ) {
+            m_checksum = ( m_checksum ^ bytes[ i ] ) * 1099511628211ull;
+        }
+    }
+
+    virtual void render( const RenderInfo& ri ) override
+    {
+        m_draws++;
+        m_instances += ri.m_instanceCount;
+        hash( &ri.m_pipeline, sizeof( ri.m_pipeline ) );
+        hash( &ri.m_instanceCount, sizeof( ri.m_instanceCount ) );
+        hash( ri.m_fragmentTexture.data(), sizeof( ri.m_fragmentTexture ) );
+        hash( ri.m_uniform.ptr, ri.m_uniform.size );
+    }
+
+    virtual void dispatch( const DispatchInfo& di ) override
+    {
+        m_dispatches++;
+        hash( &di.m_pipeline, sizeof( di.m_pipeline ) );
+        hash( di.m_uniform.ptr, di.m_uniform.size );
+    }
+};
+
+class BenchModel : public ui::DataModel {
+public:
+    ui::Variant m_value{};
+    size_type m_revision = 0;
+    size_type m_current = 0;
+    // copies of string value handed out, each one allocates from default resource
+    static inline uint32_t s_stringCopies = 0;
+
+    virtual size_type revision() const override { return m_revision; }
+    virtual size_type current() const override { return m_current; }
+    virtual size_type size() const override { return 4; }
+    virtual ui::Variant data( size_type ) const override
+    {
+        if ( std::holds_alternative<std::pmr::u32string>( m_value ) ) s_stringCopies++;
+        return m_value;
+    }
+    virtual void select( size_type i ) override
+    {
+        m_current = i;
+        m_value = ui::Variant{ std::pmr::u32string{ U"value " } + static_cast<char32_t>( U'0' + i ) };
+        m_revision++;
+    }
+};
+
+// Fonts, sprites, lockit and data models for every .ui screen of the game, with textures as plain ids.
+struct UiFixture {
+    static constexpr Texture TEXTURE = ( 4u << 16 ) | 1u;
+    static constexpr Texture TEXTURE_FALLBACK = ( 4u << 16 ) | 2u;
+    std::pmr::vector<std::filesystem::path> files{};
+    std::pmr::vector<Hash::value_type> screens{};
+    std::pmr::vector<std::pmr::vector<uint8_t>> buffers{};
+    std::map<Hash::value_type, std::unique_ptr<BenchModel>> models{};
+    ResourceMap<Texture> textures{};
+    ResourceMap<PipelineSlot> materials{};
+    input::Remapper remapper{};
+
+    static std::pmr::vector<uint8_t> makeAtlas( std::string_view name, std::set<char32_t> keys, uint16_t height, Hash::value_type texture = "ui"_hash )
+    {
+        const fnta::Header header{
+            .count = static_cast<uint32_t>( keys.size() ),
+            .width = 1024,
+            .height = 1024,
+            .lineHeight = height,
+            .nameHash = Hash{}( name ),
+            .textureHash = texture,
+        };
+        std::pmr::vector<uint8_t> ret( sizeof( header ) + keys.size() * ( sizeof( char32_t ) + sizeof( fnta::Glyph ) ) );
+        uint8_t* ptr = ret.data();
+        std::memcpy( ptr, &header, sizeof( header ) );
+        ptr += sizeof( header );
+        for ( char32_t c : keys ) {
+            std::memcpy( ptr, &c, sizeof( c ) );
+            ptr += sizeof( c );
+        }
+        uint16_t i = 0;
+        for ( [[maybe_unused]] char32_t c : keys ) {
+            const fnta::Glyph glyph{
+                .position{ static_cast<uint16_t>( i % 64 * 16 ), static_cast<uint16_t>( i / 64 * 16 ) },
+                .size{ static_cast<uint16_t>( height / 2 ), height },
+                .advance{ static_cast<int16_t>( height / 2 + 1 ), 0 },
+            };
+            std::memcpy( ptr, &glyph, sizeof( glyph ) );
+            ptr += sizeof( glyph );
+            i++;
+        }
+        return ret;
+    }
+
+    static std::pmr::vector<uint8_t> makeLockit( const std::set<std::string>& keys, std::string_view id = "en", std::string_view prefix = {} )
+    {
+        std::pmr::vector<lang::KeyType> index;
+        std::pmr::u32string strings;
+        for ( const auto& key : keys ) {
+            const std::string value = std::string{ prefix } + key;
+            index.emplace_back( Hash{}( key ), static_cast<uint32_t>( strings.size() ), static_cast<uint32_t>( value.size() ) );
+            strings.append( value.begin(), value.end() );
+        }
+        std::pmr::vector<uint32_t> seeds;
+        EXPECT_TRUE( lang::perfectHash( index, seeds ) );
+        lang::Header header{
+            .count = static_cast<uint32_t>( index.size() ),
+            .string = static_cast<uint32_t>( strings.size() ),
+            .buckets = static_cast<uint32_t>( seeds.size() ),
+        };
+        std::ranges::copy( id, std::begin( header.id ) );
+        std::pmr::vector<uint8_t> ret( sizeof( header ) + seeds.size() * sizeof( uint32_t ) + index.size() * sizeof( lang::KeyType ) + strings.size() * sizeof( char32_t ) );
+        uint8_t* ptr = ret.data();
+        std::memcpy( ptr, &header, sizeof( header ) );
+        ptr += sizeof( header );
+        std::memcpy( ptr, seeds.data(), seeds.size() * sizeof( uint32_t ) );
+        ptr += seeds.size() * sizeof( uint32_t );
+        std::memcpy( ptr, index.data(), index.size() * sizeof( lang::KeyType ) );
+        ptr += index.size() * sizeof( lang::KeyType );
+        std::memcpy( ptr, strings.data(), strings.size() * sizeof( char32_t ) );
+        return ret;
+    }
+
+    static std::pmr::vector<uint8_t> readFile( const std::filesystem::path& path )
+    {
+        std::ifstream ifs( path, std::ios::binary | std::ios::ate );
+        std::pmr::vector<uint8_t> ret( static_cast<size_t>( ifs.tellg() ) );
+        ifs.seekg( 0 );
+        ifs.read( reinterpret_cast<char*>( ret.data() ), static_cast<std::streamsize>( ret.size() ) );
+        return ret;
+    }
+
+    UiFixture()
+    {
+        textures.insert( std::make_pair( "ui"_hash, TEXTURE ) );
+        textures.insert( std::make_pair( "fallback"_hash, TEXTURE_FALLBACK ) );
+        PipelineSlot slot = 1;
+        for ( const char* name : { "spriteBatch", "spriteSequence", "spriteSequenceColors", "glow", "blur" } ) {
+            materials.insert( std::make_pair( std::string_view{ name }, slot++ ) );
+        }
+        g_uiProperty.setResources( ui::Property::Resources{
+            .textures = &textures,
+            .materials = &materials,
+            .remapper = &remapper,
+        } );
+
+        std::set<std::string> texts{};
+        std::set<char32_t> sprites{};
+        for ( const char* name : { "white", "arrowLeft", "arrowRight", "mid", "topLeftSquare", "top", "topRightSquare", "left", "right"
+            , "botLeftSquare", "bot", "botRightSquare", "botLeftDiamond", "botRightDiamond" } ) {
+            sprites.insert( static_cast<char32_t>( Hash{}( name ) ) );
+        }
+
+        for ( const auto& entry : std::filesystem::directory_iterator{ UI_DIR } ) {
+            if ( entry.path().extension() != ".ui" ) continue;
+            files.emplace_back( entry.path() );
+        }
+        std::ranges::sort( files );
+
+        auto scan = [&]( auto&& self, const cfg::Entry& widget ) -> void
+        {
+            for ( const cfg::Entry& property : widget ) {
+                const std::string_view name = property.name();
+                const std::string_view value = property.toString();
+                if ( property.begin() != property.end() ) {
+                    self( self, property );
+                    continue;
+                }
+                if ( name == "text" ) {
+                    texts.emplace( value );
+                }
+                else if ( name == "path" || name.starts_with( "frame" ) ) {
+                    sprites.insert( static_cast<char32_t>( Hash{}( value ) ) );
+                }
+                else if ( name == "data" ) {
+                    auto& model = models[ Hash{}( value ) ];
+                    if ( model ) continue;
+                    model = std::make_unique<BenchModel>();
+                    const std::string_view type = widget.name();
+                    if ( type == "Progressbar" || type == "AnimFrame" ) model->m_value = 0.5f;
+                    else if ( type == "Image" ) model->m_value = ui::Sprite{ .texture = TEXTURE, .w = 64, .h = 64 };
+                    else model->m_value = std::pmr::u32string{ U"value 0" };
+                    g_uiProperty.addDataModel( Hash{}( value ), model.get() );
+                }
+            }
+        };
+        for ( const auto& path : files ) {
+            const cfg::Entry entry = cfg::Entry::fromData( readFile( path ) );
+            scan( scan, entry );
+            screens.emplace_back( Hash{}( entry[ "name" ].toString() ) );
+        }
+
+        std::set<char32_t> glyphs{};
+        for ( char32_t c = U' '; c < 127; ++c ) glyphs.insert( c );
+        g_uiProperty.loadFNTA( buffers.emplace_back( makeAtlas( "small", glyphs, 16 ) ) );
+        g_uiProperty.loadFNTA( buffers.emplace_back( makeAtlas( "medium", glyphs, 24 ) ) );
+        g_uiProperty.loadFNTA( buffers.emplace_back( makeAtlas( "large", glyphs, 48 ) ) );
+        // cyrillic, some CJK and astral code points none of the fonts above have
+        std::set<char32_t> fallback{};
+        for ( char32_t c = 0x410; c < 0x450; ++c ) fallback.insert( c );
+        for ( char32_t c = 0x4E00; c < 0x4E40; ++c ) fallback.insert( c );
+        for ( char32_t c = 0x1F600; c < 0x1F610; ++c ) fallback.insert( c );
+        g_uiProperty.loadFNTA( buffers.emplace_back( makeAtlas( "fallback", fallback, 32, "fallback"_hash ) ) );
+        g_uiProperty.loadATLAS( buffers.emplace_back( makeAtlas( "atlas", sprites, 32 ) ) );
+        g_uiProperty.loadLANG( buffers.emplace_back( makeLockit( texts ) ) );
+        // longer strings than the default language, switching to it has to grow label text
+        g_uiProperty.loadLANG( buffers.emplace_back( makeLockit( texts, "xx", "longer translation of " ) ) );
+        for ( const auto& path : files ) {
+            g_uiProperty.loadUI( buffers.emplace_back( readFile( path ) ) );
+        }
+    }
+
+    static UiFixture& instance()
+    {
+        static UiFixture fixture{};
+        return fixture;
+    }
+};
+
+static constexpr math::vec2 VIEWPORT{ 1280.0f, 720.0f };
+static constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+static ui::Screen* showScreen( Hash::value_type name )
+{
+    g_uiProperty.changeScreen( name, VIEWPORT );
+    ui::Screen* screen = g_uiProperty.currentScreen();
+    // let slide-in animation finish
+    CountingContext ctx{};
+    for ( uint32_t i = 0; i < 30; ++i ) {
+        screen->update( ui::UpdateContext{ .deltaTime = DELTA_TIME } );
+        screen->render( &ctx, VIEWPORT );
+    }
+    return screen;
+}
+
+static CountingContext frame( ui::Screen* screen, math::vec2 viewport = VIEWPORT, bool checksum = true )
+{
+    CountingContext ctx{};
+    ctx.m_hashEnabled = checksum;
+    screen->resize( viewport );
+    screen->update( ui::UpdateContext{ .deltaTime = DELTA_TIME } );
+    screen->render( &ctx, viewport );
+    return ctx;
+}
+
+TEST( UiScreen, replays_clean_widgets )
+{
+    UiFixture& fixture = UiFixture::instance();
+    ASSERT_FALSE( fixture.screens.empty() );
+    for ( Hash::value_type name : fixture.screens ) {
+        ui::Screen* screen = showScreen( name );
+        ASSERT_TRUE( screen );
+
+        // different aspect ratio changes projection, every widget records again
+        const math::vec2 wide{ 1920.0f, 720.0f };
+        const CountingContext rebuilt = frame( screen, wide );
+        const ui::RenderStatistics first = screen->statistics();
+        EXPECT_EQ( first.replayed, 0u );
+
+        const CountingContext replayed = frame( screen, wide );
+        const ui::RenderStatistics second = screen->statistics();
+        EXPECT_EQ( first.rebuilt + first.replayed, second.rebuilt + second.replayed );
+        EXPECT_EQ( first.draws, second.draws );
+        if ( name == "loading"_hash ) {
+            // spinner keeps changing frames on its own
+            EXPECT_LE( second.rebuilt, 1u );
+            continue;
+        }
+        EXPECT_EQ( second.rebuilt, 0u );
+        EXPECT_EQ( rebuilt.m_draws, replayed.m_draws );
+        EXPECT_EQ( rebuilt.m_dispatches, replayed.m_dispatches );
+        EXPECT_EQ( rebuilt.m_checksum, replayed.m_checksum );
+    }
+}
+
+TEST( UiScreen, invalidates_on_revision_focus_and_animation )
+{
+    UiFixture& fixture = UiFixture::instance();
+    ui::Screen* screen = showScreen( "customize"_hash );
+    ASSERT_TRUE( screen );
+    frame( screen );
+    EXPECT_EQ( screen->statistics().rebuilt, 0u );
+
+    // value label of first spin box
+    BenchModel* jet = fixture.models[ "$data:jet"_hash ].get();
+    ASSERT_TRUE( jet );
+    jet->select( 1 );
+    frame( screen );
+    EXPECT_EQ( screen->statistics().rebuilt, 1u );
+    frame( screen );
+    EXPECT_EQ( screen->statistics().rebuilt, 0u );
+
+    // focus moves from first to second spin box
+    screen->onAction( ui::Action{ .a = ui::Action::eMenuDown, .value = 1 } );
+    screen->onAction( ui::Action{ .a = ui::Action::eMenuDown, .value = 0 } );
+    frame( screen );
+    EXPECT_EQ( screen->statistics().rebuilt, 2u );
+    frame( screen );
+    EXPECT_EQ( screen->statistics().rebuilt, 0u );
+
+    // arrow slides back for a few frames, value label changes once
+    screen->onAction( ui::Action{ .a = ui::Action::eMenuRight, .value = 1 } );
+    screen->onAction( ui::Action{ .a = ui::Action::eMenuRight, .value = 0 } );
+    frame( screen );
+    EXPECT_EQ( screen->statistics().rebuilt, 2u );
+    frame( screen );
+    EXPECT_EQ( screen->statistics().rebuilt, 1u );
+    for ( uint32_t i = 0; i < 30; ++i ) frame( screen );
+    EXPECT_EQ( screen->statistics().rebuilt, 0u );
+}
+
+TEST( UiScreen, batches_screen_draws )
+{
+    UiFixture& fixture = UiFixture::instance();
+    for ( size_t i = 0; i < fixture.screens.size(); ++i ) {
+        ui::Screen* screen = showScreen( fixture.screens[ i ] );
+        ASSERT_TRUE( screen );
+        const CountingContext ctx = frame( screen );
+        const ui::RenderStatistics statistics = screen->statistics();
+        EXPECT_EQ( ctx.m_draws, statistics.submitted );
+        EXPECT_LE( statistics.submitted, statistics.draws );
+        // glow and as many full batches as sprites and glyphs of whole screen need, message box blur would split it further
+        using Batch = ui::PushConstant<ui::Pipeline::eSpriteBatch>;
+        if ( ctx.m_dispatches == 0 ) {
+            EXPECT_LE( statistics.submitted, 1u + ( ctx.m_instances + Batch::INSTANCES - 1 ) / Batch::INSTANCES );
+        }
+    }
+}
+
+TEST( UiScreen, DISABLED_benchmark )
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint32_t FRAMES = 2000;
+    UiFixture& fixture = UiFixture::instance();
+
+    auto measure = []( ui::Screen* screen, bool forceRebuild, uint32_t& rebuilt, uint32_t& draws )
+    {
+        rebuilt = 0;
+        draws = 0;
+        const auto begin = Clock::now();
+        for ( uint32_t i = 0; i < FRAMES; ++i ) {
+            // alternating viewport width invalidates projection of every widget
+            const math::vec2 viewport = forceRebuild ? VIEWPORT + math::vec2{ static_cast<float>( i & 1 ), 0.0f } : VIEWPORT;
+            const CountingContext ctx = frame( screen, viewport, false );
+            rebuilt += screen->statistics().rebuilt;
+            draws += ctx.m_draws;
+        }
+        return std::chrono::duration<double, std::micro>( Clock::now() - begin ).count() / FRAMES;
+    };
+
+    for ( size_t i = 0; i < fixture.screens.size(); ++i ) {
+        ui::Screen* screen = showScreen( fixture.screens[ i ] );
+        uint32_t rebuiltAll = 0;
+        uint32_t drawsAll = 0;
+        uint32_t rebuiltCached = 0;
+        uint32_t drawsCached = 0;
+        const double all = measure( screen, true, rebuiltAll, drawsAll );
+        const double cached = measure( screen, false, rebuiltCached, drawsCached );
+        EXPECT_EQ( drawsAll, drawsCached );
+        EXPECT_LE( rebuiltCached, rebuiltAll );
+        const std::string prefix = fixture.files[ i ].stem().string();
+        RecordProperty( prefix + "_rebuild_us", std::to_string( all ) );
+        RecordProperty( prefix + "_cached_us", std::to_string( cached ) );
+    }
+}
+
+static std::pmr::vector<uint8_t> readCooked( const std::filesystem::path& path )
+{
+    const std::filesystem::path cooked = std::filesystem::path{ UI_COOKED_DIR } / path.filename();
+    if ( !std::filesystem::exists( cooked ) ) return {};
+    return UiFixture::readFile( cooked );
+}
+
+TEST( UiScreen, cooked_matches_text )
+{
+    UiFixture& fixture = UiFixture::instance();
+    for ( const auto& path : fixture.files ) {
+        const auto text = UiFixture::readFile( path );
+        const auto cooked = readCooked( path );
+        ASSERT_FALSE( cooked.empty() ) << path;
+
+        ui::Screen fromText{ text };
+        ui::Screen fromCooked{ cooked };
+        EXPECT_EQ( fromText.name(), fromCooked.name() ) << path;
+        EXPECT_EQ( fromText.scene(), fromCooked.scene() ) << path;
+        fromText.show( VIEWPORT );
+        fromCooked.show( VIEWPORT );
+        CountingContext a{};
+        CountingContext b{};
+        for ( uint32_t i = 0; i < 30; ++i ) {
+            a = frame( &fromText );
+            b = frame( &fromCooked );
+        }
+        EXPECT_EQ( a.m_draws, b.m_draws ) << path;
+        EXPECT_EQ( a.m_instances, b.m_instances ) << path;
+        EXPECT_EQ( a.m_checksum, b.m_checksum ) << path;
+    }
+}
+
+TEST( UiScreen, DISABLED_load_benchmark )
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint32_t ITERATIONS = 2000;
+    UiFixture& fixture = UiFixture::instance();
+
+    auto measure = []( std::span<const uint8_t> data )
+    {
+        const auto begin = Clock::now();
+        for ( uint32_t i = 0; i < ITERATIONS; ++i ) {
+            ui::Screen screen{ data };
+            EXPECT_NE( screen.name(), 0u );
+        }
+        return std::chrono::duration<double, std::micro>( Clock::now() - begin ).count() / ITERATIONS;
+    };
+
+    for ( const auto& path : fixture.files ) {
+        const auto text = UiFixture::readFile( path );
+        const auto cooked = readCooked( path );
+        ASSERT_FALSE( cooked.empty() ) << path;
+        const double textTime = measure( text );
+        const double cookedTime = measure( cooked );
+        const std::string prefix = path.stem().string();
+        RecordProperty( prefix + "_text_us", std::to_string( textTime ) );
+        RecordProperty( prefix + "_cooked_us", std::to_string( cookedTime ) );
+    }
+}
+
+// Installed as default resource for its lifetime, counts allocations that would otherwise reach heap.
+class CountingResource : public std::pmr::memory_resource {
+    std::pmr::memory_resource* m_upstream = nullptr;
+
+public:
+    uint32_t m_allocations = 0;
+
+    ~CountingResource() noexcept
+    {
+        std::pmr::set_default_resource( m_upstream );
+    }
+
+    CountingResource() noexcept
+    : m_upstream{ std::pmr::set_default_resource( this ) }
+    {}
+
+private:
+    virtual void* do_allocate( size_t bytes, size_t align ) override
+    {
+        m_allocations++;
+        return m_upstream->allocate( bytes, align );
+    }
+
+    virtual void do_deallocate( void* ptr, size_t bytes, size_t align ) override
+    {
+        m_upstream->deallocate( ptr, bytes, align );
+    }
+
+    virtual bool do_is_equal( const std::pmr::memory_resource& rhs ) const noexcept override
+    {
+        return this == &rhs;
+    }
+};
+
+TEST( UiScreen, arena_allocations )
+{
+    UiFixture& fixture = UiFixture::instance();
+    for ( const auto& path : fixture.files ) {
+        const auto text = UiFixture::readFile( path );
+        const auto cooked = readCooked( path );
+        ASSERT_FALSE( cooked.empty() ) << path;
+
+        CountingResource counting{};
+        BenchModel::s_stringCopies = 0;
+        ui::Screen screen{ cooked };
+        const uint32_t created = counting.m_allocations;
+        const uint32_t stringCopies = BenchModel::s_stringCopies;
+        const ui::Arena::Statistics statistics = screen.arenaStatistics();
+        // every allocation of widget tree is served by arena, the rest of heap traffic is strings copied out of data models
+        EXPECT_EQ( created, statistics.heapAllocations + stringCopies ) << path;
+        // budget is derived from widget sizes and usual text length, unusually long strings may grow arena once
+        EXPECT_GE( statistics.heapAllocations, 1u ) << path;
+        EXPECT_LE( statistics.heapAllocations, 2u ) << path;
+
+        const ui::Screen fromText{ text };
+        EXPECT_LE( fromText.arenaStatistics().heapAllocations, 2u ) << path;
+
+        screen.show( VIEWPORT );
+        for ( uint32_t i = 0; i < 30; ++i ) frame( &screen );
+        const uint32_t warm = counting.m_allocations;
+        const uint32_t arenaWarm = screen.arenaStatistics().allocations;
+        for ( uint32_t i = 0; i < 30; ++i ) frame( &screen );
+        EXPECT_EQ( counting.m_allocations, warm ) << path;
+        EXPECT_EQ( screen.arenaStatistics().allocations, arenaWarm ) << path;
+    }
+}
+
+TEST( UiScreen, language_switch_reuses_tree )
+{
+    static constexpr std::array<char, 8> EN{ 'e', 'n' };
+    static constexpr std::array<char, 8> XX{ 'x', 'x' };
+    UiFixture& fixture = UiFixture::instance();
+    std::pmr::vector<ui::Screen*> screens{};
+    std::pmr::vector<uint64_t> checksums{};
+    for ( Hash::value_type name : fixture.screens ) {
+        ui::Screen* screen = showScreen( name );
+        ASSERT_TRUE( screen );
+        screens.emplace_back( screen );
+        checksums.emplace_back( frame( screen ).m_checksum );
+    }
+
+    // first round trip lets label text grow to the longest translation
+    g_uiProperty.changeLockit( XX );
+    g_uiProperty.changeLockit( EN );
+    std::pmr::vector<uint32_t> arenaAllocations{};
+    for ( ui::Screen* screen : screens ) {
+        arenaAllocations.emplace_back( screen->arenaStatistics().allocations );
+    }
+
+    CountingResource counting{};
+    BenchModel::s_stringCopies = 0;
+    for ( uint32_t i = 0; i < 10; ++i ) {
+        g_uiProperty.changeLockit( XX );
+        g_uiProperty.changeLockit( EN );
+    }
+    EXPECT_EQ( counting.m_allocations, BenchModel::s_stringCopies );
+    for ( size_t i = 0; i < screens.size(); ++i ) {
+        EXPECT_EQ( screens[ i ]->arenaStatistics().allocations, arenaAllocations[ i ] ) << fixture.files[ i ];
+    }
+
+    g_uiProperty.changeLockit( XX );
+    uint32_t translated = 0;
+    for ( size_t i = 0; i < screens.size(); ++i ) {
+        translated += frame( screens[ i ] ).m_checksum != checksums[ i ];
+    }
+    g_uiProperty.changeLockit( EN );
+    for ( size_t i = 0; i < screens.size(); ++i ) {
+        const uint64_t checksum = frame( screens[ i ] ).m_checksum;
+        // spinner keeps changing frames on its own
+        if ( fixture.screens[ i ] == "loading"_hash ) continue;
+        EXPECT_EQ( checksum, checksums[ i ] ) << fixture.files[ i ];
+    }
+    EXPECT_GT( translated, 0u );
+}
+
+TEST( UiFont, resolves_fallback_glyphs )
+{
+    UiFixture::instance();
+    const ui::Font* medium = g_uiProperty.font( "medium"_hash );
+    const ui::Font* fallback = g_uiProperty.font( "fallback"_hash );
+    ASSERT_TRUE( medium );
+    ASSERT_TRUE( fallback );
+    EXPECT_TRUE( medium->hasCodepoint( U'A' ) );
+    EXPECT_FALSE( medium->hasCodepoint( U'Ж' ) );
+    EXPECT_FALSE( medium->hasCodepoint( 0x1F600 ) );
+
+    EXPECT_EQ( medium->find( U'A' ).texture, UiFixture::TEXTURE );
+    EXPECT_EQ( medium->find( U'Ж' ).texture, UiFixture::TEXTURE_FALLBACK );
+    EXPECT_EQ( medium->find( char32_t{ 0x4E01 } ).texture, UiFixture::TEXTURE_FALLBACK );
+    EXPECT_EQ( medium->find( char32_t{ 0x1F601 } ).texture, UiFixture::TEXTURE_FALLBACK );
+    EXPECT_EQ( medium->find( U'Ж' ).w, fallback->find( U'Ж' ).w );
+
+    // glyph borrowed from taller font is scaled down to line height of requesting one
+    const ui::Font::RenderText latin = medium->composeText( U"AB" );
+    const ui::Font::RenderText cyrillic = medium->composeText( U"ЖЖ" );
+    ASSERT_EQ( latin.data.size(), 2u );
+    ASSERT_EQ( cyrillic.data.size(), 2u );
+    EXPECT_EQ( latin.extent.y, cyrillic.extent.y );
+    EXPECT_FLOAT_EQ( cyrillic.data[ 0 ].m_xywh.w, 24.0f );
+    EXPECT_EQ( cyrillic.pushData.m_fragmentTexture[ cyrillic.data[ 0 ].m_whichAtlas ], UiFixture::TEXTURE_FALLBACK );
+}
+
+TEST( UiFont, DISABLED_layout_benchmark )
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint32_t ITERATIONS = 20000;
+    UiFixture::instance();
+    const ui::Font* font = g_uiProperty.font( "medium"_hash );
+    ASSERT_TRUE( font );
+
+    struct Sample {
+        const char* name;
+        std::u32string_view text;
+    };
+    static constexpr Sample SAMPLES[] = {
+        { "hud", U"SCORE 0012345  SPD 1234.5 km/h  ALPHA-7 LOCKED  AMMO 120/240" },
+        { "sentence", U"The quick brown fox jumps over the lazy dog while the engines hum quietly in the background." },
+        { "fallback", U"Скорость 123 一丁七万 \U0001F600\U0001F601 ЖЗИЙ mixed with latin text" },
+    };
+    for ( const Sample& sample : SAMPLES ) {
+        size_t glyphs = 0;
+        const auto begin = Clock::now();
+        for ( uint32_t i = 0; i < ITERATIONS; ++i ) {
+            glyphs += font->composeText( sample.text, math::vec2{ 4096.0f, 100.0f } ).data.size();
+        }
+        const double seconds = std::chrono::duration<double>( Clock::now() - begin ).count();
+        EXPECT_EQ( glyphs % ITERATIONS, 0u );
+        RecordProperty( std::string{ sample.name } + "_mglyphs_s", std::to_string( static_cast<double>( glyphs ) / seconds / 1'000'000.0 ) );
+    }
+}
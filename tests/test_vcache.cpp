@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <extra/vcache.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+static constexpr uint32_t STRIDE = 3;
+
+// non-indexed triangle list of a grid, triangles shuffled to simulate unordered exporter output
+static std::vector<float> shuffledGrid( uint32_t size, uint32_t seed )
+{
+    std::vector<std::array<float, 9>> triangles;
+    for ( uint32_t y = 0; y < size; ++y ) {
+        for ( uint32_t x = 0; x < size; ++x ) {
+            const float x0 = static_cast<float>( x );
+            const float y0 = static_cast<float>( y );
+            const float x1 = x0 + 1.0f;
+            const float y1 = y0 + 1.0f;
+            triangles.push_back( { x0, y0, 0.0f, x1, y0, 0.0f, x1, y1, 0.0f } );
+            triangles.push_back( { x0, y0, 0.0f, x1, y1, 0.0f, x0, y1, 0.0f } );
+        }
+    }
+    std::mt19937 gen{ seed };
+    std::shuffle( triangles.begin(), triangles.end(), gen );
+
+    std::vector<float> ret;
+    for ( const auto& it : triangles ) ret.insert( ret.end(), it.begin(), it.end() );
+    return ret;
+}
+
+static std::vector<std::array<float, 9>> expand( const vcache::Welded& w )
+{
+    std::vector<std::array<float, 9>> ret;
+    for ( std::size_t i = 0; i < w.indices.size(); i += 3 ) {
+        std::array<float, 9> tri{};
+        for ( uint32_t j = 0; j < 3; ++j ) {
+            std::copy_n( w.vertices.data() + w.indices[ i + j ] * STRIDE, STRIDE, tri.data() + j * STRIDE );
+        }
+        ret.push_back( tri );
+    }
+    std::ranges::sort( ret );
+    return ret;
+}
+
+TEST( VertexCache, weld )
+{
+    const std::vector<float> grid = shuffledGrid( 8, 1 );
+    const vcache::Welded w = vcache::weld( grid, STRIDE );
+    EXPECT_EQ( w.indices.size(), grid.size() / STRIDE );
+    EXPECT_EQ( w.vertices.size(), 9u * 9u * STRIDE );
+    for ( std::size_t i = 0; i < w.indices.size(); ++i ) {
+        ASSERT_TRUE( std::equal( grid.begin() + i * STRIDE, grid.begin() + ( i + 1 ) * STRIDE, w.vertices.begin() + w.indices[ i ] * STRIDE ) );
+    }
+}
+
+TEST( VertexCache, optimize )
+{
+    const std::vector<float> grid = shuffledGrid( 32, 2 );
+    vcache::Welded w = vcache::weld( grid, STRIDE );
+    const auto reference = expand( w );
+    const float before = vcache::acmr( w.indices );
+
+    vcache::optimizeTriangles( w.indices, static_cast<uint32_t>( w.vertices.size() / STRIDE ) );
+    const float after = vcache::acmr( w.indices );
+    EXPECT_EQ( expand( w ), reference );
+
+    vcache::optimizeFetch( w.indices, w.vertices, STRIDE );
+    EXPECT_EQ( expand( w ), reference );
+    EXPECT_EQ( vcache::acmr( w.indices ), after );
+
+    // first use order after fetch optimization
+    uint32_t next = 0;
+    for ( uint32_t idx : w.indices ) {
+        ASSERT_LE( idx, next );
+        if ( idx == next ) next++;
+    }
+
+    EXPECT_GT( before, 1.5f );
+    EXPECT_LT( after, 0.8f );
+}
+
+TEST( VertexCache, acmr )
+{
+    const std::vector<uint32_t> nonIndexed{ 0, 1, 2, 3, 4, 5 };
+    EXPECT_EQ( vcache::acmr( nonIndexed ), 3.0f );
+    const std::vector<uint32_t> quad{ 0, 1, 2, 0, 2, 3 };
+    EXPECT_EQ( vcache::acmr( quad ), 2.0f );
+}